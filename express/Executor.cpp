@@ -14,9 +14,18 @@
 #include "core/WrapExecution.hpp"
 #include "geometry/GeometryComputerUtils.hpp"
 #include <MNN/expr/ExecutorScope.hpp>
+#include <algorithm>
+#include "backend/cpu/CPUBackend.hpp"
+#ifdef MNN_USE_THREAD_POOL
+#include "backend/cpu/ThreadPool.hpp"
+#endif
 #ifdef MNN_EXPR_ENABLE_PROFILER
 #define MNN_EXPRESS_ERROR_REPORT
 #endif
+// The cost model of scheduling lanes, counted in elements read and written. The fixed cost of dispatching a task to
+// the thread pool and waiting for it, and the elements an op needs for each thread of the backend to speed up
+#define MNN_EXPR_DISPATCH_COST 4096.0f
+#define MNN_EXPR_ELEMENTS_PER_THREAD 8192.0f
 #define MNN_EXPRESS_OPEN_MEMORY_REUSE
 namespace MNN {
 namespace Express {
@@ -65,6 +74,32 @@ void Executor::Profiler::addFlops(const std::string& opType, float flops) {
     iter->second += flops;
 }
 #endif
+// Single thread CPU runtimes with separate memory pools, the ops in them are run by one task of the thread pool
+struct Executor::Lanes {
+    std::vector<std::shared_ptr<Runtime>> runtimes;
+#ifdef MNN_USE_THREAD_POOL
+    /* The thread pool has only MNN_THREAD_POOL_MAX_TASKS (2) task slots, and each multi-thread CPU runtime holds one.
+       A stage runs either in the lanes or by the backend, so the lanes use the slot of the backend, and take one of
+       their own only if the backend is single thread. If no slot is left, the lanes run one by one. */
+    int taskIndex(int backendIndex) {
+        if (backendIndex >= 0) {
+            return backendIndex;
+        }
+        std::lock_guard<std::mutex> _l(mutex);
+        if (!acquired) {
+            ownIndex = ThreadPool::acquireWorkIndex();
+            acquired = true;
+        }
+        return ownIndex;
+    }
+    ~Lanes() {
+        ThreadPool::releaseWorkIndex(ownIndex);
+    }
+    std::mutex mutex;
+    int ownIndex  = -1;
+    bool acquired = false;
+#endif
+};
 void Executor::setGlobalExecutorConfig(MNNForwardType type, const BackendConfig& config, int numberThread) {
     std::lock_guard<std::mutex> _l(mMutex);
     auto creator = MNNGetExtraRuntimeCreator(type);
@@ -92,6 +127,37 @@ void Executor::gc(GCFlag flag) {
         mBackupRuntime.first->onGabageCollect(0);
         mRuntime.first->onGabageCollect(0);
     }
+    if (nullptr != mLanes) {
+        for (auto& runtime : mLanes->runtimes) {
+            runtime->onGabageCollect(FULL == flag ? 100 : 0);
+        }
+    }
+}
+void Executor::setBranchLanes(int number) {
+    std::lock_guard<std::mutex> _l(mMutex);
+    mLanes = nullptr;
+    if (number <= 1) {
+        return;
+    }
+#ifdef MNN_USE_THREAD_POOL
+    std::shared_ptr<Lanes> lanes(new Lanes);
+    number = ThreadPool::init(number);
+    if (number <= 1) {
+        MNN_ERROR("Can't run branches concurrently, the thread pool is not available\n");
+        return;
+    }
+    auto creator = MNNGetExtraRuntimeCreator(MNN_FORWARD_CPU);
+    Backend::Info info;
+    info.type      = MNN_FORWARD_CPU;
+    info.mode      = Backend::Info::DIRECT;
+    info.numThread = 1;
+    for (int i = 0; i < number; ++i) {
+        lanes->runtimes.emplace_back(creator->onCreate(info));
+    }
+    mLanes = lanes;
+#else
+    MNN_ERROR("Running branches concurrently needs MNN_USE_THREAD_POOL\n");
+#endif
 }
 Executor::Executor(std::shared_ptr<Runtime> backend, MNNForwardType type) {
     mRuntime.first = backend;
@@ -159,7 +225,10 @@ std::shared_ptr<Executor> Executor::newExecutor(MNNForwardType type,
     Backend::Info info;
     info.type = type;
     info.numThread = numberThread;
-    std::shared_ptr<Runtime> bn(creator->onCreate(info));
+    // Some runtimes read the config when creating backends, so the copy lives as long as the runtime
+    std::shared_ptr<BackendConfig> copyConfig(new BackendConfig(config));
+    info.user = copyConfig.get();
+    std::shared_ptr<Runtime> bn(creator->onCreate(info), [copyConfig](Runtime* runtime) { delete runtime; });
     return std::shared_ptr<Executor>(new Executor(bn, type));
 }
 
@@ -210,16 +279,33 @@ public:
     void* mapOutput(int offset, Tensor* dest);
 
     ~ ComputeCache();
-    ComputeCache(std::shared_ptr<Backend> backend, std::shared_ptr<Backend> backupBackend);
+    ComputeCache(std::shared_ptr<Backend> backend, std::shared_ptr<Backend> backupBackend, std::shared_ptr<Lanes> lanes);
 
     ErrorCode compute();
     ErrorCode resize();
 private:
+    // The commands of [begin, end) have the same depth, they are run in the lanes concurrently or by mBackend
+    struct Stage {
+        int begin;
+        int end;
+        bool lanes;
+    };
+    // Sort the commands by depth and split them into stages
+    void _schedule();
+    ErrorCode _execute(int index);
+    ErrorCode _executeLanes(const Stage& stage);
+
     std::set<std::shared_ptr<ComputeCache>> mInputs;
     std::vector<Tensor*> mOutputs;
     std::vector<std::shared_ptr<Unit>> mUnits;
     std::shared_ptr<Backend> mBackend;
     std::shared_ptr<Backend> mBackupBackend;
+    std::shared_ptr<Lanes> mLanes;
+    std::vector<std::shared_ptr<Backend>> mLaneBackends;
+    std::vector<Stage> mStages;
+    // The lane of each command, -1 means mBackend
+    std::vector<int> mLaneIndex;
+    std::vector<ErrorCode> mLaneCodes;
     std::set<std::shared_ptr<Expr::Inside>> mInputInside;
     friend class Executor;
     bool mContentDirty = true;
@@ -271,9 +357,18 @@ void Executor::ComputeCache::setContentDirty() {
     mContentDirty = true;
 }
 
-Executor::ComputeCache::ComputeCache(std::shared_ptr<Backend> backend, std::shared_ptr<Backend> backupBackend) : mContext(backupBackend) {
+Executor::ComputeCache::ComputeCache(std::shared_ptr<Backend> backend, std::shared_ptr<Backend> backupBackend, std::shared_ptr<Lanes> lanes) : mContext(backupBackend) {
     mBackend = backend;
     mBackupBackend = backupBackend;
+    mContext.setForwardType(backend->type());
+    // The lanes compute in float and the same layout as CPUBackend
+    if (nullptr != lanes && backend->type() == MNN_FORWARD_CPU) {
+        mLanes = lanes;
+        for (auto& runtime : lanes->runtimes) {
+            mLaneBackends.emplace_back(runtime->onCreate());
+        }
+        mLaneCodes.resize(mLaneBackends.size());
+    }
 }
 Executor::ComputeCache::~ComputeCache() {
     mUnits.clear();
@@ -302,35 +397,204 @@ ErrorCode Executor::ComputeCache::compute() {
     }
     mBackend->onExecuteBegin();
     mBackupBackend->onExecuteBegin();
+#ifdef MNN_USE_THREAD_POOL
+    if (nullptr != mLanes) {
+        ThreadPool::active();
+    }
+#endif
     MNN_ASSERT(mExecutions.size() == mCmdBuffer.command.size());
-    for (int i=0; i<mCmdBuffer.command.size(); ++i) {
+    ErrorCode code = NO_ERROR;
+    for (int i = 0; i < mStages.size() && NO_ERROR == code; ++i) {
+        auto& stage = mStages[i];
+        if (stage.lanes) {
+            code = _executeLanes(stage);
+            continue;
+        }
+        for (int k = stage.begin; k < stage.end && NO_ERROR == code; ++k) {
+            code = _execute(k);
+        }
+    }
+#ifdef MNN_USE_THREAD_POOL
+    if (nullptr != mLanes) {
+        ThreadPool::deactive();
+    }
+#endif
+    if (NO_ERROR != code) {
+        mBackend->onExecuteEnd();
+        return code;
+    }
+    mBackend->onExecuteEnd();
+    mBackupBackend->onExecuteEnd();
+    mContentDirty = false;
+    return NO_ERROR;
+}
+ErrorCode Executor::ComputeCache::_execute(int index) {
 #ifdef MNN_EXPR_ENABLE_PROFILER
-        Timer autoTime;
+    Timer autoTime;
 #endif
-        auto& iter = mCmdBuffer.command[i];
-        auto code = mExecutions[i]->onExecute(iter.inputs, iter.outputs);
-        if (NO_ERROR != code) {
+    auto& iter = mCmdBuffer.command[index];
+    auto code = mExecutions[index]->onExecute(iter.inputs, iter.outputs);
+    if (NO_ERROR != code) {
 #ifdef MNN_EXPRESS_ERROR_REPORT
-            auto op = iter.buffer.empty() ? iter.op : flatbuffers::GetRoot<Op>(iter.buffer.data());
-            MNN_ERROR("Error to compute for %s, \n", EnumNameOpType(op->type()));
+        auto op = iter.buffer.empty() ? iter.op : flatbuffers::GetRoot<Op>(iter.buffer.data());
+        MNN_ERROR("Error to compute for %s, \n", EnumNameOpType(op->type()));
 #endif
-            mBackend->onExecuteEnd();
+        return code;
+    }
+#ifdef MNN_EXPR_ENABLE_PROFILER
+    float costTime = (float)autoTime.durationInUs() / (float)1000;
+    auto op = iter.op;
+    if (!iter.buffer.empty()) {
+        op = flatbuffers::GetMutableRoot<Op>(iter.buffer.data());
+    }
+    ExecutorScope::Current()->addOpCostTime((int)op->type(), costTime);
+#endif
+    return NO_ERROR;
+}
+ErrorCode Executor::ComputeCache::_executeLanes(const Stage& stage) {
+#if defined(MNN_USE_THREAD_POOL) && !defined(MNN_EXPR_ENABLE_PROFILER)
+    std::pair<std::function<void(int)>, int> task;
+    task.second = (int)mLaneBackends.size();
+    task.first  = [this, &stage](int lane) {
+        mLaneCodes[lane] = NO_ERROR;
+        for (int k = stage.begin; k < stage.end; ++k) {
+            if (mLaneIndex[k] != lane) {
+                continue;
+            }
+            mLaneCodes[lane] = _execute(k);
+            if (NO_ERROR != mLaneCodes[lane]) {
+                return;
+            }
+        }
+    };
+    ThreadPool::enqueue(std::move(task), mLanes->taskIndex(static_cast<CPUBackend*>(mBackend.get())->taskIndex()));
+    for (auto code : mLaneCodes) {
+        if (NO_ERROR != code) {
             return code;
         }
-#ifdef MNN_EXPR_ENABLE_PROFILER
-        float costTime = (float)autoTime.durationInUs() / (float)1000;
-        auto op = iter.op;
-        if (!iter.buffer.empty()) {
-            op = flatbuffers::GetMutableRoot<Op>(iter.buffer.data());
+    }
+#else
+    // The profiler is not thread safe
+    for (int k = stage.begin; k < stage.end; ++k) {
+        auto code = _execute(k);
+        if (NO_ERROR != code) {
+            return code;
         }
-        ExecutorScope::Current()->addOpCostTime((int)op->type(), costTime);
-#endif
     }
-    mBackend->onExecuteEnd();
-    mBackupBackend->onExecuteEnd();
-    mContentDirty = false;
+#endif
     return NO_ERROR;
 }
+void Executor::ComputeCache::_schedule() {
+    auto& commands = mCmdBuffer.command;
+    int size       = (int)commands.size();
+    mStages.clear();
+    mLaneIndex.assign(size, -1);
+    if (0 == size) {
+        return;
+    }
+    if (mLaneBackends.empty()) {
+        mStages.emplace_back(Stage{0, size, false});
+        return;
+    }
+    // The depth of a command is larger than the ones writing its inputs and the ones reading / writing its outputs.
+    // The depths of last write and last read of each tensor, -1 means none
+    std::map<const Tensor*, std::pair<int, int>> access;
+    auto find = [&access](const Tensor* t) -> std::pair<int, int>& {
+        auto iter = access.find(t);
+        if (iter == access.end()) {
+            iter = access.insert(std::make_pair(t, std::make_pair(-1, -1))).first;
+        }
+        return iter->second;
+    };
+    std::vector<int> depth(size);
+    // Estimate the cost by the number of elements read and written
+    std::vector<float> cost(size, 0.0f);
+    std::vector<const Tensor*> reads;
+    for (int k = 0; k < size; ++k) {
+        auto& cmd = commands[k];
+        reads.clear();
+        for (auto t : cmd.inputs) {
+            reads.emplace_back(t);
+            for (auto& region : TensorUtils::getDescribe(t)->regions) {
+                reads.emplace_back(region.origin);
+            }
+            cost[k] += (float)t->elementSize();
+        }
+        int d = 0;
+        for (auto t : reads) {
+            d = std::max(d, find(t).first + 1);
+        }
+        for (auto t : cmd.outputs) {
+            auto& record = find(t);
+            d = std::max(d, std::max(record.first, record.second) + 1);
+            cost[k] += (float)t->elementSize();
+        }
+        for (auto t : reads) {
+            auto& record  = find(t);
+            record.second = std::max(record.second, d);
+        }
+        for (auto t : cmd.outputs) {
+            find(t).first = d;
+        }
+        depth[k] = d;
+    }
+    std::vector<int> order(size);
+    for (int k = 0; k < size; ++k) {
+        order[k] = k;
+    }
+    std::stable_sort(order.begin(), order.end(), [&depth](int a, int b) { return depth[a] < depth[b]; });
+    std::vector<Command> sorted;
+    sorted.reserve(size);
+    for (auto k : order) {
+        sorted.emplace_back(std::move(commands[k]));
+    }
+    commands = std::move(sorted);
+
+    int laneNumber     = (int)mLaneBackends.size();
+    float threadNumber = (float)static_cast<CPUBackend*>(mBackend.get())->threadNumber();
+    // The threads of the backend split each op, a small op doesn't speed up by all of them but still pays the dispatch
+    auto backendTime = [threadNumber](float opCost) {
+        if (threadNumber <= 1.0f) {
+            return opCost;
+        }
+        auto speedup = std::min(threadNumber, std::max(1.0f, opCost / MNN_EXPR_ELEMENTS_PER_THREAD));
+        return opCost / speedup + MNN_EXPR_DISPATCH_COST;
+    };
+    std::vector<float> laneCost(laneNumber);
+    std::vector<int> indexes;
+    for (int begin = 0; begin < size;) {
+        float total    = cost[order[begin]];
+        float largest  = total;
+        float loneTime = backendTime(total);
+        int end        = begin + 1;
+        for (; end < size && depth[order[end]] == depth[order[begin]]; ++end) {
+            total += cost[order[end]];
+            largest = std::max(largest, cost[order[end]]);
+            loneTime += backendTime(cost[order[end]]);
+        }
+        Stage stage{begin, end, false};
+        // The lanes split the ops, they are run by one task of the thread pool
+        float laneTime = std::max(largest, total / (float)laneNumber) + MNN_EXPR_DISPATCH_COST;
+        if (end - begin > 1 && laneTime < loneTime) {
+            stage.lanes = true;
+            indexes.clear();
+            for (int k = begin; k < end; ++k) {
+                indexes.emplace_back(k);
+            }
+            std::stable_sort(indexes.begin(), indexes.end(),
+                             [&cost, &order](int a, int b) { return cost[order[a]] > cost[order[b]]; });
+            // Give the largest op to the least loaded lane
+            std::fill(laneCost.begin(), laneCost.end(), 0.0f);
+            for (auto k : indexes) {
+                auto lane = (int)(std::min_element(laneCost.begin(), laneCost.end()) - laneCost.begin());
+                mLaneIndex[k] = lane;
+                laneCost[lane] += cost[order[k]];
+            }
+        }
+        mStages.emplace_back(stage);
+        begin = end;
+    }
+}
 ErrorCode Executor::ComputeCache::resize() {
     if (!mShapeDirty) {
         return NO_ERROR;
@@ -357,6 +621,9 @@ ErrorCode Executor::ComputeCache::resize() {
         mCmdBuffer.extras.clear();
         mBackend->onClearBuffer();
         mBackupBackend->onClearBuffer();
+        for (auto& lane : mLaneBackends) {
+            lane->onClearBuffer();
+        }
         mExecutions.clear();
         mContext.clear();
 #ifdef MNN_EXPR_ENABLE_PROFILER
@@ -423,6 +690,7 @@ ErrorCode Executor::ComputeCache::resize() {
         Timer autoTime;
 #endif
         GeometryComputerUtils::makeRaster(buffer, mCmdBuffer, mContext);
+        _schedule();
 #ifdef MNN_EXPR_ENABLE_PROFILER
         float costTime = (float)autoTime.durationInUs() / (float)1000;
         ExecutorScope::Current()->addOpCostTime((int)OpType_If, costTime);
@@ -456,9 +724,16 @@ ErrorCode Executor::ComputeCache::resize() {
 
     /** Prepare Begin */
     mBackend->onResizeBegin();
+    for (auto& lane : mLaneBackends) {
+        lane->onResizeBegin();
+    }
     mExecutions.resize(mCmdBuffer.command.size());
+    // The memory released in a stage may be reused by the other lanes of it, release them after the stage
+    std::vector<const Tensor*> releases;
+    int stageIndex = 0;
     for (int k=0; k<mCmdBuffer.command.size(); ++k) {
         auto& cmd = mCmdBuffer.command[k];
+        auto target = mLaneIndex[k] >= 0 ? mLaneBackends[mLaneIndex[k]].get() : mBackend.get();
         auto op = cmd.op;
         bool origin = true;
         if (!cmd.buffer.empty()) {
@@ -472,14 +747,14 @@ ErrorCode Executor::ComputeCache::resize() {
         bool cacheed = false;
         if (!mCacheExes.empty() && origin) {
             auto iter = mCacheExes.find(op);
-            if (iter != mCacheExes.end()) {
+            if (iter != mCacheExes.end() && (nullptr == mLanes || iter->second->backend() == target)) {
                 mExecutions[k] = iter->second;
                 cacheed = true;
             }
         }
         if (nullptr == mExecutions[k]) {
-            mExecutions[k].reset(mBackend->onCreate(cmd.inputs, cmd.outputs, op));
-            if (nullptr == mExecutions[k]) {
+            mExecutions[k].reset(target->onCreate(cmd.inputs, cmd.outputs, op));
+            if (nullptr == mExecutions[k] && target == mBackend.get()) {
                 mExecutions[k].reset(mBackupBackend->onCreate(cmd.inputs, cmd.outputs, op));
             }
             if (nullptr == mExecutions[k]) {
@@ -528,7 +803,7 @@ ErrorCode Executor::ComputeCache::resize() {
         }
         if ((op->type() == OpType_Convolution && cmd.inputs.size() == 1)) {
             // TODO: Support Other op's cache
-            mCacheExes.insert(std::make_pair(op, mExecutions[k]));
+            mCacheExes[op] = mExecutions[k];
         }
         for (auto t : cmd.outputs) {
             auto des = TensorUtils::getDescribe(t);
@@ -555,7 +830,7 @@ ErrorCode Executor::ComputeCache::resize() {
                 if (des->usage == Tensor::InsideDescribe::Usage::NORMAL) {
                     des->useCount-=1;
                     if (0 == des->useCount && nullptr != des->backend) {
-                        des->backend->onReleaseBuffer(t, Backend::DYNAMIC);
+                        releases.emplace_back(t);
                     }
                 }
             }
@@ -565,17 +840,29 @@ ErrorCode Executor::ComputeCache::resize() {
                 if (subDes->memoryType == Tensor::InsideDescribe::MemoryType::MEMORY_BACKEND && subDes->usage == Tensor::InsideDescribe::Usage::NORMAL) {
                     subDes->useCount--;
                     if (0 == subDes->useCount && nullptr != subDes->backend) {
-                        subDes->backend->onReleaseBuffer(s.origin, Backend::DYNAMIC);
+                        releases.emplace_back(s.origin);
                     }
                 }
             }
         }
+        if (nullptr == mLanes || k + 1 == mStages[stageIndex].end) {
+            for (auto t : releases) {
+                TensorUtils::getDescribe(t)->backend->onReleaseBuffer(t, Backend::DYNAMIC);
+            }
+            releases.clear();
+        }
+        if (k + 1 == mStages[stageIndex].end) {
+            stageIndex++;
+        }
 #ifdef MNN_EXPR_ENABLE_PROFILER
         float costTime = (float)autoTime.durationInUs() / (float)1000;
         ExecutorScope::Current()->addOpCostTime((int)op->type(), costTime);
 #endif
     }
     mBackend->onResizeEnd();
+    for (auto& lane : mLaneBackends) {
+        lane->onResizeEnd();
+    }
 
     /** Prepare End */
 
@@ -636,7 +923,11 @@ void Executor::_create(const std::vector<EXPRP>& outputs, std::set<std::shared_p
         cacheBn.reset(mRuntime.first->onCreate());
         cacheBackupBn.reset(mBackupRuntime.first->onCreate());
     }
-    std::shared_ptr<ComputeCache> packedCache(new ComputeCache(cacheBn, cacheBackupBn));
+    std::shared_ptr<Lanes> lanes;
+    if (!forceCPU) {
+        lanes = mLanes;
+    }
+    std::shared_ptr<ComputeCache> packedCache(new ComputeCache(cacheBn, cacheBackupBn, lanes));
     packedCache->mInputs = std::move(inputCaches);
     packedCache->mInputInside = std::move(inputNode);
     for (auto expr : packed) {
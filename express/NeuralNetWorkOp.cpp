@@ -1474,6 +1474,14 @@ VARP _ZeroGrad(VARP x) {
     op->type = OpType_ZeroGrad;
     return Variable::create(Expr::create(std::move(op), {x}));
 }
+VARP _FakeQuant(VARP x, VARP scale, int bits) {
+    std::unique_ptr<OpT> op(new OpT);
+    op->type       = OpType_FakeQuant;
+    op->main.type  = OpParameter_QuantizedFloatParam;
+    op->main.value = new QuantizedFloatParamT;
+    op->main.AsQuantizedFloatParam()->nbits = bits;
+    return Variable::create(Expr::create(std::move(op), {x, scale}));
+}
 
 VARP _Conv(std::vector<int8_t>&& weight, std::vector<int>&& bias, std::vector<float>&& scale, VARP x, INTS channel, INTS kernelSize,
                               PaddingMode pad, INTS stride, INTS dilate, int group, INTS pads, bool relu, int nbits) {
@@ -144,23 +144,56 @@ Module* Module::load(const std::vector<std::string>& inputs, const std::vector<s
 
 EXPRP Module::CloneContext::getOrClone(EXPRP expr) {
     auto it = mExprMap.find(expr.get());
-    if (it == mExprMap.end()) {
-        // EXPRP replica = expr->clone(shareParams);
-        // TODO(hjchen2): Clone expr.
-        EXPRP replica = expr;
-        it = mExprMap.emplace(expr.get(), replica).first;
+    if (it != mExprMap.end()) {
+        return it->second;
     }
-    return it->second;
+    EXPRP replica;
+    if (nullptr == expr->get()) {
+        // Inputs are always cloned so that replicas can be fed independently, constants and
+        // trainable parameters are copied unless shareParams is set
+        if (mShareParams && VARP::INPUT != expr->inputType()) {
+            replica = expr;
+        } else {
+            Variable::Info info = *expr->outputInfo(0);
+            const void* ptr     = nullptr;
+            if (VARP::INPUT != expr->inputType()) {
+                ptr = Variable::create(expr, 0)->readMap<void>();
+            }
+            replica = Expr::create(std::move(info), ptr, expr->inputType());
+        }
+    } else {
+        // Rebuild the op only if some input is replaced, the op buffer itself is immutable and shared
+        bool changed = false;
+        std::vector<VARP> inputs;
+        for (auto& input : expr->inputs()) {
+            inputs.emplace_back(getOrClone(input));
+            changed = changed || inputs.back().get() != input.get();
+        }
+        replica = changed ? Expr::create(expr->extra(), std::move(inputs), expr->outputSize()) : expr;
+    }
+    if (replica != expr) {
+        replica->setName(expr->name());
+        for (int i = 0; i < expr->outputSize(); ++i) {
+            Variable::create(replica, i)->setName(expr->outputName(i));
+        }
+    }
+    mExprMap.emplace(expr.get(), replica);
+    return replica;
 }
 
 VARP Module::CloneContext::getOrClone(VARP var) {
+    if (nullptr == var) {
+        return nullptr;
+    }
     auto it = mVarMap.find(var.get());
     if (it != mVarMap.end()) {
-        // TODO(hjchen2): Clone variable.
-        VARP replica = var;
-        it = mVarMap.emplace(var.get(), replica).first;
+        return it->second;
     }
-    return it->second;
+    auto expr    = var->expr();
+    auto replica = getOrClone(expr.first);
+    VARP result  = replica == expr.first ? var : Variable::create(replica, expr.second);
+    mVarMap.emplace(var.get(), result);
+    return result;
 }
 
 Module* Module::clone(const Module* module, const bool shareParams) {
@@ -15,6 +15,7 @@
 #include "MNN_generated.h"
 #include "RandomGenerator.hpp"
 #include "core/Macro.h"
+#include <math.h>
 #include <string>
 
 using namespace MNN::Express;
@@ -679,35 +680,52 @@ public:
         mFeatureScaleStatMethod = featureScaleStatMethod;
         mScaleUpdateMethod = scaleUpdateMethod;
 
-        auto limit = (float)(1 << (bits - 1)) - 1.0f;
-        mLimitScale = _Scalar<float>(1.0f / limit);
-        mClampValue = _Scalar<float>(limit);
-        
+        mBits = bits;
+        mLimit = (float)(1 << (bits - 1)) - 1.0f;
+        mLimitScale = _Scalar<float>(1.0f / mLimit);
+        mClampValue = _Scalar<float>(mLimit);
+
+        if (mScaleUpdateMethod == NN::Learnable) {
+            // The values are initialized by the first batch of training, see initLearnedScale
+            mInputScale = _TrainableParam(1.0f, {}, NCHW);
+            mOutputScale = _TrainableParam(1.0f, {}, NCHW);
+            mWeightScale = _TrainableParam(1.0f, {mWeight->getInfo()->dim[0], 1, 1, 1}, NCHW);
+        }
         mInputScalePos = addParameter(mInputScale);
         mOutputScalePos = addParameter(mOutputScale);
+        if (nullptr != mWeightScale) {
+            addParameter(mWeightScale);
+        }
 
         setType("ConvBNReluFused");
     }
 
-    std::pair<VARP, VARP> fakeQuantFeature(VARP x, VARP useScale = nullptr) {
-        auto originFormat = x->getInfo()->order;
-        auto tempX        = x;
-        if (originFormat == NC4HW4) {
-            tempX = _Convert(tempX, NCHW);
-        }
-        auto originX = tempX;
-        VARP scale = _Maximum(_ReduceMax(_Abs(tempX)), _Scalar<float>(0.0001f)) * mLimitScale;
-        if (useScale == nullptr) {
-            tempX = _Round(tempX * _Reciprocal(scale)) * scale;
-        } else {
-            tempX = _Round(tempX * _Reciprocal(useScale)) * useScale;
+    std::pair<VARP, VARP> fakeQuantFeature(VARP x) {
+        VARP scale = _Maximum(_ReduceMax(_Abs(_Convert(x, NCHW))), _Scalar<float>(0.0001f)) * mLimitScale;
+        // Break the grad by use cast, the scale is only got from statistics
+        scale = _Cast<float>(scale);
+        return std::make_pair(_FakeQuant(x, scale, mBits), scale);
+    }
+
+    VARP weightScaleByMax(VARP weight) {
+        return _Maximum(_ReduceMax(_Abs(weight), {1, 2, 3}, true), _Scalar<float>(1E-6)) * mLimitScale;
+    }
+
+    static bool copyScale(VARP dst, VARP src) {
+        auto srcPtr = src->readMap<float>();
+        auto dstPtr = dst->writeMap<float>();
+        if (nullptr == srcPtr || nullptr == dstPtr || src->getInfo()->size != dst->getInfo()->size) {
+            MNN_ERROR("Can't initialize the learned scale of quantization\n");
+            return false;
         }
-        // Break the grad by use cast
-        tempX = _Cast<float>(tempX);
-        
-        // Move grad from tempX to originX
-        tempX = _Convert(tempX + _ZeroGrad(originX), originFormat);
-        return std::make_pair(tempX, scale);
+        ::memcpy(dstPtr, srcPtr, src->getInfo()->size * sizeof(float));
+        return true;
+    }
+
+    // LSQ initializes the scale by 2 * mean(|x|) / sqrt(limit)
+    bool initLearnedScale(VARP scale, VARP x, INTS axis) {
+        auto value = _ReduceMean(_Abs(_Convert(x, NCHW)), axis, !axis.empty()) * _Scalar<float>(2.0f / sqrtf(mLimit));
+        return copyScale(scale, _Maximum(value, _Scalar<float>(1E-6)));
     }
 
     VARP clamp(VARP x) {
@@ -732,23 +750,35 @@ public:
 
     virtual std::vector<Express::VARP> onForward(const std::vector<Express::VARP>& inputs) override {
         VARP res;
+        bool learnable = mScaleUpdateMethod == NN::Learnable;
         if (getIsTraining()) {
-            auto x = _Convert(inputs[0], NCHW);
+            auto x = inputs[0];
+            if (learnable && !mScaleInited) {
+                initLearnedScale(mInputScale, x, {});
+                initLearnedScale(mWeightScale, mWeight, {1, 2, 3});
+            }
             // simulate weight quant
-            auto weightScale = _Maximum(_ReduceMax(_Abs(mWeight), {1, 2, 3}, true), _Scalar<float>(1E-6)) * mLimitScale;
-            auto weightTemp = _Round(mWeight * _Reciprocal(weightScale)) * weightScale;
-            weightTemp = weightTemp + _ZeroGrad(mWeight);
+            VARP weightScale = mWeightScale;
+            if (!learnable) {
+                // Break the grad by use cast, the scale is only got from statistics
+                weightScale = _Cast<float>(weightScaleByMax(mWeight));
+            }
+            auto weightTemp = _FakeQuant(mWeight, weightScale, mBits);
 
             // simulate input quant to get original input scale
-            auto inputPair  = fakeQuantFeature(x);
-            mInputScale = updateScale(mInputScale, inputPair.second);
-            setParameter(mInputScale, mInputScalePos);
+            if (learnable) {
+                x = _FakeQuant(x, mInputScale, mBits);
+            } else {
+                auto inputPair = fakeQuantFeature(x);
+                mInputScale    = updateScale(mInputScale, inputPair.second);
+                setParameter(mInputScale, mInputScalePos);
+                x = inputPair.first;
+            }
 
             // simulate output quant to get original output scale
-            res = _Conv(weightTemp, mBias, _Convert(inputPair.first, NC4HW4), mOption.padMode, mOption.stride,
+            res = _Conv(weightTemp, mBias, _Convert(x, NC4HW4), mOption.padMode, mOption.stride,
                         mOption.dilate, mGroup, mOption.pads);
             res->setName(name());
-            auto conv = res;
 
             if (mBatchNorm) {
                 res = mBatchNorm->forward(res);
@@ -756,22 +786,35 @@ public:
 
             res = _activate(res, mActivation);
 
-            auto outputPair = fakeQuantFeature(res);
-            mOutputScale = updateScale(mOutputScale, outputPair.second);
-            setParameter(mOutputScale, mOutputScalePos);
-            res = outputPair.first;
+            if (learnable) {
+                if (!mScaleInited) {
+                    initLearnedScale(mOutputScale, res, {});
+                    mScaleInited = true;
+                }
+                res = _FakeQuant(res, mOutputScale, mBits);
+            } else {
+                auto outputPair = fakeQuantFeature(res);
+                mOutputScale    = updateScale(mOutputScale, outputPair.second);
+                setParameter(mOutputScale, mOutputScalePos);
+                res = outputPair.first;
+            }
         } else {
-            if (nullptr == mInputScale) {
+            if (nullptr == mInputScale || (learnable && !mScaleInited)) {
                 // Initial for test
                 // simulate weight quant
-                auto weightScale = _Maximum(_ReduceMax(_Abs(mWeight), {1, 2, 3}, true), _Scalar<float>(1E-6)) * mLimitScale;
+                auto weightScale = weightScaleByMax(mWeight);
                 weightScale.fix(VARP::CONSTANT);
-                auto weightTemp = _Round(mWeight * _Reciprocal(weightScale)) * weightScale;
+                auto weightTemp = _FakeQuant(mWeight, weightScale, mBits);
 
-                auto x = _Convert(inputs[0], NCHW);
+                auto x = inputs[0];
                 auto inputPair  = fakeQuantFeature(x);
-                mInputScale     = inputPair.second;
-                setParameter(mInputScale, mInputScalePos);
+                if (learnable) {
+                    copyScale(mInputScale, inputPair.second);
+                    copyScale(mWeightScale, weightScale);
+                } else {
+                    mInputScale = inputPair.second;
+                    setParameter(mInputScale, mInputScalePos);
+                }
                 inputPair.first.fix(VARP::CONSTANT);
 
                 auto simuRes = _Conv(weightTemp, mBias, _Convert(inputPair.first, NC4HW4), mOption.padMode, mOption.stride,
@@ -783,14 +826,21 @@ public:
 
                 Variable::prepareCompute({simuRes});
                 auto outputPair = fakeQuantFeature(simuRes);
-                mOutputScale    = outputPair.second;
-                setParameter(mOutputScale, mOutputScalePos);
+                if (learnable) {
+                    copyScale(mOutputScale, outputPair.second);
+                    mScaleInited = true;
+                } else {
+                    mOutputScale = outputPair.second;
+                    setParameter(mOutputScale, mOutputScalePos);
+                }
                 outputPair.first.fix(VARP::CONSTANT);
             }
 
             // fold bn to conv weights and bias
             VARP fusedWeights = mWeight;
             VARP fusedBias = mBias;
+            // The learned grid of weight is scaled with the weight
+            VARP learnedWeightScale = mWeightScale;
             fusedBias = _Reshape(fusedBias, {fusedBias->getInfo()->size, 1, 1, 1});
             if (mBatchNorm) {
                 auto bn = std::static_pointer_cast<BatchNormModule>(mBatchNorm);
@@ -812,6 +862,9 @@ public:
 
                 fusedWeights = alpha * fusedWeights;
                 fusedBias = alpha * fusedBias + beta;
+                if (nullptr != learnedWeightScale) {
+                    learnedWeightScale = _Abs(alpha) * learnedWeightScale;
+                }
                 fusedWeights.fix(VARP::CONSTANT);
                 fusedBias.fix(VARP::CONSTANT);
             }
@@ -828,18 +881,19 @@ public:
             std::vector<int32_t> bias;
             std::vector<float> scale;
             {
-                VARP weightScale, quanWeight, convScale;
+                VARP newWeight, weightScale, quanWeight, convScale;
                 if (mOption.depthwise) {
-                    auto newWeight = fusedWeights * _Reshape(mInputScale, {-1, 1, 1, 1});
-                    weightScale = _Maximum(_ReduceMax(_Abs(newWeight), {1, 2, 3}, true), _Scalar<float>(1E-6)) * mLimitScale;
-                    quanWeight  = _Cast<int8_t>(_Round(newWeight * _Reciprocal(weightScale)));
-                    convScale   = _Reshape(_Reciprocal(mOutputScale), {-1, 1, 1, 1}) * weightScale;
+                    newWeight = fusedWeights * _Reshape(mInputScale, {-1, 1, 1, 1});
+                } else {
+                    newWeight = fusedWeights * mInputScale;
+                }
+                if (nullptr != learnedWeightScale) {
+                    weightScale = learnedWeightScale * mInputScale;
                 } else {
-                    auto newWeight = fusedWeights * mInputScale;
-                    weightScale = _Maximum(_ReduceMax(_Abs(newWeight), {1, 2, 3}, true), _Scalar<float>(1E-6)) * mLimitScale;
-                    quanWeight  = _Cast<int8_t>(_Round(newWeight * _Reciprocal(weightScale)));
-                    convScale   = _Reshape(_Reciprocal(mOutputScale), {-1, 1, 1, 1}) * weightScale;
+                    weightScale = weightScaleByMax(newWeight);
                 }
+                quanWeight  = _Cast<int8_t>(clamp(_Round(newWeight * _Reciprocal(weightScale))));
+                convScale   = _Reshape(_Reciprocal(mOutputScale), {-1, 1, 1, 1}) * weightScale;
                 auto quanBias    = _Cast<int32_t>(fusedBias * _Reciprocal(weightScale));
                 Variable::prepareCompute({quanBias, quanWeight, convScale});
                 {
@@ -894,6 +948,10 @@ private:
         module->mInputScale = ctx->getOrClone(mInputScale);
         module->mOutputScale = ctx->getOrClone(mOutputScale);
         module->mClampValue = ctx->getOrClone(mClampValue);
+        module->mWeightScale = ctx->getOrClone(mWeightScale);
+        module->mScaleInited = mScaleInited;
+        module->mBits = mBits;
+        module->mLimit = mLimit;
         module->mMomentum = mMomentum;
         module->mFeatureScaleStatMethod = mFeatureScaleStatMethod;
         module->mScaleUpdateMethod = mScaleUpdateMethod;
@@ -917,6 +975,11 @@ private:
     VARP mInputScale = nullptr;
     VARP mOutputScale = nullptr;
     VARP mClampValue;
+    // Only for NN::Learnable, per channel of output
+    VARP mWeightScale = nullptr;
+    bool mScaleInited = false;
+    int mBits = 8;
+    float mLimit = 127.0f;
     float mMomentum = 0.99f;
     NN::FeatureScaleStatMethod mFeatureScaleStatMethod;
     NN::ScaleUpdateMethod mScaleUpdateMethod;
@@ -26,7 +26,12 @@ enum ImageFormat {
     YUV_I420 = 13,
 };
 
-enum Filter { NEAREST = 0, BILINEAR = 1, BICUBIC = 2 };
+/**
+ * BICUBIC: 4x4 cubic convolution (a = -0.75).
+ * AREA: average the source pixels covered by the dest pixel, for downscale without alias. It only works on
+ *       axis-aligned scale with CLAMP_TO_EDGE, otherwise it is the same as BILINEAR.
+ */
+enum Filter { NEAREST = 0, BILINEAR = 1, BICUBIC = 2, AREA = 3 };
 
 enum Wrap { CLAMP_TO_EDGE = 0, ZERO = 1, REPEAT = 2 };
 
@@ -119,6 +124,44 @@ public:
     ErrorCode convert(const uint8_t* source, int iw, int ih, int stride, void* dest, int ow, int oh, int outputBpp = 0,
                       int outputStride = 0, halide_type_t type = halide_type_of<float>());
 
+    /**
+     * @brief crop and resize source data with each matrix into one batch of given tensor, in one parallel pass.
+     * @param source    source data.
+     * @param iw        source width.
+     * @param ih        source height.
+     * @param stride    number of elements per row. eg: 100 width RGB contains at least 300 elements.
+     * @param matrixs   affine transform matrixs, the same as setMatrix, the i-th one is used for batch i.
+     * @param dest      given tensor, its batch must not be less than matrixs' size.
+     * @return result code.
+     */
+    ErrorCode convert(const uint8_t* source, int iw, int ih, int stride, const std::vector<Matrix>& matrixs,
+                      Tensor* dest);
+
+    /**
+     * @brief crop and resize boxes of source data into the batches of given tensor, in one parallel pass.
+     * @param source    source data.
+     * @param iw        source width.
+     * @param ih        source height.
+     * @param stride    number of elements per row. eg: 100 width RGB contains at least 300 elements.
+     * @param boxes     boxNumber x [y1, x1, y2, x2], normalized to [0, 1] as CropAndResize.
+     * @param boxNumber number of boxes.
+     * @param dest      given tensor, its batch must not be less than boxNumber.
+     * @return result code.
+     */
+    ErrorCode convert(const uint8_t* source, int iw, int ih, int stride, const float* boxes, int boxNumber,
+                      Tensor* dest);
+
+    /**
+     * @brief compute the matrix which samples box of source image as CropAndResize.
+     * @param box   normalized [y1, x1, y2, x2].
+     * @param iw    source width.
+     * @param ih    source height.
+     * @param ow    output width.
+     * @param oh    output height.
+     * @return matrix map output points to source points.
+     */
+    static Matrix computeBoxMatrix(const float* box, int iw, int ih, int ow, int oh);
+
     /**
      * @brief create tensor with given data.
      * @param w     image width.
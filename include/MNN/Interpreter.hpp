@@ -122,6 +122,13 @@ public:
         Session_Input_Inside = 2,
         /** The input tensor is alloced by user, set input data before session resize*/
         Session_Input_User = 3,
+
+        /** About recurrent op (LSTM), Default Session_Recurrent_Reset*/
+        /** The hidden / cell state start from the initial inputs (or zero) for every runSession*/
+        Session_Recurrent_Reset = 4,
+        /** The hidden / cell state are kept between runSession, so that a stream can be feed frame by frame.
+         resizeSession resets them*/
+        Session_Recurrent_Keep = 5,
     };
     /**
      * @brief The API shoud be called before create session.
@@ -213,6 +220,16 @@ public:
      */
     ErrorCode updateSessionToModel(Session* session);
 
+    /**
+     * @brief save the resolved commands of session (shape, geometry transform, raster regions) as a static model.
+     * The static model can be loaded by createFromFile and create session without shape compute and geometry
+     * transform, only valid when the inputs' shape are fixed.
+     * @param session   given session, must be resized.
+     * @param file      file to save the static model.
+     * @return result of saving.
+     */
+    ErrorCode saveStaticModel(const Session* session, const char* file) const;
+
     /**
      * @brief run session.
      * @param session   given session.
@@ -49,6 +49,14 @@ typedef enum {
     MNN_FORWARD_CPU_EXTENSION
 
 } MNNForwardType;
+
+/* Flags for CPU Backend, combine them and set to BackendConfig::flags */
+/* Check nan / inf of every op's output */
+#define MNN_CPU_CHECK_NAN 1
+/* Measure every candidate algorithm for convolution and choose the fastest, the result is saved to cache file */
+#define MNN_CPU_TUNE_CONVOLUTION 2
+/* Share transformed convolution weights with identical content across sessions and Interpreters */
+#define MNN_CPU_SHARE_WEIGHT 4
 #ifdef __cplusplus
 namespace MNN {
 struct BackendConfig {
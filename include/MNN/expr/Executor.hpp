@@ -43,6 +43,14 @@ public:
         PART
     };
     void gc(GCFlag flag = FULL);
+    /** Run the independent ops of a graph concurrently, such as the sibling branches of the forward and the input /
+     weight gradients of the backward. The ops of the same depth are split into number lanes, each lane runs its ops
+     with one thread. It's used only if estimated faster than running the ops by the threads of the backend. Works for
+     CPU with MNN_USE_THREAD_POOL, number <= 1 disables it. Only the graphs computed later are affected.
+     The lanes share the thread pool task of the executor's multi-thread CPU runtime, they take a task of their own
+     only if the runtime is single thread. The pool has 2 tasks, so that leaves one runtime less that can use it.
+     */
+    void setBranchLanes(int number);
     static std::shared_ptr<Executor> getGlobalExecutor();
 
     static std::shared_ptr<Executor> newExecutor(MNNForwardType type,
@@ -54,6 +62,7 @@ public:
     void addOpCostTime(const std::string& type, float costTime);
     void addOpFlops(const std::string& type, float flops);
     class Profiler;
+    struct Lanes;
     static RuntimeInfo getRuntime();
 private:
     void _makeCache(const std::vector<EXPRP>& outputs, bool forceCPU);
@@ -66,6 +75,7 @@ private:
     std::pair<std::shared_ptr<Runtime>, MNNForwardType> mBackupRuntime;
     std::mutex mMutex;
     std::shared_ptr<Profiler> mProfiler;
+    std::shared_ptr<Lanes> mLanes;
 };
 } // namespace Express
 } // namespace MNN
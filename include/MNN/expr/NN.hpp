@@ -24,7 +24,9 @@ public:
     };
     enum ScaleUpdateMethod {
         Maximum = 0,
-        MovingAverage = 1
+        MovingAverage = 1,
+        // The scales are trainable parameters learned by LSQ (Learned Step Size Quantization)
+        Learnable = 2
     };
     enum FeatureScaleStatMethod {
         PerTensor = 0,
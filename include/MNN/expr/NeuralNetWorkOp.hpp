@@ -126,6 +126,12 @@ MNN_PUBLIC  std::vector<VARP> _DetectionPostProcess(VARP encode_boxes, VARP clas
 MNN_PUBLIC VARP _Interp(VARPS xs, float widthScale, float heightScale, int outputWidth, int outputHeight, int resizeType, bool alignCorners);
 
 MNN_PUBLIC VARP _ZeroGrad(VARP x);
+/* Fake quantization for training: clamp(round(x / scale), -limit, limit) * scale, limit = 2^(bits - 1) - 1.
+ The scale is a scalar, or has the dimensions of x with all of them 1 except one axis for per channel scale,
+ x in NC4HW4 only supports axis 1. The grad of x is straight-through inside the range, and the scale gets the
+ grad of LSQ (Learned Step Size Quantization), so it can be a trainable parameter.
+ */
+MNN_PUBLIC VARP _FakeQuant(VARP x, VARP scale, int bits = 8);
 
 // Int8 Inference
 MNN_PUBLIC VARP _Conv(std::vector<int8_t>&& weight, std::vector<int>&& bias, std::vector<float>&& scale, VARP x, INTS channel, INTS kernelSize,
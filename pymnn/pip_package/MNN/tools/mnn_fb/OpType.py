@@ -142,6 +142,8 @@ class OpType(object):
     TrainableParam = 266
     BatchNorm = 267
     ZeroGrad = 268
+    FakeQuant = 269
+    FakeQuantGrad = 270
     Extra = 512
     ConvInt8 = 513
     Int8ToFloat = 514
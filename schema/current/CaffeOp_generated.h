@@ -1088,9 +1088,13 @@ struct QuantizedFloatParamT : public flatbuffers::NativeTable {
   std::vector<float> tensorScale;
   QuantizeAlgo method;
   int32_t nbits;
+  int32_t inputZeroPoint;
+  int32_t outputZeroPoint;
   QuantizedFloatParamT()
       : method(QuantizeAlgo_DEFAULT),
-        nbits(8) {
+        nbits(8),
+        inputZeroPoint(0),
+        outputZeroPoint(0) {
   }
 };
 
@@ -1105,7 +1109,9 @@ struct QuantizedFloatParam FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
     VT_SCALE = 8,
     VT_TENSORSCALE = 10,
     VT_METHOD = 12,
-    VT_NBITS = 14
+    VT_NBITS = 14,
+    VT_INPUTZEROPOINT = 16,
+    VT_OUTPUTZEROPOINT = 18
   };
   const flatbuffers::Vector<int8_t> *weight() const {
     return GetPointer<const flatbuffers::Vector<int8_t> *>(VT_WEIGHT);
@@ -1125,6 +1131,12 @@ struct QuantizedFloatParam FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
   int32_t nbits() const {
     return GetField<int32_t>(VT_NBITS, 8);
   }
+  int32_t inputZeroPoint() const {
+    return GetField<int32_t>(VT_INPUTZEROPOINT, 0);
+  }
+  int32_t outputZeroPoint() const {
+    return GetField<int32_t>(VT_OUTPUTZEROPOINT, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_WEIGHT) &&
@@ -1137,6 +1149,8 @@ struct QuantizedFloatParam FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
            verifier.VerifyVector(tensorScale()) &&
            VerifyField<int8_t>(verifier, VT_METHOD) &&
            VerifyField<int32_t>(verifier, VT_NBITS) &&
+           VerifyField<int32_t>(verifier, VT_INPUTZEROPOINT) &&
+           VerifyField<int32_t>(verifier, VT_OUTPUTZEROPOINT) &&
            verifier.EndTable();
   }
   QuantizedFloatParamT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -1165,6 +1179,12 @@ struct QuantizedFloatParamBuilder {
   void add_nbits(int32_t nbits) {
     fbb_.AddElement<int32_t>(QuantizedFloatParam::VT_NBITS, nbits, 8);
   }
+  void add_inputZeroPoint(int32_t inputZeroPoint) {
+    fbb_.AddElement<int32_t>(QuantizedFloatParam::VT_INPUTZEROPOINT, inputZeroPoint, 0);
+  }
+  void add_outputZeroPoint(int32_t outputZeroPoint) {
+    fbb_.AddElement<int32_t>(QuantizedFloatParam::VT_OUTPUTZEROPOINT, outputZeroPoint, 0);
+  }
   explicit QuantizedFloatParamBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1184,8 +1204,12 @@ inline flatbuffers::Offset<QuantizedFloatParam> CreateQuantizedFloatParam(
     flatbuffers::Offset<flatbuffers::Vector<float>> scale = 0,
     flatbuffers::Offset<flatbuffers::Vector<float>> tensorScale = 0,
     QuantizeAlgo method = QuantizeAlgo_DEFAULT,
-    int32_t nbits = 8) {
+    int32_t nbits = 8,
+    int32_t inputZeroPoint = 0,
+    int32_t outputZeroPoint = 0) {
   QuantizedFloatParamBuilder builder_(_fbb);
+  builder_.add_outputZeroPoint(outputZeroPoint);
+  builder_.add_inputZeroPoint(inputZeroPoint);
   builder_.add_nbits(nbits);
   builder_.add_tensorScale(tensorScale);
   builder_.add_scale(scale);
@@ -1202,7 +1226,9 @@ inline flatbuffers::Offset<QuantizedFloatParam> CreateQuantizedFloatParamDirect(
     const std::vector<float> *scale = nullptr,
     const std::vector<float> *tensorScale = nullptr,
     QuantizeAlgo method = QuantizeAlgo_DEFAULT,
-    int32_t nbits = 8) {
+    int32_t nbits = 8,
+    int32_t inputZeroPoint = 0,
+    int32_t outputZeroPoint = 0) {
   auto weight__ = weight ? _fbb.CreateVector<int8_t>(*weight) : 0;
   auto bias__ = bias ? _fbb.CreateVector<int32_t>(*bias) : 0;
   auto scale__ = scale ? _fbb.CreateVector<float>(*scale) : 0;
@@ -1214,7 +1240,9 @@ inline flatbuffers::Offset<QuantizedFloatParam> CreateQuantizedFloatParamDirect(
       scale__,
       tensorScale__,
       method,
-      nbits);
+      nbits,
+      inputZeroPoint,
+      outputZeroPoint);
 }
 
 flatbuffers::Offset<QuantizedFloatParam> CreateQuantizedFloatParam(flatbuffers::FlatBufferBuilder &_fbb, const QuantizedFloatParamT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
@@ -1226,6 +1254,7 @@ struct Convolution2DT : public flatbuffers::NativeTable {
   std::vector<float> bias;
   std::unique_ptr<IDSTQuanT> quanParameter;
   std::unique_ptr<QuantizedFloatParamT> symmetricQuan;
+  std::vector<float> inputPadValue;
   Convolution2DT() {
   }
 };
@@ -1240,7 +1269,8 @@ struct Convolution2D FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_WEIGHT = 6,
     VT_BIAS = 8,
     VT_QUANPARAMETER = 10,
-    VT_SYMMETRICQUAN = 12
+    VT_SYMMETRICQUAN = 12,
+    VT_INPUTPADVALUE = 14
   };
   const Convolution2DCommon *common() const {
     return GetPointer<const Convolution2DCommon *>(VT_COMMON);
@@ -1257,6 +1287,9 @@ struct Convolution2D FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const QuantizedFloatParam *symmetricQuan() const {
     return GetPointer<const QuantizedFloatParam *>(VT_SYMMETRICQUAN);
   }
+  const flatbuffers::Vector<float> *inputPadValue() const {
+    return GetPointer<const flatbuffers::Vector<float> *>(VT_INPUTPADVALUE);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_COMMON) &&
@@ -1269,6 +1302,8 @@ struct Convolution2D FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyTable(quanParameter()) &&
            VerifyOffset(verifier, VT_SYMMETRICQUAN) &&
            verifier.VerifyTable(symmetricQuan()) &&
+           VerifyOffset(verifier, VT_INPUTPADVALUE) &&
+           verifier.VerifyVector(inputPadValue()) &&
            verifier.EndTable();
   }
   Convolution2DT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -1294,6 +1329,9 @@ struct Convolution2DBuilder {
   void add_symmetricQuan(flatbuffers::Offset<QuantizedFloatParam> symmetricQuan) {
     fbb_.AddOffset(Convolution2D::VT_SYMMETRICQUAN, symmetricQuan);
   }
+  void add_inputPadValue(flatbuffers::Offset<flatbuffers::Vector<float>> inputPadValue) {
+    fbb_.AddOffset(Convolution2D::VT_INPUTPADVALUE, inputPadValue);
+  }
   explicit Convolution2DBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1312,8 +1350,10 @@ inline flatbuffers::Offset<Convolution2D> CreateConvolution2D(
     flatbuffers::Offset<flatbuffers::Vector<float>> weight = 0,
     flatbuffers::Offset<flatbuffers::Vector<float>> bias = 0,
     flatbuffers::Offset<IDSTQuan> quanParameter = 0,
-    flatbuffers::Offset<QuantizedFloatParam> symmetricQuan = 0) {
+    flatbuffers::Offset<QuantizedFloatParam> symmetricQuan = 0,
+    flatbuffers::Offset<flatbuffers::Vector<float>> inputPadValue = 0) {
   Convolution2DBuilder builder_(_fbb);
+  builder_.add_inputPadValue(inputPadValue);
   builder_.add_symmetricQuan(symmetricQuan);
   builder_.add_quanParameter(quanParameter);
   builder_.add_bias(bias);
@@ -1328,16 +1368,19 @@ inline flatbuffers::Offset<Convolution2D> CreateConvolution2DDirect(
     const std::vector<float> *weight = nullptr,
     const std::vector<float> *bias = nullptr,
     flatbuffers::Offset<IDSTQuan> quanParameter = 0,
-    flatbuffers::Offset<QuantizedFloatParam> symmetricQuan = 0) {
+    flatbuffers::Offset<QuantizedFloatParam> symmetricQuan = 0,
+    const std::vector<float> *inputPadValue = nullptr) {
   auto weight__ = weight ? _fbb.CreateVector<float>(*weight) : 0;
   auto bias__ = bias ? _fbb.CreateVector<float>(*bias) : 0;
+  auto inputPadValue__ = inputPadValue ? _fbb.CreateVector<float>(*inputPadValue) : 0;
   return MNN::CreateConvolution2D(
       _fbb,
       common,
       weight__,
       bias__,
       quanParameter,
-      symmetricQuan);
+      symmetricQuan,
+      inputPadValue__);
 }
 
 flatbuffers::Offset<Convolution2D> CreateConvolution2D(flatbuffers::FlatBufferBuilder &_fbb, const Convolution2DT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
@@ -2571,11 +2614,13 @@ struct LSTMT : public flatbuffers::NativeTable {
   std::unique_ptr<BlobT> weightIQ;
   std::unique_ptr<BlobT> weightIA;
   float quantScale;
+  bool keepState;
   LSTMT()
       : outputCount(0),
         weightSize(0),
         clippingThreshold(0.0f),
-        quantScale(0.0f) {
+        quantScale(0.0f),
+        keepState(false) {
   }
 };
 
@@ -2593,7 +2638,8 @@ struct LSTM FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_BIAS = 14,
     VT_WEIGHTIQ = 16,
     VT_WEIGHTIA = 18,
-    VT_QUANTSCALE = 20
+    VT_QUANTSCALE = 20,
+    VT_KEEPSTATE = 22
   };
   int32_t outputCount() const {
     return GetField<int32_t>(VT_OUTPUTCOUNT, 0);
@@ -2622,6 +2668,9 @@ struct LSTM FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   float quantScale() const {
     return GetField<float>(VT_QUANTSCALE, 0.0f);
   }
+  bool keepState() const {
+    return GetField<uint8_t>(VT_KEEPSTATE, 0) != 0;
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int32_t>(verifier, VT_OUTPUTCOUNT) &&
@@ -2638,6 +2687,7 @@ struct LSTM FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_WEIGHTIA) &&
            verifier.VerifyTable(weightIA()) &&
            VerifyField<float>(verifier, VT_QUANTSCALE) &&
+           VerifyField<uint8_t>(verifier, VT_KEEPSTATE) &&
            verifier.EndTable();
   }
   LSTMT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -2675,6 +2725,9 @@ struct LSTMBuilder {
   void add_quantScale(float quantScale) {
     fbb_.AddElement<float>(LSTM::VT_QUANTSCALE, quantScale, 0.0f);
   }
+  void add_keepState(bool keepState) {
+    fbb_.AddElement<uint8_t>(LSTM::VT_KEEPSTATE, static_cast<uint8_t>(keepState), 0);
+  }
   explicit LSTMBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -2697,7 +2750,8 @@ inline flatbuffers::Offset<LSTM> CreateLSTM(
     flatbuffers::Offset<Blob> bias = 0,
     flatbuffers::Offset<Blob> weightIQ = 0,
     flatbuffers::Offset<Blob> weightIA = 0,
-    float quantScale = 0.0f) {
+    float quantScale = 0.0f,
+    bool keepState = false) {
   LSTMBuilder builder_(_fbb);
   builder_.add_quantScale(quantScale);
   builder_.add_weightIA(weightIA);
@@ -2708,6 +2762,7 @@ inline flatbuffers::Offset<LSTM> CreateLSTM(
   builder_.add_clippingThreshold(clippingThreshold);
   builder_.add_weightSize(weightSize);
   builder_.add_outputCount(outputCount);
+  builder_.add_keepState(keepState);
   return builder_.Finish();
 }
 
@@ -4335,7 +4390,7 @@ struct EltwiseInt8T : public flatbuffers::NativeTable {
   std::unique_ptr<QuantizedFloatParamT> inputQuan1;
   std::unique_ptr<QuantizedFloatParamT> outputQuan;
   EltwiseInt8T()
-      : type(EltwiseType_PROD) {
+      : type(EltwiseType_SUM) {
   }
 };
 
@@ -4351,7 +4406,7 @@ struct EltwiseInt8 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_OUTPUTQUAN = 10
   };
   EltwiseType type() const {
-    return static_cast<EltwiseType>(GetField<int8_t>(VT_TYPE, 0));
+    return static_cast<EltwiseType>(GetField<int8_t>(VT_TYPE, 1));
   }
   const QuantizedFloatParam *inputQuan0() const {
     return GetPointer<const QuantizedFloatParam *>(VT_INPUTQUAN0);
@@ -4382,7 +4437,7 @@ struct EltwiseInt8Builder {
   flatbuffers::FlatBufferBuilder &fbb_;
   flatbuffers::uoffset_t start_;
   void add_type(EltwiseType type) {
-    fbb_.AddElement<int8_t>(EltwiseInt8::VT_TYPE, static_cast<int8_t>(type), 0);
+    fbb_.AddElement<int8_t>(EltwiseInt8::VT_TYPE, static_cast<int8_t>(type), 1);
   }
   void add_inputQuan0(flatbuffers::Offset<QuantizedFloatParam> inputQuan0) {
     fbb_.AddOffset(EltwiseInt8::VT_INPUTQUAN0, inputQuan0);
@@ -4407,7 +4462,7 @@ struct EltwiseInt8Builder {
 
 inline flatbuffers::Offset<EltwiseInt8> CreateEltwiseInt8(
     flatbuffers::FlatBufferBuilder &_fbb,
-    EltwiseType type = EltwiseType_PROD,
+    EltwiseType type = EltwiseType_SUM,
     flatbuffers::Offset<QuantizedFloatParam> inputQuan0 = 0,
     flatbuffers::Offset<QuantizedFloatParam> inputQuan1 = 0,
     flatbuffers::Offset<QuantizedFloatParam> outputQuan = 0) {
@@ -4613,6 +4668,8 @@ inline void QuantizedFloatParam::UnPackTo(QuantizedFloatParamT *_o, const flatbu
   { auto _e = tensorScale(); if (_e) { _o->tensorScale.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->tensorScale[_i] = _e->Get(_i); } } };
   { auto _e = method(); _o->method = _e; };
   { auto _e = nbits(); _o->nbits = _e; };
+  { auto _e = inputZeroPoint(); _o->inputZeroPoint = _e; };
+  { auto _e = outputZeroPoint(); _o->outputZeroPoint = _e; };
 }
 
 inline flatbuffers::Offset<QuantizedFloatParam> QuantizedFloatParam::Pack(flatbuffers::FlatBufferBuilder &_fbb, const QuantizedFloatParamT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -4629,6 +4686,8 @@ inline flatbuffers::Offset<QuantizedFloatParam> CreateQuantizedFloatParam(flatbu
   auto _tensorScale = _o->tensorScale.size() ? _fbb.CreateVector(_o->tensorScale) : 0;
   auto _method = _o->method;
   auto _nbits = _o->nbits;
+  auto _inputZeroPoint = _o->inputZeroPoint;
+  auto _outputZeroPoint = _o->outputZeroPoint;
   return MNN::CreateQuantizedFloatParam(
       _fbb,
       _weight,
@@ -4636,7 +4695,9 @@ inline flatbuffers::Offset<QuantizedFloatParam> CreateQuantizedFloatParam(flatbu
       _scale,
       _tensorScale,
       _method,
-      _nbits);
+      _nbits,
+      _inputZeroPoint,
+      _outputZeroPoint);
 }
 
 inline Convolution2DT *Convolution2D::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -4653,6 +4714,7 @@ inline void Convolution2D::UnPackTo(Convolution2DT *_o, const flatbuffers::resol
   { auto _e = bias(); if (_e) { _o->bias.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->bias[_i] = _e->Get(_i); } } };
   { auto _e = quanParameter(); if (_e) _o->quanParameter = std::unique_ptr<IDSTQuanT>(_e->UnPack(_resolver)); };
   { auto _e = symmetricQuan(); if (_e) _o->symmetricQuan = std::unique_ptr<QuantizedFloatParamT>(_e->UnPack(_resolver)); };
+  { auto _e = inputPadValue(); if (_e) { _o->inputPadValue.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->inputPadValue[_i] = _e->Get(_i); } } };
 }
 
 inline flatbuffers::Offset<Convolution2D> Convolution2D::Pack(flatbuffers::FlatBufferBuilder &_fbb, const Convolution2DT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -4668,13 +4730,15 @@ inline flatbuffers::Offset<Convolution2D> CreateConvolution2D(flatbuffers::FlatB
   auto _bias = _o->bias.size() ? _fbb.CreateVector(_o->bias) : 0;
   auto _quanParameter = _o->quanParameter ? CreateIDSTQuan(_fbb, _o->quanParameter.get(), _rehasher) : 0;
   auto _symmetricQuan = _o->symmetricQuan ? CreateQuantizedFloatParam(_fbb, _o->symmetricQuan.get(), _rehasher) : 0;
+  auto _inputPadValue = _o->inputPadValue.size() ? _fbb.CreateVector(_o->inputPadValue) : 0;
   return MNN::CreateConvolution2D(
       _fbb,
       _common,
       _weight,
       _bias,
       _quanParameter,
-      _symmetricQuan);
+      _symmetricQuan,
+      _inputPadValue);
 }
 
 inline Convolution3DT *Convolution3D::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -5112,6 +5176,7 @@ inline void LSTM::UnPackTo(LSTMT *_o, const flatbuffers::resolver_function_t *_r
   { auto _e = weightIQ(); if (_e) _o->weightIQ = std::unique_ptr<BlobT>(_e->UnPack(_resolver)); };
   { auto _e = weightIA(); if (_e) _o->weightIA = std::unique_ptr<BlobT>(_e->UnPack(_resolver)); };
   { auto _e = quantScale(); _o->quantScale = _e; };
+  { auto _e = keepState(); _o->keepState = _e; };
 }
 
 inline flatbuffers::Offset<LSTM> LSTM::Pack(flatbuffers::FlatBufferBuilder &_fbb, const LSTMT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -5131,6 +5196,7 @@ inline flatbuffers::Offset<LSTM> CreateLSTM(flatbuffers::FlatBufferBuilder &_fbb
   auto _weightIQ = _o->weightIQ ? CreateBlob(_fbb, _o->weightIQ.get(), _rehasher) : 0;
   auto _weightIA = _o->weightIA ? CreateBlob(_fbb, _o->weightIA.get(), _rehasher) : 0;
   auto _quantScale = _o->quantScale;
+  auto _keepState = _o->keepState;
   return MNN::CreateLSTM(
       _fbb,
       _outputCount,
@@ -5141,7 +5207,8 @@ inline flatbuffers::Offset<LSTM> CreateLSTM(flatbuffers::FlatBufferBuilder &_fbb
       _bias,
       _weightIQ,
       _weightIA,
-      _quantScale);
+      _quantScale,
+      _keepState);
 }
 
 inline SliceT *Slice::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -5978,6 +6045,8 @@ inline const flatbuffers::TypeTable *QuantizedFloatParamTypeTable() {
     { flatbuffers::ET_FLOAT, 1, -1 },
     { flatbuffers::ET_FLOAT, 1, -1 },
     { flatbuffers::ET_CHAR, 0, 0 },
+    { flatbuffers::ET_INT, 0, -1 },
+    { flatbuffers::ET_INT, 0, -1 },
     { flatbuffers::ET_INT, 0, -1 }
   };
   static const flatbuffers::TypeFunction type_refs[] = {
@@ -5989,10 +6058,12 @@ inline const flatbuffers::TypeTable *QuantizedFloatParamTypeTable() {
     "scale",
     "tensorScale",
     "method",
-    "nbits"
+    "nbits",
+    "inputZeroPoint",
+    "outputZeroPoint"
   };
   static const flatbuffers::TypeTable tt = {
-    flatbuffers::ST_TABLE, 6, type_codes, type_refs, nullptr, names
+    flatbuffers::ST_TABLE, 8, type_codes, type_refs, nullptr, names
   };
   return &tt;
 }
@@ -6003,7 +6074,8 @@ inline const flatbuffers::TypeTable *Convolution2DTypeTable() {
     { flatbuffers::ET_FLOAT, 1, -1 },
     { flatbuffers::ET_FLOAT, 1, -1 },
     { flatbuffers::ET_SEQUENCE, 0, 1 },
-    { flatbuffers::ET_SEQUENCE, 0, 2 }
+    { flatbuffers::ET_SEQUENCE, 0, 2 },
+    { flatbuffers::ET_FLOAT, 1, -1 }
   };
   static const flatbuffers::TypeFunction type_refs[] = {
     Convolution2DCommonTypeTable,
@@ -6015,10 +6087,11 @@ inline const flatbuffers::TypeTable *Convolution2DTypeTable() {
     "weight",
     "bias",
     "quanParameter",
-    "symmetricQuan"
+    "symmetricQuan",
+    "inputPadValue"
   };
   static const flatbuffers::TypeTable tt = {
-    flatbuffers::ST_TABLE, 5, type_codes, type_refs, nullptr, names
+    flatbuffers::ST_TABLE, 6, type_codes, type_refs, nullptr, names
   };
   return &tt;
 }
@@ -6279,7 +6352,8 @@ inline const flatbuffers::TypeTable *LSTMTypeTable() {
     { flatbuffers::ET_SEQUENCE, 0, 0 },
     { flatbuffers::ET_SEQUENCE, 0, 0 },
     { flatbuffers::ET_SEQUENCE, 0, 0 },
-    { flatbuffers::ET_FLOAT, 0, -1 }
+    { flatbuffers::ET_FLOAT, 0, -1 },
+    { flatbuffers::ET_BOOL, 0, -1 }
   };
   static const flatbuffers::TypeFunction type_refs[] = {
     BlobTypeTable
@@ -6293,10 +6367,11 @@ inline const flatbuffers::TypeTable *LSTMTypeTable() {
     "bias",
     "weightIQ",
     "weightIA",
-    "quantScale"
+    "quantScale",
+    "keepState"
   };
   static const flatbuffers::TypeTable tt = {
-    flatbuffers::ST_TABLE, 9, type_codes, type_refs, nullptr, names
+    flatbuffers::ST_TABLE, 10, type_codes, type_refs, nullptr, names
   };
   return &tt;
 }
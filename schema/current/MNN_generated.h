@@ -211,6 +211,8 @@ enum OpType {
   OpType_TrainableParam = 266,
   OpType_BatchNorm = 267,
   OpType_ZeroGrad = 268,
+  OpType_FakeQuant = 269,
+  OpType_FakeQuantGrad = 270,
   OpType_Extra = 512,
   OpType_ConvInt8 = 513,
   OpType_Int8ToFloat = 514,
@@ -225,7 +227,7 @@ enum OpType {
   OpType_MAX = OpType_LayerNorm
 };
 
-inline const OpType (&EnumValuesOpType())[150] {
+inline const OpType (&EnumValuesOpType())[152] {
   static const OpType values[] = {
     OpType_AbsVal,
     OpType_QuantizedAdd,
@@ -367,6 +369,8 @@ inline const OpType (&EnumValuesOpType())[150] {
     OpType_TrainableParam,
     OpType_BatchNorm,
     OpType_ZeroGrad,
+    OpType_FakeQuant,
+    OpType_FakeQuantGrad,
     OpType_Extra,
     OpType_ConvInt8,
     OpType_Int8ToFloat,
@@ -652,8 +656,8 @@ inline const char * const *EnumNamesOpType() {
     "TrainableParam",
     "BatchNorm",
     "ZeroGrad",
-    "",
-    "",
+    "FakeQuant",
+    "FakeQuantGrad",
     "",
     "",
     "",
@@ -6816,12 +6820,14 @@ inline const flatbuffers::TypeTable *OpTypeTypeTable() {
     { flatbuffers::ET_INT, 0, 0 },
     { flatbuffers::ET_INT, 0, 0 },
     { flatbuffers::ET_INT, 0, 0 },
+    { flatbuffers::ET_INT, 0, 0 },
+    { flatbuffers::ET_INT, 0, 0 },
     { flatbuffers::ET_INT, 0, 0 }
   };
   static const flatbuffers::TypeFunction type_refs[] = {
     OpTypeTypeTable
   };
-  static const int64_t values[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 128, 129, 130, 131, 132, 256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 512, 513, 514, 515, 516, 517, 518, 600, 601, 603 };
+  static const int64_t values[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 128, 129, 130, 131, 132, 256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 269, 270, 512, 513, 514, 515, 516, 517, 518, 600, 601, 603 };
   static const char * const names[] = {
     "AbsVal",
     "QuantizedAdd",
@@ -6963,6 +6969,8 @@ inline const flatbuffers::TypeTable *OpTypeTypeTable() {
     "TrainableParam",
     "BatchNorm",
     "ZeroGrad",
+    "FakeQuant",
+    "FakeQuantGrad",
     "Extra",
     "ConvInt8",
     "Int8ToFloat",
@@ -6975,7 +6983,7 @@ inline const flatbuffers::TypeTable *OpTypeTypeTable() {
     "LayerNorm"
   };
   static const flatbuffers::TypeTable tt = {
-    flatbuffers::ST_ENUM, 150, type_codes, type_refs, values, names
+    flatbuffers::ST_ENUM, 152, type_codes, type_refs, values, names
   };
   return &tt;
 }
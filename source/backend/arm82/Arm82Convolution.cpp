@@ -447,6 +447,10 @@ ErrorCode Arm82Convolution::onExecute(const std::vector<Tensor *> &inputs, const
 class Arm82ConvolutionCreator : public Arm82Backend::Arm82Creator {
     virtual Execution *onCreate(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
                                 const MNN::Op *op, Backend *backend) const override {
+        // The image preprocess folded by the converter runs on the uint8 input by the CPU only
+        if (ConvolutionCommon::isRawImageConvolution(op, inputs[0])) {
+            return nullptr;
+        }
         auto convParam = op->main_as_Convolution2D();
         // avoid other quantize method entry this creator
         if(convParam->quanParameter() && convParam->quanParameter()->type() != 3){
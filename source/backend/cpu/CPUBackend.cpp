@@ -27,7 +27,6 @@
 #define LARGE_MEMORY 1024 * 1024 * 100
 
 //#define MNN_DUMP_MEMORY_USAGE
-#define MNN_CPU_CHECK_NAN 1
 namespace MNN {
 void registerCPUOps();
 #if defined(__aarch64__) && ENABLE_ARMV82
@@ -100,6 +99,55 @@ Backend* CPURuntime::onCreate() const{
 #endif
     return new CPUBackend(this);
 }
+#define MNN_CPU_CACHE_MAGIC 0x4D4E4E43
+#define MNN_CPU_CACHE_VERSION 1
+bool CPURuntime::onSetCache(const void* buffer, size_t size) {
+    mCacheBuffer.clear();
+    if (nullptr == buffer) {
+        // Only release the serialized buffer, the tuned result is still useful for resize
+        return true;
+    }
+    // Layout: magic, version, number, then [keySize, key..., algorithm, unit] for each item
+    auto src   = (const int32_t*)buffer;
+    auto total = size / sizeof(int32_t);
+    if (total < 3 || src[0] != MNN_CPU_CACHE_MAGIC || src[1] != MNN_CPU_CACHE_VERSION) {
+        return false;
+    }
+    std::map<std::vector<int>, std::pair<int, int>> algorithms;
+    size_t pos = 3;
+    for (int i = 0; i < src[2]; ++i) {
+        if (pos >= total) {
+            return false;
+        }
+        size_t keySize = src[pos++];
+        if (pos + keySize + 2 > total) {
+            return false;
+        }
+        std::vector<int> key(src + pos, src + pos + keySize);
+        pos += keySize;
+        algorithms[key] = std::make_pair(src[pos], src[pos + 1]);
+        pos += 2;
+    }
+    for (auto& iter : algorithms) {
+        mConvolutionAlgorithms.insert(iter);
+    }
+    return true;
+}
+
+std::pair<const void*, size_t> CPURuntime::onGetCache() {
+    if (mConvolutionAlgorithms.empty()) {
+        return std::make_pair(nullptr, 0);
+    }
+    mCacheBuffer = {MNN_CPU_CACHE_MAGIC, MNN_CPU_CACHE_VERSION, (int32_t)mConvolutionAlgorithms.size()};
+    for (auto& iter : mConvolutionAlgorithms) {
+        mCacheBuffer.emplace_back((int32_t)iter.first.size());
+        mCacheBuffer.insert(mCacheBuffer.end(), iter.first.begin(), iter.first.end());
+        mCacheBuffer.emplace_back(iter.second.first);
+        mCacheBuffer.emplace_back(iter.second.second);
+    }
+    return std::make_pair(mCacheBuffer.data(), mCacheBuffer.size() * sizeof(int32_t));
+}
+
 void CPURuntime::onGabageCollect(int level) {
     mStaticAllocator->release(false);
     if (level > 50) {
@@ -128,7 +176,7 @@ bool CPUBackend::addCreator(OpType t, Creator* c) {
 
 CPUBackend::CPUBackend(const CPURuntime* runtime, MNNForwardType type) : Backend(type) {
     mRuntime = runtime;
-    mCheckNAN = runtime->mFlags == MNN_CPU_CHECK_NAN;
+    mCheckNAN = (runtime->mFlags & MNN_CPU_CHECK_NAN) != 0;
     mDynamicAllocator = runtime->mDynamicAllocator;
     mStaticAllocator = runtime->mStaticAllocator;
 }
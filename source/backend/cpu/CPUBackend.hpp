@@ -32,6 +32,8 @@ public:
     virtual Backend* onCreate() const override;
     virtual void onGabageCollect(int level) override;
     virtual float onGetMemoryInMB() override;
+    virtual bool onSetCache(const void* buffer, size_t size) override;
+    virtual std::pair<const void*, size_t> onGetCache() override;
 private:
     std::shared_ptr<BufferAllocator> mStaticAllocator;
     std::shared_ptr<BufferAllocator> mDynamicAllocator;
@@ -47,6 +49,9 @@ private:
     bool mIsSupportDot = false;
     bool mIsSupportFp16arith = false;
     float mFlops = 0.0f;
+    // Convolution algorithm measured by MNN_CPU_TUNE_CONVOLUTION, key: parameter and shape, value: algorithm and unit
+    mutable std::map<std::vector<int>, std::pair<int, int>> mConvolutionAlgorithms;
+    std::vector<int32_t> mCacheBuffer;
     static Backend*(*gExtraCreate)(const Runtime* runtime);
 };
 
@@ -90,6 +95,15 @@ public:
     BackendConfig::MemoryMode memoryMode() const {
         return mRuntime->mMemory;
     }
+    bool tuneConvolution() const {
+        return (mRuntime->mFlags & MNN_CPU_TUNE_CONVOLUTION) != 0;
+    }
+    bool shareWeight() const {
+        return (mRuntime->mFlags & MNN_CPU_SHARE_WEIGHT) != 0;
+    }
+    std::map<std::vector<int>, std::pair<int, int>>& convolutionAlgorithms() const {
+        return mRuntime->mConvolutionAlgorithms;
+    }
 #ifdef MNN_USE_THREAD_POOL
     inline int taskIndex() const {return mRuntime->mTaskIndex;}
 #endif
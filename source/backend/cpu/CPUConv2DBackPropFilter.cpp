@@ -0,0 +1,267 @@
+//
+//  CPUConv2DBackPropFilter.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/18.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "backend/cpu/CPUConv2DBackPropFilter.hpp"
+#include <algorithm>
+#include "backend/cpu/compute/CommonOptFunction.h"
+#include "backend/cpu/compute/ConvOpt.h"
+#include "core/Concurrency.h"
+#include "core/ConvolutionCommon.hpp"
+#include "core/Macro.h"
+#include "core/TensorUtils.hpp"
+#include "math/Vec.hpp"
+
+using Vec4 = MNN::Math::Vec<float, 4>;
+// Number of floats for the im2col of a tile
+#define MNN_BACKPROP_FILTER_TILE_BUFFER (1024 * 1024)
+
+namespace MNN {
+CPUConv2DBackPropFilter::CPUConv2DBackPropFilter(const Convolution2DCommon* common, Backend* b)
+    : Execution(b), mCommon(common) {
+    // Do nothing
+}
+
+ErrorCode CPUConv2DBackPropFilter::onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    auto input      = inputs[0];
+    auto outputDiff = inputs[1];
+    auto pads       = ConvolutionCommon::convolutionPad(input, outputDiff, mCommon);
+    mPadX           = pads.first;
+    mPadY           = pads.second;
+    mMatMul         = nullptr;
+    mTileFunction   = nullptr;
+    mPreFunction    = nullptr;
+    mPostFunction   = nullptr;
+    mTileCount      = 0;
+    if (mCommon->group() > 1) {
+        return _resizeDepthwise(input, outputDiff, outputs[0]);
+    }
+    return _resizeGEMM(input, outputDiff, outputs[0]);
+}
+
+ErrorCode CPUConv2DBackPropFilter::_resizeGEMM(const Tensor* input, const Tensor* outputDiff, Tensor* kernelDiff) {
+    auto batch      = input->batch();
+    auto ic         = input->channel();
+    auto ih         = input->height();
+    auto iw         = input->width();
+    auto oc         = outputDiff->channel();
+    auto oh         = outputDiff->height();
+    auto ow         = outputDiff->width();
+    auto kw         = mCommon->kernelX();
+    auto kh         = mCommon->kernelY();
+    auto sw         = mCommon->strideX();
+    auto sh         = mCommon->strideY();
+    auto dw         = mCommon->dilateX();
+    auto dh         = mCommon->dilateY();
+    auto padX       = mPadX;
+    auto padY       = mPadY;
+    auto kernelSize = kw * kh;
+    auto plane      = oh * ow;
+    auto total      = batch * plane;
+    // kernelDiff^T = im2col(input) * outputDiff^T: e = ic * kh * kw, l = batch * oh * ow, h = oc
+    int e    = ic * kernelSize;
+    int tile = ALIGN_UP4(std::max(64, MNN_BACKPROP_FILTER_TILE_BUFFER / e));
+    tile     = std::min(tile, ALIGN_UP4(total));
+    int eP, lP, hP;
+    MNNGetMatMulPackMode(&eP, &lP, &hP);
+    auto ocC4 = UP_DIV(oc, 4);
+    auto icC4 = UP_DIV(ic, 4);
+
+    std::shared_ptr<Tensor> A(Tensor::createDevice<float>({tile / 4, e, 4}));
+    std::shared_ptr<Tensor> diffTile(Tensor::createDevice<float>({oc, tile}));
+    std::shared_ptr<Tensor> B(Tensor::createDevice<float>({UP_DIV(oc, hP), tile, hP}));
+    std::shared_ptr<Tensor> C(Tensor::createDevice<float>({ocC4, e, 4}));
+    std::shared_ptr<Tensor> sum(Tensor::createDevice<float>({ocC4, e, 4}));
+    std::shared_ptr<Tensor> positions(Tensor::createDevice<int32_t>({tile, 3}));
+    std::vector<Tensor*> temps = {A.get(), diffTile.get(), B.get(), C.get(), sum.get(), positions.get()};
+    for (auto t : temps) {
+        if (!backend()->onAcquireBuffer(t, Backend::DYNAMIC)) {
+            return OUT_OF_MEMORY;
+        }
+    }
+    mMatMul.reset(new StrassenMatrixComputor(backend(), true, 5));
+    auto code = mMatMul->onEncode({A.get(), B.get()}, {C.get()});
+    for (auto t : temps) {
+        backend()->onReleaseBuffer(t, Backend::DYNAMIC);
+    }
+    if (NO_ERROR != code) {
+        return code;
+    }
+
+    mTileSize          = tile;
+    mTileCount         = UP_DIV(total, tile);
+    auto threadNumber  = ((CPUBackend*)backend())->threadNumber();
+    auto inputPtr      = input->host<float>();
+    auto inputStride   = input->stride(0);
+    auto diffPtr       = outputDiff->host<float>();
+    auto diffStride    = outputDiff->stride(0);
+    auto APtr          = A->host<float>();
+    auto diffTilePtr   = diffTile->host<float>();
+    auto BPtr          = B->host<float>();
+    auto CPtr          = C->host<float>();
+    auto sumPtr        = sum->host<float>();
+    auto positionPtr   = positions->host<int32_t>();
+    auto kernelDiffPtr = kernelDiff->host<float>();
+    auto matmul        = mMatMul;
+    auto sumSize       = sum->size();
+    mPreFunction       = [sumPtr, sumSize]() { ::memset(sumPtr, 0, sumSize); };
+    mTileFunction      = [=](int start) {
+        int count = std::min(tile, total - start);
+        for (int i = 0; i < count; ++i) {
+            auto q                 = start + i;
+            auto b                 = q / plane;
+            auto p                 = q - b * plane;
+            positionPtr[3 * i + 0] = b;
+            positionPtr[3 * i + 1] = (p / ow) * sh - padY;
+            positionPtr[3 * i + 2] = (p % ow) * sw - padX;
+        }
+        MNN_CONCURRENCY_BEGIN(tId, threadNumber) {
+            // im2col of the tile as A: tile / 4, ic * kh * kw, 4, each unit of 4 positions is filled contiguously
+            for (int u = (int)tId; u < tile / 4; u += threadNumber) {
+                auto dstU = APtr + u * e * 4;
+                for (int z = 0; z < icC4; ++z) {
+                    auto srcZ    = inputPtr + z * ih * iw * 4;
+                    auto channel = std::min(4, ic - z * 4);
+                    for (int ky = 0; ky < kh; ++ky) {
+                        for (int kx = 0; kx < kw; ++kx) {
+                            auto dst = dstU + (z * 4 * kernelSize + ky * kw + kx) * 4;
+                            for (int v = 0; v < 4; ++v) {
+                                auto i  = u * 4 + v;
+                                auto sy = positionPtr[3 * i + 1] + ky * dh;
+                                auto sx = positionPtr[3 * i + 2] + kx * dw;
+                                if (i < count && sy >= 0 && sy < ih && sx >= 0 && sx < iw) {
+                                    auto src = srcZ + positionPtr[3 * i] * inputStride + (sy * iw + sx) * 4;
+                                    for (int c = 0; c < channel; ++c) {
+                                        dst[c * kernelSize * 4 + v] = src[c];
+                                    }
+                                } else {
+                                    for (int c = 0; c < channel; ++c) {
+                                        dst[c * kernelSize * 4 + v] = 0.0f;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            // outputDiff of the tile: oc, tile
+            for (int z = (int)tId; z < ocC4; z += threadNumber) {
+                auto dstZ    = diffTilePtr + z * 4 * tile;
+                auto srcZ    = diffPtr + z * plane * 4;
+                auto channel = std::min(4, oc - z * 4);
+                for (int i = 0; i < count; ++i) {
+                    auto b   = positionPtr[3 * i];
+                    auto src = srcZ + b * diffStride + (start + i - b * plane) * 4;
+                    for (int c = 0; c < channel; ++c) {
+                        dstZ[c * tile + i] = src[c];
+                    }
+                }
+                for (int c = 0; c < channel; ++c) {
+                    ::memset(dstZ + c * tile + count, 0, (tile - count) * sizeof(float));
+                }
+            }
+        }
+        MNN_CONCURRENCY_END();
+        MNNPackForMatMul_B(BPtr, diffTilePtr, oc, tile, true);
+        matmul->onExecute();
+        MNNMatrixAdd(sumPtr, sumPtr, CPtr, ocC4 * e, 0, 0, 0, 1);
+    };
+    // ocC4, e, 4 -> oc, ic, kh, kw
+    mPostFunction = [kernelDiffPtr, sumPtr, e, oc]() { MNNUnpackC4(kernelDiffPtr, sumPtr, e, oc); };
+    return NO_ERROR;
+}
+
+ErrorCode CPUConv2DBackPropFilter::_resizeDepthwise(const Tensor* input, const Tensor* outputDiff,
+                                                   Tensor* kernelDiff) {
+    auto batch         = input->batch();
+    auto ic            = input->channel();
+    auto ih            = input->height();
+    auto iw            = input->width();
+    auto oh            = outputDiff->height();
+    auto ow            = outputDiff->width();
+    auto kw            = mCommon->kernelX();
+    auto kh            = mCommon->kernelY();
+    auto sw            = mCommon->strideX();
+    auto sh            = mCommon->strideY();
+    auto dw            = mCommon->dilateX();
+    auto dh            = mCommon->dilateY();
+    auto padX          = mPadX;
+    auto padY          = mPadY;
+    auto icC4          = UP_DIV(ic, 4);
+    auto threadNumber  = std::min(((CPUBackend*)backend())->threadNumber(), icC4);
+    auto inputPtr      = input->host<float>();
+    auto inputStride   = input->stride(0);
+    auto diffPtr       = outputDiff->host<float>();
+    auto diffStride    = outputDiff->stride(0);
+    auto kernelDiffPtr = kernelDiff->host<float>();
+    // Each kernel element is the sum of outputDiff * input over the positions it touches
+    mPostFunction = [=]() {
+        MNN_CONCURRENCY_BEGIN(tId, threadNumber) {
+            for (int z = (int)tId; z < icC4; z += threadNumber) {
+                for (int ky = 0; ky < kh; ++ky) {
+                    int oyStart = std::max(0, UP_DIV(padY - ky * dh, sh));
+                    int oyEnd   = std::min(oh, UP_DIV(ih + padY - ky * dh, sh));
+                    for (int kx = 0; kx < kw; ++kx) {
+                        int oxStart = std::max(0, UP_DIV(padX - kx * dw, sw));
+                        int oxEnd   = std::min(ow, UP_DIV(iw + padX - kx * dw, sw));
+                        Vec4 sum(0.0f);
+                        for (int b = 0; b < batch; ++b) {
+                            auto srcZ  = inputPtr + b * inputStride + z * ih * iw * 4;
+                            auto diffZ = diffPtr + b * diffStride + z * oh * ow * 4;
+                            for (int oy = oyStart; oy < oyEnd; ++oy) {
+                                auto srcY  = srcZ + ((oy * sh - padY + ky * dh) * iw + kx * dw - padX) * 4;
+                                auto diffY = diffZ + oy * ow * 4;
+                                for (int ox = oxStart; ox < oxEnd; ++ox) {
+                                    sum = sum + Vec4::load(diffY + 4 * ox) * Vec4::load(srcY + 4 * ox * sw);
+                                }
+                            }
+                        }
+                        for (int i = 0; i < 4 && 4 * z + i < ic; ++i) {
+                            kernelDiffPtr[(4 * z + i) * kh * kw + ky * kw + kx] = sum[i];
+                        }
+                    }
+                }
+            }
+        }
+        MNN_CONCURRENCY_END();
+    };
+    return NO_ERROR;
+}
+
+ErrorCode CPUConv2DBackPropFilter::onExecute(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    if (nullptr != mPreFunction) {
+        mPreFunction();
+    }
+    for (int i = 0; i < mTileCount; ++i) {
+        mTileFunction(i * mTileSize);
+    }
+    if (nullptr != mPostFunction) {
+        mPostFunction();
+    }
+    return NO_ERROR;
+}
+
+class CPUConv2DBackPropFilterCreator : public CPUBackend::Creator {
+public:
+    virtual Execution* onCreate(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
+                                const MNN::Op* op, Backend* backend) const override {
+        auto common = op->main_as_Convolution2D()->common();
+        for (auto input : inputs) {
+            if (TensorUtils::getDescribe(input)->dimensionFormat != MNN_DATA_FORMAT_NC4HW4) {
+                return nullptr;
+            }
+        }
+        bool depthwise = inputs[0]->channel() == inputs[1]->channel() && inputs[1]->channel() == common->group();
+        if (1 != common->group() && !depthwise) {
+            return nullptr;
+        }
+        return new CPUConv2DBackPropFilter(common, backend);
+    }
+};
+
+REGISTER_CPU_OP_CREATOR(CPUConv2DBackPropFilterCreator, OpType_Conv2DBackPropFilter);
+} // namespace MNN
@@ -0,0 +1,49 @@
+//
+//  CPUConv2DBackPropFilter.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/18.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef CPUConv2DBackPropFilter_hpp
+#define CPUConv2DBackPropFilter_hpp
+
+#include <functional>
+#include "backend/cpu/CPUBackend.hpp"
+#include "backend/cpu/compute/StrassenMatmulComputor.hpp"
+
+namespace MNN {
+/**
+ Gradient of convolution kernel: inputs are the input of convolution and the gradient of its output, both in NC4HW4,
+ output is the gradient of kernel in NCHW: oc, ic / group, kh, kw.
+ For group = 1, the positions of output are split into tiles, im2col of a tile is packed directly as the A of GEMM
+ and the products of tiles are summed, so the temporary memory doesn't grow with batch and image size.
+ For depthwise, each kernel element is a dot product of the gradient and the shifted input, computed directly.
+ */
+class CPUConv2DBackPropFilter : public Execution {
+public:
+    CPUConv2DBackPropFilter(const Convolution2DCommon* common, Backend* b);
+    virtual ~CPUConv2DBackPropFilter() = default;
+    virtual ErrorCode onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) override;
+    virtual ErrorCode onExecute(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) override;
+
+private:
+    ErrorCode _resizeGEMM(const Tensor* input, const Tensor* outputDiff, Tensor* kernelDiff);
+    ErrorCode _resizeDepthwise(const Tensor* input, const Tensor* outputDiff, Tensor* kernelDiff);
+
+    const Convolution2DCommon* mCommon;
+    int mPadX = 0;
+    int mPadY = 0;
+    std::shared_ptr<StrassenMatrixComputor> mMatMul;
+    // Fill the tile beginning from the position, then compute the GEMM of it
+    std::function<void(int position)> mTileFunction;
+    int mTileSize  = 0;
+    int mTileCount = 0;
+    // Execute before / after the tiles
+    std::function<void()> mPreFunction;
+    std::function<void()> mPostFunction;
+};
+} // namespace MNN
+
+#endif /* CPUConv2DBackPropFilter_hpp */
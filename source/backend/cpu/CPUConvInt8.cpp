@@ -22,9 +22,9 @@ namespace MNN {
 
 static void _fastIm2Col(int8_t* colAddr, const int8_t* inputOrigin,
                         const ConvolutionCommon::Im2ColParameter* im2colParameter, size_t xIndexStart,
-                        size_t realDstCount) {
+                        size_t realDstCount, int8_t padValue) {
     const int col_buffer_size = im2colParameter->kernelCountUnit * GEMM_INT8_DST_XUNIT * GEMM_INT8_SRC_UNIT * sizeof(int8_t);
-    ::memset(colAddr, 0, col_buffer_size);
+    ::memset(colAddr, padValue, col_buffer_size);
     const int icDiv8   = im2colParameter->icDiv4 / 2;
     const int srcZStep = im2colParameter->iw * im2colParameter->ih * 4;
     inputOrigin += xIndexStart * GEMM_INT8_UNIT;
@@ -47,9 +47,9 @@ static void _fastIm2Col(int8_t* colAddr, const int8_t* inputOrigin,
 
 static void _im2colCommonZ1(int8_t* colAddr, const int8_t* inputOrigin,
                             const ConvolutionCommon::Im2ColParameter* im2colParameter, size_t xIndexStart,
-                            size_t realDstCount) {
+                            size_t realDstCount, int8_t padValue) {
     int col_buffer_size = im2colParameter->kernelCountUnit * GEMM_INT8_DST_XUNIT * GEMM_INT8_SRC_UNIT * sizeof(int8_t);
-    ::memset(colAddr, 0, col_buffer_size);
+    ::memset(colAddr, padValue, col_buffer_size);
     auto ih                     = im2colParameter->ih;
     auto iw                     = im2colParameter->iw;
     auto kh                     = im2colParameter->kernelY;
@@ -90,9 +90,9 @@ static void _im2colCommonZ1(int8_t* colAddr, const int8_t* inputOrigin,
 
 static void _im2colCommon(int8_t* colAddr, const int8_t* inputOrigin,
                           const ConvolutionCommon::Im2ColParameter* im2colParameter, size_t xIndexStart,
-                          size_t realDstCount) {
+                          size_t realDstCount, int8_t padValue) {
     const int col_buffer_size = im2colParameter->kernelCountUnit * GEMM_INT8_DST_XUNIT * GEMM_INT8_SRC_UNIT * sizeof(int8_t);
-    ::memset(colAddr, 0, col_buffer_size);
+    ::memset(colAddr, padValue, col_buffer_size);
     auto ih                     = im2colParameter->ih;
     auto iw                     = im2colParameter->iw;
     auto kh                     = im2colParameter->kernelY;
@@ -167,6 +167,12 @@ CPUConvInt8::CPUConvInt8(Backend* backend, const MNN::Convolution2D* convParam,
         mGemmKernel = MNNGemmInt8AddBiasScale_16x4_Unit_FAST;
     }
     mActBits = convParam->symmetricQuan()->nbits();
+    mInputZeroPoint  = convParam->symmetricQuan()->inputZeroPoint();
+    mOutputZeroPoint = convParam->symmetricQuan()->outputZeroPoint();
+    if (mInputZeroPoint != 0 || mOutputZeroPoint != 0) {
+        // The overflow aware kernel assume the input is in symmetric range
+        mGemmKernel = MNNGemmInt8AddBiasScale_16x4_Unit;
+    }
     
     mWeightInt8.reset(Tensor::createDevice<int8_t>({outputCountUnit, totalKernelCountD8Div2, GEMM_INT8_UNIT, GEMM_INT8_SRC_UNIT}));
     auto allocRes = backend->onAcquireBuffer(mWeightInt8.get(), Backend::STATIC);
@@ -222,6 +228,22 @@ CPUConvInt8::CPUConvInt8(Backend* backend, const MNN::Convolution2D* convParam,
     memset(scalePtr, 0, outputChannleUp4 * sizeof(float));
     memcpy(scalePtr, convParam->symmetricQuan()->scale()->data(), outputCount * sizeof(float));
 
+    // Asymmetric quantization: sum((x - zi) * w) = sum(x * w) - zi * sum(w), and the output zero point is added
+    // before scale, so the gemm kernel and im2col (padding with zi) keep the same
+    if (mInputZeroPoint != 0 || mOutputZeroPoint != 0) {
+        const int weightCount = srcCount * kernelCount;
+        for (int x = 0; x < outputCount; ++x) {
+            int32_t weightSum = 0;
+            for (int i = 0; i < weightCount; ++i) {
+                weightSum += weightSrc[x * weightCount + i];
+            }
+            biasPtr[x] -= mInputZeroPoint * weightSum;
+            if (scalePtr[x] != 0.0f) {
+                biasPtr[x] += (int32_t)roundf((float)mOutputZeroPoint / scalePtr[x]);
+            }
+        }
+    }
+
     mIm2ColParamter.dilateX         = convCommon->dilateX();
     mIm2ColParamter.dilateY         = convCommon->dilateY();
     mIm2ColParamter.strideX         = convCommon->strideX();
@@ -315,10 +337,11 @@ ErrorCode CPUConvInt8::onExecute(const std::vector<Tensor*>& inputs, const std::
     quanParameters.bias = biasDataPtr;
     quanParameters.maxValue = 127;
     if (mRelu) {
-        quanParameters.minValue = 0;
+        quanParameters.minValue = mOutputZeroPoint;
     } else {
         quanParameters.minValue = -128;
     }
+    const int8_t padValue = (int8_t)mInputZeroPoint;
 
     for (int bIndex = 0; bIndex < batch; ++bIndex) {
         const auto srcPtr = inputDataPtr + bIndex * input->stride(0);
@@ -332,7 +355,7 @@ ErrorCode CPUConvInt8::onExecute(const std::vector<Tensor*>& inputs, const std::
                 const int xIndexStart  = tIndex * GEMM_INT8_DST_XUNIT;
                 const int realDstCount = ALIMIN(outputPlaneLen - xIndexStart, GEMM_INT8_DST_XUNIT);
                 // im2col
-                im2ColProcess(colAddr, srcPtr, &mIm2ColParamter, xIndexStart, realDstCount);
+                im2ColProcess(colAddr, srcPtr, &mIm2ColParamter, xIndexStart, realDstCount, padValue);
                 auto outputInTilePtr = dstPtr + xIndexStart * GEMM_INT8_UNIT;
                 if (realDstCount == GEMM_INT8_DST_XUNIT) {
                     mGemmKernel(outputInTilePtr, colAddr, weightDataPtr, kernelCountUnitDouble, dstZStep * sizeof(int8_t),
@@ -678,6 +701,11 @@ class CPUConvInt8Creator : public CPUBackend::Creator {
 public:
     virtual Execution* onCreate(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
                                 const MNN::Op* op, Backend* backend) const override {
+        auto quan = op->main_as_Convolution2D()->symmetricQuan();
+        if (quan->inputZeroPoint() != 0 || quan->outputZeroPoint() != 0) {
+            // Only the common int8 convolution support asymmetric quantization
+            return new CPUConvInt8(backend, op->main_as_Convolution2D(), inputs);
+        }
 #if defined(__aarch64__) && defined(ENABLE_ARMV82)
         if(static_cast<CPUBackend*>(backend)->supportDot()){
             return new CPUConvArm82Int8(backend, op->main_as_Convolution2D());
@@ -25,6 +25,9 @@ private:
     // relu or relu6
     bool mRelu;
     int mActBits;
+    // zero point of asymmetric quantization
+    int mInputZeroPoint  = 0;
+    int mOutputZeroPoint = 0;
 
     std::shared_ptr<Tensor> mWeightInt8;
     std::shared_ptr<Tensor> mBiasInt32;
@@ -103,6 +103,48 @@ CPUDeconvolution::~CPUDeconvolution() {
     backend()->onReleaseBuffer(mWeight.get(), Backend::STATIC);
 }
 
+CPUDeconvolutionMultiInput::CPUDeconvolutionMultiInput(const Tensor* input, const Op* convOp, Backend* b)
+    : CPUDeconvolutionBasic(input, convOp, b) {
+    mOrigin.reset(new CPUDeconvolutionOrigin(input, convOp, b));
+}
+
+ErrorCode CPUDeconvolutionMultiInput::onExecute(const std::vector<Tensor*>& inputs,
+                                                const std::vector<Tensor*>& outputs) {
+    auto outputCount = outputs[0]->channel();
+    auto srcCount    = inputs[0]->channel();
+    ::memset(mBias->host<float>(), 0, mBias->size());
+    if (inputs.size() > 2) {
+        ::memcpy(mBias->host<float>(), inputs[2]->host<float>(), outputCount * sizeof(float));
+    }
+    _transformWeight(inputs[1]->host<float>(), mWeight->host<float>(), outputCount, srcCount, mCommon->kernelY(),
+                     mCommon->kernelX(), mCache->host<float>());
+    return mOrigin->onExecute(mTempInputs, outputs);
+}
+
+ErrorCode CPUDeconvolutionMultiInput::onResize(const std::vector<Tensor*>& inputs,
+                                               const std::vector<Tensor*>& outputs) {
+    auto outputCount = outputs[0]->channel();
+    auto srcCount    = inputs[0]->channel();
+    int eP, lP, hP;
+    MNNGetMatMulPackMode(&eP, &lP, &hP);
+    auto outputAlign = ALIGN_UP4(outputCount) * mCommon->kernelX() * mCommon->kernelY();
+    mWeight.reset(Tensor::createDevice<float>(std::vector<int>{UP_DIV(outputAlign, hP), srcCount, hP}));
+    mCache.reset(Tensor::createDevice<float>({outputAlign * srcCount}));
+    mBias.reset(Tensor::createDevice<float>({ALIGN_UP4(outputCount)}));
+    bool success = backend()->onAcquireBuffer(mWeight.get(), Backend::DYNAMIC) &&
+                   backend()->onAcquireBuffer(mCache.get(), Backend::DYNAMIC) &&
+                   backend()->onAcquireBuffer(mBias.get(), Backend::DYNAMIC);
+    if (!success) {
+        return OUT_OF_MEMORY;
+    }
+    mTempInputs = {inputs[0], mWeight.get(), mBias.get()};
+    auto code   = mOrigin->onResize(mTempInputs, outputs);
+    backend()->onReleaseBuffer(mWeight.get(), Backend::DYNAMIC);
+    backend()->onReleaseBuffer(mCache.get(), Backend::DYNAMIC);
+    backend()->onReleaseBuffer(mBias.get(), Backend::DYNAMIC);
+    return code;
+}
+
 
 ErrorCode CPUDeconvolutionOrigin::onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
     CPUDeconvolutionBasic::onResize(inputs, outputs);
@@ -234,6 +276,12 @@ public:
                                 const MNN::Op* op, Backend* backend) const {
         auto convOp = op->main_as_Convolution2D();
         auto common = convOp->common();
+        if (inputs.size() > 1) {
+            if (1 != common->group()) {
+                return nullptr;
+            }
+            return new CPUDeconvolutionMultiInput(inputs[0], op, backend);
+        }
         if (common->strideY() > 1 || common->strideX() > 1) {
             if (common->dilateX() == 1 && common->dilateY() == 1) {
                 return new DeconvolutionWithStride(inputs[0], op, backend);
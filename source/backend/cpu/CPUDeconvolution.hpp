@@ -48,6 +48,22 @@ private:
     std::vector<std::pair<std::function<void(float*, int)>, int>> mPostFunctions;
 };
 
+// The weight (ic, oc, kh, kw) and bias are inputs, they are packed for CPUDeconvolutionOrigin when executing
+class CPUDeconvolutionMultiInput : public CPUDeconvolutionBasic {
+public:
+    CPUDeconvolutionMultiInput(const Tensor *input, const Op *convOp, Backend *b);
+    virtual ~CPUDeconvolutionMultiInput() = default;
+    virtual ErrorCode onExecute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+    virtual ErrorCode onResize(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+private:
+    std::shared_ptr<Tensor> mWeight;
+    std::shared_ptr<Tensor> mCache;
+    std::shared_ptr<Tensor> mBias;
+    std::vector<Tensor *> mTempInputs;
+    std::shared_ptr<CPUDeconvolutionOrigin> mOrigin;
+};
+
 class CPUDeconvolution : public CPUDeconvolutionCommon {
 public:
     CPUDeconvolution(const Tensor *input, const Op *convOp, Backend *b);
@@ -131,6 +131,16 @@ CPUDepthwiseConvInt8::CPUDepthwiseConvInt8(Backend* backend, const MNN::Convolut
     auto scalePtr = mScaleFloat->host<float>();
     memset(scalePtr, 0, ocDivUnit * UNIT * sizeof(float));
     memcpy(scalePtr, dwConvParam->symmetricQuan()->scale()->data(), outputCount * sizeof(float));
+
+    // The output zero point is added before scale
+    mOutputZeroPoint = dwConvParam->symmetricQuan()->outputZeroPoint();
+    if (0 != mOutputZeroPoint) {
+        for (int dz = 0; dz < outputCount; ++dz) {
+            if (scalePtr[dz] != 0.0f) {
+                biasPtr[dz] += (int32_t)roundf((float)mOutputZeroPoint / scalePtr[dz]);
+            }
+        }
+    }
 }
 
 ErrorCode CPUDepthwiseConvInt8::onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
@@ -225,7 +235,11 @@ ErrorCode CPUDepthwiseConvInt8::onResize(const std::vector<Tensor*>& inputs, con
             }
 
             if (mRelu) {
-                MNNReluInt8(dst_z, dst_z, dst_z_step);
+                if (0 == mOutputZeroPoint) {
+                    MNNReluInt8(dst_z, dst_z, dst_z_step);
+                } else {
+                    MNNInt8ClipInplace(dst_z, dst_z_step, (int8_t)mOutputZeroPoint, 127);
+                }
             }
         }
     };
@@ -259,6 +273,11 @@ class CPUDepthwiseConvInt8Creator : public CPUBackend::Creator {
 public:
     virtual Execution* onCreate(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
                                 const MNN::Op* op, Backend* backend) const override {
+        if (0 != op->main_as_Convolution2D()->symmetricQuan()->inputZeroPoint()) {
+            // Padding is skipped by the kernel, so the input zero point can't be folded into bias
+            MNN_ERROR("DepthwiseConvInt8 don't support input zero point\n");
+            return nullptr;
+        }
         return new CPUDepthwiseConvInt8(backend, op->main_as_Convolution2D());
     }
 };
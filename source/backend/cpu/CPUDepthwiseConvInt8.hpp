@@ -26,6 +26,8 @@ private:
     // int mPadY;
     // relu or relu6
     bool mRelu;
+    // zero point of output for asymmetric quantization
+    int mOutputZeroPoint = 0;
     // True represent the middle accumulator if INT16, Fasle is INT32
     bool mFastMode;
     std::shared_ptr<Tensor> mWeightInt8;
@@ -10,6 +10,7 @@
 #include "backend/cpu/CPUBackend.hpp"
 #include "core/Concurrency.h"
 #include "core/Macro.h"
+#include <math.h>
 
 extern "C" {
 void MNNScaleAddInt8(int8_t* dst, const int8_t* src0, const int8_t* src1, const float* scale0, const float* scale1,
@@ -34,6 +35,7 @@ CPUEltwiseInt8::CPUEltwiseInt8(Backend* backend, const Op* op) : Execution(backe
     copyData(mInput0Scales, param->inputQuan0());
     copyData(mInput1Scales, param->inputQuan1());
     copyData(mOutputScales, param->outputQuan());
+    mIsProd = param->type() == EltwiseType_PROD;
 }
 
 CPUEltwiseInt8::~CPUEltwiseInt8() {
@@ -69,19 +71,30 @@ ErrorCode CPUEltwiseInt8::onExecute(const std::vector<Tensor*>& inputs, const st
             const auto scale1ChannelPtr      = scale1Ptr + tId * 4;
             const auto outputScaleChannelPtr = outputScalePtr + tId * 4;
             auto dstChannelPtr               = dstBatch + tId * oc4Stride * 4;
+            if (mIsProd) {
+                for (int i = 0; i < oc4Stride; ++i) {
+                    for (int k = 0; k < 4; ++k) {
+                        float prod = static_cast<float>(src0ChannelPtr[i * 4 + k]) * scale0ChannelPtr[k] *
+                                     static_cast<float>(src1ChannelPtr[i * 4 + k]) * scale1ChannelPtr[k];
+                        float value              = roundf(prod * outputScaleChannelPtr[k]);
+                        dstChannelPtr[i * 4 + k] = static_cast<int8_t>(std::max(std::min(value, 127.0f), -127.0f));
+                    }
+                }
+            } else {
 #ifdef MNN_USE_NEON
-            MNNScaleAddInt8(dstChannelPtr, src0ChannelPtr, src1ChannelPtr, scale0ChannelPtr, scale1ChannelPtr,
-                            outputScaleChannelPtr, oc4Stride);
+                MNNScaleAddInt8(dstChannelPtr, src0ChannelPtr, src1ChannelPtr, scale0ChannelPtr, scale1ChannelPtr,
+                                outputScaleChannelPtr, oc4Stride);
 #else
-            for (int i = 0; i < oc4Stride; ++i) {
-                for (int k = 0; k < 4; ++k) {
-                    float sum = static_cast<float>(src0ChannelPtr[i * 4 + k]) * scale0ChannelPtr[k] +
-                                static_cast<float>(src1ChannelPtr[i * 4 + k]) * scale1ChannelPtr[k];
-                    float value              = sum * outputScaleChannelPtr[k];
-                    dstChannelPtr[i * 4 + k] = static_cast<int8_t>(std::max(std::min(value, 127.0f), -127.0f));
+                for (int i = 0; i < oc4Stride; ++i) {
+                    for (int k = 0; k < 4; ++k) {
+                        float sum = static_cast<float>(src0ChannelPtr[i * 4 + k]) * scale0ChannelPtr[k] +
+                                    static_cast<float>(src1ChannelPtr[i * 4 + k]) * scale1ChannelPtr[k];
+                        float value              = sum * outputScaleChannelPtr[k];
+                        dstChannelPtr[i * 4 + k] = static_cast<int8_t>(std::max(std::min(value, 127.0f), -127.0f));
+                    }
                 }
-            }
 #endif
+            }
         }
         MNN_CONCURRENCY_END();
     }
@@ -23,6 +23,8 @@ private:
     std::shared_ptr<Tensor> mInput0Scales;
     std::shared_ptr<Tensor> mInput1Scales;
     std::shared_ptr<Tensor> mOutputScales;
+    // SUM or PROD
+    bool mIsProd = false;
 };
 
 } // namespace MNN
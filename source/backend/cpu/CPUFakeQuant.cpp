@@ -0,0 +1,261 @@
+//
+//  CPUFakeQuant.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "backend/cpu/CPUFakeQuant.hpp"
+#include <math.h>
+#include <string.h>
+#include "backend/cpu/CPUBackend.hpp"
+#include "core/Concurrency.h"
+#include "core/Macro.h"
+#include "core/TensorUtils.hpp"
+#ifdef MNN_USE_SSE
+#include <emmintrin.h>
+#endif
+#include "math/Vec.hpp"
+
+// Number of floats computed by one task, should be a multiple of 4
+#define MNN_FAKE_QUANT_PIECE 4096
+
+namespace MNN {
+using Vec4 = Math::Vec<float, 4>;
+
+// Round half away from zero as roundf, |v| should be small enough to be exact in int32
+static inline Vec4 _round(const Vec4& v) {
+#if defined(MNN_USE_NEON) && defined(__aarch64__)
+    Vec4 dst(vrndaq_f32(v.value));
+#elif defined(MNN_USE_NEON)
+    // v - trunc(v) is exact, adding 0.5 before truncating is not
+    auto integer = vcvtq_f32_s32(vcvtq_s32_f32(v.value));
+    auto signOne = vbslq_f32(vcltq_f32(v.value, vdupq_n_f32(0.0f)), vdupq_n_f32(-1.0f), vdupq_n_f32(1.0f));
+    auto half    = vcgeq_f32(vabsq_f32(vsubq_f32(v.value, integer)), vdupq_n_f32(0.5f));
+    Vec4 dst(vaddq_f32(integer, vbslq_f32(half, signOne, vdupq_n_f32(0.0f))));
+#elif defined(MNN_USE_SSE)
+    // Same as above, truncate by cvtt since _mm_round_ps needs SSE4.1
+    auto signMask = _mm_set1_ps(-0.0f);
+    auto integer  = _mm_cvtepi32_ps(_mm_cvttps_epi32(v.value));
+    auto fraction = _mm_andnot_ps(signMask, _mm_sub_ps(v.value, integer));
+    auto signOne  = _mm_or_ps(_mm_and_ps(v.value, signMask), _mm_set1_ps(1.0f));
+    Vec4 dst(_mm_add_ps(integer, _mm_and_ps(_mm_cmpge_ps(fraction, _mm_set1_ps(0.5f)), signOne)));
+#else
+    Vec4 dst;
+    for (int i = 0; i < 4; ++i) {
+        dst.value[i] = roundf(v.value[i]);
+    }
+#endif
+    return dst;
+}
+
+// 1.0f if -limit <= v <= limit else 0.0f
+static inline Vec4 _inside(const Vec4& v, float limit) {
+#ifdef MNN_USE_NEON
+    auto mask = vcaleq_f32(v.value, vdupq_n_f32(limit));
+    Vec4 dst(vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+#elif defined(MNN_USE_SSE)
+    auto absV = _mm_andnot_ps(_mm_set1_ps(-0.0f), v.value);
+    Vec4 dst(_mm_and_ps(_mm_cmple_ps(absV, _mm_set1_ps(limit)), _mm_set1_ps(1.0f)));
+#else
+    Vec4 dst;
+    for (int i = 0; i < 4; ++i) {
+        dst.value[i] = fabsf(v.value[i]) <= limit ? 1.0f : 0.0f;
+    }
+#endif
+    return dst;
+}
+
+static void _fakeQuant(float* dst, const float* src, int size, const float* scale, const float* invScale,
+                       float limit) {
+    auto s        = Vec4::load(scale);
+    auto inv      = Vec4::load(invScale);
+    auto maxValue = Vec4(limit);
+    auto minValue = Vec4(-limit);
+    int count     = size / 4;
+    for (int i = 0; i < count; ++i) {
+        auto v = Vec4::min(Vec4::max(Vec4::load(src + 4 * i) * inv, minValue), maxValue);
+        Vec4::save(dst + 4 * i, _round(v) * s);
+    }
+    // The remain only occurs when all lanes share the scale
+    for (int i = count * 4; i < size; ++i) {
+        auto v = fminf(fmaxf(src[i] * invScale[0], -limit), limit);
+        dst[i] = roundf(v) * scale[0];
+    }
+}
+
+static void _fakeQuantGrad(float* dx, float* scaleGrad, const float* src, const float* dy, int size,
+                           const float* invScale, float limit) {
+    auto inv      = Vec4::load(invScale);
+    auto maxValue = Vec4(limit);
+    auto minValue = Vec4(-limit);
+    auto sum      = Vec4(0.0f);
+    int count     = size / 4;
+    for (int i = 0; i < count; ++i) {
+        auto v      = Vec4::load(src + 4 * i) * inv;
+        auto mask   = _inside(v, limit);
+        auto q      = _round(Vec4::min(Vec4::max(v, minValue), maxValue));
+        auto diff   = Vec4::load(dy + 4 * i);
+        Vec4::save(dx + 4 * i, diff * mask);
+        sum = sum + diff * (q - v * mask);
+    }
+    Vec4::save(scaleGrad, sum);
+    for (int i = count * 4; i < size; ++i) {
+        auto v = src[i] * invScale[0];
+        auto q = roundf(fminf(fmaxf(v, -limit), limit));
+        if (fabsf(v) <= limit) {
+            dx[i] = dy[i];
+            scaleGrad[0] += dy[i] * (q - v);
+        } else {
+            dx[i] = 0.0f;
+            scaleGrad[0] += dy[i] * q;
+        }
+    }
+}
+
+CPUFakeQuant::CPUFakeQuant(Backend* backend, int bits, bool grad) : Execution(backend), mGrad(grad) {
+    mLimit = (float)(1 << (bits - 1)) - 1.0f;
+}
+
+ErrorCode CPUFakeQuant::onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    auto x     = inputs[0];
+    auto scale = inputs[1];
+    mPack      = TensorUtils::getDescribe(x)->dimensionFormat == MNN_DATA_FORMAT_NC4HW4;
+    int axis   = -1;
+    if (scale->elementSize() > 1) {
+        for (int i = 0; i < scale->dimensions(); ++i) {
+            if (scale->length(i) != 1) {
+                axis = i;
+            }
+        }
+    }
+    int outside = 1;
+    int span    = 1;
+    if (mPack) {
+        // The pieces are split by channel groups, so the padded lanes can be left out of the scale grad
+        MNN_ASSERT(axis < 0 || 1 == axis);
+        mPackChannel = x->length(1);
+        mChannel     = axis < 0 ? 1 : mPackChannel;
+        mGroupNumber = UP_DIV(mPackChannel, 4);
+        outside      = x->length(0);
+        span         = 4;
+        for (int i = 2; i < x->dimensions(); ++i) {
+            span *= x->length(i);
+        }
+    } else if (axis < 0) {
+        mChannel     = 1;
+        mGroupNumber = 1;
+        span         = x->elementSize();
+    } else {
+        mChannel     = x->length(axis);
+        mGroupNumber = mChannel;
+        for (int i = 0; i < axis; ++i) {
+            outside *= x->length(i);
+        }
+        for (int i = axis + 1; i < x->dimensions(); ++i) {
+            span *= x->length(i);
+        }
+    }
+    mPieces.clear();
+    for (int o = 0; o < outside; ++o) {
+        for (int g = 0; g < mGroupNumber; ++g) {
+            int offset = (o * mGroupNumber + g) * span;
+            for (int p = 0; p < span; p += MNN_FAKE_QUANT_PIECE) {
+                mPieces.emplace_back(Piece{offset + p, ALIMIN(span - p, MNN_FAKE_QUANT_PIECE), g});
+            }
+        }
+    }
+    mScale.resize(mGroupNumber * 4);
+    mInvScale.resize(mGroupNumber * 4);
+    if (mGrad) {
+        mScaleGrad.resize(mPieces.size() * 4);
+    }
+    return NO_ERROR;
+}
+
+ErrorCode CPUFakeQuant::onExecute(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    auto x        = inputs[0];
+    auto scalePtr = inputs[1]->host<float>();
+    for (int i = 0; i < mGroupNumber * 4; ++i) {
+        float s = scalePtr[0];
+        if (mChannel > 1) {
+            if (mPack) {
+                s = i < mChannel ? scalePtr[i] : 1.0f;
+            } else {
+                s = scalePtr[i / 4];
+            }
+        }
+        mScale[i]    = s;
+        mInvScale[i] = 1.0f / s;
+    }
+    auto srcPtr       = x->host<float>();
+    auto numberThread = ((CPUBackend*)backend())->threadNumber();
+    int pieceNumber   = (int)mPieces.size();
+    if (!mGrad) {
+        auto dstPtr = outputs[0]->host<float>();
+        MNN_CONCURRENCY_BEGIN(tId, numberThread) {
+            for (int i = (int)tId; i < pieceNumber; i += numberThread) {
+                auto& piece = mPieces[i];
+                _fakeQuant(dstPtr + piece.offset, srcPtr + piece.offset, piece.size, mScale.data() + 4 * piece.group,
+                           mInvScale.data() + 4 * piece.group, mLimit);
+            }
+        }
+        MNN_CONCURRENCY_END();
+        return NO_ERROR;
+    }
+    auto diffPtr = inputs[2]->host<float>();
+    auto dxPtr   = outputs[0]->host<float>();
+    MNN_CONCURRENCY_BEGIN(tId, numberThread) {
+        for (int i = (int)tId; i < pieceNumber; i += numberThread) {
+            auto& piece = mPieces[i];
+            _fakeQuantGrad(dxPtr + piece.offset, mScaleGrad.data() + 4 * i, srcPtr + piece.offset,
+                           diffPtr + piece.offset, piece.size, mInvScale.data() + 4 * piece.group, mLimit);
+        }
+    }
+    MNN_CONCURRENCY_END();
+    auto scaleGrad = outputs[1];
+    auto dsPtr     = scaleGrad->host<float>();
+    ::memset(dsPtr, 0, scaleGrad->elementSize() * sizeof(float));
+    for (int i = 0; i < pieceNumber; ++i) {
+        auto group = mPieces[i].group;
+        for (int j = 0; j < 4; ++j) {
+            if (mPack && group * 4 + j >= mPackChannel) {
+                // Padded channel of NC4HW4
+                continue;
+            }
+            int channel = 0;
+            if (mChannel > 1) {
+                channel = mPack ? group * 4 + j : group;
+            }
+            dsPtr[channel] += mScaleGrad[4 * i + j];
+        }
+    }
+    // elementSize of NC4HW4 contains the padding of channel
+    int size = 1;
+    for (int i = 0; i < x->dimensions(); ++i) {
+        size *= x->length(i);
+    }
+    float gradScale = 1.0f / sqrtf((float)(size / scaleGrad->elementSize()) * mLimit);
+    for (int i = 0; i < scaleGrad->elementSize(); ++i) {
+        dsPtr[i] *= gradScale;
+    }
+    return NO_ERROR;
+}
+
+class CPUFakeQuantCreator : public CPUBackend::Creator {
+public:
+    virtual Execution* onCreate(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
+                                const MNN::Op* op, Backend* backend) const override {
+        int bits   = 8;
+        auto param = op->main_as_QuantizedFloatParam();
+        if (nullptr != param) {
+            bits = param->nbits();
+        }
+        return new CPUFakeQuant(backend, bits, op->type() == OpType_FakeQuantGrad);
+    }
+};
+
+REGISTER_CPU_OP_CREATOR(CPUFakeQuantCreator, OpType_FakeQuant);
+REGISTER_CPU_OP_CREATOR(CPUFakeQuantCreator, OpType_FakeQuantGrad);
+} // namespace MNN
@@ -0,0 +1,53 @@
+//
+//  CPUFakeQuant.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef CPUFakeQuant_hpp
+#define CPUFakeQuant_hpp
+
+#include "backend/cpu/CPUBackend.hpp"
+
+namespace MNN {
+/**
+ FakeQuant: y = clamp(round(x / s), -limit, limit) * s
+ FakeQuantGrad: inputs are x, s and dy, outputs are
+    dx = dy if -limit <= x / s <= limit else 0 (straight-through estimator)
+    ds = sum(dy * (round(v) - v if -limit <= v <= limit else clamp(v))) * g, v = x / s
+ in which g = 1 / sqrt(n * limit) is the gradient scale of LSQ, n is the number of elements sharing one scale.
+ The scale is a scalar or per channel of one axis. x is split into pieces sharing the scales of 4 lanes, for NC4HW4
+ the lanes are 4 channels, whose padding is not counted in ds, otherwise they are the same channel.
+ */
+class CPUFakeQuant : public Execution {
+public:
+    CPUFakeQuant(Backend* backend, int bits, bool grad);
+    virtual ~CPUFakeQuant() = default;
+    virtual ErrorCode onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) override;
+    virtual ErrorCode onExecute(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) override;
+
+private:
+    struct Piece {
+        int offset;
+        int size;
+        int group;
+    };
+    float mLimit;
+    bool mGrad;
+    bool mPack = false;
+    int mChannel = 1;
+    int mGroupNumber = 1;
+    // The channel of NC4HW4 input, the lanes beyond it are padding
+    int mPackChannel = 0;
+    std::vector<Piece> mPieces;
+    // The scales and reciprocals of 4 lanes for each group
+    std::vector<float> mScale;
+    std::vector<float> mInvScale;
+    // The sums of scale grad of 4 lanes for each piece
+    std::vector<float> mScaleGrad;
+};
+} // namespace MNN
+
+#endif /* CPUFakeQuant_hpp */
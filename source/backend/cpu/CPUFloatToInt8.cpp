@@ -18,6 +18,7 @@ CPUFloatToInt8::CPUFloatToInt8(Backend* backend, const MNN::Op* param) : Executi
     auto scale         = param->main_as_QuantizedFloatParam();
     const int scaleLen = scale->tensorScale()->size();
     mClipBits = scale->nbits();
+    mZeroPoint = scale->outputZeroPoint();
     mScales.reset(Tensor::createDevice<float>({ALIGN_UP4(scaleLen)}));
     mValid = backend->onAcquireBuffer(mScales.get(), Backend::STATIC);
     if (!mValid) {
@@ -61,7 +62,12 @@ ErrorCode CPUFloatToInt8::onExecute(const std::vector<Tensor*>& inputs, const st
                 const auto srcChannelPtr   = srcBatch + z * oc4Stride * 4;
                 const auto scaleChannelPtr = scaleDataPtr + z * 4;
                 auto dstChannlePtr         = dstBatch + z * oc4Stride * 4;
-                MNNFloat2Int8(srcChannelPtr, dstChannlePtr, oc4Stride, scaleChannelPtr, minVal, maxVal);
+                if (0 == mZeroPoint) {
+                    MNNFloat2Int8(srcChannelPtr, dstChannlePtr, oc4Stride, scaleChannelPtr, minVal, maxVal);
+                } else {
+                    MNNFloat2Int8WithZero(srcChannelPtr, dstChannlePtr, oc4Stride, scaleChannelPtr, minVal, maxVal,
+                                          mZeroPoint);
+                }
             }
         }
         MNN_CONCURRENCY_END();
@@ -9,6 +9,7 @@
 #include "backend/cpu/CPUInt8ToFloat.hpp"
 #include "backend/cpu/CPUBackend.hpp"
 #include "core/Concurrency.h"
+#include "backend/cpu/compute/Int8FunctionsOpt.h"
 #include "core/Macro.h"
 
 extern "C" {
@@ -20,6 +21,7 @@ namespace MNN {
 CPUInt8ToFloat::CPUInt8ToFloat(Backend* backend, const MNN::Op* param) : Execution(backend) {
     auto scale         = param->main_as_QuantizedFloatParam();
     const int scaleLen = scale->tensorScale()->size();
+    mZeroPoint         = scale->inputZeroPoint();
     mScales.reset(Tensor::createDevice<float>({ALIGN_UP4(scaleLen)}));
     mValid = backend->onAcquireBuffer(mScales.get(), Backend::STATIC);
     if (!mValid) {
@@ -55,18 +57,21 @@ ErrorCode CPUInt8ToFloat::onExecute(const std::vector<Tensor*>& inputs, const st
             const auto srcChannelPtr   = srcBatch + tId * oc4Stride * 4;
             const auto scaleChannelPtr = scaleDataPtr + tId * 4;
             auto dstChannlePtr         = dstBatch + tId * oc4Stride * 4;
-
+            if (0 != mZeroPoint) {
+                MNNInt8ScaleToFloatWithZero(dstChannlePtr, srcChannelPtr, scaleChannelPtr, oc4Stride, mZeroPoint);
+            } else {
 #ifdef MNN_USE_NEON
-            MNNInt8ScaleToFloat(dstChannlePtr, srcChannelPtr, scaleChannelPtr, oc4Stride);
+                MNNInt8ScaleToFloat(dstChannlePtr, srcChannelPtr, scaleChannelPtr, oc4Stride);
 #else
-            for (int i = 0; i < oc4Stride; ++i) {
-                const auto srcStart = srcChannelPtr + i * 4;
-                auto dstStart       = dstChannlePtr + i * 4;
-                for (int j = 0; j < 4; ++j) {
-                    dstStart[j] = static_cast<float>(srcStart[j]) * scaleChannelPtr[j];
+                for (int i = 0; i < oc4Stride; ++i) {
+                    const auto srcStart = srcChannelPtr + i * 4;
+                    auto dstStart       = dstChannlePtr + i * 4;
+                    for (int j = 0; j < 4; ++j) {
+                        dstStart[j] = static_cast<float>(srcStart[j]) * scaleChannelPtr[j];
+                    }
                 }
-            }
 #endif
+            }
         }
         MNN_CONCURRENCY_END();
     }
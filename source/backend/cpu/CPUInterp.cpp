@@ -43,6 +43,11 @@ ErrorCode CPUInterp::onExecute(const std::vector<Tensor *> &inputs, const std::v
     if (mResizeType == 1) {
         // Nearstneighbor
         CPUResizeNearestneighborC4(input, output, mWidthScale, mHeightScale, mWidthOffset, mHeightOffset);
+    } else if (mResizeType == 2 && 1 == input.type.bytes()) {
+        // bilinear, int8
+        CPUResizeBilinearC4Int8(input, output, mWidthPosition.host<int>(), mWidthFactor.host<float>(),
+                                mHeightPosition.host<int>(), mHeightFactor.host<float>(),
+                                ((CPUBackend *)backend())->threadNumber());
     } else if (mResizeType == 2) {
         // bilinear
         CPUResizeBilinearC4(input, output, mWidthPosition.host<int>(), mWidthFactor.host<float>(),
@@ -147,6 +152,10 @@ public:
     virtual Execution *onCreate(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
                                 const MNN::Op *op, Backend *backend) const {
         auto interp = op->main_as_Interp();
+        if (inputs[0]->getType() == halide_type_of<int8_t>() && interp->resizeType() == 3) {
+            MNN_ERROR("Don't support int8 cubic interp\n");
+            return nullptr;
+        }
         return new CPUInterp(backend, interp->resizeType(),
                    interp->widthScale(), interp->heightScale(), interp->widthOffset(), interp->heightOffset());
     }
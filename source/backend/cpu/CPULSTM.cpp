@@ -0,0 +1,289 @@
+//
+//  CPULSTM.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/03.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "backend/cpu/CPULSTM.hpp"
+#include <math.h>
+#include <string.h>
+#include <limits>
+#include "backend/cpu/CPUBackend.hpp"
+#include "backend/cpu/compute/CommonOptFunction.h"
+#include "core/Concurrency.h"
+#include "core/Macro.h"
+#include "core/TensorUtils.hpp"
+#include "math/Vec.hpp"
+using Vec4 = MNN::Math::Vec<float, 4>;
+
+namespace MNN {
+
+static inline float _sigmoid(float x) {
+    return 1.0f / (1.0f + expf(-x));
+}
+
+// Compute 4 hidden units of one batch for one timestep
+// gate: C4 layout of input projection, weight: packed R of the unit block
+static void _lstmUnitC4(float* hiddenDst, float* cell, const float* hiddenSrc, const float* gate, const float* weight,
+                        int gateCol, int gateRow, int gateArea, int hidden, int unitStart) {
+    float gateValue[16];
+    for (int g = 0; g < 4; ++g) {
+        for (int x = 0; x < 4; ++x) {
+            auto unit = unitStart + x;
+            if (unit >= hidden) {
+                gateValue[4 * g + x] = 0.0f;
+                continue;
+            }
+            auto col             = gateCol + g * hidden + unit;
+            gateValue[4 * g + x] = gate[((col / 4) * gateArea + gateRow) * 4 + (col % 4)];
+        }
+    }
+    auto s0 = Vec4::load(gateValue + 0);
+    auto s1 = Vec4::load(gateValue + 4);
+    auto s2 = Vec4::load(gateValue + 8);
+    auto s3 = Vec4::load(gateValue + 12);
+    for (int k = 0; k < hidden; ++k) {
+        Vec4 h(hiddenSrc[k]);
+        auto w = weight + 16 * k;
+        s0     = s0 + h * Vec4::load(w + 0);
+        s1     = s1 + h * Vec4::load(w + 4);
+        s2     = s2 + h * Vec4::load(w + 8);
+        s3     = s3 + h * Vec4::load(w + 12);
+    }
+    Vec4::save(gateValue + 0, s0);
+    Vec4::save(gateValue + 4, s1);
+    Vec4::save(gateValue + 8, s2);
+    Vec4::save(gateValue + 12, s3);
+    for (int x = 0; x < 4; ++x) {
+        auto unit = unitStart + x;
+        if (unit >= hidden) {
+            hiddenDst[unit] = 0.0f;
+            cell[unit]      = 0.0f;
+            continue;
+        }
+        auto i          = _sigmoid(gateValue[x]);
+        auto o          = _sigmoid(gateValue[4 + x]);
+        auto f          = _sigmoid(gateValue[8 + x]);
+        auto c          = tanhf(gateValue[12 + x]);
+        auto newCell    = f * cell[unit] + i * c;
+        cell[unit]      = newCell;
+        hiddenDst[unit] = o * tanhf(newCell);
+    }
+}
+
+CPULSTM::CPULSTM(Backend* backend, bool keepState) : Execution(backend), mKeepState(keepState) {
+    mComputer.reset(new StrassenMatrixComputor(backend, true, 5));
+}
+
+CPULSTM::~CPULSTM() {
+    for (auto t : {mWeightI, mBias, mWeightR, mHidden, mCell}) {
+        if (nullptr != t) {
+            backend()->onReleaseBuffer(t.get(), Backend::STATIC);
+        }
+    }
+}
+
+void CPULSTM::_packWeight(const Tensor* W, const Tensor* R, const Tensor* B) {
+    auto hidden = mHiddenSize;
+    auto gates  = 4 * hidden * mDirections;
+    MNNPackForMatMul_B(mWeightI->host<float>(), W->host<float>(), gates, mInputSize, true);
+
+    auto biasPtr = mBias->host<float>();
+    ::memset(biasPtr, 0, mBias->size());
+    if (nullptr != B) {
+        ::memcpy(biasPtr, B->host<float>(), gates * sizeof(float));
+    }
+
+    // R: [directions, 4 * hidden, hidden] -> [directions, hiddenC4, hidden, 4 (gate), 4 (unit)]
+    auto hiddenC4 = UP_DIV(hidden, 4);
+    auto dst      = mWeightR->host<float>();
+    auto src      = R->host<float>();
+    ::memset(dst, 0, mWeightR->size());
+    for (int d = 0; d < mDirections; ++d) {
+        auto srcD = src + d * 4 * hidden * hidden;
+        auto dstD = dst + d * hiddenC4 * hidden * 16;
+        for (int u = 0; u < hiddenC4; ++u) {
+            for (int k = 0; k < hidden; ++k) {
+                auto dstK = dstD + (u * hidden + k) * 16;
+                for (int g = 0; g < 4; ++g) {
+                    for (int x = 0; x < 4 && u * 4 + x < hidden; ++x) {
+                        dstK[4 * g + x] = srcD[(g * hidden + u * 4 + x) * hidden + k];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CPULSTM::_resetState(const std::vector<Tensor*>& inputs) {
+    auto hiddenC4 = UP_DIV(mHiddenSize, 4);
+    ::memset(mHidden->host<float>(), 0, mHidden->size());
+    ::memset(mCell->host<float>(), 0, mCell->size());
+    auto copyInit = [&](Tensor* dst, const Tensor* src) {
+        if (nullptr == src || src->elementSize() != mDirections * mBatch * mHiddenSize) {
+            return;
+        }
+        for (int i = 0; i < mDirections * mBatch; ++i) {
+            ::memcpy(dst->host<float>() + i * hiddenC4 * 4, src->host<float>() + i * mHiddenSize,
+                     mHiddenSize * sizeof(float));
+        }
+    };
+    copyInit(mHidden.get(), inputs.size() > 4 ? inputs[4] : nullptr);
+    copyInit(mCell.get(), inputs.size() > 5 ? inputs[5] : nullptr);
+}
+
+ErrorCode CPULSTM::onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    auto X      = inputs[0];
+    auto W      = inputs[1];
+    auto R      = inputs[2];
+    mSeqLength  = X->length(0);
+    mBatch      = X->length(1);
+    mInputSize  = X->length(2);
+    mDirections = W->length(0);
+    mHiddenSize = R->length(2);
+    auto gates    = 4 * mHiddenSize * mDirections;
+    auto hiddenC4 = UP_DIV(mHiddenSize, 4);
+    int eP, lP, hP;
+    MNNGetMatMulPackMode(&eP, &lP, &hP);
+    if (nullptr == mWeightI) {
+        mWeightI.reset(Tensor::createDevice<float>({UP_DIV(gates, hP), mInputSize, hP}));
+        mBias.reset(Tensor::createDevice<float>({UP_DIV(gates, 4) * 4}));
+        mWeightR.reset(Tensor::createDevice<float>({mDirections, hiddenC4, mHiddenSize, 16}));
+        for (auto t : {mWeightI, mBias, mWeightR}) {
+            if (!backend()->onAcquireBuffer(t.get(), Backend::STATIC)) {
+                return OUT_OF_MEMORY;
+            }
+        }
+    }
+    mWeightPacked = false;
+    mConstWeight  = true;
+    for (int i = 1; i < 4 && i < inputs.size(); ++i) {
+        mConstWeight = mConstWeight && TensorUtils::getDescribe(inputs[i])->usage == Tensor::InsideDescribe::Usage::CONSTANT;
+    }
+
+    // The state must not be overwritten by other executions between two runs, so use static memory
+    for (auto t : {mHidden, mCell}) {
+        if (nullptr != t) {
+            backend()->onReleaseBuffer(t.get(), Backend::STATIC);
+        }
+    }
+    mHidden.reset(Tensor::createDevice<float>({mDirections, mBatch, hiddenC4 * 4}));
+    mCell.reset(Tensor::createDevice<float>({mDirections, mBatch, hiddenC4 * 4}));
+    if (!backend()->onAcquireBuffer(mHidden.get(), Backend::STATIC) ||
+        !backend()->onAcquireBuffer(mCell.get(), Backend::STATIC)) {
+        return OUT_OF_MEMORY;
+    }
+    mNeedResetState = true;
+
+    auto area = mSeqLength * mBatch;
+    mInputPack.reset(Tensor::createDevice<float>({UP_DIV(mInputSize, 4), area, 4}));
+    mGate.reset(Tensor::createDevice<float>({UP_DIV(gates, 4), area, 4}));
+    mHiddenNext.reset(Tensor::createDevice<float>({mBatch, hiddenC4 * 4}));
+    bool res = backend()->onAcquireBuffer(mInputPack.get(), Backend::DYNAMIC);
+    res      = res && backend()->onAcquireBuffer(mGate.get(), Backend::DYNAMIC);
+    res      = res && backend()->onAcquireBuffer(mHiddenNext.get(), Backend::DYNAMIC);
+    if (!res) {
+        return OUT_OF_MEMORY;
+    }
+    std::vector<float> postParameters = {
+        1.0f,
+        1.0f,
+        -std::numeric_limits<float>().max(),
+        std::numeric_limits<float>().max(),
+    };
+    mComputer->onReset();
+    auto code = mComputer->onEncode({mInputPack.get(), mWeightI.get(), mBias.get()}, {mGate.get()}, postParameters);
+    if (NO_ERROR != code) {
+        return code;
+    }
+    backend()->onReleaseBuffer(mInputPack.get(), Backend::DYNAMIC);
+    backend()->onReleaseBuffer(mGate.get(), Backend::DYNAMIC);
+    backend()->onReleaseBuffer(mHiddenNext.get(), Backend::DYNAMIC);
+    return NO_ERROR;
+}
+
+ErrorCode CPULSTM::onExecute(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    if (!mWeightPacked || !mConstWeight) {
+        _packWeight(inputs[1], inputs[2], inputs.size() > 3 ? inputs[3] : nullptr);
+        mWeightPacked = true;
+    }
+    if (mNeedResetState || !mKeepState) {
+        _resetState(inputs);
+        mNeedResetState = false;
+    }
+    auto area     = mSeqLength * mBatch;
+    auto hidden   = mHiddenSize;
+    auto hiddenC4 = UP_DIV(hidden, 4);
+    // X: [seq * batch, input] -> [inputC4, seq * batch, 4]
+    {
+        auto src = inputs[0]->host<float>();
+        auto dst = mInputPack->host<float>();
+        ::memset(dst, 0, mInputPack->size());
+        for (int r = 0; r < area; ++r) {
+            auto srcR = src + r * mInputSize;
+            for (int k = 0; k < mInputSize; ++k) {
+                dst[((k / 4) * area + r) * 4 + (k % 4)] = srcR[k];
+            }
+        }
+    }
+    // Input projection of all timesteps and directions
+    mComputer->onExecute();
+
+    auto Y           = outputs[0];
+    auto yPtr        = Y->host<float>();
+    auto gatePtr     = mGate->host<float>();
+    auto nextPtr     = mHiddenNext->host<float>();
+    int numberThread = ((CPUBackend*)backend())->threadNumber();
+    for (int d = 0; d < mDirections; ++d) {
+        auto weight   = mWeightR->host<float>() + d * hiddenC4 * hidden * 16;
+        auto hiddenD  = mHidden->host<float>() + d * mBatch * hiddenC4 * 4;
+        auto cellD    = mCell->host<float>() + d * mBatch * hiddenC4 * 4;
+        auto gateCol  = d * 4 * hidden;
+        for (int step = 0; step < mSeqLength; ++step) {
+            int t = d == 0 ? step : mSeqLength - 1 - step;
+            MNN_CONCURRENCY_BEGIN(tId, numberThread) {
+                for (int u = (int)tId; u < hiddenC4; u += numberThread) {
+                    for (int b = 0; b < mBatch; ++b) {
+                        _lstmUnitC4(nextPtr + b * hiddenC4 * 4, cellD + b * hiddenC4 * 4, hiddenD + b * hiddenC4 * 4,
+                                    gatePtr, weight + u * hidden * 16, gateCol, t * mBatch + b, area, hidden, u * 4);
+                    }
+                }
+            }
+            MNN_CONCURRENCY_END();
+            ::memcpy(hiddenD, nextPtr, mBatch * hiddenC4 * 4 * sizeof(float));
+            // Y: [seq, directions, batch, hidden]
+            for (int b = 0; b < mBatch; ++b) {
+                ::memcpy(yPtr + ((t * mDirections + d) * mBatch + b) * hidden, hiddenD + b * hiddenC4 * 4,
+                         hidden * sizeof(float));
+            }
+        }
+    }
+    // Y_h, Y_c: [directions, batch, hidden]
+    for (int i = 1; i < outputs.size() && i < 3; ++i) {
+        auto src = i == 1 ? mHidden->host<float>() : mCell->host<float>();
+        auto dst = outputs[i]->host<float>();
+        for (int j = 0; j < mDirections * mBatch; ++j) {
+            ::memcpy(dst + j * hidden, src + j * hiddenC4 * 4, hidden * sizeof(float));
+        }
+    }
+    return NO_ERROR;
+}
+
+class CPULSTMCreator : public CPUBackend::Creator {
+public:
+    virtual Execution* onCreate(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
+                                const MNN::Op* op, Backend* backend) const override {
+        if (inputs.size() < 4) {
+            // Old version's Caffe LSTM is computed by geometry
+            return nullptr;
+        }
+        auto lstm = op->main_as_LSTM();
+        return new CPULSTM(backend, nullptr != lstm && lstm->keepState());
+    }
+};
+
+REGISTER_CPU_OP_CREATOR(CPULSTMCreator, OpType_LSTM);
+
+} // namespace MNN
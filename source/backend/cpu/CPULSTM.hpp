@@ -0,0 +1,59 @@
+//
+//  CPULSTM.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/03.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef CPULSTM_hpp
+#define CPULSTM_hpp
+
+#include "core/Execution.hpp"
+#include "backend/cpu/compute/StrassenMatmulComputor.hpp"
+
+namespace MNN {
+
+/** Onnx's LSTM: inputs X, W, R, B, [initial_h, initial_c], outputs Y, [Y_h, Y_c], gates order is IOFC.
+    The input projection of all timesteps and directions is computed by one GEMM, the recurrent weight
+    is packed for the per-timestep GEMV. If keepState, the hidden / cell state are kept between executions
+    and only reset by onResize, so that a stream can be feed frame by frame. */
+class CPULSTM : public Execution {
+public:
+    CPULSTM(Backend *backend, bool keepState);
+    virtual ~CPULSTM();
+    virtual ErrorCode onResize(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+    virtual ErrorCode onExecute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+private:
+    void _packWeight(const Tensor *W, const Tensor *R, const Tensor *B);
+    void _resetState(const std::vector<Tensor *> &inputs);
+
+    bool mKeepState;
+    bool mNeedResetState = true;
+    bool mWeightPacked   = false;
+    bool mConstWeight    = false;
+    int mSeqLength       = 0;
+    int mBatch           = 0;
+    int mInputSize       = 0;
+    int mHiddenSize      = 0;
+    int mDirections      = 0;
+
+    // W packed for StrassenMatrixComputor and the padded bias
+    std::shared_ptr<Tensor> mWeightI;
+    std::shared_ptr<Tensor> mBias;
+    // R packed as [directions, UP_DIV(hidden, 4), hidden, 4 (gate), 4 (unit)]
+    std::shared_ptr<Tensor> mWeightR;
+    // State, [directions, batch, UP_DIV(hidden, 4) * 4]
+    std::shared_ptr<Tensor> mHidden;
+    std::shared_ptr<Tensor> mCell;
+    std::shared_ptr<Tensor> mHiddenNext;
+    // X packed as [UP_DIV(input, 4), seq * batch, 4], Gate: [UP_DIV(directions * 4 * hidden, 4), seq * batch, 4]
+    std::shared_ptr<Tensor> mInputPack;
+    std::shared_ptr<Tensor> mGate;
+    std::shared_ptr<StrassenMatrixComputor> mComputer;
+};
+
+} // namespace MNN
+
+#endif /* CPULSTM_hpp */
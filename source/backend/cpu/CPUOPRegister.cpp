@@ -63,6 +63,7 @@ extern void ___CPUTFQuantizedConv2DCreator__OpType_TfQuantizedConv2D__();
 extern void ___CPUQuantizedAvgPoolCreator__OpType_QuantizedAvgPool__();
 extern void ___ConvolutionFactory__OpType_Convolution__();
 extern void ___CPURNNSequenceGRUCreator__OpType_RNNSequenceGRU__();
+extern void ___CPULSTMCreator__OpType_LSTM__();
 extern void ___CPUEltwiseCreator__OpType_Eltwise__();
 extern void ___CPUAsStringCreator__OpType_AsString__();
 extern void ___CPURandomUniformCreator__OpType_RandomUniform__();
@@ -72,6 +73,9 @@ extern void ___CPUPriorBoxCreator__OpType_PriorBox__();
 extern void ___CPUEltwiseInt8Creator__OpType_EltwiseInt8__();
 extern void ___CPUBatchMatMulCreator__OpType_BatchMatMul__();
 extern void ___CPULayerNormCreator__OpType_LayerNorm__();
+extern void ___CPUConv2DBackPropFilterCreator__OpType_Conv2DBackPropFilter__();
+extern void ___CPUFakeQuantCreator__OpType_FakeQuant__();
+extern void ___CPUFakeQuantCreator__OpType_FakeQuantGrad__();
 
 void registerCPUOps() {
 ___CPUCropAndResizeCreator__OpType_CropAndResize__();
@@ -137,6 +141,7 @@ ___CPUTFQuantizedConv2DCreator__OpType_TfQuantizedConv2D__();
 ___CPUQuantizedAvgPoolCreator__OpType_QuantizedAvgPool__();
 ___ConvolutionFactory__OpType_Convolution__();
 ___CPURNNSequenceGRUCreator__OpType_RNNSequenceGRU__();
+___CPULSTMCreator__OpType_LSTM__();
 ___CPUEltwiseCreator__OpType_Eltwise__();
 ___CPUAsStringCreator__OpType_AsString__();
 ___CPURandomUniformCreator__OpType_RandomUniform__();
@@ -146,5 +151,8 @@ ___CPUPriorBoxCreator__OpType_PriorBox__();
 ___CPUEltwiseInt8Creator__OpType_EltwiseInt8__();
 ___CPUBatchMatMulCreator__OpType_BatchMatMul__();
 ___CPULayerNormCreator__OpType_LayerNorm__();
+___CPUConv2DBackPropFilterCreator__OpType_Conv2DBackPropFilter__();
+___CPUFakeQuantCreator__OpType_FakeQuant__();
+___CPUFakeQuantCreator__OpType_FakeQuantGrad__();
 }
 }
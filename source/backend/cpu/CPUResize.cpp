@@ -214,6 +214,46 @@ void CPUResizeCommon::CPUResizeBilinearC4(halide_buffer_t& input, halide_buffer_
     }
 }
 
+void CPUResizeCommon::CPUResizeBilinearC4Int8(halide_buffer_t& input, halide_buffer_t& output,
+                                              const int* widthPosition, const float* widthFactor,
+                                              const int* heightPosition, const float* heightFactor, int threadNumber) {
+    const int batches         = input.dim[0].extent;
+    const int inputBatchSize  = input.dim[0].stride;
+    const int outputBatchSize = output.dim[0].stride;
+    const int inW             = input.dim[3].extent;
+    const int inH             = input.dim[2].extent;
+    const int outW            = output.dim[3].extent;
+    const int outH            = output.dim[2].extent;
+    const int depthQuad       = UP_DIV(input.dim[1].extent, 4);
+
+    for (int b = 0; b < batches; ++b) {
+        MNN_CONCURRENCY_BEGIN(tId, threadNumber) {
+            for (int n = (int)tId; n < depthQuad; n += threadNumber) {
+                auto bottomData = reinterpret_cast<const int8_t*>(input.host) + b * inputBatchSize + n * 4 * inW * inH;
+                auto topData    = reinterpret_cast<int8_t*>(output.host) + b * outputBatchSize + n * 4 * outW * outH;
+                for (int dy = 0; dy < outH; ++dy) {
+                    auto line0   = bottomData + heightPosition[2 * dy + 0] * inW * 4;
+                    auto line1   = bottomData + heightPosition[2 * dy + 1] * inW * 4;
+                    float fy     = heightFactor[dy];
+                    auto topY    = topData + outW * 4 * dy;
+                    for (int dx = 0; dx < outW; ++dx) {
+                        int x0   = widthPosition[2 * dx + 0] * 4;
+                        int x1   = widthPosition[2 * dx + 1] * 4;
+                        float fx = widthFactor[dx];
+                        for (int k = 0; k < 4; ++k) {
+                            float top    = (float)line0[x0 + k] * (1.0f - fx) + (float)line0[x1 + k] * fx;
+                            float bottom = (float)line1[x0 + k] * (1.0f - fx) + (float)line1[x1 + k] * fx;
+                            // Same scale for input and output, the result is always in int8 range
+                            topY[4 * dx + k] = (int8_t)roundf(top * (1.0f - fy) + bottom * fy);
+                        }
+                    }
+                }
+            }
+        }
+        MNN_CONCURRENCY_END();
+    }
+}
+
 void CPUResizeCommon::CPUResizeNearestneighborRoundC4(halide_buffer_t &input, halide_buffer_t &output, float wScale, float hScale, float wOffset, float hOffset) {
     const int batches         = input.dim[0].extent;
     const int inputBatchSize  = input.dim[0].stride;
@@ -225,6 +265,7 @@ void CPUResizeCommon::CPUResizeNearestneighborRoundC4(halide_buffer_t &input, ha
     const float xScaling      = wScale;
     const float yScaling      = hScale;
     const int depthQuad       = UP_DIV(input.dim[1].extent, 4);
+    const int bytes           = input.type.bytes();
 
     AutoStorage<int> linePosition(outW);
     auto _linePosition = linePosition.get();
@@ -236,17 +277,15 @@ void CPUResizeCommon::CPUResizeNearestneighborRoundC4(halide_buffer_t &input, ha
 
     for (int b = 0; b < batches; ++b) {
         MNN_CONCURRENCY_BEGIN(n, depthQuad) {
-            auto srcData =
-                reinterpret_cast<const float*>(input.host) + b * inputBatchSize + static_cast<int>(n) * 4 * inW * inH;
-            auto dstData =
-                reinterpret_cast<float*>(output.host) + b * outputBatchSize + static_cast<int>(n) * 4 * outW * outH;
+            auto srcData = input.host + (b * inputBatchSize + static_cast<int>(n) * 4 * inW * inH) * bytes;
+            auto dstData = output.host + (b * outputBatchSize + static_cast<int>(n) * 4 * outW * outH) * bytes;
             for (int dy = 0; dy < outH; ++dy) {
                 float srcY       = dy * yScaling + hOffset;
                 const int y_     = CLAMP(static_cast<int>(roundf(srcY)), 0, inH - 1);
-                auto srcDataLine = srcData + inW * 4 * y_;
-                auto dstDataLine = dstData + outW * 4 * dy;
+                auto srcDataLine = srcData + inW * 4 * y_ * bytes;
+                auto dstDataLine = dstData + outW * 4 * dy * bytes;
                 for (int dx = 0; dx < outW; ++dx) {
-                    ::memcpy(dstDataLine + dx * 4, srcDataLine + _linePosition[dx] * 4, sizeof(float) * 4);
+                    ::memcpy(dstDataLine + dx * 4 * bytes, srcDataLine + _linePosition[dx] * 4 * bytes, 4 * bytes);
                 }
             }
         }
@@ -266,6 +305,7 @@ void CPUResizeCommon::CPUResizeNearestneighborC4(halide_buffer_t& input, halide_
     const float xScaling      = wScale;
     const float yScaling      = hScale;
     const int depthQuad       = UP_DIV(input.dim[1].extent, 4);
+    const int bytes           = input.type.bytes();
 
     AutoStorage<int> linePosition(outW);
     auto _linePosition = linePosition.get();
@@ -277,17 +317,15 @@ void CPUResizeCommon::CPUResizeNearestneighborC4(halide_buffer_t& input, halide_
 
     for (int b = 0; b < batches; ++b) {
         MNN_CONCURRENCY_BEGIN(n, depthQuad) {
-            auto srcData =
-                reinterpret_cast<const float*>(input.host) + b * inputBatchSize + static_cast<int>(n) * 4 * inW * inH;
-            auto dstData =
-                reinterpret_cast<float*>(output.host) + b * outputBatchSize + static_cast<int>(n) * 4 * outW * outH;
+            auto srcData = input.host + (b * inputBatchSize + static_cast<int>(n) * 4 * inW * inH) * bytes;
+            auto dstData = output.host + (b * outputBatchSize + static_cast<int>(n) * 4 * outW * outH) * bytes;
             for (int dy = 0; dy < outH; ++dy) {
                 float srcY       = dy * yScaling + hOffset;
                 const int y_     = CLAMP(static_cast<int>(floor(srcY)), 0, inH - 1);
-                auto srcDataLine = srcData + inW * 4 * y_;
-                auto dstDataLine = dstData + outW * 4 * dy;
+                auto srcDataLine = srcData + inW * 4 * y_ * bytes;
+                auto dstDataLine = dstData + outW * 4 * dy * bytes;
                 for (int dx = 0; dx < outW; ++dx) {
-                    ::memcpy(dstDataLine + dx * 4, srcDataLine + _linePosition[dx] * 4, sizeof(float) * 4);
+                    ::memcpy(dstDataLine + dx * 4 * bytes, srcDataLine + _linePosition[dx] * 4 * bytes, 4 * bytes);
                 }
             }
         }
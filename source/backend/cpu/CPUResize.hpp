@@ -27,6 +27,10 @@ public:
     void CPUResizeBilinearC4(halide_buffer_t &input, halide_buffer_t &output, const int *widthPosition,
                              const float *widthFactor, const int *heightPosition, const float *heightFactor,
                              float *lineBuffer, int threadNumber);
+    // int8 input / output with the same quantization scale
+    void CPUResizeBilinearC4Int8(halide_buffer_t &input, halide_buffer_t &output, const int *widthPosition,
+                                 const float *widthFactor, const int *heightPosition, const float *heightFactor,
+                                 int threadNumber);
     void CPUResizeNearestneighborC4(halide_buffer_t &input, halide_buffer_t &output, float wScale, float hScale, float wOffset = 0.f, float hOffset = 0.f);
     void CPUResizeNearestneighborRoundC4(halide_buffer_t &input, halide_buffer_t &output, float wScale, float hScale, float wOffset = 0.f, float hOffset = 0.f);
 };
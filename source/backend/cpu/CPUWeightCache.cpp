@@ -0,0 +1,116 @@
+//
+//  CPUWeightCache.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/02.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "backend/cpu/CPUWeightCache.hpp"
+#include <string.h>
+#include <map>
+#include <mutex>
+
+namespace MNN {
+struct WeightKey {
+    std::vector<int> layout;
+    size_t size;
+    uint64_t hash;
+    uint64_t check;
+    bool operator<(const WeightKey& other) const {
+        if (hash != other.hash) {
+            return hash < other.hash;
+        }
+        if (check != other.check) {
+            return check < other.check;
+        }
+        if (size != other.size) {
+            return size < other.size;
+        }
+        return layout < other.layout;
+    }
+};
+
+static std::mutex gWeightLock;
+static std::map<WeightKey, std::weak_ptr<Tensor>> gWeights;
+
+uint64_t CPUWeightCache::hash(const void* data, size_t size) {
+    // FNV-1a on 64 bit words, then mix the tail bytes
+    static const uint64_t prime = 0x100000001b3ULL;
+    uint64_t result             = 0xcbf29ce484222325ULL;
+    auto bytes                  = (const uint8_t*)data;
+    size_t words                = size / sizeof(uint64_t);
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t word;
+        ::memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(uint64_t));
+        result = (result ^ word) * prime;
+    }
+    for (size_t i = words * sizeof(uint64_t); i < size; ++i) {
+        result = (result ^ bytes[i]) * prime;
+    }
+    result ^= result >> 33;
+    result *= 0xff51afd7ed558ccdULL;
+    result ^= result >> 33;
+    return result;
+}
+
+static inline uint64_t _rotate(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+uint64_t CPUWeightCache::checkHash(const void* data, size_t size) {
+    static const uint64_t prime1 = 0x9e3779b185ebca87ULL;
+    static const uint64_t prime2 = 0xc2b2ae3d27d4eb4fULL;
+    static const uint64_t prime3 = 0x165667b19e3779f9ULL;
+    uint64_t result              = 0x27d4eb2f165667c5ULL + (uint64_t)size * prime3;
+    auto bytes                   = (const uint8_t*)data;
+    size_t words                 = size / sizeof(uint64_t);
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t word;
+        ::memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(uint64_t));
+        result ^= _rotate(word * prime2, 31) * prime1;
+        result = _rotate(result, 27) * prime1 + prime3;
+    }
+    for (size_t i = words * sizeof(uint64_t); i < size; ++i) {
+        result ^= bytes[i] * prime3;
+        result = _rotate(result, 11) * prime1;
+    }
+    result ^= result >> 33;
+    result *= prime2;
+    result ^= result >> 29;
+    return result;
+}
+
+std::shared_ptr<Tensor> CPUWeightCache::acquire(const std::vector<int>& layout, const void* origin, size_t size,
+                                                const std::function<std::shared_ptr<Tensor>()>& create) {
+    WeightKey key;
+    key.layout = layout;
+    key.size   = size;
+    key.hash   = hash(origin, size);
+    key.check  = checkHash(origin, size);
+    std::lock_guard<std::mutex> _l(gWeightLock);
+    auto iter = gWeights.find(key);
+    if (iter != gWeights.end()) {
+        auto weight = iter->second.lock();
+        if (nullptr != weight) {
+            return weight;
+        }
+        gWeights.erase(iter);
+    }
+    auto weight = create();
+    if (nullptr == weight || nullptr == weight->host<void>()) {
+        return nullptr;
+    }
+    gWeights.insert(std::make_pair(key, weight));
+    // Remove the keys of released weights
+    for (auto it = gWeights.begin(); it != gWeights.end();) {
+        if (it->second.expired()) {
+            it = gWeights.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return weight;
+}
+
+} // namespace MNN
@@ -0,0 +1,49 @@
+//
+//  CPUWeightCache.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/02.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef CPUWeightCache_hpp
+#define CPUWeightCache_hpp
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <MNN/MNNDefine.h>
+#include <MNN/Tensor.hpp>
+
+namespace MNN {
+/** Process-wide store of transformed constant weights, keyed by layout and content of the origin weight.
+    Executions of different Interpreters with identical weights share one copy, the memory is freed when
+    the last holder releases it. The content is identified by its size and two independent 64 bit hashes,
+    so a collision of one hash doesn't serve the weight of another layer. */
+class MNN_PUBLIC CPUWeightCache {
+public:
+    // The first element of layout
+    enum Algorithm {
+        TILED    = 0,
+        STRASSEN = 1,
+        WINOGRAD = 2,
+    };
+    /**
+     @brief find the transformed weight, create it if not found.
+     @param layout  description of the transformed weight, such as algorithm, shape and pack unit.
+     @param origin  origin weight, used to compute the content hash.
+     @param size    bytes of origin weight.
+     @param create  create the transformed weight, the tensor must own its memory. return nullptr if failed.
+     @return transformed weight, nullptr if create failed.
+     */
+    static std::shared_ptr<Tensor> acquire(const std::vector<int>& layout, const void* origin, size_t size,
+                                           const std::function<std::shared_ptr<Tensor>()>& create);
+
+    // FNV-1a hash of the content
+    static uint64_t hash(const void* data, size_t size);
+    // Multiply-rotate hash of the content, independent of hash
+    static uint64_t checkHash(const void* data, size_t size);
+};
+} // namespace MNN
+
+#endif /* CPUWeightCache_hpp */
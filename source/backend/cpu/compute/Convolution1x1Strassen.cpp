@@ -10,6 +10,7 @@
 #include <string.h>
 #include "core/BufferAllocator.hpp"
 #include "backend/cpu/CPUBackend.hpp"
+#include "backend/cpu/CPUWeightCache.hpp"
 #include "CommonOptFunction.h"
 #include "core/Concurrency.h"
 #include "ConvOpt.h"
@@ -22,13 +23,30 @@ Convolution1x1Strassen::Convolution1x1Strassen(const Convolution2DCommon *common
     auto mSrcCount   = (int)originWeightSize / outputCount;
     int ePack, lPack, hPack;
     MNNGetMatMulPackMode(&ePack, &lPack, &hPack);
-    mWeight.reset(Tensor::createDevice<float>(std::vector<int>{UP_DIV(outputCount, hPack), mSrcCount, hPack}));
-    mValid = b->onAcquireBuffer(mWeight.get(), Backend::STATIC);
+    std::vector<int> weightShape{UP_DIV(outputCount, hPack), mSrcCount, hPack};
+    if (((CPUBackend*)b)->shareWeight()) {
+        mShareWeight = true;
+        mWeight      = CPUWeightCache::acquire({CPUWeightCache::STRASSEN, outputCount, mSrcCount, hPack}, originWeight,
+                                               originWeightSize * sizeof(float), [&]() {
+                                              std::shared_ptr<Tensor> weight(Tensor::create<float>(weightShape));
+                                              if (nullptr != weight->host<float>()) {
+                                                  MNNPackForMatMul_B(weight->host<float>(), originWeight, outputCount,
+                                                                     mSrcCount, true);
+                                              }
+                                              return weight;
+                                          });
+        mValid = nullptr != mWeight;
+    } else {
+        mWeight.reset(Tensor::createDevice<float>(weightShape));
+        mValid = b->onAcquireBuffer(mWeight.get(), Backend::STATIC);
+        if (mValid) {
+            MNNPackForMatMul_B(mWeight->host<float>(), originWeight, outputCount, mSrcCount, true);
+        }
+    }
     if (!mValid) {
         MNN_ERROR("Not Enough Memory\n");
         return;
     }
-    MNNPackForMatMul_B(mWeight->host<float>(), originWeight, outputCount, mSrcCount, true);
 
     mBias.reset(Tensor::createDevice<float>(std::vector<int>{UP_DIV(outputCount, 4), 4}));
     mValid = b->onAcquireBuffer(mBias.get(), Backend::STATIC);
@@ -44,7 +62,7 @@ Convolution1x1Strassen::Convolution1x1Strassen(const Convolution2DCommon *common
 }
 
 Convolution1x1Strassen::~Convolution1x1Strassen() {
-    if (nullptr != mWeight) {
+    if (nullptr != mWeight && !mShareWeight) {
         backend()->onReleaseBuffer(mWeight.get(), Backend::STATIC);
     }
     backend()->onReleaseBuffer(mBias.get(), Backend::STATIC);
@@ -26,6 +26,8 @@ public:
 private:
     std::shared_ptr<Tensor> mWeight;
     std::shared_ptr<Tensor> mBias;
+    // mWeight is hold by CPUWeightCache, not by backend
+    bool mShareWeight = false;
 
     struct Unit {
         bool mValid = true;
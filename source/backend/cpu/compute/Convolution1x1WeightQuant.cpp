@@ -0,0 +1,203 @@
+//
+//  Convolution1x1WeightQuant.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/04.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "backend/cpu/compute/Convolution1x1WeightQuant.hpp"
+#include <string.h>
+#include <algorithm>
+#include "core/Concurrency.h"
+#include "core/Macro.h"
+#include "math/Vec.hpp"
+using Vec4 = MNN::Math::Vec<float, 4>;
+
+#define CONVOLUTION_WEIGHT_QUANT_TILE 8
+
+namespace MNN {
+
+static void _decodeWeight(float* dst, const int8_t* src, bool int4) {
+    if (!int4) {
+        for (int j = 0; j < 16; ++j) {
+            dst[j] = (float)src[j];
+        }
+        return;
+    }
+    for (int j = 0; j < 8; ++j) {
+        auto value = (uint8_t)src[j];
+        int low    = value & 0x0F;
+        int high   = value >> 4;
+        dst[2 * j]     = (float)(low >= 8 ? low - 16 : low);
+        dst[2 * j + 1] = (float)(high >= 8 ? high - 16 : high);
+    }
+}
+
+// Compute one output channel block for [planeStart, planeStart + count) of the plane
+// src: [icC4, plane, 4], weight: [icC4, 16 or 8 bytes], dst: [plane, 4]
+static void _gemmWeightQuant(float* dst, const float* src, const int8_t* weight, const float* scale, const float* offset,
+                             int srcCount, int plane, int planeStart, int count, bool int4) {
+    auto icC4      = UP_DIV(srcCount, 4);
+    int blockBytes = int4 ? 8 : 16;
+    Vec4 acc[CONVOLUTION_WEIGHT_QUANT_TILE];
+    float srcSum[CONVOLUTION_WEIGHT_QUANT_TILE];
+    for (int x = 0; x < count; ++x) {
+        acc[x]    = Vec4(0.0f);
+        srcSum[x] = 0.0f;
+    }
+    float w[16];
+    for (int c = 0; c < icC4; ++c) {
+        _decodeWeight(w, weight + c * blockBytes, int4);
+        auto w0 = Vec4::load(w + 0);
+        auto w1 = Vec4::load(w + 4);
+        auto w2 = Vec4::load(w + 8);
+        auto w3 = Vec4::load(w + 12);
+        auto s  = src + (c * plane + planeStart) * 4;
+        for (int x = 0; x < count; ++x) {
+            auto sx = s + 4 * x;
+            acc[x]  = acc[x] + w0 * sx[0] + w1 * sx[1] + w2 * sx[2] + w3 * sx[3];
+        }
+        if (nullptr != offset) {
+            auto valid = std::min(4, srcCount - 4 * c);
+            for (int x = 0; x < count; ++x) {
+                for (int i = 0; i < valid; ++i) {
+                    srcSum[x] += s[4 * x + i];
+                }
+            }
+        }
+    }
+    auto scaleV = Vec4::load(scale);
+    for (int x = 0; x < count; ++x) {
+        auto result = acc[x] * scaleV;
+        if (nullptr != offset) {
+            result = result + Vec4::load(offset) * srcSum[x];
+        }
+        Vec4::save(dst + (planeStart + x) * 4, result);
+    }
+}
+
+Convolution1x1WeightQuant::Convolution1x1WeightQuant(const Convolution2DCommon* common, Backend* b,
+                                                     const ConvolutionCommon::Int8Common* quan, const float* bias,
+                                                     size_t biasSize)
+    : CPUConvolution(common, b) {
+    auto outputCount = (int)biasSize;
+    auto srcCount    = (int)quan->weight.size() / outputCount;
+    auto ocC4        = UP_DIV(outputCount, 4);
+    auto icC4        = UP_DIV(srcCount, 4);
+    auto source      = quan->weight.get();
+    // Low bit weight (converter's weightQuantBits <= 4) is stored as int4
+    mInt4 = true;
+    for (int i = 0; i < quan->weight.size(); ++i) {
+        if (source[i] < -8 || source[i] > 7) {
+            mInt4 = false;
+            break;
+        }
+    }
+    int blockBytes = mInt4 ? 8 : 16;
+    mWeight.reset(Tensor::createDevice<int8_t>({ocC4, icC4, blockBytes}));
+    mScale.reset(Tensor::createDevice<float>({ocC4 * 4}));
+    mOffset.reset(Tensor::createDevice<float>({ocC4 * 4}));
+    mBias.reset(Tensor::createDevice<float>({ocC4 * 4}));
+    for (auto t : {mWeight, mScale, mOffset, mBias}) {
+        mValid = b->onAcquireBuffer(t.get(), Backend::STATIC);
+        if (!mValid) {
+            MNN_ERROR("Not Enough Memory\n");
+            return;
+        }
+    }
+    auto scale  = mScale->host<float>();
+    auto offset = mOffset->host<float>();
+    ::memset(scale, 0, mScale->size());
+    ::memset(offset, 0, mOffset->size());
+    ::memset(mBias->host<float>(), 0, mBias->size());
+    ::memcpy(mBias->host<float>(), bias, biasSize * sizeof(float));
+    for (int o = 0; o < outputCount; ++o) {
+        if (quan->asymmetric) {
+            // weight = (q + 128) * scale + min
+            auto minValue = quan->alpha.get()[2 * o];
+            scale[o]      = quan->alpha.get()[2 * o + 1];
+            offset[o]     = minValue + 128.0f * scale[o];
+        } else {
+            scale[o] = quan->alpha.get()[o] * quan->quan->quantScale();
+        }
+        mHasOffset = mHasOffset || offset[o] != 0.0f;
+    }
+
+    auto dst = mWeight->host<int8_t>();
+    ::memset(dst, 0, mWeight->size());
+    for (int o = 0; o < outputCount; ++o) {
+        for (int i = 0; i < srcCount; ++i) {
+            auto block = dst + ((o / 4) * icC4 + i / 4) * blockBytes;
+            auto lane  = (i % 4) * 4 + (o % 4);
+            auto value = source[o * srcCount + i];
+            if (!mInt4) {
+                block[lane] = value;
+                continue;
+            }
+            auto nibble = (uint8_t)(value & 0x0F);
+            if (lane % 2 == 0) {
+                block[lane / 2] = (int8_t)(((uint8_t)block[lane / 2] & 0xF0) | nibble);
+            } else {
+                block[lane / 2] = (int8_t)(((uint8_t)block[lane / 2] & 0x0F) | (nibble << 4));
+            }
+        }
+    }
+}
+
+Convolution1x1WeightQuant::~Convolution1x1WeightQuant() {
+    for (auto t : {mWeight, mScale, mOffset, mBias}) {
+        if (nullptr != t->host<void>()) {
+            backend()->onReleaseBuffer(t.get(), Backend::STATIC);
+        }
+    }
+}
+
+bool Convolution1x1WeightQuant::support(const Tensor* input, const Tensor* output, const Convolution2DCommon* common) {
+    if (common->kernelX() != 1 || common->kernelY() != 1 || common->strideX() != 1 || common->strideY() != 1) {
+        return false;
+    }
+    auto pad = ConvolutionCommon::convolutionPad(input, output, common);
+    return pad.first == 0 && pad.second == 0;
+}
+
+ErrorCode Convolution1x1WeightQuant::onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    CPUConvolution::onResize(inputs, outputs);
+    mThreadNumber = ((CPUBackend*)backend())->threadNumber();
+    return NO_ERROR;
+}
+
+ErrorCode Convolution1x1WeightQuant::onExecute(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    auto input     = inputs[0];
+    auto output    = outputs[0];
+    auto plane     = input->width() * input->height();
+    auto srcCount  = input->channel();
+    auto icC4      = UP_DIV(srcCount, 4);
+    auto ocC4      = UP_DIV(output->channel(), 4);
+    int blockBytes = mInt4 ? 8 : 16;
+    auto weight    = mWeight->host<int8_t>();
+    auto scale     = mScale->host<float>();
+    auto offset    = mHasOffset ? mOffset->host<float>() : nullptr;
+    auto bias      = mBias->host<float>();
+    for (int b = 0; b < input->batch(); ++b) {
+        auto srcBatch = input->host<float>() + b * icC4 * plane * 4;
+        auto dstBatch = output->host<float>() + b * ocC4 * plane * 4;
+        MNN_CONCURRENCY_BEGIN(tId, mThreadNumber) {
+            for (int z = (int)tId; z < ocC4; z += mThreadNumber) {
+                auto dstZ    = dstBatch + z * plane * 4;
+                auto weightZ = weight + z * icC4 * blockBytes;
+                auto offsetZ = nullptr != offset ? offset + 4 * z : nullptr;
+                for (int p = 0; p < plane; p += CONVOLUTION_WEIGHT_QUANT_TILE) {
+                    auto count = std::min(CONVOLUTION_WEIGHT_QUANT_TILE, plane - p);
+                    _gemmWeightQuant(dstZ, srcBatch, weightZ, scale + 4 * z, offsetZ, srcCount, plane, p, count,
+                                     mInt4);
+                }
+                mPostFunction(dstZ, bias + 4 * z, plane, 1);
+            }
+        }
+        MNN_CONCURRENCY_END();
+    }
+    return NO_ERROR;
+}
+
+} // namespace MNN
@@ -0,0 +1,40 @@
+//
+//  Convolution1x1WeightQuant.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/04.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef Convolution1x1WeightQuant_hpp
+#define Convolution1x1WeightQuant_hpp
+
+#include "backend/cpu/CPUConvolution.hpp"
+
+namespace MNN {
+/** 1x1 Convolution whose weight stay int8 / int4 in memory (weight = q * scale + offset per output channel),
+    the weight is dequantized in the GEMM kernel. Used for weight quantized models in Memory_Low mode. */
+class Convolution1x1WeightQuant : public CPUConvolution {
+public:
+    Convolution1x1WeightQuant(const Convolution2DCommon *common, Backend *b, const ConvolutionCommon::Int8Common *quan,
+                              const float *bias, size_t biasSize);
+    virtual ~Convolution1x1WeightQuant();
+    virtual ErrorCode onResize(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+    virtual ErrorCode onExecute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+    static bool support(const Tensor *input, const Tensor *output, const Convolution2DCommon *common);
+
+private:
+    // [ocC4, icC4, 4 (ic), 4 (oc)] int8, or two int4 in one byte if mInt4
+    std::shared_ptr<Tensor> mWeight;
+    // scale, offset, bias: [ocC4 * 4] each
+    std::shared_ptr<Tensor> mScale;
+    std::shared_ptr<Tensor> mOffset;
+    std::shared_ptr<Tensor> mBias;
+    bool mInt4       = false;
+    bool mHasOffset  = false;
+    int mThreadNumber = 1;
+};
+} // namespace MNN
+
+#endif /* Convolution1x1WeightQuant_hpp */
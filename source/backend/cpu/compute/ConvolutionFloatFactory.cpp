@@ -10,34 +10,147 @@
 #include "backend/cpu/CPUConvolutionDepthwise.hpp"
 #include "backend/cpu/compute/ConvOpt.h"
 #include "backend/cpu/compute/Convolution1x1Strassen.hpp"
+#include "backend/cpu/compute/Convolution1x1WeightQuant.hpp"
 #include "backend/cpu/compute/ConvolutionGroup.hpp"
 #include "backend/cpu/compute/ConvolutionIntFactory.hpp"
+#include "backend/cpu/compute/ConvolutionRawImage.hpp"
 #include "backend/cpu/compute/ConvolutionTiledExecutor.hpp"
 #include "backend/cpu/compute/ConvolutionWinograd.hpp"
+#include <string.h>
+#include <algorithm>
+#include <MNN/AutoTime.hpp>
 #include "core/Macro.h"
 namespace MNN {
 
-static Execution* _createUnit(const Tensor* input, const Tensor* output, Backend* backend,
-                              const Convolution2DCommon* common, const float* originWeight, size_t originWeightSize,
-                              const float* bias, size_t biasSize) {
-    auto layer   = common;
-    bool fastWay = layer->kernelY() == 1 && layer->kernelX() == 1;
+enum ConvolutionAlgorithm {
+    CONVOLUTION_TILED    = 0,
+    CONVOLUTION_STRASSEN = 1,
+    CONVOLUTION_WINOGRAD = 2,
+};
+
+static Execution* _createAlgorithm(std::pair<int, int> algorithm, const Tensor* input, const Tensor* output,
+                                   Backend* backend, const Convolution2DCommon* common, const float* originWeight,
+                                   size_t originWeightSize, const float* bias, size_t biasSize) {
+    switch (algorithm.first) {
+        case CONVOLUTION_STRASSEN:
+            return new Convolution1x1Strassen(common, backend, originWeight, originWeightSize, bias, biasSize);
+        case CONVOLUTION_WINOGRAD:
+            return new ConvolutionWinograd(common, input, output, backend, originWeight, originWeightSize, bias,
+                                           biasSize, algorithm.second);
+        default:
+            break;
+    }
+    return new ConvolutionTiledExecutor(common, backend, originWeight, originWeightSize, bias, biasSize);
+}
+
+static std::pair<int, int> _defaultAlgorithm(const Tensor* input, const Tensor* output, CPUBackend* backend,
+                                             const Convolution2DCommon* common) {
+    bool fastWay = common->kernelY() == 1 && common->kernelX() == 1;
     if (fastWay) {
-        return new Convolution1x1Strassen(common, backend, originWeight, originWeightSize, bias, biasSize);
+        return std::make_pair(CONVOLUTION_STRASSEN, 0);
     }
     if (!ConvolutionWinograd::canUseWinograd(common)) {
-        return new ConvolutionTiledExecutor(common, backend, originWeight, originWeightSize, bias, biasSize);
+        return std::make_pair(CONVOLUTION_TILED, 0);
     }
-    auto cpuBackend = (CPUBackend*)backend;
-    if (cpuBackend->memoryMode() == BackendConfig::Memory_Low) {
-        return new ConvolutionTiledExecutor(common, backend, originWeight, originWeightSize, bias, biasSize);
+    if (backend->memoryMode() == BackendConfig::Memory_Low) {
+        return std::make_pair(CONVOLUTION_TILED, 0);
     }
-    auto unit = ConvolutionWinograd::bestWinogradUnit(common, input, output, cpuBackend->threadNumber());
+    auto unit = ConvolutionWinograd::bestWinogradUnit(common, input, output, backend->threadNumber());
     if (unit <= 1) {
-        return new ConvolutionTiledExecutor(common, backend, originWeight, originWeightSize, bias, biasSize);
+        return std::make_pair(CONVOLUTION_TILED, 0);
+    }
+    return std::make_pair(CONVOLUTION_WINOGRAD, unit);
+}
+
+static std::vector<std::pair<int, int>> _candidateAlgorithms(CPUBackend* backend, const Convolution2DCommon* common) {
+    std::vector<std::pair<int, int>> candidates{std::make_pair(CONVOLUTION_TILED, 0)};
+    if (common->kernelY() == 1 && common->kernelX() == 1) {
+        candidates.emplace_back(std::make_pair(CONVOLUTION_STRASSEN, 0));
+        return candidates;
+    }
+    if (!ConvolutionWinograd::canUseWinograd(common) || backend->memoryMode() == BackendConfig::Memory_Low) {
+        return candidates;
+    }
+    for (auto unit : ConvolutionWinograd::supportWinogradUnits(common)) {
+        candidates.emplace_back(std::make_pair(CONVOLUTION_WINOGRAD, unit));
+    }
+    return candidates;
+}
+
+static bool _validAlgorithm(std::pair<int, int> algorithm, CPUBackend* backend, const Convolution2DCommon* common) {
+    auto candidates = _candidateAlgorithms(backend, common);
+    return std::find(candidates.begin(), candidates.end(), algorithm) != candidates.end();
+}
+
+static std::pair<int, int> _tuneAlgorithm(const Tensor* input, const Tensor* output, CPUBackend* backend,
+                                          const Convolution2DCommon* common, const float* originWeight,
+                                          size_t originWeightSize, const float* bias, size_t biasSize,
+                                          std::pair<int, int> defaultAlgorithm) {
+    auto candidates = _candidateAlgorithms(backend, common);
+    if (candidates.size() <= 1) {
+        return defaultAlgorithm;
+    }
+    std::shared_ptr<Tensor> tempInput(Tensor::createDevice<float>(input->shape(), Tensor::CAFFE_C4));
+    std::shared_ptr<Tensor> tempOutput(Tensor::createDevice<float>(output->shape(), Tensor::CAFFE_C4));
+    bool success = backend->onAcquireBuffer(tempInput.get(), Backend::STATIC);
+    success      = success && backend->onAcquireBuffer(tempOutput.get(), Backend::STATIC);
+    if (!success) {
+        return defaultAlgorithm;
     }
-    return new ConvolutionWinograd(common, input, output, backend, originWeight, originWeightSize, bias, biasSize,
-                                   unit);
+    ::memset(tempInput->host<float>(), 0, tempInput->size());
+    std::vector<Tensor*> inputs{tempInput.get()};
+    std::vector<Tensor*> outputs{tempOutput.get()};
+    static const int gTuneLoop = 3;
+    auto bestAlgorithm         = defaultAlgorithm;
+    uint64_t bestCost          = 0;
+    for (auto& algorithm : candidates) {
+        std::shared_ptr<Execution> execution(_createAlgorithm(algorithm, input, output, backend, common, originWeight,
+                                                              originWeightSize, bias, biasSize));
+        if (nullptr == execution || !execution->valid() || NO_ERROR != execution->onResize(inputs, outputs)) {
+            continue;
+        }
+        backend->onExecuteBegin();
+        // Warm up
+        execution->onExecute(inputs, outputs);
+        uint64_t cost = 0;
+        for (int i = 0; i < gTuneLoop; ++i) {
+            Timer timer;
+            execution->onExecute(inputs, outputs);
+            auto current = timer.durationInUs();
+            cost         = (0 == i) ? current : std::min(cost, current);
+        }
+        backend->onExecuteEnd();
+        if (bestCost == 0 || cost < bestCost) {
+            bestCost      = cost;
+            bestAlgorithm = algorithm;
+        }
+    }
+    backend->onReleaseBuffer(tempInput.get(), Backend::STATIC);
+    backend->onReleaseBuffer(tempOutput.get(), Backend::STATIC);
+    return bestAlgorithm;
+}
+
+static Execution* _createUnit(const Tensor* input, const Tensor* output, Backend* backend,
+                              const Convolution2DCommon* common, const float* originWeight, size_t originWeightSize,
+                              const float* bias, size_t biasSize) {
+    auto cpuBackend = (CPUBackend*)backend;
+    auto algorithm  = _defaultAlgorithm(input, output, cpuBackend, common);
+    // Use the measured algorithm if it has been tuned before (maybe loaded from cache file)
+    auto& algorithms = cpuBackend->convolutionAlgorithms();
+    std::vector<int> key{common->kernelX(), common->kernelY(), common->strideX(), common->strideY(),
+                         common->dilateX(), common->dilateY(), common->padX(),    common->padY(),
+                         input->batch(),    input->channel(),  input->height(),   input->width(),
+                         output->channel(), output->height(),  output->width(),   cpuBackend->threadNumber()};
+    auto iter = algorithms.find(key);
+    if (iter != algorithms.end() && _validAlgorithm(iter->second, cpuBackend, common)) {
+        algorithm = iter->second;
+    } else if (cpuBackend->tuneConvolution()) {
+        algorithm = _tuneAlgorithm(input, output, cpuBackend, common, originWeight, originWeightSize, bias, biasSize,
+                                   algorithm);
+        algorithms[key] = algorithm;
+    }
+    return _createAlgorithm(algorithm, input, output, backend, common, originWeight, originWeightSize, bias,
+                            biasSize);
 }
 
 Execution* ConvolutionFloatFactory::create(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
@@ -51,7 +164,20 @@ Execution* ConvolutionFloatFactory::create(const std::vector<Tensor*>& inputs, c
     size_t originWeightSize   = 0;
     std::shared_ptr<ConvolutionCommon::Int8Common> quanCommon;
     if (nullptr != conv2d->quanParameter()) {
-        quanCommon = ConvolutionCommon::load(conv2d->quanParameter());
+        auto quan        = conv2d->quanParameter();
+        bool weightQuant = (1 == quan->type() || 2 == quan->type() || 4 == quan->type()) && !quan->has_scaleInt();
+        if (weightQuant && ((CPUBackend*)backend)->memoryMode() == BackendConfig::Memory_Low &&
+            1 == conv2d->common()->group() &&
+            Convolution1x1WeightQuant::support(inputs[0], outputs[0], conv2d->common())) {
+            // Don't decode the weight to float, dequantize it in the kernel to save memory
+            quanCommon = ConvolutionCommon::load(quan, false, true);
+            if (nullptr != quanCommon &&
+                quanCommon->weight.size() == inputs[0]->channel() * conv2d->bias()->size()) {
+                return new Convolution1x1WeightQuant(conv2d->common(), backend, quanCommon.get(),
+                                                     conv2d->bias()->data(), conv2d->bias()->size());
+            }
+        }
+        quanCommon = ConvolutionCommon::load(quan);
         if (nullptr == quanCommon) {
             MNN_ERROR("Memory not Enough, can't extract IDST Convolution: %s \n", op->name()->c_str());
             return nullptr;
@@ -72,6 +198,15 @@ Execution* ConvolutionFloatFactory::create(const std::vector<Tensor*>& inputs, c
         originWeightSize = op->main_as_Convolution2D()->weight()->size();
     }
 
+    if (ConvolutionCommon::isRawImageConvolution(op, inputs[0])) {
+        // The first convolution with the image preprocess folded into it
+        if (1 != common->group()) {
+            MNN_ERROR("Don't support group convolution for uint8 image input: %s\n", op->name()->c_str());
+            return nullptr;
+        }
+        return new ConvolutionRawImage(common, backend, originWeight, originWeightSize, conv2d->bias()->data(),
+                                       conv2d->bias()->size(), conv2d->inputPadValue());
+    }
     if (1 == common->group()) {
         return _createUnit(inputs[0], outputs[0], backend, common, originWeight, originWeightSize,
                            conv2d->bias()->data(), conv2d->bias()->size());
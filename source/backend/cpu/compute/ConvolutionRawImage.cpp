@@ -0,0 +1,216 @@
+//
+//  ConvolutionRawImage.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/10.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "backend/cpu/compute/ConvolutionRawImage.hpp"
+#include <string.h>
+#include <algorithm>
+#include "backend/cpu/compute/CommonOptFunction.h"
+#include "core/Concurrency.h"
+#include "core/Macro.h"
+#include "core/TensorUtils.hpp"
+
+namespace MNN {
+
+// Round up a / b for b > 0 and any sign of a
+static inline int _ceilDiv(int a, int b) {
+    return a >= 0 ? (a + b - 1) / b : -((-a) / b);
+}
+
+ConvolutionRawImage::ConvolutionRawImage(const Convolution2DCommon* common, Backend* b, const float* originWeight,
+                                         size_t originWeightSize, const float* bias, size_t biasSize,
+                                         const flatbuffers::Vector<float>* padValue)
+    : CPUConvolution(common, b) {
+    auto outputCount = (int)biasSize;
+    auto kernelSize  = common->kernelX() * common->kernelY();
+    mSrcCount        = (int)originWeightSize / outputCount / kernelSize;
+    auto K           = kernelSize * mSrcCount;
+    int eP, lP, hP;
+    MNNGetMatMulPackMode(&eP, &lP, &hP);
+    mWeight.reset(Tensor::createDevice<float>({UP_DIV(outputCount, hP), K, hP}));
+    mBias.reset(Tensor::createDevice<float>({ALIGN_UP4(outputCount)}));
+    std::shared_ptr<Tensor> cache(Tensor::createDevice<float>({outputCount, K}));
+    mValid = b->onAcquireBuffer(mWeight.get(), Backend::STATIC) && b->onAcquireBuffer(mBias.get(), Backend::STATIC) &&
+             b->onAcquireBuffer(cache.get(), Backend::STATIC);
+    if (!mValid) {
+        MNN_ERROR("Not Enough Memory\n");
+        return;
+    }
+    ::memset(mBias->host<float>(), 0, mBias->size());
+    ::memcpy(mBias->host<float>(), bias, biasSize * sizeof(float));
+    // [oc, ic, ky, kx] -> [oc, (ky, kx, ic)], the order of im2col, then pack for MNNPackedMatMul
+    auto cachePtr = cache->host<float>();
+    for (int o = 0; o < outputCount; ++o) {
+        for (int c = 0; c < mSrcCount; ++c) {
+            for (int k = 0; k < kernelSize; ++k) {
+                cachePtr[o * K + k * mSrcCount + c] = originWeight[(o * mSrcCount + c) * kernelSize + k];
+            }
+        }
+    }
+    MNNPackForMatMul_B(mWeight->host<float>(), cachePtr, outputCount, K, true);
+    b->onReleaseBuffer(cache.get(), Backend::STATIC);
+    mPadValue.resize(mSrcCount, 0.0f);
+    if (nullptr != padValue) {
+        for (int c = 0; c < mSrcCount && c < padValue->size(); ++c) {
+            mPadValue[c] = padValue->data()[c];
+        }
+    }
+}
+
+ConvolutionRawImage::~ConvolutionRawImage() {
+    if (nullptr != mWeight->host<void>()) {
+        backend()->onReleaseBuffer(mWeight.get(), Backend::STATIC);
+    }
+    if (nullptr != mBias->host<void>()) {
+        backend()->onReleaseBuffer(mBias.get(), Backend::STATIC);
+    }
+}
+
+ErrorCode ConvolutionRawImage::onResize(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    CPUConvolution::onResize(inputs, outputs);
+    auto input  = inputs[0];
+    auto output = outputs[0];
+    if (input->channel() != mSrcCount) {
+        MNN_ERROR("The channel of raw image input %d is not the same as the weight %d\n", input->channel(), mSrcCount);
+        return INPUT_DATA_ERROR;
+    }
+    auto iw     = input->width();
+    auto ih     = input->height();
+    auto format = TensorUtils::getDescribe(input)->dimensionFormat;
+    if (MNN_DATA_FORMAT_NHWC == format) {
+        mStrides[0] = mSrcCount;
+        mStrides[1] = iw * mSrcCount;
+        mStrides[2] = 1;
+    } else if (MNN_DATA_FORMAT_NCHW == format) {
+        mStrides[0] = 1;
+        mStrides[1] = iw;
+        mStrides[2] = iw * ih;
+    } else {
+        MNN_ERROR("Raw image input of convolution only support NHWC / NCHW\n");
+        return NOT_SUPPORT;
+    }
+    int eP, lP, hP;
+    MNNGetMatMulPackMode(&eP, &lP, &hP);
+    auto K        = mCommon->kernelX() * mCommon->kernelY() * mSrcCount;
+    auto plane    = output->width() * output->height();
+    auto ocC4     = UP_DIV(output->channel(), 4);
+    mThreadNumber = std::max(1, std::min(((CPUBackend*)backend())->threadNumber(), UP_DIV(plane, eP)));
+    mCache.reset(Tensor::createDevice<float>({mThreadNumber, K, eP}));
+    bool success = backend()->onAcquireBuffer(mCache.get(), Backend::DYNAMIC);
+    mMatMulCache.reset();
+    if (hP % 4 != 0) {
+        mMatMulCache.reset(
+            Tensor::createDevice<float>({mThreadNumber, 4 * MNNGetC4DivNumber(hP) * eP + ocC4 * 4 * eP}));
+        success = success && backend()->onAcquireBuffer(mMatMulCache.get(), Backend::DYNAMIC);
+    }
+    if (!success) {
+        return OUT_OF_MEMORY;
+    }
+    backend()->onReleaseBuffer(mCache.get(), Backend::DYNAMIC);
+    if (nullptr != mMatMulCache) {
+        backend()->onReleaseBuffer(mMatMulCache.get(), Backend::DYNAMIC);
+    }
+    // e, l, h, CStride, AStride, BStride
+    mParameters     = {eP * sizeof(float), (size_t)K, (size_t)output->channel(), plane * 4 * sizeof(float), 0, 0};
+    mPostParameters = getPostParameters();
+    return NO_ERROR;
+}
+
+ErrorCode ConvolutionRawImage::onExecute(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs) {
+    auto input     = inputs[0];
+    auto output    = outputs[0];
+    auto iw        = input->width();
+    auto ih        = input->height();
+    auto ow        = output->width();
+    auto oh        = output->height();
+    auto plane     = ow * oh;
+    auto ocC4      = UP_DIV(output->channel(), 4);
+    auto kw        = mCommon->kernelX();
+    auto kh        = mCommon->kernelY();
+    auto K         = kw * kh * mSrcCount;
+    auto srcBatch  = input->stride(0);
+    auto weight    = mWeight->host<float>();
+    auto bias      = mBias->host<float>();
+    auto padValue  = mPadValue.data();
+    auto xStride   = mStrides[0];
+    auto yStride   = mStrides[1];
+    auto cStride   = mStrides[2];
+    auto strideX   = mCommon->strideX();
+    auto strideY   = mCommon->strideY();
+    auto dilateX   = mCommon->dilateX();
+    auto dilateY   = mCommon->dilateY();
+    auto parameter = mParameters.data();
+    auto post      = mPostParameters.data();
+    int eP, lP, hP;
+    MNNGetMatMulPackMode(&eP, &lP, &hP);
+    auto tileCount = UP_DIV(plane, eP);
+    for (int b = 0; b < input->batch(); ++b) {
+        auto src = input->host<uint8_t>() + b * srcBatch;
+        auto dst = output->host<float>() + b * ocC4 * plane * 4;
+        MNN_CONCURRENCY_BEGIN(tId, mThreadNumber) {
+            auto col           = mCache->host<float>() + tId * K * eP;
+            float* matMulCache = nullptr;
+            if (nullptr != mMatMulCache) {
+                matMulCache = mMatMulCache->host<float>() + tId * mMatMulCache->stride(0);
+            }
+            for (int t = (int)tId; t < tileCount; t += mThreadNumber) {
+                int xStart = t * eP;
+                int count  = std::min(eP, plane - xStart);
+                // im2col straight into the packed A of MNNPackedMatMul: [K, eP], one output row at a time so that
+                // the valid range of each kernel tap is computed once, the padding takes padValue
+                int oy    = xStart / ow;
+                int ox    = xStart % ow;
+                int index = 0;
+                while (index < count) {
+                    int step = std::min(ow - ox, count - index);
+                    for (int ky = 0; ky < kh; ++ky) {
+                        int sy = oy * strideY - mPadY + ky * dilateY;
+                        for (int kx = 0; kx < kw; ++kx) {
+                            auto colK    = col + (ky * kw + kx) * mSrcCount * eP + index;
+                            int sxOffset = kx * dilateX - mPadX;
+                            // ox is valid for 0 <= ox * strideX + sxOffset < iw
+                            int validStart = step, validEnd = step;
+                            if (sy >= 0 && sy < ih) {
+                                validStart = std::min(std::max(_ceilDiv(-sxOffset, strideX) - ox, 0), step);
+                                validEnd   = std::min(std::max(_ceilDiv(iw - sxOffset, strideX) - ox, validStart), step);
+                            }
+                            for (int c = 0; c < mSrcCount; ++c) {
+                                auto dstC = colK + c * eP;
+                                for (int x = 0; x < validStart; ++x) {
+                                    dstC[x] = padValue[c];
+                                }
+                                if (validEnd > validStart) {
+                                    auto srcC = src + sy * yStride + c * cStride +
+                                                ((ox + validStart) * strideX + sxOffset) * xStride;
+                                    auto srcStep = strideX * xStride;
+                                    for (int x = validStart; x < validEnd; ++x) {
+                                        dstC[x] = (float)srcC[(x - validStart) * srcStep];
+                                    }
+                                }
+                                for (int x = validEnd; x < step; ++x) {
+                                    dstC[x] = padValue[c];
+                                }
+                            }
+                        }
+                    }
+                    index += step;
+                    ox = 0;
+                    ++oy;
+                }
+                if (count == eP) {
+                    MNNPackedMatMul(dst + xStart * 4, col, weight, parameter, matMulCache, post, bias);
+                } else {
+                    MNNPackedMatMulRemain(dst + xStart * 4, col, weight, count, parameter, matMulCache, post, bias);
+                }
+            }
+        }
+        MNN_CONCURRENCY_END();
+    }
+    return NO_ERROR;
+}
+
+} // namespace MNN
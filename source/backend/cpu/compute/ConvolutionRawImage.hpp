@@ -0,0 +1,45 @@
+//
+//  ConvolutionRawImage.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/10.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef ConvolutionRawImage_hpp
+#define ConvolutionRawImage_hpp
+
+#include "backend/cpu/CPUConvolution.hpp"
+
+namespace MNN {
+/** First convolution of a model which reads the uint8 image (NHWC or NCHW) directly, the ImageProcess mean / normal
+    is folded into weight and bias by the converter. im2col converts the uint8 pixels to float tile by tile, and pads
+    with inputPadValue (the mean) so that the border is the same as padding zero after normalize. */
+class ConvolutionRawImage : public CPUConvolution {
+public:
+    ConvolutionRawImage(const Convolution2DCommon *common, Backend *b, const float *originWeight,
+                        size_t originWeightSize, const float *bias, size_t biasSize,
+                        const flatbuffers::Vector<float> *padValue);
+    virtual ~ConvolutionRawImage();
+    virtual ErrorCode onResize(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+    virtual ErrorCode onExecute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+private:
+    // Packed for MNNPackedMatMul: [UP_DIV(oc, hP), kernelY * kernelX * ic, hP]
+    std::shared_ptr<Tensor> mWeight;
+    std::shared_ptr<Tensor> mBias;
+    std::vector<float> mPadValue;
+    // im2col in the packed A layout: [threadNumber, kernelY * kernelX * ic, eP]
+    std::shared_ptr<Tensor> mCache;
+    // Cache of MNNPackedMatMul when hP is not a multiple of 4
+    std::shared_ptr<Tensor> mMatMulCache;
+    std::vector<size_t> mParameters;
+    std::vector<float> mPostParameters;
+    int mSrcCount     = 0;
+    int mThreadNumber = 1;
+    // Stride of x, y and channel for the uint8 input
+    int mStrides[3];
+};
+} // namespace MNN
+
+#endif /* ConvolutionRawImage_hpp */
@@ -9,6 +9,7 @@
 #include "ConvolutionTiledExecutor.hpp"
 #include <MNN/AutoTime.hpp>
 #include "backend/cpu/CPUBackend.hpp"
+#include "backend/cpu/CPUWeightCache.hpp"
 #include "CommonOptFunction.h"
 #include "core/Concurrency.h"
 #include "ConvOpt.h"
@@ -89,15 +90,33 @@ ConvolutionTiledExecutor::ConvolutionTiledExecutor(const Convolution2DCommon* co
 
     // Don't use common->inputCount for old model common->inputCount is zero
     auto srcCount    = (int)originWeightSize / outputCount / common->kernelX() / common->kernelY();
-    mWeight.reset(Tensor::createDevice<float>(
-        {UP_DIV(outputCount, hP), UP_DIV(srcCount, 4), (int)common->kernelX(), common->kernelY(), 4 * hP}));
+    std::vector<int> weightShape{UP_DIV(outputCount, hP), UP_DIV(srcCount, 4), (int)common->kernelX(), common->kernelY(), 4 * hP};
     std::shared_ptr<Tensor> cache(Tensor::createDevice<float>({outputCount, srcCount * common->kernelX() * common->kernelY()}));
-    mValid = backend()->onAcquireBuffer(mWeight.get(), Backend::STATIC) && backend()->onAcquireBuffer(cache.get(), Backend::STATIC);
-    if (!mValid) {
-        return;
+    if (((CPUBackend*)b)->shareWeight()) {
+        mShareWeight = true;
+        mWeight = CPUWeightCache::acquire({CPUWeightCache::TILED, outputCount, srcCount, common->kernelX(), common->kernelY(), hP},
+                                          originWeight, originWeightSize * sizeof(float), [&]() {
+            std::shared_ptr<Tensor> weight(Tensor::create<float>(weightShape));
+            if (nullptr != weight->host<float>() && backend()->onAcquireBuffer(cache.get(), Backend::STATIC)) {
+                _initWeight(weight->host<float>(), originWeight, cache->host<float>(), srcCount, outputCount, common->kernelX() * common->kernelY());
+                backend()->onReleaseBuffer(cache.get(), Backend::STATIC);
+                return weight;
+            }
+            return std::shared_ptr<Tensor>(nullptr);
+        });
+        mValid = nullptr != mWeight;
+        if (!mValid) {
+            return;
+        }
+    } else {
+        mWeight.reset(Tensor::createDevice<float>(weightShape));
+        mValid = backend()->onAcquireBuffer(mWeight.get(), Backend::STATIC) && backend()->onAcquireBuffer(cache.get(), Backend::STATIC);
+        if (!mValid) {
+            return;
+        }
+        _initWeight(mWeight->host<float>(), originWeight, cache->host<float>(), srcCount, outputCount, common->kernelX() * common->kernelY());
+        backend()->onReleaseBuffer(cache.get(), Backend::STATIC);
     }
-    _initWeight(mWeight->host<float>(), originWeight, cache->host<float>(), srcCount, outputCount, common->kernelX() * common->kernelY());
-    backend()->onReleaseBuffer(cache.get(), Backend::STATIC);
     mBias.reset(Tensor::createDevice<float>({ALIGN_UP4((int)biasSize)}));
     mValid = backend()->onAcquireBuffer(mBias.get(), Backend::STATIC);
     if (!mValid) {
@@ -111,7 +130,7 @@ ConvolutionTiledExecutor::~ConvolutionTiledExecutor() {
     if (nullptr != mBias) {
         backend()->onReleaseBuffer(mBias.get(), Backend::STATIC);
     }
-    if (nullptr != mWeight) {
+    if (nullptr != mWeight && !mShareWeight) {
         backend()->onReleaseBuffer(mWeight.get(), Backend::STATIC);
     }
 }
@@ -60,6 +60,8 @@ protected:
     std::shared_ptr<Tensor> mBias;
     std::shared_ptr<ConvolutionTiledExecutorBasic> mProxy;
     std::vector<Tensor *> mInputs;
+    // mWeight is hold by CPUWeightCache, not by backend
+    bool mShareWeight = false;
 };
 } // namespace MNN
 
@@ -9,6 +9,7 @@
 #include "backend/cpu/compute/ConvolutionWinograd.hpp"
 #include <math.h>
 #include "backend/cpu/compute/CommonOptFunction.h"
+#include "backend/cpu/CPUWeightCache.hpp"
 #include "core/Concurrency.h"
 #include "backend/cpu/compute/ConvOpt.h"
 #include "core/Macro.h"
@@ -90,6 +91,19 @@ ConvolutionWinograd::ConvolutionWinograd(const Convolution2DCommon *convOp, cons
     auto G = generator.G();
     std::shared_ptr<Tensor> sourceWeight(Tensor::create<float>(
         std::vector<int>{outputCount, srcCount, kernelSize, kernelSize}, (void *)originWeight, Tensor::CAFFE));
+    if (((CPUBackend *)b)->shareWeight()) {
+        mShareWeight = true;
+        mWeight      = CPUWeightCache::acquire({CPUWeightCache::WINOGRAD, outputCount, srcCount, kernelSize, unit, hPack},
+                                          originWeight, originWeightSize * sizeof(float), [&]() {
+                                              auto weight = generator.allocTransformWeight(sourceWeight.get(), 1, hPack);
+                                              if (nullptr != weight->host<float>()) {
+                                                  generator.transformWeight(weight.get(), sourceWeight.get());
+                                              }
+                                              return weight;
+                                          });
+        mValid = nullptr != mWeight;
+        return;
+    }
     mWeight = generator.allocTransformWeight(sourceWeight.get(), 1, hPack, false);
     mValid  = backend()->onAcquireBuffer(mWeight.get(), Backend::STATIC);
     if (!mValid) {
@@ -101,7 +115,7 @@ ConvolutionWinograd::~ConvolutionWinograd() {
     if (nullptr != mBias) {
         backend()->onReleaseBuffer(mBias.get(), Backend::STATIC);
     }
-    if (nullptr != mWeight) {
+    if (nullptr != mWeight && !mShareWeight) {
         backend()->onReleaseBuffer(mWeight.get(), Backend::STATIC);
     }
 }
@@ -378,6 +392,23 @@ int ConvolutionWinograd::bestWinogradUnit(const Convolution2DCommon *common, con
     return unit;
 }
 
+std::vector<int> ConvolutionWinograd::supportWinogradUnits(const Convolution2DCommon *common) {
+    std::vector<int> units;
+    auto kernelSize = common->kernelY();
+    static std::set<int> supportSu{4, 6, 8};
+    for (int u = CONVOLUTION_WINOGRAD_MIN_UNIT; u <= CONVOLUTION_WINOGRAD_MAX_UNIT; ++u) {
+        auto sui = u + kernelSize - 1;
+        if (supportSu.find(sui) == supportSu.end()) {
+            continue;
+        }
+        if (nullptr == WinogradFunction::chooseDestTransform(sui, u)) {
+            continue;
+        }
+        units.emplace_back(u);
+    }
+    return units;
+}
+
 bool ConvolutionWinograd::canUseWinograd(const Convolution2DCommon *common) {
     if (common->kernelY() != common->kernelX() || common->kernelY() <= 1) {
         return false;
@@ -26,12 +26,15 @@ public:
     static bool canUseWinograd(const Convolution2DCommon *convOp);
     static int bestWinogradUnit(const Convolution2DCommon *convOp, const Tensor *input, const Tensor *output,
                                 int threadnumber);
+    static std::vector<int> supportWinogradUnits(const Convolution2DCommon *convOp);
 
 private:
     std::shared_ptr<Tensor> mBias;
     std::shared_ptr<Tensor> mA;
     std::shared_ptr<Tensor> mB;
     std::shared_ptr<Tensor> mWeight;
+    // mWeight is hold by CPUWeightCache, not by backend
+    bool mShareWeight = false;
 
     Tensor mTempBuffer;
     Tensor mTransformMidBuffer;
@@ -186,6 +186,8 @@ void MNNGemmInt8AddBiasScale_ARMV82_Unit(int8_t* dst, const int8_t* src, const i
 
 #ifdef MNN_USE_NEON
 #include <arm_neon.h>
+#elif defined(MNN_USE_SSE)
+#include <emmintrin.h>
 #endif
 
 void MNNInt8ToInt16C4(const int8_t* source, int16_t* dest, size_t sizeQuad) {
@@ -264,20 +266,94 @@ void MNNInt8C4ToC8(int8_t* dst, const int8_t* src, size_t area, size_t depth) {
 }
 
 void MNNInt8ClipInplace(int8_t* data, size_t size, int8_t minVal, int8_t maxVal) {
+    size_t start = 0;
+#ifdef MNN_USE_NEON
     auto sizeC8 = size / 8;
     for (int i = 0; i < sizeC8; ++i) {
         int8_t* ptr = data + i * 8;
-#ifdef MNN_USE_NEON
         auto s = vld1_s8(ptr);
         auto d = vmin_s8(vmax_s8(s, vdup_n_s8(minVal)), vdup_n_s8(maxVal));
         vst1_s8(ptr, d);
+    }
+    start = sizeC8 * 8;
+#elif defined(MNN_USE_SSE)
+    // SSE2 has no signed 8 bit min / max, clip in the unsigned domain instead
+    auto offset  = _mm_set1_epi8((char)0x80);
+    auto minV    = _mm_xor_si128(_mm_set1_epi8(minVal), offset);
+    auto maxV    = _mm_xor_si128(_mm_set1_epi8(maxVal), offset);
+    auto sizeC16 = size / 16;
+    for (int i = 0; i < sizeC16; ++i) {
+        auto ptr = (__m128i*)(data + i * 16);
+        auto s   = _mm_xor_si128(_mm_loadu_si128(ptr), offset);
+        _mm_storeu_si128(ptr, _mm_xor_si128(_mm_min_epu8(_mm_max_epu8(s, minV), maxV), offset));
+    }
+    start = sizeC16 * 16;
+#endif
+    for (auto i = start; i < size; ++i) {
+        data[i] = ALIMIN(ALIMAX(data[i], minVal), maxVal);
+    }
+}
+
+#ifndef MNN_USE_SSE
+#include <math.h>
+
+#ifdef MNN_USE_NEON
+// Same as roundf: half away from zero
+static inline float32x4_t _roundHalfAwayFromZero(float32x4_t v) {
+#ifdef __aarch64__
+    return vrndaq_f32(v);
 #else
-        for (int j=0; j<8; ++j) {
-            ptr[j] = ALIMIN(ALIMAX(ptr[j], minVal), maxVal);
-        }
+    auto integer  = vcvtq_f32_s32(vcvtq_s32_f32(v));
+    auto signOne  = vbslq_f32(vcltq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(-1.0f), vdupq_n_f32(1.0f));
+    auto half     = vcgeq_f32(vabsq_f32(vsubq_f32(v, integer)), vdupq_n_f32(0.5f));
+    return vaddq_f32(integer, vbslq_f32(half, signOne, vdupq_n_f32(0.0f)));
 #endif
+}
+#endif
+
+void MNNFloat2Int8WithZero(const float* src, int8_t* dst, size_t sizeQuad, const float* scalep, ssize_t minValue,
+                           ssize_t maxValue, ssize_t zeroPoint) {
+    int i = 0;
+#ifdef MNN_USE_NEON
+    // The bounds are integers, so clamping before rounding gives the same result as clamping after it
+    auto scale = vld1q_f32(scalep);
+    auto minV  = vdupq_n_f32((float)(minValue - zeroPoint));
+    auto maxV  = vdupq_n_f32((float)(maxValue - zeroPoint));
+    auto zero  = vdupq_n_s32((int32_t)zeroPoint);
+    for (; i + 1 < sizeQuad; i += 2) {
+        auto v0 = vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(src + 4 * i), scale), minV), maxV);
+        auto v1 = vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(src + 4 * i + 4), scale), minV), maxV);
+        auto d0 = vaddq_s32(vcvtq_s32_f32(_roundHalfAwayFromZero(v0)), zero);
+        auto d1 = vaddq_s32(vcvtq_s32_f32(_roundHalfAwayFromZero(v1)), zero);
+        vst1_s8(dst + 4 * i, vmovn_s16(vcombine_s16(vmovn_s32(d0), vmovn_s32(d1))));
     }
-    for (auto i = sizeC8 * 8; i < size; ++i) {
-        data[i] = ALIMIN(ALIMAX(data[i], minVal), maxVal);
+#endif
+    for (; i < sizeQuad; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            int v = (int)roundf(src[4 * i + j] * scalep[j]) + (int)zeroPoint;
+            dst[4 * i + j] = (int8_t)ALIMIN(ALIMAX(v, (int)minValue), (int)maxValue);
+        }
     }
 }
+
+void MNNInt8ScaleToFloatWithZero(float* dst, const int8_t* src, const float* scale, size_t sizeQuad,
+                                 ssize_t zeroPoint) {
+    int i = 0;
+#ifdef MNN_USE_NEON
+    auto scaleV = vld1q_f32(scale);
+    auto zero   = vdupq_n_s32((int32_t)zeroPoint);
+    for (; i + 1 < sizeQuad; i += 2) {
+        auto s  = vmovl_s8(vld1_s8(src + 4 * i));
+        auto s0 = vsubq_s32(vmovl_s16(vget_low_s16(s)), zero);
+        auto s1 = vsubq_s32(vmovl_s16(vget_high_s16(s)), zero);
+        vst1q_f32(dst + 4 * i, vmulq_f32(vcvtq_f32_s32(s0), scaleV));
+        vst1q_f32(dst + 4 * i + 4, vmulq_f32(vcvtq_f32_s32(s1), scaleV));
+    }
+#endif
+    for (; i < sizeQuad; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            dst[4 * i + j] = (float)(src[4 * i + j] - (int)zeroPoint) * scale[j];
+        }
+    }
+}
+#endif
@@ -36,6 +36,12 @@ void MNNConvRunForUnitDepthWiseInt8(float* dst, const int8_t* src, const int8_t*
 void MNNFloat2Int8(const float* src, int8_t* dst, size_t sizeQuad, const float* scalep, ssize_t minValue,
                    ssize_t maxValue);
 void MNNInt8ToInt16C4(const int8_t* source, int16_t* dest, size_t sizeQuad);
+// dst = clamp(roundf(src * scale) + zeroPoint, minValue, maxValue)
+void MNNFloat2Int8WithZero(const float* src, int8_t* dst, size_t sizeQuad, const float* scalep, ssize_t minValue,
+                           ssize_t maxValue, ssize_t zeroPoint);
+// dst = (src - zeroPoint) * scale
+void MNNInt8ScaleToFloatWithZero(float* dst, const int8_t* src, const float* scale, size_t sizeQuad,
+                                 ssize_t zeroPoint);
 
 void MNNGemmInt8toFloat32_8x4_Unit(float* dst, const int8_t* src, const int8_t* weight, size_t src_depth_quad,
                                    size_t dst_step, size_t dst_depth_quad);
@@ -71,6 +71,23 @@ struct FunctionGroup {
     void (*MNNGemmInt8AddBiasScale_16x4_Unit)(int8_t* dst, const int8_t* src, const int8_t* weight, size_t src_depth_quad, size_t dst_step,
                                               size_t dst_depth_quad, const QuanPostTreatParameters* post) = _SSE_MNNGemmInt8AddBiasScale_16x4_Unit;
     void (*MNNExpC8)(float* dest, const float* source, const float* parameters, size_t countC8) = _SSE_MNNExpC8;
+    void (*MNNFloat2Int8WithZero)(const float* src, int8_t* dst, size_t sizeQuad, const float* scalep,
+                                  ssize_t minValue, ssize_t maxValue,
+                                  ssize_t zeroPoint)                         = _SSE_MNNFloat2Int8WithZero;
+    void (*MNNInt8ScaleToFloatWithZero)(float* dst, const int8_t* src, const float* scale, size_t sizeQuad,
+                                        ssize_t zeroPoint)                   = _SSE_MNNInt8ScaleToFloatWithZero;
+    void (*MNNSamplerC4BilinearOpt)(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                    size_t xMax, size_t yMax, size_t yStride) = _SSE_MNNSamplerC4BilinearOpt;
+    void (*MNNSamplerC1BilinearOpt)(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                    size_t xMax, size_t yMax, size_t yStride) = _SSE_MNNSamplerC1BilinearOpt;
+    void (*MNNSamplerC4NearestOpt)(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                   size_t xMax, size_t yMax, size_t yStride)  = _SSE_MNNSamplerC4NearestOpt;
+    void (*MNNSamplerC1NearestOpt)(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                   size_t xMax, size_t yMax, size_t yStride)  = _SSE_MNNSamplerC1NearestOpt;
+    void (*MNNBlitC4ToFloatC4)(const unsigned char* source, float* dest, const float* mean, const float* normal,
+                               size_t count)                                 = _SSE_MNNBlitC4ToFloatC4;
+    void (*MNNBlitC3ToFloatRGBA)(const unsigned char* source, float* dest, const float* mean, const float* normal,
+                                 size_t count)                               = _SSE_MNNBlitC3ToFloatRGBA;
 };
 
 static FunctionGroup gFunc;
@@ -90,6 +107,14 @@ void MNNFunctionInit() {
         gFunc.MNNPackC4ForMatMul_A  = _AVX_MNNPackC4ForMatMul_A;
         gFunc.MNNConvRunForLineDepthwise = _AVX_MNNConvRunForLineDepthwise;
         gFunc.MNNGemmInt8AddBiasScale_16x4_Unit = _AVX_MNNGemmInt8AddBiasScale_16x4_Unit;
+        gFunc.MNNFloat2Int8WithZero             = _AVX_MNNFloat2Int8WithZero;
+        gFunc.MNNInt8ScaleToFloatWithZero       = _AVX_MNNInt8ScaleToFloatWithZero;
+        gFunc.MNNSamplerC4BilinearOpt = _AVX_MNNSamplerC4BilinearOpt;
+        gFunc.MNNSamplerC1BilinearOpt = _AVX_MNNSamplerC1BilinearOpt;
+        gFunc.MNNSamplerC4NearestOpt  = _AVX_MNNSamplerC4NearestOpt;
+        gFunc.MNNSamplerC1NearestOpt  = _AVX_MNNSamplerC1NearestOpt;
+        gFunc.MNNBlitC4ToFloatC4      = _AVX_MNNBlitC4ToFloatC4;
+        gFunc.MNNBlitC3ToFloatRGBA    = _AVX_MNNBlitC3ToFloatRGBA;
         if (cpuFlags & libyuv::kCpuHasFMA3) {
             gFunc.MNNGemmFloatUnit_4    = _AVX_MNNGemmFloatUnitFMA_4;
             gFunc.MNNGemmFloatCommon_4  = _AVX_MNNGemmFloatCommonFMA_4;
@@ -357,3 +382,41 @@ void MNNGemmInt8AddBiasScale_16x4_Unit(int8_t* dst, const int8_t* src, const int
                                               size_t dst_depth_quad, const QuanPostTreatParameters* post) {
     return gFunc.MNNGemmInt8AddBiasScale_16x4_Unit(dst, src, weight, src_depth_quad, dst_step, dst_depth_quad, post);
 }
+
+void MNNFloat2Int8WithZero(const float* src, int8_t* dst, size_t sizeQuad, const float* scalep, ssize_t minValue,
+                           ssize_t maxValue, ssize_t zeroPoint) {
+    return gFunc.MNNFloat2Int8WithZero(src, dst, sizeQuad, scalep, minValue, maxValue, zeroPoint);
+}
+
+void MNNInt8ScaleToFloatWithZero(float* dst, const int8_t* src, const float* scale, size_t sizeQuad,
+                                 ssize_t zeroPoint) {
+    return gFunc.MNNInt8ScaleToFloatWithZero(dst, src, scale, sizeQuad, zeroPoint);
+}
+
+// ========= ImageSampler.cpp / ImageFloatBlitter.cpp ===========
+extern "C" {
+void MNNSamplerC4BilinearOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count, size_t xMax,
+                             size_t yMax, size_t yStride) {
+    gFunc.MNNSamplerC4BilinearOpt(source, dest, points, count, xMax, yMax, yStride);
+}
+void MNNSamplerC1BilinearOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count, size_t xMax,
+                             size_t yMax, size_t yStride) {
+    gFunc.MNNSamplerC1BilinearOpt(source, dest, points, count, xMax, yMax, yStride);
+}
+void MNNSamplerC4NearestOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count, size_t iw,
+                            size_t ih, size_t yStride) {
+    gFunc.MNNSamplerC4NearestOpt(source, dest, points, count, iw, ih, yStride);
+}
+void MNNSamplerC1NearestOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count, size_t iw,
+                            size_t ih, size_t yStride) {
+    gFunc.MNNSamplerC1NearestOpt(source, dest, points, count, iw, ih, yStride);
+}
+void MNNBlitC4ToFloatC4(const unsigned char* source, float* dest, const float* mean, const float* normal,
+                        size_t count) {
+    gFunc.MNNBlitC4ToFloatC4(source, dest, mean, normal, count);
+}
+void MNNBlitC3ToFloatRGBA(const unsigned char* source, float* dest, const float* mean, const float* normal,
+                          size_t count) {
+    gFunc.MNNBlitC3ToFloatRGBA(source, dest, mean, normal, count);
+}
+}
@@ -286,3 +286,73 @@ void _AVX_MNNConvRunForLineDepthwise(float* dst, const float* src, const float*
         }
     }
 }
+
+// roundf rounds half away from zero, while _mm256_round_ps can only round half to even
+static inline __m256 _roundHalfAwayFromZero(__m256 v) {
+    auto signMask = _mm256_set1_ps(-0.0f);
+    auto integer  = _mm256_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    auto fraction = _mm256_andnot_ps(signMask, _mm256_sub_ps(v, integer));
+    auto signOne  = _mm256_or_ps(_mm256_and_ps(v, signMask), _mm256_set1_ps(1.0f));
+    auto half     = _mm256_cmp_ps(fraction, _mm256_set1_ps(0.5f), _CMP_GE_OQ);
+    return _mm256_add_ps(integer, _mm256_and_ps(half, signOne));
+}
+
+// The bounds are integers, so clamping before rounding gives the same result as clamping after it
+static inline __m256i _float2Int32WithZero(const float* src, __m256 scale, __m256 minValue, __m256 maxValue,
+                                           __m256i zeroPoint) {
+    auto v = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src), scale), minValue), maxValue);
+    return _mm256_add_epi32(_mm256_cvtps_epi32(_roundHalfAwayFromZero(v)), zeroPoint);
+}
+
+void _AVX_MNNFloat2Int8WithZero(const float* src, int8_t* dst, size_t sizeQuad, const float* scalep, ssize_t minValue,
+                                ssize_t maxValue, ssize_t zeroPoint) {
+    auto scale = _mm256_broadcast_ps((const __m128*)scalep);
+    auto minV  = _mm256_set1_ps((float)(minValue - zeroPoint));
+    auto maxV  = _mm256_set1_ps((float)(maxValue - zeroPoint));
+    auto zero  = _mm256_set1_epi32((int32_t)zeroPoint);
+    // The packs work inside each 128 bit lane, the permute puts the quads back in order
+    auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    int i      = 0;
+    for (; i + 7 < sizeQuad; i += 8) {
+        auto s   = src + 4 * i;
+        auto d01 = _mm256_packs_epi32(_float2Int32WithZero(s + 0, scale, minV, maxV, zero),
+                                      _float2Int32WithZero(s + 8, scale, minV, maxV, zero));
+        auto d23 = _mm256_packs_epi32(_float2Int32WithZero(s + 16, scale, minV, maxV, zero),
+                                      _float2Int32WithZero(s + 24, scale, minV, maxV, zero));
+        auto d   = _mm256_permutevar8x32_epi32(_mm256_packs_epi16(d01, d23), order);
+        _mm256_storeu_si256((__m256i*)(dst + 4 * i), d);
+    }
+    for (; i + 1 < sizeQuad; i += 2) {
+        auto d   = _float2Int32WithZero(src + 4 * i, scale, minV, maxV, zero);
+        auto d16 = _mm_packs_epi32(_mm256_castsi256_si128(d), _mm256_extracti128_si256(d, 1));
+        _mm_storel_epi64((__m128i*)(dst + 4 * i), _mm_packs_epi16(d16, d16));
+    }
+    if (i < sizeQuad) {
+        float temp[8] = {0.0f};
+        ::memcpy(temp, src + 4 * i, 4 * sizeof(float));
+        auto d   = _float2Int32WithZero(temp, scale, minV, maxV, zero);
+        auto d16 = _mm_packs_epi32(_mm256_castsi256_si128(d), _mm256_castsi256_si128(d));
+        int32_t v = _mm_cvtsi128_si32(_mm_packs_epi16(d16, d16));
+        ::memcpy(dst + 4 * i, &v, sizeof(int32_t));
+    }
+}
+
+void _AVX_MNNInt8ScaleToFloatWithZero(float* dst, const int8_t* src, const float* scale, size_t sizeQuad,
+                                      ssize_t zeroPoint) {
+    auto scaleV = _mm256_broadcast_ps((const __m128*)scale);
+    auto zero   = _mm256_set1_epi32((int32_t)zeroPoint);
+    int i       = 0;
+    for (; i + 3 < sizeQuad; i += 4) {
+        auto s  = _mm_loadu_si128((const __m128i*)(src + 4 * i));
+        auto s0 = _mm256_sub_epi32(_mm256_cvtepi8_epi32(s), zero);
+        auto s1 = _mm256_sub_epi32(_mm256_cvtepi8_epi32(_mm_srli_si128(s, 8)), zero);
+        _mm256_storeu_ps(dst + 4 * i + 0, _mm256_mul_ps(_mm256_cvtepi32_ps(s0), scaleV));
+        _mm256_storeu_ps(dst + 4 * i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(s1), scaleV));
+    }
+    for (; i < sizeQuad; ++i) {
+        int32_t v;
+        ::memcpy(&v, src + 4 * i, sizeof(int32_t));
+        auto s0 = _mm_sub_epi32(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(v)), _mm256_castsi256_si128(zero));
+        _mm_storeu_ps(dst + 4 * i, _mm_mul_ps(_mm_cvtepi32_ps(s0), _mm256_castps256_ps128(scaleV)));
+    }
+}
@@ -0,0 +1,255 @@
+//
+//  ImageProcessFunction.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/09.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <algorithm>
+#include "FunctionSummary.hpp"
+
+static inline __m256 _avxChannel(__m256i pixels, int channel) {
+    auto mask = _mm256_set1_epi32(0xFF);
+    return _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 8 * channel), mask));
+}
+
+static inline __m128 _avxLoadPixelC4(const unsigned char* source) {
+    return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int32_t*)source)));
+}
+
+void _AVX_MNNSamplerC4BilinearOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                  size_t xMax, size_t yMax, size_t yStride) {
+    float dx    = points[2];
+    float dy    = points[3];
+    float xMaxF = (float)xMax;
+    float yMaxF = (float)yMax;
+    int countC8 = (int)count / 8;
+    if (countC8 > 0) {
+        auto index   = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+        auto dxV     = _mm256_set1_ps(dx);
+        auto dyV     = _mm256_set1_ps(dy);
+        auto xMaxV   = _mm256_set1_ps(xMaxF);
+        auto yMaxV   = _mm256_set1_ps(yMaxF);
+        auto zero    = _mm256_setzero_ps();
+        auto one     = _mm256_set1_ps(1.0f);
+        auto maxV    = _mm256_set1_ps(255.0f);
+        auto strideV = _mm256_set1_epi32((int)yStride);
+        auto bppV    = _mm256_set1_epi32(4);
+        for (int i = 0; i < countC8; ++i) {
+            auto offset = _mm256_add_ps(index, _mm256_set1_ps((float)(8 * i)));
+            auto x      = _mm256_add_ps(_mm256_set1_ps(points[0]), _mm256_mul_ps(offset, dxV));
+            auto y      = _mm256_add_ps(_mm256_set1_ps(points[1]), _mm256_mul_ps(offset, dyV));
+            x           = _mm256_max_ps(_mm256_min_ps(x, xMaxV), zero);
+            y           = _mm256_max_ps(_mm256_min_ps(y, yMaxV), zero);
+            auto x0F    = _mm256_floor_ps(x);
+            auto y0F    = _mm256_floor_ps(y);
+            auto xF     = _mm256_sub_ps(x, x0F);
+            auto yF     = _mm256_sub_ps(y, y0F);
+            auto x0     = _mm256_mullo_epi32(_mm256_cvttps_epi32(x0F), bppV);
+            auto x1     = _mm256_mullo_epi32(_mm256_cvttps_epi32(_mm256_ceil_ps(x)), bppV);
+            auto y0     = _mm256_mullo_epi32(_mm256_cvttps_epi32(y0F), strideV);
+            auto y1     = _mm256_mullo_epi32(_mm256_cvttps_epi32(_mm256_ceil_ps(y)), strideV);
+            auto p00    = _mm256_i32gather_epi32((const int*)source, _mm256_add_epi32(y0, x0), 1);
+            auto p01    = _mm256_i32gather_epi32((const int*)source, _mm256_add_epi32(y0, x1), 1);
+            auto p10    = _mm256_i32gather_epi32((const int*)source, _mm256_add_epi32(y1, x0), 1);
+            auto p11    = _mm256_i32gather_epi32((const int*)source, _mm256_add_epi32(y1, x1), 1);
+            auto w00    = _mm256_mul_ps(_mm256_sub_ps(one, xF), _mm256_sub_ps(one, yF));
+            auto w01    = _mm256_mul_ps(xF, _mm256_sub_ps(one, yF));
+            auto w10    = _mm256_mul_ps(_mm256_sub_ps(one, xF), yF);
+            auto w11    = _mm256_mul_ps(xF, yF);
+            auto result = _mm256_setzero_si256();
+            for (int c = 0; c < 4; ++c) {
+                auto v = _mm256_mul_ps(_avxChannel(p00, c), w00);
+                v      = _mm256_add_ps(v, _mm256_mul_ps(_avxChannel(p01, c), w01));
+                v      = _mm256_add_ps(v, _mm256_mul_ps(_avxChannel(p10, c), w10));
+                v      = _mm256_add_ps(v, _mm256_mul_ps(_avxChannel(p11, c), w11));
+                auto d = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(v, zero), maxV));
+                result = _mm256_or_si256(result, _mm256_slli_epi32(d, 8 * c));
+            }
+            _mm256_storeu_si256((__m256i*)(dest + 32 * i), result);
+        }
+    }
+    auto zero = _mm_set1_ps(0.0f);
+    auto maxV = _mm_set1_ps(255.0f);
+    for (int i = countC8 * 8; i < count; ++i) {
+        float x  = std::max(std::min(points[0] + dx * i, xMaxF), 0.0f);
+        float y  = std::max(std::min(points[1] + dy * i, yMaxF), 0.0f);
+        int x0   = (int)x;
+        int y0   = (int)y;
+        int x1   = (int)ceilf(x);
+        int y1   = (int)ceilf(y);
+        float xF = x - (float)x0;
+        float yF = y - (float)y0;
+        auto v   = _mm_mul_ps(_avxLoadPixelC4(source + y0 * yStride + 4 * x0), _mm_set1_ps((1.0f - xF) * (1.0f - yF)));
+        v = _mm_add_ps(v, _mm_mul_ps(_avxLoadPixelC4(source + y0 * yStride + 4 * x1), _mm_set1_ps(xF * (1.0f - yF))));
+        v = _mm_add_ps(v, _mm_mul_ps(_avxLoadPixelC4(source + y1 * yStride + 4 * x0), _mm_set1_ps((1.0f - xF) * yF)));
+        v = _mm_add_ps(v, _mm_mul_ps(_avxLoadPixelC4(source + y1 * yStride + 4 * x1), _mm_set1_ps(xF * yF)));
+        auto d = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, zero), maxV));
+        d      = _mm_packus_epi16(_mm_packs_epi32(d, d), d);
+        *(int32_t*)(dest + 4 * i) = _mm_cvtsi128_si32(d);
+    }
+    _mm256_zeroall();
+}
+
+void _AVX_MNNBlitC4ToFloatC4(const unsigned char* source, float* dest, const float* mean, const float* normal,
+                             size_t count) {
+    auto meanV   = _mm256_broadcast_ps((const __m128*)mean);
+    auto normalV = _mm256_broadcast_ps((const __m128*)normal);
+    int countC4  = (int)count / 4;
+    for (int i = 0; i < countC4; ++i) {
+        auto s  = _mm_loadu_si128((const __m128i*)(source + 16 * i));
+        auto f0 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(s));
+        auto f1 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(s, 8)));
+        _mm256_storeu_ps(dest + 16 * i + 0, _mm256_mul_ps(_mm256_sub_ps(f0, meanV), normalV));
+        _mm256_storeu_ps(dest + 16 * i + 8, _mm256_mul_ps(_mm256_sub_ps(f1, meanV), normalV));
+    }
+    for (int i = countC4 * 4; i < count; ++i) {
+        auto s = _avxLoadPixelC4(source + 4 * i);
+        _mm_storeu_ps(dest + 4 * i, _mm_mul_ps(_mm_sub_ps(s, _mm_loadu_ps(mean)), _mm_loadu_ps(normal)));
+    }
+    _mm256_zeroall();
+}
+
+void _AVX_MNNBlitC3ToFloatRGBA(const unsigned char* source, float* dest, const float* mean, const float* normal,
+                               size_t count) {
+    // RGBRGBRGBRGB -> RGB0RGB0RGB0RGB0, the alpha is (0 - 0) * 0
+    auto meanV       = _mm256_setr_ps(mean[0], mean[1], mean[2], 0.0f, mean[0], mean[1], mean[2], 0.0f);
+    auto normalV     = _mm256_setr_ps(normal[0], normal[1], normal[2], 0.0f, normal[0], normal[1], normal[2], 0.0f);
+    const __m128i rM = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    int i            = 0;
+    // Load 16 bytes for 4 pixels, avoid reading over the end
+    for (; i + 6 <= count; i += 4) {
+        auto s  = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + 3 * i)), rM);
+        auto f0 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(s));
+        auto f1 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(s, 8)));
+        _mm256_storeu_ps(dest + 4 * i + 0, _mm256_mul_ps(_mm256_sub_ps(f0, meanV), normalV));
+        _mm256_storeu_ps(dest + 4 * i + 8, _mm256_mul_ps(_mm256_sub_ps(f1, meanV), normalV));
+    }
+    for (; i < count; ++i) {
+        dest[4 * i + 0] = normal[0] * (source[3 * i + 0] - mean[0]);
+        dest[4 * i + 1] = normal[1] * (source[3 * i + 1] - mean[1]);
+        dest[4 * i + 2] = normal[2] * (source[3 * i + 2] - mean[2]);
+        dest[4 * i + 3] = 0.0f;
+    }
+    _mm256_zeroall();
+}
+
+// Gather the bytes at offset by the 4 bytes ending at it, the bytes before the source start are not read. The source
+// has 4 bytes at least.
+static inline __m256i _avxGatherC1(const unsigned char* source, __m256i offset) {
+    auto base  = _mm256_max_epi32(_mm256_sub_epi32(offset, _mm256_set1_epi32(3)), _mm256_setzero_si256());
+    auto shift = _mm256_slli_epi32(_mm256_sub_epi32(offset, base), 3);
+    auto value = _mm256_i32gather_epi32((const int*)source, base, 1);
+    return _mm256_and_si256(_mm256_srlv_epi32(value, shift), _mm256_set1_epi32(0xFF));
+}
+
+// 8 dest pixels of int32 to the bytes
+static inline int64_t _avxPackC1(__m256i d) {
+    auto u16 = _mm_packs_epi32(_mm256_castsi256_si128(d), _mm256_extracti128_si256(d, 1));
+    return _mm_cvtsi128_si64(_mm_packus_epi16(u16, u16));
+}
+
+void _AVX_MNNSamplerC1BilinearOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                  size_t xMax, size_t yMax, size_t yStride) {
+    float dx    = points[2];
+    float dy    = points[3];
+    float xMaxF = (float)xMax;
+    float yMaxF = (float)yMax;
+    int countC8 = yMax * yStride + xMax >= 3 ? (int)count / 8 : 0;
+    if (countC8 > 0) {
+        auto index   = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+        auto dxV     = _mm256_set1_ps(dx);
+        auto dyV     = _mm256_set1_ps(dy);
+        auto xMaxV   = _mm256_set1_ps(xMaxF);
+        auto yMaxV   = _mm256_set1_ps(yMaxF);
+        auto zero    = _mm256_setzero_ps();
+        auto one     = _mm256_set1_ps(1.0f);
+        auto maxV    = _mm256_set1_ps(255.0f);
+        auto strideV = _mm256_set1_epi32((int)yStride);
+        for (int i = 0; i < countC8; ++i) {
+            auto offset = _mm256_add_ps(index, _mm256_set1_ps((float)(8 * i)));
+            auto x      = _mm256_add_ps(_mm256_set1_ps(points[0]), _mm256_mul_ps(offset, dxV));
+            auto y      = _mm256_add_ps(_mm256_set1_ps(points[1]), _mm256_mul_ps(offset, dyV));
+            x           = _mm256_max_ps(_mm256_min_ps(x, xMaxV), zero);
+            y           = _mm256_max_ps(_mm256_min_ps(y, yMaxV), zero);
+            auto x0F    = _mm256_floor_ps(x);
+            auto y0F    = _mm256_floor_ps(y);
+            auto xF     = _mm256_sub_ps(x, x0F);
+            auto yF     = _mm256_sub_ps(y, y0F);
+            auto x0     = _mm256_cvttps_epi32(x0F);
+            auto x1     = _mm256_cvttps_epi32(_mm256_ceil_ps(x));
+            auto y0     = _mm256_mullo_epi32(_mm256_cvttps_epi32(y0F), strideV);
+            auto y1     = _mm256_mullo_epi32(_mm256_cvttps_epi32(_mm256_ceil_ps(y)), strideV);
+            auto c00    = _mm256_cvtepi32_ps(_avxGatherC1(source, _mm256_add_epi32(y0, x0)));
+            auto c01    = _mm256_cvtepi32_ps(_avxGatherC1(source, _mm256_add_epi32(y0, x1)));
+            auto c10    = _mm256_cvtepi32_ps(_avxGatherC1(source, _mm256_add_epi32(y1, x0)));
+            auto c11    = _mm256_cvtepi32_ps(_avxGatherC1(source, _mm256_add_epi32(y1, x1)));
+            auto v      = _mm256_mul_ps(c00, _mm256_mul_ps(_mm256_sub_ps(one, xF), _mm256_sub_ps(one, yF)));
+            v           = _mm256_add_ps(v, _mm256_mul_ps(c01, _mm256_mul_ps(xF, _mm256_sub_ps(one, yF))));
+            v           = _mm256_add_ps(v, _mm256_mul_ps(c10, _mm256_mul_ps(_mm256_sub_ps(one, xF), yF)));
+            v           = _mm256_add_ps(v, _mm256_mul_ps(c11, _mm256_mul_ps(xF, yF)));
+            auto d      = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(v, zero), maxV));
+            *(int64_t*)(dest + 8 * i) = _avxPackC1(d);
+        }
+    }
+    for (int i = countC8 * 8; i < count; ++i) {
+        float x  = std::max(std::min(points[0] + dx * i, xMaxF), 0.0f);
+        float y  = std::max(std::min(points[1] + dy * i, yMaxF), 0.0f);
+        int x0   = (int)x;
+        int y0   = (int)y;
+        int x1   = (int)ceilf(x);
+        int y1   = (int)ceilf(y);
+        float xF = x - (float)x0;
+        float yF = y - (float)y0;
+        float v  = (1.0f - xF) * (1.0f - yF) * source[y0 * yStride + x0] + xF * (1.0f - yF) * source[y0 * yStride + x1] +
+                  (1.0f - xF) * yF * source[y1 * yStride + x0] + xF * yF * source[y1 * yStride + x1];
+        dest[i] = (unsigned char)std::min(std::max(v, 0.0f), 255.0f);
+    }
+    _mm256_zeroall();
+}
+
+// Offsets of the nearest source pixels of 8 dest pixels, round half away from zero like roundf for x >= 0
+static inline __m256i _avxNearestOffset(float* points, int i, float xMax, float yMax, int bpp, int yStride) {
+    auto offset = _mm256_add_ps(_mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f),
+                                _mm256_set1_ps((float)i));
+    auto half   = _mm256_set1_ps(0.5f);
+    auto zero   = _mm256_setzero_ps();
+    auto x      = _mm256_add_ps(_mm256_set1_ps(points[0]), _mm256_mul_ps(offset, _mm256_set1_ps(points[2])));
+    auto y      = _mm256_add_ps(_mm256_set1_ps(points[1]), _mm256_mul_ps(offset, _mm256_set1_ps(points[3])));
+    x = _mm256_floor_ps(_mm256_add_ps(_mm256_max_ps(_mm256_min_ps(x, _mm256_set1_ps(xMax)), zero), half));
+    y = _mm256_floor_ps(_mm256_add_ps(_mm256_max_ps(_mm256_min_ps(y, _mm256_set1_ps(yMax)), zero), half));
+    return _mm256_add_epi32(_mm256_mullo_epi32(_mm256_cvttps_epi32(y), _mm256_set1_epi32(yStride)),
+                            _mm256_mullo_epi32(_mm256_cvttps_epi32(x), _mm256_set1_epi32(bpp)));
+}
+
+void _AVX_MNNSamplerC4NearestOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                 size_t xMax, size_t yMax, size_t yStride) {
+    int countC8 = (int)count / 8;
+    for (int i = 0; i < countC8; ++i) {
+        auto offset = _avxNearestOffset(points, 8 * i, (float)xMax, (float)yMax, 4, (int)yStride);
+        _mm256_storeu_si256((__m256i*)(dest + 32 * i), _mm256_i32gather_epi32((const int*)source, offset, 1));
+    }
+    for (int i = countC8 * 8; i < count; ++i) {
+        int x = (int)roundf(std::max(std::min(points[0] + points[2] * i, (float)xMax), 0.0f));
+        int y = (int)roundf(std::max(std::min(points[1] + points[3] * i, (float)yMax), 0.0f));
+        *(int32_t*)(dest + 4 * i) = *(const int32_t*)(source + y * yStride + 4 * x);
+    }
+    _mm256_zeroall();
+}
+
+void _AVX_MNNSamplerC1NearestOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                 size_t xMax, size_t yMax, size_t yStride) {
+    int countC8 = yMax * yStride + xMax >= 3 ? (int)count / 8 : 0;
+    for (int i = 0; i < countC8; ++i) {
+        auto offset = _avxNearestOffset(points, 8 * i, (float)xMax, (float)yMax, 1, (int)yStride);
+        *(int64_t*)(dest + 8 * i) = _avxPackC1(_avxGatherC1(source, offset));
+    }
+    for (int i = countC8 * 8; i < count; ++i) {
+        int x   = (int)roundf(std::max(std::min(points[0] + points[2] * i, (float)xMax), 0.0f));
+        int y   = (int)roundf(std::max(std::min(points[1] + points[3] * i, (float)yMax), 0.0f));
+        dest[i] = source[y * yStride + x];
+    }
+    _mm256_zeroall();
+}
@@ -218,3 +218,65 @@ void _SSE_MNNExpC8(float* dest, const float* source, const float* parameters, si
         _mm_store_ps(dest + 4 * i, _mm_mul_ps(expBasic, expRemain));
     }
 }
+
+// roundf rounds half away from zero, while _mm_round_ps can only round half to even
+static inline __m128 _roundHalfAwayFromZero(__m128 v) {
+    auto signMask = _mm_set1_ps(-0.0f);
+    auto integer  = _mm_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    auto fraction = _mm_andnot_ps(signMask, _mm_sub_ps(v, integer));
+    auto signOne  = _mm_or_ps(_mm_and_ps(v, signMask), _mm_set1_ps(1.0f));
+    return _mm_add_ps(integer, _mm_and_ps(_mm_cmpge_ps(fraction, _mm_set1_ps(0.5f)), signOne));
+}
+
+// The bounds are integers, so clamping before rounding gives the same result as clamping after it
+static inline __m128i _float2Int32WithZero(const float* src, __m128 scale, __m128 minValue, __m128 maxValue,
+                                           __m128i zeroPoint) {
+    auto v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src), scale), minValue), maxValue);
+    return _mm_add_epi32(_mm_cvtps_epi32(_roundHalfAwayFromZero(v)), zeroPoint);
+}
+
+void _SSE_MNNFloat2Int8WithZero(const float* src, int8_t* dst, size_t sizeQuad, const float* scalep, ssize_t minValue,
+                                ssize_t maxValue, ssize_t zeroPoint) {
+    auto scale = _mm_loadu_ps(scalep);
+    auto minV  = _mm_set1_ps((float)(minValue - zeroPoint));
+    auto maxV  = _mm_set1_ps((float)(maxValue - zeroPoint));
+    auto zero  = _mm_set1_epi32((int32_t)zeroPoint);
+    int i      = 0;
+    for (; i + 3 < sizeQuad; i += 4) {
+        auto s   = src + 4 * i;
+        auto d01 = _mm_packs_epi32(_float2Int32WithZero(s + 0, scale, minV, maxV, zero),
+                                   _float2Int32WithZero(s + 4, scale, minV, maxV, zero));
+        auto d23 = _mm_packs_epi32(_float2Int32WithZero(s + 8, scale, minV, maxV, zero),
+                                   _float2Int32WithZero(s + 12, scale, minV, maxV, zero));
+        _mm_storeu_si128((__m128i*)(dst + 4 * i), _mm_packs_epi16(d01, d23));
+    }
+    for (; i < sizeQuad; ++i) {
+        auto d = _mm_packs_epi32(_float2Int32WithZero(src + 4 * i, scale, minV, maxV, zero), _mm_setzero_si128());
+        int32_t v = _mm_cvtsi128_si32(_mm_packs_epi16(d, d));
+        ::memcpy(dst + 4 * i, &v, sizeof(int32_t));
+    }
+}
+
+void _SSE_MNNInt8ScaleToFloatWithZero(float* dst, const int8_t* src, const float* scale, size_t sizeQuad,
+                                      ssize_t zeroPoint) {
+    auto scaleV = _mm_loadu_ps(scale);
+    auto zero   = _mm_set1_epi32((int32_t)zeroPoint);
+    int i       = 0;
+    for (; i + 3 < sizeQuad; i += 4) {
+        auto s  = _mm_loadu_si128((const __m128i*)(src + 4 * i));
+        auto s0 = _mm_sub_epi32(_mm_cvtepi8_epi32(s), zero);
+        auto s1 = _mm_sub_epi32(_mm_cvtepi8_epi32(_mm_srli_si128(s, 4)), zero);
+        auto s2 = _mm_sub_epi32(_mm_cvtepi8_epi32(_mm_srli_si128(s, 8)), zero);
+        auto s3 = _mm_sub_epi32(_mm_cvtepi8_epi32(_mm_srli_si128(s, 12)), zero);
+        _mm_storeu_ps(dst + 4 * i + 0, _mm_mul_ps(_mm_cvtepi32_ps(s0), scaleV));
+        _mm_storeu_ps(dst + 4 * i + 4, _mm_mul_ps(_mm_cvtepi32_ps(s1), scaleV));
+        _mm_storeu_ps(dst + 4 * i + 8, _mm_mul_ps(_mm_cvtepi32_ps(s2), scaleV));
+        _mm_storeu_ps(dst + 4 * i + 12, _mm_mul_ps(_mm_cvtepi32_ps(s3), scaleV));
+    }
+    for (; i < sizeQuad; ++i) {
+        int32_t v;
+        ::memcpy(&v, src + 4 * i, sizeof(int32_t));
+        auto s0 = _mm_sub_epi32(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(v)), zero);
+        _mm_storeu_ps(dst + 4 * i, _mm_mul_ps(_mm_cvtepi32_ps(s0), scaleV));
+    }
+}
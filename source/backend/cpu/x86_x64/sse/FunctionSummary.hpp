@@ -75,3 +75,21 @@ void _SSE_MNNConvRunForLineDepthwise(float* dst, const float* src, const float*
 void _SSE_MNNGemmInt8AddBiasScale_16x4_Unit(int8_t* dst, const int8_t* src, const int8_t* weight, size_t src_depth_quad, size_t dst_step,
                                             size_t dst_depth_quad, const QuanPostTreatParameters* post);
 void _SSE_MNNExpC8(float* dest, const float* source, const float* parameters, size_t countC8);
+void _SSE_MNNFloat2Int8WithZero(const float* src, int8_t* dst, size_t sizeQuad, const float* scalep, ssize_t minValue,
+                                ssize_t maxValue, ssize_t zeroPoint);
+void _SSE_MNNInt8ScaleToFloatWithZero(float* dst, const int8_t* src, const float* scale, size_t sizeQuad,
+                                      ssize_t zeroPoint);
+
+// ========= ImageProcessFunction.cpp ===========
+void _SSE_MNNSamplerC4BilinearOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                  size_t xMax, size_t yMax, size_t yStride);
+void _SSE_MNNSamplerC1BilinearOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                  size_t xMax, size_t yMax, size_t yStride);
+void _SSE_MNNSamplerC4NearestOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                 size_t xMax, size_t yMax, size_t yStride);
+void _SSE_MNNSamplerC1NearestOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                 size_t xMax, size_t yMax, size_t yStride);
+void _SSE_MNNBlitC4ToFloatC4(const unsigned char* source, float* dest, const float* mean, const float* normal,
+                             size_t count);
+void _SSE_MNNBlitC3ToFloatRGBA(const unsigned char* source, float* dest, const float* mean, const float* normal,
+                               size_t count);
@@ -0,0 +1,218 @@
+//
+//  ImageProcessFunction.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/09.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <algorithm>
+#include "FunctionSummary.hpp"
+
+static inline __m128 _sseLoadPixelC4(const unsigned char* source) {
+    return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int32_t*)source)));
+}
+
+void _SSE_MNNSamplerC4BilinearOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                  size_t xMax, size_t yMax, size_t yStride) {
+    float curX   = points[0];
+    float curY   = points[1];
+    float dx     = points[2];
+    float dy     = points[3];
+    float xMaxF  = (float)xMax;
+    float yMaxF  = (float)yMax;
+    auto zero    = _mm_set1_ps(0.0f);
+    auto maxV    = _mm_set1_ps(255.0f);
+    for (int i = 0; i < count; ++i) {
+        float x  = std::max(std::min(curX, xMaxF), 0.0f);
+        float y  = std::max(std::min(curY, yMaxF), 0.0f);
+        int x0   = (int)x;
+        int y0   = (int)y;
+        int x1   = (int)ceilf(x);
+        int y1   = (int)ceilf(y);
+        float xF = x - (float)x0;
+        float yF = y - (float)y0;
+        auto c00 = _sseLoadPixelC4(source + y0 * yStride + 4 * x0);
+        auto c01 = _sseLoadPixelC4(source + y0 * yStride + 4 * x1);
+        auto c10 = _sseLoadPixelC4(source + y1 * yStride + 4 * x0);
+        auto c11 = _sseLoadPixelC4(source + y1 * yStride + 4 * x1);
+        auto v   = _mm_mul_ps(c00, _mm_set1_ps((1.0f - xF) * (1.0f - yF)));
+        v        = _mm_add_ps(v, _mm_mul_ps(c01, _mm_set1_ps(xF * (1.0f - yF))));
+        v        = _mm_add_ps(v, _mm_mul_ps(c10, _mm_set1_ps((1.0f - xF) * yF)));
+        v        = _mm_add_ps(v, _mm_mul_ps(c11, _mm_set1_ps(xF * yF)));
+        auto d   = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, zero), maxV));
+        d        = _mm_packus_epi16(_mm_packs_epi32(d, d), d);
+        *(int32_t*)(dest + 4 * i) = _mm_cvtsi128_si32(d);
+        curX += dx;
+        curY += dy;
+    }
+}
+
+void _SSE_MNNBlitC4ToFloatC4(const unsigned char* source, float* dest, const float* mean, const float* normal,
+                             size_t count) {
+    auto meanV   = _mm_loadu_ps(mean);
+    auto normalV = _mm_loadu_ps(normal);
+    for (int i = 0; i < count; ++i) {
+        auto s = _sseLoadPixelC4(source + 4 * i);
+        _mm_storeu_ps(dest + 4 * i, _mm_mul_ps(_mm_sub_ps(s, meanV), normalV));
+    }
+}
+
+void _SSE_MNNBlitC3ToFloatRGBA(const unsigned char* source, float* dest, const float* mean, const float* normal,
+                               size_t count) {
+    int remain  = 0;
+    int countC4 = count / 4;
+    if (countC4 > 1) {
+        if ((count % 4) * 3 < 4) {
+            // Avoid load extra memory
+            countC4 -= 1;
+        }
+        // RGBRGBRGBRGB -> RGB0 , RGB0, RGB0
+        auto alpha0      = _mm_setr_ps(normal[0], normal[1], normal[2], 0.0f);
+        auto beta0       = _mm_setr_ps(mean[0], mean[1], mean[2], 0.0f);
+        remain           = countC4 * 4;
+        const __m128i rM = _mm_setr_epi8(0, 1, 2, 0, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+        const __m128i gM = _mm_setr_epi8(3, 4, 5, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+        const __m128i bM = _mm_setr_epi8(6, 7, 8, 6, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+        const __m128i aM = _mm_setr_epi8(9, 10, 11, 9, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+        for (int i = 0; i < countC4; ++i) {
+            auto sInt8 = _mm_loadu_si128((const __m128i*)(source + 12 * i));
+            auto s0    = _mm_cvtepu8_epi32(_mm_shuffle_epi8(sInt8, rM));
+            auto s1    = _mm_cvtepu8_epi32(_mm_shuffle_epi8(sInt8, gM));
+            auto s2    = _mm_cvtepu8_epi32(_mm_shuffle_epi8(sInt8, bM));
+            auto s3    = _mm_cvtepu8_epi32(_mm_shuffle_epi8(sInt8, aM));
+
+            auto f0 = _mm_cvtepi32_ps(s0);
+            auto f1 = _mm_cvtepi32_ps(s1);
+            auto f2 = _mm_cvtepi32_ps(s2);
+            auto f3 = _mm_cvtepi32_ps(s3);
+            _mm_storeu_ps(dest + 16 * i + 4 * 0, _mm_mul_ps(_mm_sub_ps(f0, beta0), alpha0));
+            _mm_storeu_ps(dest + 16 * i + 4 * 1, _mm_mul_ps(_mm_sub_ps(f1, beta0), alpha0));
+            _mm_storeu_ps(dest + 16 * i + 4 * 2, _mm_mul_ps(_mm_sub_ps(f2, beta0), alpha0));
+            _mm_storeu_ps(dest + 16 * i + 4 * 3, _mm_mul_ps(_mm_sub_ps(f3, beta0), alpha0));
+        }
+    }
+    for (int i = remain; i < count; ++i) {
+        dest[4 * i + 0] = normal[0] * (source[3 * i + 0] - mean[0]);
+        dest[4 * i + 1] = normal[1] * (source[3 * i + 1] - mean[1]);
+        dest[4 * i + 2] = normal[2] * (source[3 * i + 2] - mean[2]);
+        dest[4 * i + 3] = 0.0f;
+    }
+}
+
+// The coordinates of 4 dest pixels are computed together, the pixels are read one by one
+void _SSE_MNNSamplerC1BilinearOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                  size_t xMax, size_t yMax, size_t yStride) {
+    auto index   = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    auto dxV     = _mm_set1_ps(points[2]);
+    auto dyV     = _mm_set1_ps(points[3]);
+    auto xMaxV   = _mm_set1_ps((float)xMax);
+    auto yMaxV   = _mm_set1_ps((float)yMax);
+    auto zero    = _mm_setzero_ps();
+    auto one     = _mm_set1_ps(1.0f);
+    auto maxV    = _mm_set1_ps(255.0f);
+    auto strideV = _mm_set1_epi32((int)yStride);
+    int countC4  = (int)count / 4;
+    for (int i = 0; i < countC4; ++i) {
+        auto offset = _mm_add_ps(index, _mm_set1_ps((float)(4 * i)));
+        auto x      = _mm_add_ps(_mm_set1_ps(points[0]), _mm_mul_ps(offset, dxV));
+        auto y      = _mm_add_ps(_mm_set1_ps(points[1]), _mm_mul_ps(offset, dyV));
+        x           = _mm_max_ps(_mm_min_ps(x, xMaxV), zero);
+        y           = _mm_max_ps(_mm_min_ps(y, yMaxV), zero);
+        auto x0F    = _mm_floor_ps(x);
+        auto y0F    = _mm_floor_ps(y);
+        auto xF     = _mm_sub_ps(x, x0F);
+        auto yF     = _mm_sub_ps(y, y0F);
+        auto x0     = _mm_cvttps_epi32(x0F);
+        auto x1     = _mm_cvttps_epi32(_mm_ceil_ps(x));
+        auto y0     = _mm_mullo_epi32(_mm_cvttps_epi32(y0F), strideV);
+        auto y1     = _mm_mullo_epi32(_mm_cvttps_epi32(_mm_ceil_ps(y)), strideV);
+        int32_t o00[4], o01[4], o10[4], o11[4];
+        _mm_storeu_si128((__m128i*)o00, _mm_add_epi32(y0, x0));
+        _mm_storeu_si128((__m128i*)o01, _mm_add_epi32(y0, x1));
+        _mm_storeu_si128((__m128i*)o10, _mm_add_epi32(y1, x0));
+        _mm_storeu_si128((__m128i*)o11, _mm_add_epi32(y1, x1));
+        auto c00 = _mm_setr_epi32(source[o00[0]], source[o00[1]], source[o00[2]], source[o00[3]]);
+        auto c01 = _mm_setr_epi32(source[o01[0]], source[o01[1]], source[o01[2]], source[o01[3]]);
+        auto c10 = _mm_setr_epi32(source[o10[0]], source[o10[1]], source[o10[2]], source[o10[3]]);
+        auto c11 = _mm_setr_epi32(source[o11[0]], source[o11[1]], source[o11[2]], source[o11[3]]);
+        auto v   = _mm_mul_ps(_mm_cvtepi32_ps(c00), _mm_mul_ps(_mm_sub_ps(one, xF), _mm_sub_ps(one, yF)));
+        v        = _mm_add_ps(v, _mm_mul_ps(_mm_cvtepi32_ps(c01), _mm_mul_ps(xF, _mm_sub_ps(one, yF))));
+        v        = _mm_add_ps(v, _mm_mul_ps(_mm_cvtepi32_ps(c10), _mm_mul_ps(_mm_sub_ps(one, xF), yF)));
+        v        = _mm_add_ps(v, _mm_mul_ps(_mm_cvtepi32_ps(c11), _mm_mul_ps(xF, yF)));
+        auto d   = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, zero), maxV));
+        d        = _mm_packus_epi16(_mm_packs_epi32(d, d), d);
+        *(int32_t*)(dest + 4 * i) = _mm_cvtsi128_si32(d);
+    }
+    for (int i = countC4 * 4; i < count; ++i) {
+        float x  = std::max(std::min(points[0] + points[2] * i, (float)xMax), 0.0f);
+        float y  = std::max(std::min(points[1] + points[3] * i, (float)yMax), 0.0f);
+        int x0   = (int)x;
+        int y0   = (int)y;
+        int x1   = (int)ceilf(x);
+        int y1   = (int)ceilf(y);
+        float xF = x - (float)x0;
+        float yF = y - (float)y0;
+        float v  = (1.0f - xF) * (1.0f - yF) * source[y0 * yStride + x0] + xF * (1.0f - yF) * source[y0 * yStride + x1] +
+                  (1.0f - xF) * yF * source[y1 * yStride + x0] + xF * yF * source[y1 * yStride + x1];
+        dest[i] = (unsigned char)std::min(std::max(v, 0.0f), 255.0f);
+    }
+}
+
+// Offsets of the nearest source pixels of 4 dest pixels, round half away from zero like roundf for x >= 0
+static inline __m128i _sseNearestOffset(float* points, int i, __m128 xMaxV, __m128 yMaxV, __m128i bppV,
+                                        __m128i strideV) {
+    auto offset = _mm_add_ps(_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f), _mm_set1_ps((float)i));
+    auto half   = _mm_set1_ps(0.5f);
+    auto zero   = _mm_setzero_ps();
+    auto x      = _mm_add_ps(_mm_set1_ps(points[0]), _mm_mul_ps(offset, _mm_set1_ps(points[2])));
+    auto y      = _mm_add_ps(_mm_set1_ps(points[1]), _mm_mul_ps(offset, _mm_set1_ps(points[3])));
+    x           = _mm_floor_ps(_mm_add_ps(_mm_max_ps(_mm_min_ps(x, xMaxV), zero), half));
+    y           = _mm_floor_ps(_mm_add_ps(_mm_max_ps(_mm_min_ps(y, yMaxV), zero), half));
+    return _mm_add_epi32(_mm_mullo_epi32(_mm_cvttps_epi32(y), strideV), _mm_mullo_epi32(_mm_cvttps_epi32(x), bppV));
+}
+
+void _SSE_MNNSamplerC4NearestOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                 size_t xMax, size_t yMax, size_t yStride) {
+    auto xMaxV   = _mm_set1_ps((float)xMax);
+    auto yMaxV   = _mm_set1_ps((float)yMax);
+    auto bppV    = _mm_set1_epi32(4);
+    auto strideV = _mm_set1_epi32((int)yStride);
+    int countC4  = (int)count / 4;
+    for (int i = 0; i < countC4; ++i) {
+        int32_t o[4];
+        _mm_storeu_si128((__m128i*)o, _sseNearestOffset(points, 4 * i, xMaxV, yMaxV, bppV, strideV));
+        auto d = _mm_setr_epi32(*(const int32_t*)(source + o[0]), *(const int32_t*)(source + o[1]),
+                                *(const int32_t*)(source + o[2]), *(const int32_t*)(source + o[3]));
+        _mm_storeu_si128((__m128i*)(dest + 16 * i), d);
+    }
+    for (int i = countC4 * 4; i < count; ++i) {
+        int x = (int)roundf(std::max(std::min(points[0] + points[2] * i, (float)xMax), 0.0f));
+        int y = (int)roundf(std::max(std::min(points[1] + points[3] * i, (float)yMax), 0.0f));
+        *(int32_t*)(dest + 4 * i) = *(const int32_t*)(source + y * yStride + 4 * x);
+    }
+}
+
+void _SSE_MNNSamplerC1NearestOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count,
+                                 size_t xMax, size_t yMax, size_t yStride) {
+    auto xMaxV   = _mm_set1_ps((float)xMax);
+    auto yMaxV   = _mm_set1_ps((float)yMax);
+    auto bppV    = _mm_set1_epi32(1);
+    auto strideV = _mm_set1_epi32((int)yStride);
+    int countC4  = (int)count / 4;
+    for (int i = 0; i < countC4; ++i) {
+        int32_t o[4];
+        _mm_storeu_si128((__m128i*)o, _sseNearestOffset(points, 4 * i, xMaxV, yMaxV, bppV, strideV));
+        dest[4 * i + 0] = source[o[0]];
+        dest[4 * i + 1] = source[o[1]];
+        dest[4 * i + 2] = source[o[2]];
+        dest[4 * i + 3] = source[o[3]];
+    }
+    for (int i = countC4 * 4; i < count; ++i) {
+        int x   = (int)roundf(std::max(std::min(points[0] + points[2] * i, (float)xMax), 0.0f));
+        int y   = (int)roundf(std::max(std::min(points[1] + points[3] * i, (float)yMax), 0.0f));
+        dest[i] = source[y * yStride + x];
+    }
+}
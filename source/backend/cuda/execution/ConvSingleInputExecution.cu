@@ -7,6 +7,7 @@
 //
 
 #include "ConvSingleInputExecution.hpp"
+#include "core/ConvolutionCommon.hpp"
 
 namespace MNN {
 namespace CUDA {
@@ -296,6 +297,10 @@ class CUDAConvolutionCreator : public CUDABackend::Creator {
 public:
     virtual Execution* onCreate(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs, 
             const MNN::Op* op, Backend* backend) const override {
+        // The image preprocess folded by the converter runs on the uint8 input by the CPU only
+        if (ConvolutionCommon::isRawImageConvolution(op, inputs[0])) {
+            return nullptr;
+        }
         if (nullptr != op->main_as_Convolution2D()->quanParameter()) {
             auto quan = op->main_as_Convolution2D()->quanParameter();
             if (1 == quan->type() || 2 == quan->type()) {
@@ -7,6 +7,7 @@
 //
 
 #import "backend/metal/MetalConvolution.hpp"
+#import "core/ConvolutionCommon.hpp"
 #import "core/Macro.h"
 #import "backend/metal/MetalBackend.hpp"
 #import "backend/metal/MetalConvolution1x1.hpp"
@@ -152,6 +153,10 @@ ErrorCode MetalConvolution::onFloat(const Tensor *input, const Tensor *output) {
 class MetalConvolutionCreator : public MetalBackend::Creator {
 public:
     virtual Execution *onCreate(const std::vector<Tensor *> &inputs, const MNN::Op *op, Backend *backend) const {
+        // The image preprocess folded by the converter runs on the uint8 input by the CPU only
+        if (ConvolutionCommon::isRawImageConvolution(op, inputs[0])) {
+            return nullptr;
+        }
         if (op->type() == OpType_Convolution) {
             auto conv  = op->main_as_Convolution2D();
             auto input = inputs[0];
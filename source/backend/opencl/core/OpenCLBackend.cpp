@@ -231,6 +231,24 @@ std::pair<float, bool> OpenCLBackend::onMeasure(const std::vector<Tensor*>& inpu
     auto computeFlops = mOpenCLRuntime->flops();
     return std::make_pair(defaultScheduleTime + flops / 1024.0f / computeFlops * 1000.0f, true);
 }
+// Asymmetric quantization needs zero point aware kernels, which only CPU has
+static bool _isAsymmetricQuan(const MNN::Op* op) {
+    switch (op->type()) {
+        case OpType_ConvInt8:
+        case OpType_DepthwiseConvInt8: {
+            auto quan = op->main_as_Convolution2D()->symmetricQuan();
+            return nullptr != quan && (0 != quan->inputZeroPoint() || 0 != quan->outputZeroPoint());
+        }
+        case OpType_FloatToInt8:
+            return 0 != op->main_as_QuantizedFloatParam()->outputZeroPoint();
+        case OpType_Int8ToFloat:
+            return 0 != op->main_as_QuantizedFloatParam()->inputZeroPoint();
+        default:
+            break;
+    }
+    return false;
+}
+
 Execution* OpenCLBackend::onCreate(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
                                    const MNN::Op* op) {
 #ifdef LOG_VERBOSE
@@ -311,6 +329,11 @@ Execution* OpenCLBackend::onCreate(const std::vector<Tensor*>& inputs, const std
         return NULL;
     }
 
+    if (_isAsymmetricQuan(op)) {
+        MNN_PRINT("asymmetric quantization of %s! fallback to cpu backend\n", EnumNameOpType(op->type()));
+        return NULL;
+    }
+
     auto exe = iter->second->onCreate(inputs, outputs, op, this);
     if (NULL == exe) {
         if (nullptr != op->name()) {
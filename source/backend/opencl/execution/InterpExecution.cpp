@@ -122,7 +122,19 @@ ErrorCode InterpExecution::onExecute(const std::vector<Tensor *> &inputs, const
     return NO_ERROR;
 }
 
-OpenCLCreatorRegister<TypedCreator<InterpExecution>> __Interp_op_(OpType_Interp);
+class InterpCreator : public OpenCLBackend::Creator {
+public:
+    virtual Execution *onCreate(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                                const MNN::Op *op, Backend *backend) const override {
+        if (inputs[0]->getType() == halide_type_of<int8_t>()) {
+            // Int8 Interp is only supported by CPU
+            return nullptr;
+        }
+        return new InterpExecution(inputs, op, backend);
+    }
+};
+
+OpenCLCreatorRegister<InterpCreator> __Interp_op_(OpType_Interp);
 
 } // namespace OpenCL
 } // namespace MNN
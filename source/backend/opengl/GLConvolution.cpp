@@ -11,6 +11,7 @@
 
 #include <sstream>
 #include "AllShader.hpp"
+#include "core/ConvolutionCommon.hpp"
 #include "core/Macro.h"
 #include "backend/opengl/GLConvolutionIm2col.hpp"
 namespace MNN {
@@ -216,6 +217,10 @@ public:
     virtual ~ConvolutionCreator() = default;
     virtual Execution *onCreate(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
                                 const MNN::Op *op, Backend *backend) const override {
+        // The image preprocess folded by the converter runs on the uint8 input by the CPU only
+        if (ConvolutionCommon::isRawImageConvolution(op, inputs[0])) {
+            return nullptr;
+        }
         auto common = op->main_as_Convolution2D()->common();
 
         //TODO: bugfix
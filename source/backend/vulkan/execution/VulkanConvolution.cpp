@@ -230,6 +230,10 @@ class VulkanConvolutionCreator : public VulkanBackend::Creator {
 public:
     virtual VulkanBasicExecution* onCreate(const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs, const MNN::Op* op,
                                 Backend* backend) const override {
+        // The image preprocess folded by the converter runs on the uint8 input by the CPU only
+        if (ConvolutionCommon::isRawImageConvolution(op, inputs[0])) {
+            return nullptr;
+        }
         auto extra          = static_cast<VulkanBackend *>(backend);
         auto convReal       = op->main_as_Convolution2D();
         auto common         = convReal->common();
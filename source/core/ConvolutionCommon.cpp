@@ -345,7 +345,7 @@ static int8_t *ReadSparseQuanData_c(unsigned char *&myfile, uint32_t& len) {
     len = Size;
     return blob;
 }
-std::shared_ptr<ConvolutionCommon::Int8Common> ConvolutionCommon::load(const IDSTQuan *quan, bool forceFloat) {
+std::shared_ptr<ConvolutionCommon::Int8Common> ConvolutionCommon::load(const IDSTQuan *quan, bool forceFloat, bool forceInt8) {
     auto result           = std::make_shared<Int8Common>();
     uint32_t weightLength = 0;
     int8_t *buffer        = nullptr;
@@ -373,6 +373,20 @@ std::shared_ptr<ConvolutionCommon::Int8Common> ConvolutionCommon::load(const IDS
     }
 
     // weight int8 only
+    if (4 == quan->type() && forceInt8) {
+        weightLength = quan->buffer()->size();
+        result->weight.reset(weightLength);
+        result->alpha.reset(quan->alpha()->size());
+        if (nullptr == result->weight.get() || nullptr == result->alpha.get()) {
+            MNN_PRINT("Alloc memory error for extract int8 weight\n");
+            return nullptr;
+        }
+        ::memcpy(result->weight.get(), quan->buffer()->data(), weightLength);
+        ::memcpy(result->alpha.get(), quan->alpha()->data(), quan->alpha()->size() * sizeof(float));
+        result->quan       = quan;
+        result->asymmetric = true;
+        return result;
+    }
     if (4 == quan->type()) {
         weightLength = quan->buffer()->size();
         result->weightFloat.reset(weightLength);
@@ -413,7 +427,7 @@ std::shared_ptr<ConvolutionCommon::Int8Common> ConvolutionCommon::load(const IDS
     }
     ::memcpy(result->alpha.get(), quan->alpha()->data(), quan->alpha()->size() * sizeof(float));
 
-    if (!quan->has_scaleInt() || forceFloat) {
+    if ((!quan->has_scaleInt() && !forceInt8) || forceFloat) {
         // Back to float
         result->weightFloat.reset(weightLength);
         if (nullptr == result->weightFloat.get()) {
@@ -452,6 +466,14 @@ void ConvolutionCommon::getConvParameters(std::shared_ptr<Int8Common> *quanCommo
     }
 }
 
+bool ConvolutionCommon::isRawImageConvolution(const Op* op, const Tensor* input) {
+    if (OpType_Convolution != op->type() || OpParameter_Convolution2D != op->main_type()) {
+        return false;
+    }
+    return nullptr != op->main_as_Convolution2D()->inputPadValue() &&
+           input->getType() == halide_type_of<uint8_t>();
+}
+
 std::pair<int, int> ConvolutionCommon::convolutionPad(const Tensor *input, const Tensor *output,
                                                       const Convolution2DCommon *mCommon) {
     if (mCommon->padMode() == PadMode_SAME) {
@@ -19,8 +19,11 @@ public:
         AutoStorage<float> alpha;
         AutoStorage<float> weightFloat;
         const IDSTQuan* quan;
+        // weight = (q + 128) * alpha[2k + 1] + alpha[2k], only for forceInt8 loaded type 4 (weight int8 only)
+        bool asymmetric = false;
     };
-    static std::shared_ptr<Int8Common> load(const IDSTQuan* quan, bool forceFloat = false);
+    // forceInt8: keep int8 weight and alpha instead of decoding to weightFloat
+    static std::shared_ptr<Int8Common> load(const IDSTQuan* quan, bool forceFloat = false, bool forceInt8 = false);
     static void getConvParameters(std::shared_ptr<ConvolutionCommon::Int8Common> *quanCommon, const MNN::Convolution2D *conv2d, const float** originWeight, int* originWeightSize);
 
     // Return padX, padY
@@ -28,6 +31,9 @@ public:
                                               const Convolution2DCommon* common);
     static std::pair<int, int> convolutionTransposePad(const Tensor* input, const Tensor* output,
                                                        const Convolution2DCommon* common);
+    // The converter folds the image preprocess into the convolution and marks it with inputPadValue (--imageMean),
+    // such a convolution reads the uint8 image directly, see ConvolutionRawImage
+    static bool isRawImageConvolution(const Op* op, const Tensor* input);
     struct Im2ColParameter {
         int32_t padX;
         int32_t padY;
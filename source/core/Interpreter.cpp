@@ -27,6 +27,7 @@ struct Content {
     std::map<const Tensor*, const Session*> tensorMap;
     Interpreter::SessionMode callBackMode = Interpreter::Session_Debug;
     Interpreter::SessionMode inputMode    = Interpreter::Session_Input_Inside;
+    Interpreter::SessionMode recurrentMode = Interpreter::Session_Recurrent_Reset;
     AutoStorage<uint8_t> cacheBuffer;
     size_t cacheOffset = 0;
     std::string cacheFile;
@@ -65,12 +66,12 @@ Interpreter* Interpreter::createFromBuffer(const void* buffer, size_t size) {
         return nullptr;
     }
     auto* net = new Content;
-    if (!net || !net->buffer.get()) {
+    net->buffer.reset(static_cast<int>(size));
+    if (nullptr == net->buffer.get()) {
         MNN_ERROR("Memory not enought!\n");
+        delete net;
         return nullptr;
     }
-
-    net->buffer.reset(static_cast<int>(size));
     ::memcpy(net->buffer.get(), buffer, size);
 
     return createFromBufferInternal(net);
@@ -108,6 +109,8 @@ Interpreter* Interpreter::createFromBufferInternal(Content* net) {
 void Interpreter::setSessionMode(SessionMode mode) {
     if (mode == Session_Input_Inside || mode == Session_Input_User) {
         mNet->inputMode = mode;
+    } else if (mode == Session_Recurrent_Reset || mode == Session_Recurrent_Keep) {
+        mNet->recurrentMode = mode;
     } else {
         mNet->callBackMode = mode;
     }
@@ -181,7 +184,7 @@ Session* Interpreter::createMultiPathSession(const std::vector<ScheduleConfig>&
     auto validForResize = info.validForResize;
     RuntimeInfo rt = runtime;
     auto newSession =
-        std::unique_ptr<Session>(new Session(std::move(info), mNet->callBackMode, mNet->inputMode, std::move(rt)));
+        std::unique_ptr<Session>(new Session(std::move(info), mNet->callBackMode, mNet->inputMode, mNet->recurrentMode, std::move(rt)));
     if (!newSession->valid()) {
         MNN_PRINT("Invalide Session!!\n");
         return nullptr;
@@ -404,6 +407,34 @@ ErrorCode Interpreter::updateSessionToModel(Session* session) {
     return session->updateToModel(const_cast<Net*>(mNet->net));
 }
 
+ErrorCode Interpreter::saveStaticModel(const Session* session, const char* file) const {
+    std::unique_lock<std::mutex> _l(mNet->lock);
+    if (mNet->buffer.get() == nullptr) {
+        MNN_ERROR("Can't saveStaticModel because you called releaseModel before\n");
+        return INPUT_DATA_ERROR;
+    }
+    if (nullptr == session || nullptr == file) {
+        return INPUT_DATA_ERROR;
+    }
+    std::vector<uint8_t> buffer;
+    auto code = session->generateStaticModel(mNet->net, buffer);
+    if (NO_ERROR != code) {
+        return code;
+    }
+    FILE* f = fopen(file, "wb");
+    if (nullptr == f) {
+        MNN_ERROR("Open %s error\n", file);
+        return INVALID_VALUE;
+    }
+    auto size = fwrite((const char*)buffer.data(), 1, buffer.size(), f);
+    fclose(f);
+    if (size != buffer.size()) {
+        MNN_ERROR("Write %s error\n", file);
+        return INVALID_VALUE;
+    }
+    return NO_ERROR;
+}
+
 bool Interpreter::getSessionInfo(const Session* session, SessionInfoCode code, void* ptr) const {
     std::unique_lock<std::mutex> _l(mNet->lock);
     if (nullptr == session || nullptr == ptr) {
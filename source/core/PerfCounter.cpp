@@ -0,0 +1,166 @@
+//
+//  PerfCounter.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/01.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "core/PerfCounter.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#if defined(__linux__) || defined(__ANDROID__)
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define MNN_PERF_EVENT_SUPPORT
+#endif
+#include "core/Macro.h"
+
+namespace MNN {
+#ifdef MNN_PERF_EVENT_SUPPORT
+static int _openEvent(int tid, uint64_t config) {
+    struct perf_event_attr attr;
+    ::memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return (int)syscall(__NR_perf_event_open, &attr, tid, -1, -1, 0);
+}
+#endif
+
+PerfCounter::PerfCounter() {
+#ifdef MNN_PERF_EVENT_SUPPORT
+    static const uint64_t gConfigs[EVENT_NUMBER] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                    PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES};
+    // The thread pool has been created before, so open the counters for every exist thread
+    auto dir = opendir("/proc/self/task");
+    if (nullptr == dir) {
+        return;
+    }
+    while (auto entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        int tid = atoi(entry->d_name);
+        for (int i = 0; i < EVENT_NUMBER; ++i) {
+            auto fd = _openEvent(tid, gConfigs[i]);
+            if (fd >= 0) {
+                mValid = true;
+            }
+            mFds.emplace_back(fd);
+        }
+    }
+    closedir(dir);
+    if (!mValid) {
+        MNN_ERROR("Open perf event failed, check /proc/sys/kernel/perf_event_paranoid\n");
+    }
+#endif
+}
+
+PerfCounter::~PerfCounter() {
+#ifdef MNN_PERF_EVENT_SUPPORT
+    for (auto fd : mFds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+void PerfCounter::read(Sample& sample) const {
+    sample.timeInUs = mTimer.durationInUs();
+    for (int i = 0; i < EVENT_NUMBER; ++i) {
+        sample.value[i] = 0;
+    }
+#ifdef MNN_PERF_EVENT_SUPPORT
+    for (int i = 0; i < mFds.size(); ++i) {
+        if (mFds[i] < 0) {
+            continue;
+        }
+        uint64_t value = 0;
+        if (::read(mFds[i], &value, sizeof(value)) == sizeof(value)) {
+            sample.value[i % EVENT_NUMBER] += value;
+        }
+    }
+#endif
+}
+
+void PerfCounterProfiler::setUp(size_t opNumber) {
+    mRecords.clear();
+    mRecords.resize(opNumber);
+}
+
+void PerfCounterProfiler::begin() {
+    if (nullptr == mCounter) {
+        // Lazy open so that all the worker threads are alive
+        mCounter.reset(new PerfCounter);
+    }
+    mCounter->read(mBegin);
+}
+
+void PerfCounterProfiler::end(size_t index) {
+    PerfCounter::Sample current;
+    mCounter->read(current);
+    auto& record = mRecords[index];
+    record.runTimes++;
+    record.sum.timeInUs += current.timeInUs - mBegin.timeInUs;
+    for (int i = 0; i < PerfCounter::EVENT_NUMBER; ++i) {
+        record.sum.value[i] += current.value[i] - mBegin.value[i];
+    }
+}
+
+void PerfCounterProfiler::printReport() const {
+    if (nullptr == mCounter) {
+        return;
+    }
+    static const float gCacheLine = 64.0f;
+    // Rooflines: assumed peak compute comes from Backend::onMeasure, bandwidth is the max observed one
+    float peakCompute   = 0.0f; // GFlop/s
+    float peakBandwidth = 0.0f; // GB/s
+    std::vector<const Record*> records;
+    for (auto& r : mRecords) {
+        if (r.runTimes == 0 || r.sum.timeInUs == 0) {
+            continue;
+        }
+        records.emplace_back(&r);
+        float timeInMs = (float)r.sum.timeInUs / 1000.0f / r.runTimes;
+        if (r.expectTime > 0.0f) {
+            peakCompute = std::max(peakCompute, r.flops / r.expectTime);
+        }
+        float bytes   = (float)r.sum.value[PerfCounter::CACHE_MISSES] * gCacheLine / r.runTimes;
+        peakBandwidth = std::max(peakBandwidth, bytes / timeInMs / 1e6f);
+    }
+    std::sort(records.begin(), records.end(),
+              [](const Record* a, const Record* b) { return a->sum.timeInUs > b->sum.timeInUs; });
+    float ridge = peakBandwidth > 0.0f ? peakCompute / peakBandwidth : 0.0f;
+    MNN_PRINT("Perf counter report, assumed peak: %.3f GFlop/s, observed peak bandwidth: %.3f GB/s, ridge: %.3f "
+              "Flop/Byte\n",
+              peakCompute, peakBandwidth, ridge);
+    MNN_PRINT("%-32s %-16s %10s %10s %10s %10s %10s %8s %8s %10s %8s\n", "Name", "Type", "Time(ms)", "Expect(ms)",
+              "MFlops", "GFlop/s", "Assumed", "IPC", "Miss(%)", "Flop/Byte", "Bound");
+    for (auto r : records) {
+        float timeInMs = (float)r->sum.timeInUs / 1000.0f / r->runTimes;
+        float cycles   = (float)r->sum.value[PerfCounter::CYCLES];
+        float ipc      = cycles > 0.0f ? (float)r->sum.value[PerfCounter::INSTRUCTIONS] / cycles : 0.0f;
+        float refs     = (float)r->sum.value[PerfCounter::CACHE_REFERENCES];
+        float misses   = (float)r->sum.value[PerfCounter::CACHE_MISSES];
+        float missRate = refs > 0.0f ? misses / refs * 100.0f : 0.0f;
+        float achieved = r->flops / timeInMs;
+        float assumed  = r->expectTime > 0.0f ? r->flops / r->expectTime : 0.0f;
+        float bytes    = misses * gCacheLine / r->runTimes;
+        float intense  = bytes > 0.0f ? r->flops * 1e6f / bytes : 0.0f;
+        const char* bound = "-";
+        if (r->flops > 0.0f && ridge > 0.0f) {
+            bound = (bytes > 0.0f && intense < ridge) ? "memory" : "compute";
+        }
+        MNN_PRINT("%-32s %-16s %10.4f %10.4f %10.3f %10.3f %10.3f %8.3f %8.2f %10.3f %8s\n", r->name.c_str(),
+                  r->type.c_str(), timeInMs, r->expectTime, r->flops, achieved, assumed, ipc, missRate, intense, bound);
+    }
+}
+
+} // namespace MNN
@@ -0,0 +1,84 @@
+//
+//  PerfCounter.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/01.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef PerfCounter_hpp
+#define PerfCounter_hpp
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <MNN/AutoTime.hpp>
+#include "core/NonCopyable.hpp"
+
+namespace MNN {
+
+/** Hardware performance counters (perf_event_open) summed over all threads of the process.
+    Only effective on Linux / Android, isValid() returns false elsewhere. */
+class PerfCounter : public NonCopyable {
+public:
+    enum Event {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        CACHE_REFERENCES,
+        CACHE_MISSES,
+        EVENT_NUMBER
+    };
+    struct Sample {
+        uint64_t value[EVENT_NUMBER] = {0, 0, 0, 0};
+        uint64_t timeInUs            = 0;
+    };
+
+    PerfCounter();
+    ~PerfCounter();
+
+    bool isValid() const {
+        return mValid;
+    }
+    /** read current value of all counters */
+    void read(Sample& sample) const;
+
+private:
+    // fds of every thread, EVENT_NUMBER for each thread, -1 for unsupported event
+    std::vector<int> mFds;
+    bool mValid = false;
+    mutable Timer mTimer;
+};
+
+/** Attribute hardware counters to ops and print a roofline-style report */
+class PerfCounterProfiler : public NonCopyable {
+public:
+    struct Record {
+        std::string name;
+        std::string type;
+        float flops      = 0.0f; // M
+        float expectTime = 0.0f; // ms, predicted by Backend::onMeasure
+        uint64_t runTimes = 0;
+        PerfCounter::Sample sum;
+    };
+    PerfCounterProfiler() = default;
+    ~PerfCounterProfiler() = default;
+
+    /** reset records, call after the executions are created */
+    void setUp(size_t opNumber);
+    Record& record(size_t index) {
+        return mRecords[index];
+    }
+    void begin();
+    void end(size_t index);
+    void printReport() const;
+
+private:
+    std::unique_ptr<PerfCounter> mCounter;
+    PerfCounter::Sample mBegin;
+    std::vector<Record> mRecords;
+};
+
+} // namespace MNN
+
+#endif /* PerfCounter_hpp */
@@ -83,9 +83,9 @@ void Pipeline::UnitInfo::setUp(const Command& command, int index) {
 }
 
 Pipeline::Pipeline(std::vector<Schedule::PipelineInfo>&& infos, std::shared_ptr<Backend> backend,
-                   std::shared_ptr<Backend> cpuBackend, bool allocInput, bool geometry)
+                   std::shared_ptr<Backend> cpuBackend, bool allocInput, bool geometry, bool keepRecurrentState)
 #ifndef MNN_BUILD_MINI
-    : mContext(cpuBackend, true), mUseGeometry(geometry) {
+    : mContext(cpuBackend, true, keepRecurrentState), mUseGeometry(geometry) {
 #else
 {
 #endif
@@ -95,6 +95,9 @@ Pipeline::Pipeline(std::vector<Schedule::PipelineInfo>&& infos, std::shared_ptr<
     mBackend       = backend;
     mAllocInput    = allocInput;
     mInfo          = std::move(infos);
+#ifndef MNN_BUILD_MINI
+    mContext.setForwardType(backend->type());
+#endif
     GeometryComputerUtils::buildConstantTensors(mInfo, mBackupBackend, !mAllocInput, mConstTensors, mMidConstTensors);
 }
 
@@ -297,6 +300,17 @@ ErrorCode Pipeline::allocMemory(bool supportDebug) {
         for (int i = 0; i < mBuffer.command.size(); ++i) {
             mDebugInfos[i].setUp(mBuffer.command[i], i);
         }
+#ifdef MNN_PERF_COUNTER
+        mPerfProfiler.setUp(mBuffer.command.size());
+        for (int i = 0; i < mBuffer.command.size(); ++i) {
+            auto& cmd         = mBuffer.command[i];
+            auto& record      = mPerfProfiler.record(i);
+            record.name       = mDebugInfos[i].name();
+            record.type       = mDebugInfos[i].type();
+            record.flops      = mDebugInfos[i].flops();
+            record.expectTime = mExecutions[i]->backend()->onMeasure(cmd.inputs, cmd.outputs, cmd.op).first;
+        }
+#endif
     }
     return NO_ERROR;
 }
@@ -326,7 +340,13 @@ ErrorCode Pipeline::executeCallBack(const TensorCallBackWithInfo& before, const
         auto& info = mDebugInfos[i];
         auto run   = before(cmd.inputs, &info);
         if (run) {
+#ifdef MNN_PERF_COUNTER
+            mPerfProfiler.begin();
+#endif
             auto code = mExecutions[i]->onExecute(cmd.inputs, cmd.outputs);
+#ifdef MNN_PERF_COUNTER
+            mPerfProfiler.end(i);
+#endif
             if (NO_ERROR != code) {
                 mBackend->onExecuteEnd();
                 return code;
@@ -343,6 +363,9 @@ ErrorCode Pipeline::executeCallBack(const TensorCallBackWithInfo& before, const
 }
 
 Pipeline::~Pipeline() {
+#ifdef MNN_PERF_COUNTER
+    mPerfProfiler.printReport();
+#endif
     mExecutions.clear();
     for (auto t : mConstTensors) {
         mBackupBackend->onReleaseBuffer(t, Backend::STATIC);
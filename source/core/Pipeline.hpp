@@ -11,6 +11,9 @@
 #include "Schedule.hpp"
 #include "core/Execution.hpp"
 #include "geometry/GeometryComputer.hpp"
+#ifdef MNN_PERF_COUNTER
+#include "core/PerfCounter.hpp"
+#endif
 
 namespace MNN {
 struct OperatorInfo::Info {
@@ -23,7 +26,7 @@ class SizeComputer;
 class Pipeline : public NonCopyable {
 public:
     Pipeline(std::vector<Schedule::PipelineInfo>&& info, std::shared_ptr<Backend> major,
-             std::shared_ptr<Backend> backup, bool allocInput, bool useGeometry);
+             std::shared_ptr<Backend> backup, bool allocInput, bool useGeometry, bool keepRecurrentState = false);
     ~Pipeline();
     class UnitInfo : public OperatorInfo {
     public:
@@ -46,6 +49,9 @@ public:
     ErrorCode execute();
     ErrorCode executeCallBack(const TensorCallBackWithInfo& before, const TensorCallBackWithInfo& after);
     std::vector<Schedule::PipelineInfo>& getPipelineInfo();
+    const CommandBuffer& getCommandBuffer() const {
+        return mBuffer;
+    }
 
 private:
     std::shared_ptr<Backend> mBackend;
@@ -63,5 +69,8 @@ private:
     GeometryComputer::Context mContext;
     bool mUseGeometry = true;
 #endif
+#ifdef MNN_PERF_COUNTER
+    PerfCounterProfiler mPerfProfiler;
+#endif
 };
 } // namespace MNN
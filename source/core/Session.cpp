@@ -16,12 +16,13 @@
 #include "core/RuntimeFactory.hpp"
 #include "core/TensorUtils.hpp"
 #include "core/WrapExecution.hpp"
+#include "utils/InitNet.hpp"
 
 using namespace std;
 
 namespace MNN {
 Session::Session(Schedule::ScheduleInfo&& info, Interpreter::SessionMode callBackMode,
-                 Interpreter::SessionMode inputMode, RuntimeInfo&& runtime) {
+                 Interpreter::SessionMode inputMode, Interpreter::SessionMode recurrentMode, RuntimeInfo&& runtime) {
     mRuntime = std::move(runtime);
     if (info.pipelineInfo.empty()) {
         mValid = false;
@@ -41,7 +42,7 @@ Session::Session(Schedule::ScheduleInfo&& info, Interpreter::SessionMode callBac
         } else {
             second.reset(cpuRuntime->onCreate());
         }
-        std::shared_ptr<Pipeline> newPipeline(new Pipeline(std::move(iter.second), first, second, inputMode == Interpreter::Session_Input_Inside, runtime->onGetCompilerType() == Runtime::Compiler_Geometry));
+        std::shared_ptr<Pipeline> newPipeline(new Pipeline(std::move(iter.second), first, second, inputMode == Interpreter::Session_Input_Inside, runtime->onGetCompilerType() == Runtime::Compiler_Geometry, recurrentMode == Interpreter::Session_Recurrent_Keep));
         mPipelines.emplace_back(std::move(newPipeline));
     }
     mInputs       = std::move(info.inputTensors);
@@ -236,4 +237,29 @@ ErrorCode Session::updateToModel(Net* net) const {
     return NO_ERROR;
 }
 
+ErrorCode Session::generateStaticModel(const Net* net, std::vector<uint8_t>& buffer) const {
+    if (mNeedResize) {
+        MNN_ERROR("Can't generate static model because session not resized\n");
+        return COMPUTE_SIZE_ERROR;
+    }
+    CommandBuffer commands;
+    for (auto& iter : mPipelines) {
+        auto& cmd = iter->getCommandBuffer().command;
+        commands.command.insert(commands.command.end(), cmd.begin(), cmd.end());
+    }
+    std::map<Tensor*, std::string> tensorNames;
+    for (int i = 0; i < mTensors.size(); ++i) {
+        tensorNames[mTensors[i].second.get()] = net->tensorName()->GetAsString(i)->str();
+    }
+    auto netT = MNN::generateStaticModel(commands, tensorNames);
+    netT->bizCode = nullptr != net->bizCode() ? net->bizCode()->str() : "";
+    flatbuffers::FlatBufferBuilder builder(1024);
+    builder.ForceDefaults(true);
+    auto offset = Net::Pack(builder, netT.get());
+    builder.Finish(offset);
+    buffer.resize(builder.GetSize());
+    ::memcpy(buffer.data(), builder.GetBufferPointer(), buffer.size());
+    return NO_ERROR;
+}
+
 } // namespace MNN
@@ -25,7 +25,7 @@ struct Net;
 class MNN_PUBLIC Session {
 public:
     Session(Schedule::ScheduleInfo&& info, Interpreter::SessionMode callBackMode, Interpreter::SessionMode inputMode,
-            RuntimeInfo&& runtime);
+            Interpreter::SessionMode recurrentMode, RuntimeInfo&& runtime);
     ~Session();
 
 public:
@@ -116,6 +116,15 @@ public:
      */
     ErrorCode updateToModel(Net* net) const;
 
+    /**
+     * @brief save the resolved commands as static model, which can create session without shape compute and
+     * geometry transform.
+     * @param net     origin model, used for tensor names.
+     * @param buffer  output buffer of the static model.
+     * @return errorcode
+     */
+    ErrorCode generateStaticModel(const Net* net, std::vector<uint8_t>& buffer) const;
+
     bool loadCache(const void* buffer, size_t size);
     std::pair<const void*, size_t> getCache();
 
@@ -49,6 +49,25 @@ static void _gray2C4(const unsigned char* source, unsigned char* dest, size_t co
         }
         sta = countD8 * 8;
     }
+#endif
+#ifdef MNN_USE_SSE
+    int countD16 = (int)count / 16;
+    if (countD16 > 0) {
+        const auto alpha = _mm_set1_epi8(-1);
+        for (int i = 0; i < countD16; ++i) {
+            auto gray = _mm_loadu_si128((const __m128i*)(source + 16 * i));
+            // gg and ga pairs, then gga pixels
+            auto gg0  = _mm_unpacklo_epi8(gray, gray);
+            auto gg1  = _mm_unpackhi_epi8(gray, gray);
+            auto ga0  = _mm_unpacklo_epi8(gray, alpha);
+            auto ga1  = _mm_unpackhi_epi8(gray, alpha);
+            _mm_storeu_si128((__m128i*)(dest + 64 * i + 16 * 0), _mm_unpacklo_epi16(gg0, ga0));
+            _mm_storeu_si128((__m128i*)(dest + 64 * i + 16 * 1), _mm_unpackhi_epi16(gg0, ga0));
+            _mm_storeu_si128((__m128i*)(dest + 64 * i + 16 * 2), _mm_unpacklo_epi16(gg1, ga1));
+            _mm_storeu_si128((__m128i*)(dest + 64 * i + 16 * 3), _mm_unpackhi_epi16(gg1, ga1));
+        }
+        sta = countD16 * 16;
+    }
 #endif
     for (int i = sta; i < count; ++i) {
         dest[4 * i + 0] = source[i];
@@ -74,6 +93,21 @@ static void _gray2C3(const unsigned char* source, unsigned char* dest, size_t co
         }
         sta = countD8 * 8;
     }
+#endif
+#ifdef MNN_USE_SSE
+    int countD16 = (int)count / 16;
+    if (countD16 > 0) {
+        const auto m0 = _mm_setr_epi8(0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5);
+        const auto m1 = _mm_setr_epi8(5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10);
+        const auto m2 = _mm_setr_epi8(10, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14, 14, 15, 15, 15);
+        for (int i = 0; i < countD16; ++i) {
+            auto gray = _mm_loadu_si128((const __m128i*)(source + 16 * i));
+            _mm_storeu_si128((__m128i*)(dest + 48 * i + 16 * 0), _mm_shuffle_epi8(gray, m0));
+            _mm_storeu_si128((__m128i*)(dest + 48 * i + 16 * 1), _mm_shuffle_epi8(gray, m1));
+            _mm_storeu_si128((__m128i*)(dest + 48 * i + 16 * 2), _mm_shuffle_epi8(gray, m2));
+        }
+        sta = countD16 * 16;
+    }
 #endif
     for (int i = sta; i < count; ++i) {
         dest[3 * i + 0] = source[i];
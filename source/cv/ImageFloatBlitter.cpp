@@ -254,6 +254,8 @@ static void _blitC3ToFloatC3(const unsigned char* source, float* dest, const flo
 #endif
 }
 
+// x86 has SSE / AVX2 version in backend/cpu/x86_x64
+#ifndef MNN_USE_SSE
 void MNNBlitC4ToFloatC4(const unsigned char* source, float* dest, const float* mean, const float* normal,
                         size_t count) {
     for (int i = 0; i < count; ++i) {
@@ -263,6 +265,7 @@ void MNNBlitC4ToFloatC4(const unsigned char* source, float* dest, const float* m
         dest[4 * i + 3] = normal[3] * (source[4 * i + 3] - mean[3]);
     }
 }
+#endif
 #ifndef MNN_USE_NEON
 void MNNBlitC1ToFloatRGBA(const unsigned char* source, float* dest, const float* mean, const float* normal,
                           size_t count) {
@@ -333,44 +336,12 @@ void MNNBlitC1ToFloatRGBA(const unsigned char* source, float* dest, const float*
     }
 }
 
+#endif
+
+#if !defined(MNN_USE_NEON) && !defined(MNN_USE_SSE)
 void MNNBlitC3ToFloatRGBA(const unsigned char* source, float* dest, const float* mean, const float* normal,
                           size_t count) {
-int remain = 0;
-#ifdef MNN_USE_SSE
-    int countC4 = count / 4;
-    if (countC4 > 1) {
-        if ((count % 4) * 3 < 4) {
-            //Avoid load extra memory
-            countC4 -=1;
-        }
-        // RGBRGBRGBRGB -> RGB0 , RGB0, RGB0
-        auto alpha0 = _mm_setr_ps(normal[0], normal[1], normal[2], 0.0f);
-        auto beta0 = _mm_setr_ps(mean[0], mean[1], mean[2], 0.0f);
-        remain = countC4 * 4;
-        const __m128i rM = _mm_setr_epi8(0, 1, 2, 0, 6,5,4,7, 10,9,8,11, 14,13,12,15);
-        const __m128i gM = _mm_setr_epi8(3, 4, 5, 3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
-        const __m128i bM = _mm_setr_epi8(6, 7, 8, 6, 6,5,4,7, 10,9,8,11, 14,13,12,15);
-        const __m128i aM = _mm_setr_epi8(9, 10, 11, 9, 6,5,4,7, 10,9,8,11, 14,13,12,15);
-
-        for (int i = 0; i < countC4; ++i) {
-            auto sInt8 = _mm_loadu_si128((const __m128i*)(source + 12 * i));
-            auto s0 = _mm_cvtepu8_epi32(_mm_shuffle_epi8(sInt8, rM));
-            auto s1 = _mm_cvtepu8_epi32(_mm_shuffle_epi8(sInt8, gM));
-            auto s2 = _mm_cvtepu8_epi32(_mm_shuffle_epi8(sInt8, bM));
-            auto s3 = _mm_cvtepu8_epi32(_mm_shuffle_epi8(sInt8, aM));
-
-            auto f0 = _mm_cvtepi32_ps(s0);
-            auto f1 = _mm_cvtepi32_ps(s1);
-            auto f2 = _mm_cvtepi32_ps(s2);
-            auto f3 = _mm_cvtepi32_ps(s3);
-            _mm_storeu_ps(dest + 16 * i + 4 * 0, _mm_mul_ps(_mm_sub_ps(f0, beta0), alpha0));
-            _mm_storeu_ps(dest + 16 * i + 4 * 1, _mm_mul_ps(_mm_sub_ps(f1, beta0), alpha0));
-            _mm_storeu_ps(dest + 16 * i + 4 * 2, _mm_mul_ps(_mm_sub_ps(f2, beta0), alpha0));
-            _mm_storeu_ps(dest + 16 * i + 4 * 3, _mm_mul_ps(_mm_sub_ps(f3, beta0), alpha0));
-        }
-    }
-#endif
-    for (int i = remain; i < count; ++i) {
+    for (int i = 0; i < count; ++i) {
         dest[4 * i + 0] = normal[0] * (source[3 * i + 0] - mean[0]);
         dest[4 * i + 1] = normal[1] * (source[3 * i + 1] - mean[1]);
         dest[4 * i + 2] = normal[2] * (source[3 * i + 2] - mean[2]);
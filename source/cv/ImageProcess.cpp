@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include "core/AutoStorage.h"
 #include "core/Macro.h"
 #include "core/TensorUtils.hpp"
@@ -16,7 +17,9 @@
 #include "cv/ImageBlitter.hpp"
 #include "cv/ImageFloatBlitter.hpp"
 #include "cv/ImageSampler.hpp"
+#include "backend/cpu/CPUBackend.hpp"
 #include "backend/cpu/CPUTensorConvert.hpp"
+#include "core/Concurrency.h"
 #include <MNN/MNNForwardType.h>
 #include "core/Backend.hpp"
 #define CACHE_SIZE 256
@@ -26,6 +29,8 @@ struct ImageProcess::Inside {
     Config config;
     AutoStorage<uint8_t> cacheBuffer;
     AutoStorage<uint8_t> cacheBufferRGBA;
+    // Row cache of each thread for ImageSeparableSampler
+    std::vector<ImageSeparableSampler::RowCache> separableCache;
 };
 
 ImageProcess::~ImageProcess() {
@@ -33,6 +38,8 @@ ImageProcess::~ImageProcess() {
 }
 
 ImageProcess::ImageProcess(const Config& config) {
+    // Register the CPU backend, which selects the SIMD kernels used by sampler and blitter
+    MNNGetExtraRuntimeCreator(MNN_FORWARD_CPU);
     mInside         = new Inside;
     mInside->config = config;
     mInside->cacheBuffer.reset(4 * CACHE_SIZE);
@@ -64,9 +71,24 @@ ImageProcess* ImageProcess::create(const ImageFormat sourceFormat, const ImageFo
     return new ImageProcess(config);
 }
 
+// A degenerate box samples one source row / column for every dest row / column, its scale is 0 and the matrix
+// can't be inverted. The invert is only used to clip along a dest row, where the degenerate axis is constant.
+static bool _invertBoxMatrix(const Matrix& matrix, Matrix* invert) {
+    if (matrix.invert(invert)) {
+        return true;
+    }
+    if (!matrix.isScaleTranslate()) {
+        return false;
+    }
+    float sx = matrix.getScaleX() != 0.0f ? 1.0f / matrix.getScaleX() : 0.0f;
+    float sy = matrix.getScaleY() != 0.0f ? 1.0f / matrix.getScaleY() : 0.0f;
+    invert->setScaleTranslate(sx, sy, -matrix.getTranslateX() * sx, -matrix.getTranslateY() * sy);
+    return true;
+}
+
 void ImageProcess::setMatrix(const Matrix& matrix) {
     mTransform = matrix;
-    mTransform.invert(&mTransformInvert);
+    _invertBoxMatrix(mTransform, &mTransformInvert);
 }
 
 static int _getBpp(ImageFormat format) {
@@ -193,94 +215,32 @@ static ImageFormat _correctImageFormat(int outputBpp, halide_type_t type, ImageF
     return format;
 }
 
-ErrorCode ImageProcess::convert(const uint8_t* source, int iw, int ih, int stride, Tensor* destOrigin) {
-    auto dest = destOrigin;
-    if (nullptr == dest || nullptr == source) {
-        MNN_ERROR("null dest or source for image process\n");
-        return INPUT_DATA_ERROR;
-    }
-    if (destOrigin->buffer().device == 0 && destOrigin->buffer().host == nullptr) {
-        MNN_ERROR("Invalid Tensor, the session may not be ready\n");
-        return INPUT_DATA_ERROR;
-    }
-    std::shared_ptr<Tensor> tempTensor;
-    auto ow              = dest->width();
-    auto oh              = dest->height();
-    auto bpp             = dest->channel();
-    auto dimensionFormat = TensorUtils::getDescribe(dest)->dimensionFormat;
-    auto tensorBn = TensorUtils::getDescribe(dest)->backend;
-    auto bnType = MNN_FORWARD_CPU;
-    if(tensorBn){
-        bnType = tensorBn->type();
-    }
-    if (bnType != MNN_FORWARD_CPU) {
-        tempTensor.reset(Tensor::create({1, bpp, oh, ow}, dest->getType(), nullptr, Tensor::CAFFE_C4),[destOrigin] (void* p) {
-            auto hostTensor = (Tensor*)p;
-            destOrigin->copyFromHostTensor(hostTensor);
-            delete hostTensor;
-        });
-        dest = tempTensor.get();
-    }
-    else if (MNN_DATA_FORMAT_NCHW == dimensionFormat) {
-        tempTensor.reset(Tensor::create(dest->shape(), dest->getType(), nullptr, Tensor::CAFFE_C4), [destOrigin](void* p) {
-            auto hostTensor = (Tensor*)p;
-            CPUTensorConverter::convert(hostTensor, destOrigin);
-            delete hostTensor;
-        });
-        dest = tempTensor.get();
-    }
-    dimensionFormat = TensorUtils::getDescribe(dest)->dimensionFormat;
-    if (dimensionFormat == MNN_DATA_FORMAT_NC4HW4) {
-        bpp = 4;
-    }
-    return convert(source, iw, ih, stride, dest->host<void>(), ow, oh, bpp, ow * bpp, dest->getType());
-}
-
-ErrorCode ImageProcess::convert(const uint8_t* source, int iw, int ih, int stride, void* dest, int ow, int oh,
-                                int outputBpp, int outputStride, halide_type_t type) {
-    auto sourceBpp = _getBpp(mInside->config.sourceFormat);
-    if (0 == stride) {
-        stride = iw * sourceBpp;
-    }
-
-    // AUTOTIME;
-    auto& config      = mInside->config;
-    auto sourceFormat = config.sourceFormat;
-    auto destFormat   = config.destFormat;
-    destFormat        = _correctImageFormat(outputBpp, type, destFormat);
-    auto blitter      = ImageBlitter::choose(sourceFormat, destFormat);
-    if (nullptr == blitter) {
-        return INPUT_DATA_ERROR;
-    }
-    bool identity = mTransform.isIdentity() && iw >= ow && ih >= oh; // TODO, no need for iw, ih limit
-    auto sampler  = ImageSampler::choose(sourceFormat, config.filterType, identity);
-    if (nullptr == sampler) {
-        return INPUT_DATA_ERROR;
-    }
-    if (0 == outputBpp) {
-        outputBpp = _getBpp(destFormat);
-    }
-
-    int tileCount = UP_DIV(ow, CACHE_SIZE);
+// Sample, convert format and turn float for the rows [yStart, yEnd) with the given cache
+static void _convertRows(const ImageProcess::Config& config, const Matrix& transform, const Matrix& transformInvert,
+                         ImageSampler::PROC sampler, const ImageSeparableSampler* separable,
+                         ImageBlitter::BLITTER blitter, ImageFloatBlitter::BLIT_FLOAT blitFloat,
+                         const uint8_t* source, int iw, int ih, int stride, uint8_t* dest, int ow, int bpp,
+                         halide_type_t type, uint8_t* sampleBuffer, uint8_t* blitBuffer,
+                         ImageSeparableSampler::RowCache* separableCache, int yStart, int yEnd) {
+    auto sourceBpp  = _getBpp(config.sourceFormat);
+    auto destFormat = _correctImageFormat(bpp, type, config.destFormat);
+    int tileCount   = UP_DIV(ow, CACHE_SIZE);
+    auto destBytes  = type.bytes();
+    auto needBlit   = config.sourceFormat != destFormat;
+    bool isFloat    = type.code == halide_type_float;
     Point points[2];
-    auto sampleBuffer = (uint8_t*)mInside->cacheBuffer.get();
-    auto srcData      = source;
-    auto destBytes    = type.bytes();
-    auto bpp          = outputBpp;
-    auto needBlit     = sourceFormat != destFormat;
-    bool isFloat      = type.code == halide_type_float;
-    //            MNN_PRINT("bpp:%d, destBytes:%d, destFormat:%d, %d, %d\n",bpp, destBytes, ow, oh, dimensionFormat);
-
-    auto blitFloat = ImageFloatBlitter::choose(destFormat, bpp);
-    for (int dy = 0; dy < oh; ++dy) {
-        auto dstY = (uint8_t*)dest + dy * destBytes * ow * bpp;
+    if (nullptr != separable) {
+        separable->resetCache(*separableCache);
+    }
+    for (int dy = yStart; dy < yEnd; ++dy) {
+        auto dstY = dest + dy * destBytes * ow * bpp;
         for (int tIndex = 0; tIndex < tileCount; ++tIndex) {
             int xStart    = tIndex * CACHE_SIZE;
             int count     = std::min(CACHE_SIZE, ow - xStart);
             auto dstStart = dstY + destBytes * bpp * xStart;
 
             auto samplerDest = sampleBuffer;
-            auto blitDest    = mInside->cacheBufferRGBA.get();
+            auto blitDest    = blitBuffer;
 
             if (!isFloat) {
                 blitDest = dstStart;
@@ -290,7 +250,9 @@ ErrorCode ImageProcess::convert(const uint8_t* source, int iw, int ih, int strid
             }
 
             // Sample
-            {
+            if (nullptr != separable) {
+                separable->sample(source, stride, dy, xStart, count, samplerDest, *separableCache);
+            } else {
                 // Compute position
                 points[0].fX = xStart;
                 points[0].fY = dy;
@@ -298,7 +260,7 @@ ErrorCode ImageProcess::convert(const uint8_t* source, int iw, int ih, int strid
                 points[1].fX = xStart + count;
                 points[1].fY = dy;
 
-                mTransform.mapPoints(points, 2);
+                transform.mapPoints(points, 2);
                 float deltaY = points[1].fY - points[0].fY;
                 float deltaX = points[1].fX - points[0].fX;
 
@@ -308,13 +270,13 @@ ErrorCode ImageProcess::convert(const uint8_t* source, int iw, int ih, int strid
                 // FUNC_PRINT(sta);
                 if (config.wrap == ZERO) {
                     // Clip: Cohen-Sutherland
-                    auto clip    = _computeClip(points, iw, ih, mTransformInvert, xStart, count);
+                    auto clip    = _computeClip(points, iw, ih, transformInvert, xStart, count);
                     sta          = clip.first;
                     end          = clip.second;
                     points[0].fX = sta + xStart;
                     points[0].fY = dy;
 
-                    mTransform.mapPoints(points, 1);
+                    transform.mapPoints(points, 1);
                     if (sta != 0 || end < count) {
                         if (sourceBpp > 0) {
                             if (sta > 0) {
@@ -333,7 +295,7 @@ ErrorCode ImageProcess::convert(const uint8_t* source, int iw, int ih, int strid
                 points[1].fX = (deltaX) / (float)(count);
                 points[1].fY = (deltaY) / (float)(count);
 
-                sampler(srcData, samplerDest, points, sta, end - sta, count, iw, ih, stride);
+                sampler(source, samplerDest, points, sta, end - sta, count, iw, ih, stride);
             }
             // Convert format
             if (needBlit) {
@@ -341,15 +303,202 @@ ErrorCode ImageProcess::convert(const uint8_t* source, int iw, int ih, int strid
             }
             // Turn float
             if (isFloat) {
-                auto normal = mInside->config.normal;
-                auto mean   = mInside->config.mean;
-                blitFloat(blitDest, (float*)dstStart, mean, normal, count);
+                blitFloat(blitDest, (float*)dstStart, config.mean, config.normal, count);
             }
         }
     }
+}
 
+// Convert the source with each of the batch transforms into dest, one batch after another
+static ErrorCode _convertImage(ImageProcess::Inside* inside, const Matrix* transforms, const Matrix* transformInverts,
+                               int batch, const uint8_t* source, int iw, int ih, int stride, void* dest, int ow,
+                               int oh, int outputBpp, halide_type_t type, const CPUBackend* cpuBackend) {
+    auto& config   = inside->config;
+    auto sourceBpp = _getBpp(config.sourceFormat);
+    if (0 == stride) {
+        stride = iw * sourceBpp;
+    }
+
+    // AUTOTIME;
+    auto sourceFormat = config.sourceFormat;
+    auto destFormat   = _correctImageFormat(outputBpp, type, config.destFormat);
+    auto blitter      = ImageBlitter::choose(sourceFormat, destFormat);
+    if (nullptr == blitter) {
+        return INPUT_DATA_ERROR;
+    }
+    std::vector<ImageSampler::PROC> samplers(batch);
+    std::vector<std::shared_ptr<ImageSeparableSampler>> separables(batch);
+    bool hasSeparable = false;
+    for (int b = 0; b < batch; ++b) {
+        bool identity = transforms[b].isIdentity() && iw >= ow && ih >= oh; // TODO, no need for iw, ih limit
+        samplers[b]   = ImageSampler::choose(sourceFormat, config.filterType, identity);
+        if (nullptr == samplers[b]) {
+            return INPUT_DATA_ERROR;
+        }
+        if (!identity && ImageSeparableSampler::support(sourceFormat, config.filterType, config.wrap, transforms[b])) {
+            separables[b].reset(
+                new ImageSeparableSampler(sourceFormat, config.filterType, transforms[b], iw, ih, ow, oh));
+            hasSeparable = true;
+        }
+    }
+    if (0 == outputBpp) {
+        outputBpp = _getBpp(destFormat);
+    }
+    auto blitFloat  = ImageFloatBlitter::choose(destFormat, outputBpp);
+    auto batchBytes = (size_t)ow * oh * outputBpp * type.bytes();
+
+    // Split the rows of all batches into bands for the threads, each thread has its own cache
+    int totalRows    = batch * oh;
+    int threadNumber = 1;
+    if (nullptr != cpuBackend) {
+        threadNumber = std::max(1, std::min(cpuBackend->threadNumber(), totalRows));
+    }
+    if (inside->cacheBuffer.size() < threadNumber * 4 * CACHE_SIZE) {
+        inside->cacheBuffer.reset(threadNumber * 4 * CACHE_SIZE);
+        inside->cacheBufferRGBA.reset(threadNumber * 4 * CACHE_SIZE);
+    }
+    if (hasSeparable && inside->separableCache.size() < threadNumber) {
+        inside->separableCache.resize(threadNumber);
+    }
+    auto sampleBuffer = inside->cacheBuffer.get();
+    auto blitBuffer   = inside->cacheBufferRGBA.get();
+    auto convertBand  = [&](int tId, int rowStart, int rowEnd) {
+        for (int b = rowStart / oh; b * oh < rowEnd; ++b) {
+            int yStart = std::max(rowStart - b * oh, 0);
+            int yEnd   = std::min(rowEnd - b * oh, oh);
+            _convertRows(config, transforms[b], transformInverts[b], samplers[b], separables[b].get(), blitter,
+                         blitFloat, source, iw, ih, stride, (uint8_t*)dest + b * batchBytes, ow, outputBpp, type,
+                         sampleBuffer + tId * 4 * CACHE_SIZE, blitBuffer + tId * 4 * CACHE_SIZE,
+                         hasSeparable ? inside->separableCache.data() + tId : nullptr, yStart, yEnd);
+        }
+    };
+    if (1 == threadNumber) {
+        convertBand(0, 0, totalRows);
+        return NO_ERROR;
+    }
+    // MNN_CONCURRENCY_END find the thread pool by backend()
+    auto backend = [cpuBackend]() { return const_cast<CPUBackend*>(cpuBackend); };
+    cpuBackend->onExecuteBegin();
+    MNN_CONCURRENCY_BEGIN(tId, threadNumber) {
+        convertBand((int)tId, (int)tId * totalRows / threadNumber, ((int)tId + 1) * totalRows / threadNumber);
+    }
+    MNN_CONCURRENCY_END();
+    cpuBackend->onExecuteEnd();
     return NO_ERROR;
 }
 
+static ErrorCode _convertTensor(ImageProcess::Inside* inside, const Matrix* transforms, const Matrix* transformInverts,
+                                int batch, const uint8_t* source, int iw, int ih, int stride, Tensor* destOrigin) {
+    auto dest = destOrigin;
+    if (nullptr == dest || nullptr == source) {
+        MNN_ERROR("null dest or source for image process\n");
+        return INPUT_DATA_ERROR;
+    }
+    if (destOrigin->buffer().device == 0 && destOrigin->buffer().host == nullptr) {
+        MNN_ERROR("Invalid Tensor, the session may not be ready\n");
+        return INPUT_DATA_ERROR;
+    }
+    if (destOrigin->batch() < batch) {
+        MNN_ERROR("The batch of dest tensor %d is less than the crop number %d\n", destOrigin->batch(), batch);
+        return INPUT_DATA_ERROR;
+    }
+    std::shared_ptr<Tensor> tempTensor;
+    auto ow              = dest->width();
+    auto oh              = dest->height();
+    auto bpp             = dest->channel();
+    auto dimensionFormat = TensorUtils::getDescribe(dest)->dimensionFormat;
+    auto tensorBn = TensorUtils::getDescribe(dest)->backend;
+    auto bnType = MNN_FORWARD_CPU;
+    if(tensorBn){
+        bnType = tensorBn->type();
+    }
+    if (bnType != MNN_FORWARD_CPU) {
+        tempTensor.reset(Tensor::create({batch, bpp, oh, ow}, dest->getType(), nullptr, Tensor::CAFFE_C4),[destOrigin] (void* p) {
+            auto hostTensor = (Tensor*)p;
+            destOrigin->copyFromHostTensor(hostTensor);
+            delete hostTensor;
+        });
+        dest = tempTensor.get();
+    }
+    else if (MNN_DATA_FORMAT_NCHW == dimensionFormat) {
+        tempTensor.reset(Tensor::create(dest->shape(), dest->getType(), nullptr, Tensor::CAFFE_C4), [destOrigin](void* p) {
+            auto hostTensor = (Tensor*)p;
+            CPUTensorConverter::convert(hostTensor, destOrigin);
+            delete hostTensor;
+        });
+        dest = tempTensor.get();
+    }
+    dimensionFormat = TensorUtils::getDescribe(dest)->dimensionFormat;
+    if (dimensionFormat == MNN_DATA_FORMAT_NC4HW4) {
+        bpp = 4;
+    }
+    // Use the threads of the CPU backend which the tensor belongs to
+    const CPUBackend* cpuBackend = nullptr;
+    if (nullptr != tensorBn && bnType == MNN_FORWARD_CPU) {
+        cpuBackend = static_cast<const CPUBackend*>(tensorBn);
+    }
+    return _convertImage(inside, transforms, transformInverts, batch, source, iw, ih, stride, dest->host<void>(), ow,
+                         oh, bpp, dest->getType(), cpuBackend);
+}
+
+ErrorCode ImageProcess::convert(const uint8_t* source, int iw, int ih, int stride, Tensor* dest) {
+    return _convertTensor(mInside, &mTransform, &mTransformInvert, 1, source, iw, ih, stride, dest);
+}
+
+ErrorCode ImageProcess::convert(const uint8_t* source, int iw, int ih, int stride, const std::vector<Matrix>& matrixs,
+                                Tensor* dest) {
+    if (matrixs.empty()) {
+        MNN_ERROR("No matrix for batch image process\n");
+        return INPUT_DATA_ERROR;
+    }
+    std::vector<Matrix> inverts(matrixs.size());
+    for (int i = 0; i < matrixs.size(); ++i) {
+        if (!_invertBoxMatrix(matrixs[i], &inverts[i])) {
+            MNN_ERROR("The matrix %d for batch image process can't be inverted\n", i);
+            return INPUT_DATA_ERROR;
+        }
+    }
+    return _convertTensor(mInside, matrixs.data(), inverts.data(), (int)matrixs.size(), source, iw, ih, stride, dest);
+}
+
+ErrorCode ImageProcess::convert(const uint8_t* source, int iw, int ih, int stride, const float* boxes, int boxNumber,
+                                Tensor* dest) {
+    if (nullptr == dest || nullptr == boxes || boxNumber <= 0) {
+        MNN_ERROR("null dest or no box for batch image process\n");
+        return INPUT_DATA_ERROR;
+    }
+    std::vector<Matrix> matrixs(boxNumber);
+    for (int i = 0; i < boxNumber; ++i) {
+        matrixs[i] = computeBoxMatrix(boxes + 4 * i, iw, ih, dest->width(), dest->height());
+    }
+    return convert(source, iw, ih, stride, matrixs, dest);
+}
+
+Matrix ImageProcess::computeBoxMatrix(const float* box, int iw, int ih, int ow, int oh) {
+    // Same sample points as CropAndResize: box is normalized [y1, x1, y2, x2] and the corner pixels of the
+    // crop map to the box edges. A crop of size 1 samples the box center, keep scale 1 to make it invertible.
+    const float y1 = box[0], x1 = box[1], y2 = box[2], x2 = box[3];
+    float sx = 1.0f, sy = 1.0f;
+    float tx = 0.5f * (x1 + x2) * (iw - 1);
+    float ty = 0.5f * (y1 + y2) * (ih - 1);
+    if (ow > 1) {
+        sx = (x2 - x1) * (iw - 1) / (ow - 1);
+        tx = x1 * (iw - 1);
+    }
+    if (oh > 1) {
+        sy = (y2 - y1) * (ih - 1) / (oh - 1);
+        ty = y1 * (ih - 1);
+    }
+    Matrix matrix;
+    matrix.setScaleTranslate(sx, sy, tx, ty);
+    return matrix;
+}
+
+ErrorCode ImageProcess::convert(const uint8_t* source, int iw, int ih, int stride, void* dest, int ow, int oh,
+                                int outputBpp, int outputStride, halide_type_t type) {
+    return _convertImage(mInside, &mTransform, &mTransformInvert, 1, source, iw, ih, stride, dest, ow, oh, outputBpp,
+                         type, nullptr);
+}
+
 } // namespace CV
 } // namespace MNN
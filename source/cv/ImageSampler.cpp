@@ -8,10 +8,15 @@
 
 #include "cv/ImageSampler.hpp"
 #include <algorithm>
-#include "core/Macro.h"
+#include <math.h>
+#include <string.h>
 #ifdef MNN_USE_NEON
 #include <arm_neon.h>
+#elif defined(MNN_USE_SSE)
+#include <emmintrin.h>
 #endif
+#include "core/Macro.h"
+#include "math/Vec.hpp"
 extern "C" {
 void MNNSamplerC4BilinearOpt(const unsigned char* source, unsigned char* dest, float* points, size_t count, size_t xMax,
                              size_t yMax, size_t yStride);
@@ -26,11 +31,158 @@ void MNNSamplerC1NearestOpt(const unsigned char* source, unsigned char* dest, fl
 
 namespace MNN {
 namespace CV {
+using Vec4 = MNN::Math::Vec<float, 4>;
 
 static inline float __clamp(float v, float minV, float maxV) {
     return std::max(std::min(v, maxV), minV);
 }
 
+// The bytes of pixel in memory order to the lanes
+static inline Vec4 _pixelToVec4(uint32_t pixel) {
+#ifdef MNN_USE_NEON
+    auto u16 = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(pixel))));
+    return Vec4(vcvtq_f32_u32(vmovl_u16(u16)));
+#elif defined(MNN_USE_SSE)
+    auto zero = _mm_setzero_si128();
+    auto u8   = _mm_cvtsi32_si128((int)pixel);
+    return Vec4(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(u8, zero), zero)));
+#else
+    unsigned char p[4];
+    ::memcpy(p, &pixel, sizeof(uint32_t));
+    float v[4] = {(float)p[0], (float)p[1], (float)p[2], (float)p[3]};
+    return Vec4::load(v);
+#endif
+}
+
+static inline Vec4 _loadPixelC4(const unsigned char* source) {
+    uint32_t pixel;
+    ::memcpy(&pixel, source, sizeof(uint32_t));
+    return _pixelToVec4(pixel);
+}
+
+// Little endian like the memcpy of _loadPixelC4. Built in registers, a narrow copy to the stack stalls the load.
+static inline uint32_t _packBytes(uint32_t b0, uint32_t b1, uint32_t b2, uint32_t b3) {
+    return b0 | (b1 << 8) | (b2 << 16) | (b3 << 24);
+}
+
+// The last lane is zero, never reads the byte after the pixel
+static inline Vec4 _loadPixelC3(const unsigned char* source) {
+    return _pixelToVec4(_packBytes(source[0], source[1], source[2], 0));
+}
+
+// Gather one byte of each row
+static inline Vec4 _loadPixelC1x4(const unsigned char* const* rows, int offset) {
+    return _pixelToVec4(_packBytes(rows[0][offset], rows[1][offset], rows[2][offset], rows[3][offset]));
+}
+
+static inline unsigned char _roundToUint8(float v) {
+    return (unsigned char)__clamp(v + 0.5f, 0.0f, 255.0f);
+}
+
+// _roundToUint8 of the lanes, the bytes are in lane order in memory
+static inline uint32_t _roundToUint8C4(const Vec4& v) {
+#ifdef MNN_USE_NEON
+    auto f   = vminq_f32(vmaxq_f32(vaddq_f32(v.value, vdupq_n_f32(0.5f)), vdupq_n_f32(0.0f)), vdupq_n_f32(255.0f));
+    auto u16 = vmovn_u32(vcvtq_u32_f32(f));
+    auto u8  = vmovn_u16(vcombine_u16(u16, u16));
+    return vget_lane_u32(vreinterpret_u32_u8(u8), 0);
+#elif defined(MNN_USE_SSE)
+    auto f   = _mm_min_ps(_mm_max_ps(_mm_add_ps(v.value, _mm_set1_ps(0.5f)), _mm_setzero_ps()), _mm_set1_ps(255.0f));
+    auto i32 = _mm_cvttps_epi32(f);
+    auto u8  = _mm_packus_epi16(_mm_packs_epi32(i32, i32), _mm_setzero_si128());
+    return (uint32_t)_mm_cvtsi128_si32(u8);
+#else
+    float f[4];
+    Vec4::save(f, v);
+    unsigned char p[4] = {_roundToUint8(f[0]), _roundToUint8(f[1]), _roundToUint8(f[2]), _roundToUint8(f[3])};
+    uint32_t pixel;
+    ::memcpy(&pixel, p, sizeof(uint32_t));
+    return pixel;
+#endif
+}
+
+// Cubic convolution kernel with a = -0.75
+static inline float _cubicWeight(float t) {
+    const float a = -0.75f;
+    t             = fabsf(t);
+    if (t <= 1.0f) {
+        return ((a + 2.0f) * t - (a + 3.0f)) * t * t + 1.0f;
+    }
+    if (t < 2.0f) {
+        return ((a * t - 5.0f * a) * t + 8.0f * a) * t - 4.0f * a;
+    }
+    return 0.0f;
+}
+
+// The 4 taps around s: floor(s) - 1 ... floor(s) + 2, index clamped to [0, size - 1]
+static inline void _cubicTaps(float s, int size, int* index, float* weight) {
+    int s0   = (int)floorf(s);
+    float sF = s - (float)s0;
+    weight[0] = _cubicWeight(sF + 1.0f);
+    weight[1] = _cubicWeight(sF);
+    weight[2] = _cubicWeight(1.0f - sF);
+    weight[3] = _cubicWeight(2.0f - sF);
+    for (int k = 0; k < 4; ++k) {
+        index[k] = std::max(std::min(s0 - 1 + k, size - 1), 0);
+    }
+}
+
+static void _sampleBicubicCommon(const unsigned char* source, unsigned char* dest, Point* points, size_t count,
+                                 size_t iw, size_t ih, size_t yStride, size_t bpp) {
+    float dy   = points[1].fY;
+    float dx   = points[1].fX;
+    float xMax = iw - 1;
+    float yMax = ih - 1;
+    float curX = points[0].fX;
+    float curY = points[0].fY;
+    int xIndex[4], yIndex[4];
+    float xWeight[4], yWeight[4];
+    for (int i = 0; i < count; ++i) {
+        _cubicTaps(__clamp(curX, 0, xMax), (int)iw, xIndex, xWeight);
+        _cubicTaps(__clamp(curY, 0, yMax), (int)ih, yIndex, yWeight);
+        curX += dx;
+        curY += dy;
+        if (1 != bpp) {
+            Vec4 sum(0.0f);
+            for (int ky = 0; ky < 4; ++ky) {
+                auto row = source + yIndex[ky] * yStride;
+                Vec4 line(0.0f);
+                for (int kx = 0; kx < 4; ++kx) {
+                    auto pixel = row + bpp * xIndex[kx];
+                    line       = line + (4 == bpp ? _loadPixelC4(pixel) : _loadPixelC3(pixel)) * xWeight[kx];
+                }
+                sum = sum + line * yWeight[ky];
+            }
+            auto pixel = _roundToUint8C4(sum);
+            ::memcpy(dest + bpp * i, &pixel, bpp);
+            continue;
+        }
+        // GRAY: the 4 rows in the lanes
+        const unsigned char* rows[4] = {source + yIndex[0] * yStride, source + yIndex[1] * yStride,
+                                        source + yIndex[2] * yStride, source + yIndex[3] * yStride};
+        Vec4 lines(0.0f);
+        for (int kx = 0; kx < 4; ++kx) {
+            lines = lines + _loadPixelC1x4(rows, xIndex[kx]) * xWeight[kx];
+        }
+        float v[4];
+        Vec4::save(v, lines * Vec4::load(yWeight));
+        dest[i] = _roundToUint8((v[0] + v[1]) + (v[2] + v[3]));
+    }
+}
+
+static void MNNSamplerC4Bicubic(const unsigned char* source, unsigned char* dest, Point* points, size_t sta,
+                                size_t count, size_t capacity, size_t iw, size_t ih, size_t yStride) {
+    _sampleBicubicCommon(source, dest + 4 * sta, points, count, iw, ih, yStride, 4);
+}
+static void MNNSamplerC3Bicubic(const unsigned char* source, unsigned char* dest, Point* points, size_t sta,
+                                size_t count, size_t capacity, size_t iw, size_t ih, size_t yStride) {
+    _sampleBicubicCommon(source, dest + 3 * sta, points, count, iw, ih, yStride, 3);
+}
+static void MNNSamplerC1Bicubic(const unsigned char* source, unsigned char* dest, Point* points, size_t sta,
+                                size_t count, size_t capacity, size_t iw, size_t ih, size_t yStride) {
+    _sampleBicubicCommon(source, dest + sta, points, count, iw, ih, yStride, 1);
+}
+
 static void _sampleBilinearCommon(const unsigned char* source, unsigned char* dest, Point* points, size_t count,
                                   size_t iw, size_t ih, size_t yStride, size_t bpp) {
     float dy   = points[1].fY;
@@ -69,7 +221,7 @@ static void _sampleBilinearCommon(const unsigned char* source, unsigned char* de
 
 static void MNNSamplerC4Bilinear(const unsigned char* source, unsigned char* dest, Point* points, size_t sta,
                                  size_t count, size_t capacity, size_t iw, size_t ih, size_t yStride) {
-#ifdef MNN_USE_NEON
+#if defined(MNN_USE_NEON) || defined(MNN_USE_SSE)
     MNNSamplerC4BilinearOpt(source, dest + 4 * sta, reinterpret_cast<float*>(points), count, iw - 1, ih - 1, yStride);
 #else
     _sampleBilinearCommon(source, dest + 4 * sta, points, count, iw, ih, yStride, 4);
@@ -81,7 +233,7 @@ static void MNNSamplerC3Bilinear(const unsigned char* source, unsigned char* des
 }
 static void MNNSamplerC1Bilinear(const unsigned char* source, unsigned char* dest, Point* points, size_t sta,
                                  size_t count, size_t capacity, size_t iw, size_t ih, size_t yStride) {
-#ifdef MNN_USE_NEON
+#if defined(MNN_USE_NEON) || defined(MNN_USE_SSE)
     MNNSamplerC1BilinearOpt(source, dest + sta, reinterpret_cast<float*>(points), count, iw - 1, ih - 1, yStride);
 #else
     _sampleBilinearCommon(source, dest + sta, points, count, iw, ih, yStride, 1);
@@ -112,7 +264,7 @@ static void MNNSamplerNearest(const unsigned char* source, unsigned char* dest,
 
 static void MNNSamplerC4Nearest(const unsigned char* source, unsigned char* dest, Point* points, size_t sta,
                                 size_t count, size_t capacity, size_t iw, size_t ih, size_t yStride) {
-#ifdef MNN_USE_NEON
+#if defined(MNN_USE_NEON) || defined(MNN_USE_SSE)
     MNNSamplerC4NearestOpt(source, dest + 4 * sta, (float*)points, count, iw - 1, ih - 1, yStride);
 #else
     MNNSamplerNearest(source, dest, points, sta, count, iw, ih, yStride, 4);
@@ -121,7 +273,7 @@ static void MNNSamplerC4Nearest(const unsigned char* source, unsigned char* dest
 
 static void MNNSamplerC1Nearest(const unsigned char* source, unsigned char* dest, Point* points, size_t sta,
                                 size_t count, size_t capacity, size_t iw, size_t ih, size_t yStride) {
-#ifdef MNN_USE_NEON
+#if defined(MNN_USE_NEON) || defined(MNN_USE_SSE)
     MNNSamplerC1NearestOpt(source, dest + sta, (float*)points, count, iw - 1, ih - 1, yStride);
 #else
     MNNSamplerNearest(source, dest, points, sta, count, iw, ih, yStride, 1);
@@ -276,6 +428,15 @@ static void _swapUV(const unsigned char* source, unsigned char* dest, size_t cou
         src.val[1] = temp;
         vst2q_u8(dest + i * 32, src);
     }
+#endif
+#ifdef MNN_USE_SSE
+    int countC2C8 = (int)countC2 / 8;
+    sta = countC2C8 * 8;
+    for (int i=0; i<countC2C8; ++i) {
+        auto src = _mm_loadu_si128((const __m128i*)(source + i * 16));
+        // Swap the bytes of each 16 bits
+        _mm_storeu_si128((__m128i*)(dest + i * 16), _mm_or_si128(_mm_slli_epi16(src, 8), _mm_srli_epi16(src, 8)));
+    }
 #endif
     for (int i=sta; i < countC2; ++i) {
         auto temp = source[2*i];
@@ -323,7 +484,23 @@ ImageSampler::PROC ImageSampler::choose(ImageFormat format, Filter type, bool id
                 break;
         }
     }
-    if (BILINEAR == type) {
+    if (BICUBIC == type) {
+        switch (format) {
+            case RGBA:
+            case BGRA:
+                return MNNSamplerC4Bicubic;
+            case GRAY:
+                return MNNSamplerC1Bicubic;
+
+            case RGB:
+            case BGR:
+                return MNNSamplerC3Bicubic;
+            default:
+                break;
+        }
+    }
+    // AREA without ImageSeparableSampler is the same as BILINEAR
+    if (BILINEAR == type || AREA == type) {
         switch (format) {
             case RGBA:
             case BGRA:
@@ -363,5 +540,247 @@ ImageSampler::PROC ImageSampler::choose(ImageFormat format, Filter type, bool id
     return nullptr;
 }
 
+bool ImageSeparableSampler::support(ImageFormat format, Filter type, Wrap wrap, const Matrix& transform) {
+    if ((BICUBIC != type && AREA != type) || CLAMP_TO_EDGE != wrap) {
+        return false;
+    }
+    switch (format) {
+        case RGBA:
+        case BGRA:
+        case RGB:
+        case BGR:
+        case GRAY:
+            break;
+        default:
+            return false;
+    }
+    return transform.isScaleTranslate() && transform.getScaleX() > 0.0f && transform.getScaleY() > 0.0f;
+}
+
+void ImageSeparableSampler::_computeTaps(Taps& taps, Filter type, float scale, float offset, int inSize,
+                                         int outSize) {
+    if (BICUBIC == type) {
+        taps.number = 4;
+        taps.index.resize(outSize * 4);
+        taps.weight.resize(outSize * 4);
+        float sMax = (float)(inSize - 1);
+        for (int o = 0; o < outSize; ++o) {
+            _cubicTaps(__clamp(o * scale + offset, 0, sMax), inSize, taps.index.data() + 4 * o,
+                       taps.weight.data() + 4 * o);
+        }
+        return;
+    }
+    // AREA: the pixel i covers [i, i + 1), the dest pixel o covers the box of width max(scale, 1) centered at
+    // o * scale + offset + 0.5, the weight of i is the covered length. Upscale turns to be bilinear.
+    float width  = std::max(scale, 1.0f);
+    taps.number  = (int)ceilf(width) + 1;
+    taps.index.resize(outSize * taps.number);
+    taps.weight.resize(outSize * taps.number);
+    for (int o = 0; o < outSize; ++o) {
+        float lo     = o * scale + offset + 0.5f - width * 0.5f;
+        float hi     = lo + width;
+        lo           = __clamp(lo, 0.0f, (float)inSize - width);
+        hi           = lo + width;
+        int first    = (int)floorf(lo);
+        auto index   = taps.index.data() + o * taps.number;
+        auto weight  = taps.weight.data() + o * taps.number;
+        float sum    = 0.0f;
+        for (int k = 0; k < taps.number; ++k) {
+            int i     = first + k;
+            float w   = std::min(hi, (float)(i + 1)) - std::max(lo, (float)i);
+            weight[k] = std::max(w, 0.0f);
+            index[k]  = std::max(std::min(i, inSize - 1), 0);
+            sum += weight[k];
+        }
+        for (int k = 0; k < taps.number; ++k) {
+            weight[k] = weight[k] / sum;
+        }
+    }
+}
+
+void ImageSeparableSampler::_computeBoxes(float scale, float offset, int inSize, int outSize) {
+    // The same box as the AREA taps, a bound within 1e-3 of an integer is snapped to it, so the integer and
+    // near-integer factors have no partial pixel
+    auto snap = [](float v) {
+        float r = roundf(v);
+        return fabsf(v - r) < 1e-3f ? r : v;
+    };
+    mBoxScale = 1.0f / scale;
+    mBoxes.resize(outSize);
+    for (int o = 0; o < outSize; ++o) {
+        float lo        = __clamp(o * scale + offset + 0.5f - scale * 0.5f, 0.0f, (float)inSize - scale);
+        float hi        = snap(lo + scale);
+        lo              = snap(lo);
+        auto& box       = mBoxes[o];
+        box.begin       = (int)ceilf(lo);
+        box.end         = std::max((int)floorf(hi), box.begin);
+        box.left        = std::max(box.begin - 1, 0);
+        box.right       = std::min(box.end, inSize - 1);
+        box.leftWeight  = (float)box.begin - lo;
+        box.rightWeight = box.end < inSize ? hi - (float)box.end : 0.0f;
+    }
+}
+
+ImageSeparableSampler::ImageSeparableSampler(ImageFormat format, Filter type, const Matrix& transform, int iw,
+                                             int ih, int ow, int oh) {
+    mBpp       = (GRAY == format) ? 1 : ((RGB == format || BGR == format) ? 3 : 4);
+    mOutWidth  = ow;
+    mRowStride = ALIGN_UP4(ow * mBpp) + 4;
+    _computeTaps(mY, type, transform.getScaleY(), transform.getTranslateY(), ih, oh);
+    // The box of AREA downscale covers about scale pixels, summing them as integers is cheaper than the taps
+    if (AREA == type && transform.getScaleX() > 1.0f && transform.getScaleX() <= std::min((float)iw, 512.0f)) {
+        _computeBoxes(transform.getScaleX(), transform.getTranslateX(), iw, ow);
+        return;
+    }
+    _computeTaps(mX, type, transform.getScaleX(), transform.getTranslateX(), iw, ow);
+    if (1 == mBpp) {
+        auto number = mX.number;
+        mXC4.number = number;
+        mXC4.index.resize(UP_DIV(ow, 4) * number * 4, 0);
+        mXC4.weight.resize(UP_DIV(ow, 4) * number * 4, 0.0f);
+        for (int x = 0; x < ow; ++x) {
+            for (int k = 0; k < number; ++k) {
+                auto dst         = ((x / 4) * number + k) * 4 + x % 4;
+                mXC4.index[dst]  = mX.index[x * number + k];
+                mXC4.weight[dst] = mX.weight[x * number + k];
+            }
+        }
+    }
+}
+
+void ImageSeparableSampler::resetCache(RowCache& cache) const {
+    if (cache.buffer.size() < (size_t)mY.number * mRowStride) {
+        cache.buffer.resize((size_t)mY.number * mRowStride);
+    }
+    cache.rows.assign(mY.number, -1);
+}
+
+template <int BPP>
+void ImageSeparableSampler::_filterRowBox(const unsigned char* row, float* dest) const {
+    // Sum the bytes by 8 bytes words: the even and odd bytes of a word are added in the 16 bits lanes of two
+    // accumulators. The group of words holds whole pixels, so the channel of a lane only depends on its place. A lane
+    // gets one byte per group, it doesn't overflow for the box of 512 pixels at most.
+    const int words     = (3 == BPP) ? 3 : 1;
+    const uint64_t mask = 0x00FF00FF00FF00FFULL;
+    for (int x = 0; x < mOutWidth; ++x) {
+        const auto& box = mBoxes[x];
+        auto bytes      = row + box.begin * BPP;
+        int size        = (box.end - box.begin) * BPP;
+        uint64_t even[3] = {0, 0, 0};
+        uint64_t odd[3]  = {0, 0, 0};
+        int i            = 0;
+        for (; i + 8 * words <= size; i += 8 * words) {
+            for (int w = 0; w < words; ++w) {
+                uint64_t v;
+                ::memcpy(&v, bytes + i + 8 * w, sizeof(uint64_t));
+                even[w] += v & mask;
+                odd[w] += (v >> 8) & mask;
+            }
+        }
+        uint32_t sum[BPP] = {0};
+        for (int w = 0; w < words; ++w) {
+            for (int l = 0; l < 4; ++l) {
+                sum[(8 * w + 2 * l) % BPP] += (uint32_t)(even[w] >> (16 * l)) & 0xFFFF;
+                sum[(8 * w + 2 * l + 1) % BPP] += (uint32_t)(odd[w] >> (16 * l)) & 0xFFFF;
+            }
+        }
+        for (; i < size; ++i) {
+            sum[i % BPP] += bytes[i];
+        }
+        auto left  = row + box.left * BPP;
+        auto right = row + box.right * BPP;
+        for (int c = 0; c < BPP; ++c) {
+            dest[BPP * x + c] = ((float)sum[c] + box.leftWeight * left[c] + box.rightWeight * right[c]) * mBoxScale;
+        }
+    }
+}
+
+void ImageSeparableSampler::_filterRow(const unsigned char* row, float* dest) const {
+    if (!mBoxes.empty()) {
+        switch (mBpp) {
+            case 1:
+                _filterRowBox<1>(row, dest);
+                break;
+            case 3:
+                _filterRowBox<3>(row, dest);
+                break;
+            default:
+                _filterRowBox<4>(row, dest);
+                break;
+        }
+        return;
+    }
+    auto number = mX.number;
+    if (1 == mBpp) {
+        for (int x = 0; x < mOutWidth; x += 4) {
+            auto index  = mXC4.index.data() + x * number;
+            auto weight = mXC4.weight.data() + x * number;
+            Vec4 sum(0.0f);
+            for (int k = 0; k < number; ++k) {
+                auto pixel = _packBytes(row[index[4 * k + 0]], row[index[4 * k + 1]], row[index[4 * k + 2]],
+                                        row[index[4 * k + 3]]);
+                sum        = sum + _pixelToVec4(pixel) * Vec4::load(weight + 4 * k);
+            }
+            // The row is padded to 4 floats
+            Vec4::save(dest + x, sum);
+        }
+        return;
+    }
+    for (int x = 0; x < mOutWidth; ++x) {
+        auto index  = mX.index.data() + x * number;
+        auto weight = mX.weight.data() + x * number;
+        Vec4 sum(0.0f);
+        if (4 == mBpp) {
+            for (int k = 0; k < number; ++k) {
+                sum = sum + _loadPixelC4(row + 4 * index[k]) * weight[k];
+            }
+        } else {
+            for (int k = 0; k < number; ++k) {
+                sum = sum + _loadPixelC3(row + 3 * index[k]) * weight[k];
+            }
+        }
+        // C3 writes one float after the pixel, the next pixel or the row padding
+        Vec4::save(dest + mBpp * x, sum);
+    }
+}
+
+void ImageSeparableSampler::sample(const unsigned char* source, size_t yStride, int dy, int xStart, int count,
+                                   unsigned char* dest, RowCache& cache) const {
+    auto number  = mY.number;
+    auto yIndex  = mY.index.data() + dy * number;
+    auto yWeight = mY.weight.data() + dy * number;
+    // The rows of a dest row are consecutive after clamping, so they never share a slot
+    for (int k = 0; k < number; ++k) {
+        auto y    = yIndex[k];
+        auto slot = y % number;
+        if (0.0f != yWeight[k] && cache.rows[slot] != y) {
+            _filterRow(source + y * yStride, cache.buffer.data() + slot * mRowStride);
+            cache.rows[slot] = y;
+        }
+    }
+    auto line = cache.buffer.data() + xStart * mBpp;
+    auto size = count * mBpp;
+    int i     = 0;
+    for (; i + 4 <= size; i += 4) {
+        Vec4 sum(0.0f);
+        for (int k = 0; k < number; ++k) {
+            if (0.0f != yWeight[k]) {
+                sum = sum + Vec4::load(line + (yIndex[k] % number) * mRowStride + i) * yWeight[k];
+            }
+        }
+        auto pixel = _roundToUint8C4(sum);
+        ::memcpy(dest + i, &pixel, sizeof(uint32_t));
+    }
+    for (; i < size; ++i) {
+        float sum = 0.0f;
+        for (int k = 0; k < number; ++k) {
+            if (0.0f != yWeight[k]) {
+                sum += line[(yIndex[k] % number) * mRowStride + i] * yWeight[k];
+            }
+        }
+        dest[i] = _roundToUint8(sum);
+    }
+}
+
 } // namespace CV
 } // namespace MNN
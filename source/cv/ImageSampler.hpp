@@ -9,6 +9,7 @@
 #ifndef ImageSampler_hpp
 #define ImageSampler_hpp
 #include <MNN/ImageProcess.hpp>
+#include <vector>
 namespace MNN {
 namespace CV {
 class ImageSampler {
@@ -18,6 +19,63 @@ public:
 
     static PROC choose(ImageFormat format, Filter type, bool identity);
 };
+
+/** Separable resize for axis-aligned scale (BICUBIC / AREA). The taps of each dest column and row are computed
+    once. Source rows are filtered horizontally into a ring of rows that is shared by the consecutive dest rows,
+    a dest row then only combines them vertically. */
+class ImageSeparableSampler {
+public:
+    static bool support(ImageFormat format, Filter type, Wrap wrap, const Matrix& transform);
+    // transform: dest -> source
+    ImageSeparableSampler(ImageFormat format, Filter type, const Matrix& transform, int iw, int ih, int ow, int oh);
+
+    // Horizontally filtered source rows of one thread, the source row r is kept in the slot r % (row taps)
+    struct RowCache {
+        std::vector<float> buffer;
+        std::vector<int> rows;
+    };
+    // Drop the rows of the previous source / sampler, call it before the first sample of a band
+    void resetCache(RowCache& cache) const;
+
+    // Sample [xStart, xStart + count) of dest row dy
+    void sample(const unsigned char* source, size_t yStride, int dy, int xStart, int count, unsigned char* dest,
+                RowCache& cache) const;
+
+private:
+    struct Taps {
+        int number = 0;
+        // [outSize, number], the padding taps have zero weight
+        std::vector<int> index;
+        std::vector<float> weight;
+    };
+    static void _computeTaps(Taps& taps, Filter type, float scale, float offset, int inSize, int outSize);
+    // AREA downscale of a row: the dest pixel sums the source pixels [begin, end) as integers and adds the partly
+    // covered pixels left and right by their weights, the result is divided by the box width
+    struct Box {
+        int begin;
+        int end;
+        int left;
+        int right;
+        float leftWeight;
+        float rightWeight;
+    };
+    void _computeBoxes(float scale, float offset, int inSize, int outSize);
+    // Filter the whole dest width of a source row
+    void _filterRow(const unsigned char* row, float* dest) const;
+    template <int BPP>
+    void _filterRowBox(const unsigned char* row, float* dest) const;
+    Taps mX;
+    Taps mY;
+    // GRAY: mX regrouped as [UP_DIV(ow, 4), number, 4] to filter 4 dest pixels at once
+    Taps mXC4;
+    // Replace mX if not empty
+    std::vector<Box> mBoxes;
+    float mBoxScale = 1.0f;
+    int mBpp;
+    int mOutWidth;
+    // Floats of a cached row, padded for the Vec4 store of the last pixel
+    int mRowStride;
+};
 } // namespace CV
 } // namespace MNN
 #endif /* ImageSampler_hpp */
@@ -23,9 +23,11 @@ GeometryComputer::Context::~Context() {
     }
 }
 
-GeometryComputer::Context::Context(std::shared_ptr<Backend> allocBackend, bool permitVirtual) {
-    mPermitVirtual = permitVirtual;
-    mBackend       = allocBackend;
+GeometryComputer::Context::Context(std::shared_ptr<Backend> allocBackend, bool permitVirtual, bool keepRecurrentState) {
+    mPermitVirtual      = permitVirtual;
+    mKeepRecurrentState = keepRecurrentState;
+    mBackend            = allocBackend;
+    mForwardType        = allocBackend->type();
     flatbuffers::FlatBufferBuilder builder;
     OpBuilder opBuilder(builder);
     opBuilder.add_type(OpType_Raster);
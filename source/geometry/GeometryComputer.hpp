@@ -10,6 +10,7 @@
 #define GeometryComputer_hpp
 #include <map>
 #include <vector>
+#include <MNN/MNNForwardType.h>
 #include "MNN_generated.h"
 #include "core/Command.hpp"
 #include "core/TensorUtils.hpp"
@@ -22,7 +23,7 @@ public:
     }
     class MNN_PUBLIC Context {
     public:
-        Context(std::shared_ptr<Backend> allocBackend, bool permitVirtual = true);
+        Context(std::shared_ptr<Backend> allocBackend, bool permitVirtual = true, bool keepRecurrentState = false);
         ~Context();
 
         void clear();
@@ -30,6 +31,17 @@ public:
         bool supportVirtual() const {
             return mPermitVirtual;
         }
+        // Recurrent op should keep its state between executions instead of decomposing it
+        bool keepRecurrentState() const {
+            return mKeepRecurrentState;
+        }
+        // The type of backend running the commands, see GeometryConv2DBackPropFilter
+        void setForwardType(MNNForwardType type) {
+            mForwardType = type;
+        }
+        MNNForwardType forwardType() const {
+            return mForwardType;
+        }
         Tensor* getRasterCacheCreateRecurrse(Tensor* src, CommandBuffer& cmd);
         const std::vector<std::shared_ptr<Tensor>>& searchConst(const Op* op) const;
         std::shared_ptr<Tensor> allocConst(const Op* key, const std::vector<int>& shape, halide_type_t type,
@@ -42,6 +54,8 @@ public:
         std::map<const Op*, std::vector<std::shared_ptr<Tensor>>> mConstTensors;
         std::vector<std::shared_ptr<Tensor>> mEmpty;
         bool mPermitVirtual;
+        bool mKeepRecurrentState;
+        MNNForwardType mForwardType;
         std::shared_ptr<Backend> mBackend;
         std::vector<uint8_t> mRasterOp;
     };
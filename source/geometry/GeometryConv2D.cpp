@@ -218,14 +218,15 @@ public:
             res.extras.emplace_back(C);
 
             // Col2Im:
-            // 1. C-> C' batch, oc, oh, ow, kw*kh, 2. C' -> C'' batch, oc, oh, ow (reduce_sum)
+            // 1. C-> C' kw*kh, batch, oc, oh, ow, 2. C' -> C'' batch, oc, oh, ow (reduce_sum)
             // 3. C'' -> C'' + bias, 4. posttreat(C'' + bias)
-            std::shared_ptr<Tensor> C_(Tensor::createDevice<float>({batch, kw * kh, oc * oh * ow}));
+            // The kernel axis of C' must be outside of batch, im2Col assumes the batch stride is oc * oh * ow
+            std::shared_ptr<Tensor> C_(Tensor::createDevice<float>({1, kw * kh, batch * oc * oh * ow}));
             res.extras.emplace_back(C_);
             {
                 std::shared_ptr<Tensor> im2ColTemp(Tensor::createDevice<float>({oc * kw * kh, batch * ih * iw}));
                 // Swap ow, iw, oh, ih for im2Col
-                GeometryConvUtils::im2Col(im2ColTemp.get(), outputDiff, oc, kh, kw, batch, ih, iw, oh, ow, sh, sw, dh, dw, pads, oh * ow * oc);
+                GeometryConvUtils::im2Col(im2ColTemp.get(), outputDiff, oc, kh, kw, batch, ih, iw, oh, ow, sh, sw, dh, dw, pads, batch * oh * ow * oc);
                 auto des = TensorUtils::getDescribe(C_.get());
                 des->memoryType = Tensor::InsideDescribe::MemoryType::MEMORY_VIRTUAL;
                 auto originDes = TensorUtils::getDescribe(im2ColTemp.get());
@@ -238,9 +239,12 @@ public:
                     reg.dst = std::move(temp);
                 }
             }
+            std::shared_ptr<Tensor> sum(Tensor::createDevice<float>({1, 1, batch * oc * oh * ow}));
+            res.extras.emplace_back(sum);
+            res.command.emplace_back(GeometryComputerUtils::makeReduce(ReductionType_SUM, C_.get(), sum.get()));
             std::shared_ptr<Tensor> C__(Tensor::createDevice<float>({batch, 1, oc * oh * ow}));
             res.extras.emplace_back(C__);
-            res.command.emplace_back(GeometryComputerUtils::makeReduce(ReductionType_SUM, C_.get(), C__.get()));
+            GeometryComputerUtils::makeRawAddressRef(C__.get(), sum.get(), 0, batch * oc * oh * ow);
 
             if (inputs.size() > 2) {
                 MNN_ASSERT(oc == inputs[2]->elementSize());
@@ -305,12 +309,42 @@ public:
         }
         return true;
     }
+    // Deconvolution with the weight from input, computed by CPUDeconvolutionMultiInput in NC4HW4
+    bool computeDirect(const Op* op, const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
+                       Context& context, CommandBuffer& res) const {
+        auto newInputs = inputs;
+        if (TensorUtils::getDescribe(inputs[0])->dimensionFormat != MNN_DATA_FORMAT_NC4HW4) {
+            std::shared_ptr<Tensor> newInput(new Tensor(inputs[0], Tensor::CAFFE_C4, false));
+            ConvertUtils::compute(inputs[0], newInput.get(), res);
+            newInputs[0] = newInput.get();
+            res.extras.emplace_back(std::move(newInput));
+        }
+        std::shared_ptr<Tensor> newOutput(new Tensor(outputs[0], Tensor::CAFFE_C4, false));
+        Command cmd;
+        cmd.op      = op;
+        cmd.inputs  = std::move(newInputs);
+        cmd.outputs = {newOutput.get()};
+        res.command.emplace_back(std::move(cmd));
+        ConvertUtils::compute(newOutput.get(), outputs[0], res);
+        res.extras.emplace_back(std::move(newOutput));
+        return true;
+    }
     virtual bool onCompute(const Op* op, const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
                            Context& context, CommandBuffer& res) const override {
         if (inputs.size() == 1) {
             // Origin convolution with format converter
             return GeometryConvUtils::computeSingle(op, inputs, outputs, context, res);
         }
+        if (MNN_FORWARD_CPU == context.forwardType()) {
+            // The lowering of 1x1 stride 1 is a single MatMul without col2im, faster than CPUDeconvolutionMultiInput
+            auto common    = op->main_as_Convolution2D()->common();
+            auto pads      = ConvolutionCommon::convolutionTransposePad(inputs[0], outputs[0], common);
+            bool pointwise = 1 == common->kernelX() && 1 == common->kernelY() && 1 == common->strideX() &&
+                             1 == common->strideY() && 0 == pads.first && 0 == pads.second;
+            if (!pointwise) {
+                return computeDirect(op, inputs, outputs, context, res);
+            }
+        }
         return computeGEMM_Col2Im(op, inputs, outputs, context, res);
     }
 };
@@ -167,6 +167,28 @@ public:
         }
         return true;
     }
+    // Keep the op for CPUConv2DBackPropFilter, which reads the inputs in NC4HW4
+    bool computeDirect(const Op* op, const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
+                       Context& context, CommandBuffer& res) const {
+        auto newInputs = inputs;
+        for (auto& input : newInputs) {
+            if (TensorUtils::getDescribe(input)->dimensionFormat != MNN_DATA_FORMAT_NC4HW4) {
+                std::shared_ptr<Tensor> newInput(new Tensor(input, Tensor::CAFFE_C4, false));
+                ConvertUtils::compute(input, newInput.get(), res);
+                input = newInput.get();
+                res.extras.emplace_back(std::move(newInput));
+            }
+        }
+        std::shared_ptr<Tensor> kernelDiff(new Tensor(outputs[0], Tensor::CAFFE, false));
+        Command cmd;
+        cmd.op      = op;
+        cmd.inputs  = std::move(newInputs);
+        cmd.outputs = {kernelDiff.get()};
+        res.command.emplace_back(std::move(cmd));
+        ConvertUtils::compute(kernelDiff.get(), outputs[0], res);
+        res.extras.emplace_back(std::move(kernelDiff));
+        return true;
+    }
     virtual bool onCompute(const Op* op, const std::vector<Tensor*>& inputs, const std::vector<Tensor*>& outputs,
                            Context& context, CommandBuffer& res) const override {
         auto common     = op->main_as_Convolution2D()->common();
@@ -175,6 +197,17 @@ public:
         bool depthWise  = false;
         if (inputs[0]->channel() == inputs[1]->channel() && inputs[1]->channel() == common->group()) {
             depthWise = true;
+        }
+        if (MNN_FORWARD_CPU == context.forwardType()) {
+            // The 1x1 stride 1 gradient is a single MatMul without im2col, faster than the tiles of the CPU execution
+            auto pads      = ConvolutionCommon::convolutionPad(input, outputDiff, common);
+            bool pointwise = 1 == common->kernelX() && 1 == common->kernelY() && 1 == common->strideX() &&
+                             1 == common->strideY() && 0 == pads.first && 0 == pads.second;
+            if (depthWise || (1 == common->group() && !pointwise)) {
+                return computeDirect(op, inputs, outputs, context, res);
+            }
+        }
+        if (depthWise) {
             return computeForDepthWise(common, input, outputDiff, outputs[0], context, res);
         }
         auto kw    = common->kernelX();
@@ -217,7 +217,9 @@ bool GeometryConvUtils::computeSingle(const Op* op, const std::vector<Tensor*>&
     auto output       = originOutput;
     auto inputDes     = TensorUtils::getDescribe(newInputs[0]);
     auto format       = inputDes->dimensionFormat;
-    if (MNN_DATA_FORMAT_NC4HW4 != format) {
+    // The uint8 image input is read by the convolution directly, see ConvolutionRawImage
+    bool rawImage = ConvolutionCommon::isRawImageConvolution(op, newInputs[0]);
+    if (MNN_DATA_FORMAT_NC4HW4 != format && !rawImage) {
         std::shared_ptr<Tensor> newInput(new Tensor(newInputs[0], Tensor::CAFFE_C4, false));
         ConvertUtils::compute(newInputs[0], newInput.get(), res);
         newInputs[0] = newInput.get();
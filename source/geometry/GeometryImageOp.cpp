@@ -146,6 +146,10 @@ public:
             // Turn resize to interp
             std::unique_ptr<OpT> interp(new OpT);
             interp->type                          = OpType_Interp;
+            if (nullptr != op->name()) {
+                // Keep the name for debug callback
+                interp->name = op->name()->str();
+            }
             interp->main.type                     = OpParameter_Interp;
             interp->main.value                    = new InterpT;
             interp->main.AsInterp()->widthScale = (float)inputs[0]->width() / (float)outputs[0]->width();
@@ -157,6 +161,9 @@ public:
             // Compute cord transform for interp
             std::unique_ptr<OpT> interp(new OpT);
             interp->type                          = OpType_Interp;
+            if (nullptr != op->name()) {
+                interp->name = op->name()->str();
+            }
             auto resize                           = op->main_as_Interp();
             interp->main.type                     = OpParameter_Interp;
             interp->main.value                    = new InterpT;
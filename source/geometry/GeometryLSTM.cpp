@@ -71,6 +71,26 @@ public:
         auto batchSize     = X_Input->length(1);
         auto hiddenSize    = Y->length(3);
         auto numDirections = Y->length(1);
+        if (context.keepRecurrentState()) {
+            // Use one LSTM command, so that its execution can keep the hidden / cell state between runs
+            std::unique_ptr<OpT> lstm(new OpT);
+            lstm->type                       = OpType_LSTM;
+            lstm->main.type                  = OpParameter_LSTM;
+            lstm->main.value                 = new LSTMT;
+            lstm->main.AsLSTM()->outputCount = hiddenSize;
+            lstm->main.AsLSTM()->keepState   = true;
+            std::vector<Tensor*> lstmOutputs;
+            for (auto output : outputs) {
+                std::shared_ptr<Tensor> newOutput(new Tensor);
+                TensorUtils::copyShape(output, newOutput.get(), true);
+                newOutput->buffer().type = output->getType();
+                res.extras.emplace_back(newOutput);
+                GeometryComputerUtils::makeRawAddressRef(output, newOutput.get(), 0, output->elementSize());
+                lstmOutputs.emplace_back(newOutput.get());
+            }
+            res.command.emplace_back(GeometryComputerUtils::makeCommand(lstm.get(), inputs, lstmOutputs));
+            return;
+        }
         // Output contain seqLength * numDirection's region
         auto outputDes        = TensorUtils::getDescribe(Y);
         outputDes->memoryType = Tensor::InsideDescribe::MemoryType::MEMORY_VIRTUAL;
@@ -9,6 +9,7 @@
 #include <math.h>
 #include "shape/SizeComputer.hpp"
 #include "core/TensorUtils.hpp"
+#include "core/ConvolutionCommon.hpp"
 namespace MNN {
 class ConvolutionSizeComputer : public SizeComputer {
 public:
@@ -67,6 +68,11 @@ public:
         outputBuffer.dimensions    = input->buffer().dimensions;
         auto format = TensorUtils::getDescribe(input)->dimensionFormat;
         outputBuffer.type = input->getType();
+        if (ConvolutionCommon::isRawImageConvolution(op, input)) {
+            // Raw image input with the preprocess folded into weight and bias, output float NC4HW4
+            outputBuffer.type = halide_type_of<float>();
+            format            = MNN_DATA_FORMAT_NC4HW4;
+        }
         outputBuffer.dim[0].extent = input->buffer().dim[0].extent;
         if (MNN_DATA_FORMAT_NHWC == format) {
             outputBuffer.dim[3].extent = layer->outputCount();
@@ -78,7 +84,7 @@ public:
             outputBuffer.dim[3].extent = output_width;
         }
         //MNN_PRINT("%d, %d, %d, %d\n", outputs[0]->length(0), outputs[0]->length(1), outputs[0]->length(2), outputs[0]->length(3));
-        TensorUtils::getDescribe(outputs[0])->dimensionFormat = TensorUtils::getDescribe(inputs[0])->dimensionFormat;
+        TensorUtils::getDescribe(outputs[0])->dimensionFormat = format;
         return true;
     }
 
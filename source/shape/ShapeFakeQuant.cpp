@@ -0,0 +1,74 @@
+//
+//  ShapeFakeQuant.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "shape/SizeComputer.hpp"
+#include "core/Macro.h"
+#include "core/TensorUtils.hpp"
+
+namespace MNN {
+// The scale is a scalar or has the dimensions of x with only one of them not 1
+static bool _checkScale(const Tensor* x, const Tensor* scale) {
+    if (scale->elementSize() == 1) {
+        return true;
+    }
+    if (scale->dimensions() != x->dimensions()) {
+        return false;
+    }
+    int axis = -1;
+    for (int i = 0; i < x->dimensions(); ++i) {
+        if (scale->length(i) == 1) {
+            continue;
+        }
+        if (axis >= 0 || scale->length(i) != x->length(i)) {
+            return false;
+        }
+        axis = i;
+    }
+    if (TensorUtils::getDescribe(x)->dimensionFormat == MNN_DATA_FORMAT_NC4HW4 && axis != 1) {
+        return false;
+    }
+    return true;
+}
+
+class FakeQuantSizeComputer : public SizeComputer {
+    virtual bool onComputeSize(const MNN::Op* op, const std::vector<Tensor*>& inputs,
+                               const std::vector<Tensor*>& outputs) const override {
+        MNN_ASSERT(2 == inputs.size());
+        MNN_ASSERT(1 == outputs.size());
+        if (inputs[0]->getType() != halide_type_of<float>() || !_checkScale(inputs[0], inputs[1])) {
+            MNN_ERROR("FakeQuant: input should be float and scale should be scalar or per channel\n");
+            return false;
+        }
+        TensorUtils::copyShape(inputs[0], outputs[0], true);
+        outputs[0]->buffer().type = inputs[0]->getType();
+        return true;
+    }
+};
+
+// Inputs: x, scale, grad of output; Outputs: grad of x, grad of scale
+class FakeQuantGradSizeComputer : public SizeComputer {
+    virtual bool onComputeSize(const MNN::Op* op, const std::vector<Tensor*>& inputs,
+                               const std::vector<Tensor*>& outputs) const override {
+        MNN_ASSERT(3 == inputs.size());
+        MNN_ASSERT(2 == outputs.size());
+        if (inputs[0]->getType() != halide_type_of<float>() || !_checkScale(inputs[0], inputs[1]) ||
+            inputs[0]->elementSize() != inputs[2]->elementSize()) {
+            MNN_ERROR("FakeQuantGrad: input should be float and scale should be scalar or per channel\n");
+            return false;
+        }
+        TensorUtils::copyShape(inputs[0], outputs[0], true);
+        outputs[0]->buffer().type = inputs[0]->getType();
+        TensorUtils::copyShape(inputs[1], outputs[1], true);
+        outputs[1]->buffer().type = inputs[1]->getType();
+        return true;
+    }
+};
+
+REGISTER_SHAPE(FakeQuantSizeComputer, OpType_FakeQuant);
+REGISTER_SHAPE(FakeQuantGradSizeComputer, OpType_FakeQuantGrad);
+} // namespace MNN
@@ -76,6 +76,8 @@ extern void ___ConvolutionSizeComputer__OpType_ConvInt8__();
 extern void ___ConvolutionSizeComputer__OpType_DepthwiseConvInt8__();
 extern void ___Dilation2DSizeComputer__OpType_Dilation2D__();
 extern void ___Conv2DBackpropFilterSizeComputer__OpType_Conv2DBackPropFilter__();
+extern void ___FakeQuantSizeComputer__OpType_FakeQuant__();
+extern void ___FakeQuantGradSizeComputer__OpType_FakeQuantGrad__();
 extern void ___ShapeScatterNd__OpType_ScatterNd__();
 extern void ___BatchMatMulComputer__OpType_BatchMatMul__();
 extern void ___RankComputer__OpType_Rank__();
@@ -164,6 +166,8 @@ ___ConvolutionSizeComputer__OpType_ConvInt8__();
 ___ConvolutionSizeComputer__OpType_DepthwiseConvInt8__();
 ___Dilation2DSizeComputer__OpType_Dilation2D__();
 ___Conv2DBackpropFilterSizeComputer__OpType_Conv2DBackPropFilter__();
+___FakeQuantSizeComputer__OpType_FakeQuant__();
+___FakeQuantGradSizeComputer__OpType_FakeQuantGrad__();
 ___ShapeScatterNd__OpType_ScatterNd__();
 ___BatchMatMulComputer__OpType_BatchMatMul__();
 ___RankComputer__OpType_Rank__();
@@ -9,6 +9,7 @@
 #include "MNN_generated.h"
 #include "core/TensorUtils.hpp"
 #include "core/Schedule.hpp"
+#include "core/Command.hpp"
 
 namespace MNN {
 // init Tensors by net
@@ -19,4 +20,6 @@ void initPipelineInfosFromOps(std::vector<Schedule::PipelineInfo>& infos, std::v
 void setInputOutputForOps(std::vector<std::shared_ptr<Tensor>>& allTensors, const std::vector<const Op*>& ops, bool isStatic = false);
 // init Pipeline Infos by net and tensors, set input and output info
 void initPipelineInfosFromNet(std::vector<Schedule::PipelineInfo>& infos, const Net* net, std::vector<std::shared_ptr<Tensor>>& allTensors);
+// generate static model (Usage_INFERENCE_STATIC) from resolved command buffer, tensorNames keep the origin tensor's name
+std::unique_ptr<NetT> generateStaticModel(const CommandBuffer& buffer, const std::map<Tensor*, std::string>& tensorNames);
 } // namespace MNN
@@ -0,0 +1,82 @@
+//
+//  StaticModelTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2020/12/01.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN::Express;
+using namespace MNN;
+
+static std::vector<float> _runModel(Interpreter* net) {
+    ScheduleConfig config;
+    auto session = net->createSession(config);
+    auto input   = net->getSessionInput(session, nullptr);
+    std::shared_ptr<Tensor> inputUser(Tensor::createHostTensorFromDevice(input, false));
+    auto inputPtr = inputUser->host<float>();
+    for (int i = 0; i < inputUser->elementSize(); ++i) {
+        inputPtr[i] = (float)(i % 17) - 8.0f;
+    }
+    input->copyFromHostTensor(inputUser.get());
+    net->runSession(session);
+    auto output = net->getSessionOutput(session, nullptr);
+    std::shared_ptr<Tensor> outputUser(Tensor::createHostTensorFromDevice(output, true));
+    auto outputPtr = outputUser->host<float>();
+    return std::vector<float>(outputPtr, outputPtr + outputUser->elementSize());
+}
+
+class StaticModelTest : public MNNTestCase {
+public:
+    virtual ~StaticModelTest() = default;
+    virtual bool run() {
+        auto x = _Input({1, 3, 4, 5}, NCHW, halide_type_of<float>());
+        x->setName("input");
+        auto y = _Transpose(x, {0, 2, 3, 1});
+        y      = _Relu(y);
+        y      = _Concat({y, _Transpose(x, {0, 2, 3, 1})}, 3);
+        y      = _Reshape(y, {1, -1});
+        y->setName("output");
+        std::unique_ptr<NetT> netT(new NetT);
+        Variable::save({y}, netT.get());
+        flatbuffers::FlatBufferBuilder builder(1024);
+        auto offset = Net::Pack(builder, netT.get());
+        builder.Finish(offset);
+        std::shared_ptr<Interpreter> net(Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+        auto expect = _runModel(net.get());
+
+        // Save resolved commands and reload without shape compute
+        const char* fileName = "StaticModelTest.mnn";
+        ScheduleConfig config;
+        auto session = net->createSession(config);
+        if (NO_ERROR != net->saveStaticModel(session, fileName)) {
+            MNN_ERROR("Save static model failed\n");
+            return false;
+        }
+        std::shared_ptr<Interpreter> staticNet(Interpreter::createFromFile(fileName));
+        remove(fileName);
+        if (nullptr == staticNet) {
+            MNN_ERROR("Load static model failed\n");
+            return false;
+        }
+        auto result = _runModel(staticNet.get());
+        if (result.size() != expect.size()) {
+            MNN_ERROR("Static model output size %d != %d\n", (int)result.size(), (int)expect.size());
+            return false;
+        }
+        for (int i = 0; i < expect.size(); ++i) {
+            if (fabsf(result[i] - expect[i]) > 1e-6f) {
+                MNN_ERROR("Static model output %d: %f != %f\n", i, result[i], expect[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(StaticModelTest, "core/static_model");
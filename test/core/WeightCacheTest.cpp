@@ -0,0 +1,64 @@
+//
+//  WeightCacheTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2020/12/23.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <string.h>
+#include "MNNTestSuite.h"
+#include "backend/cpu/CPUWeightCache.hpp"
+
+using namespace MNN;
+
+class WeightCacheTest : public MNNTestCase {
+public:
+    virtual ~WeightCacheTest() = default;
+    virtual bool run() {
+        // Two contents with the same FNV-1a hash: the state after the first word differs, the second word cancels it
+        const uint64_t prime  = 0x100000001b3ULL;
+        const uint64_t offset = 0xcbf29ce484222325ULL;
+        uint64_t a[2]         = {1, 0};
+        uint64_t b[2]         = {2, ((offset ^ 1) * prime) ^ ((offset ^ 2) * prime)};
+        if (CPUWeightCache::hash(a, sizeof(a)) != CPUWeightCache::hash(b, sizeof(b))) {
+            MNN_ERROR("WeightCache test failed to build the collision\n");
+            return false;
+        }
+        if (CPUWeightCache::checkHash(a, sizeof(a)) == CPUWeightCache::checkHash(b, sizeof(b))) {
+            MNN_ERROR("WeightCache check hash collides\n");
+            return false;
+        }
+        int created = 0;
+        auto create = [&created](const void* origin) {
+            return [&created, origin]() {
+                created++;
+                std::shared_ptr<Tensor> weight(Tensor::create<float>({4}));
+                ::memcpy(weight->host<float>(), origin, 4 * sizeof(float));
+                return weight;
+            };
+        };
+        std::vector<int> layout{CPUWeightCache::TILED, 1, 4};
+        auto weightA  = CPUWeightCache::acquire(layout, a, sizeof(a), create(a));
+        auto weightB  = CPUWeightCache::acquire(layout, b, sizeof(b), create(b));
+        auto weightA2 = CPUWeightCache::acquire(layout, a, sizeof(a), create(a));
+        if (weightA == weightB || 0 != ::memcmp(weightB->host<void>(), b, sizeof(b))) {
+            MNN_ERROR("WeightCache shares the weight of a colliding content\n");
+            return false;
+        }
+        if (weightA != weightA2 || 2 != created) {
+            MNN_ERROR("WeightCache doesn't share the same content\n");
+            return false;
+        }
+        // Released weights are created again
+        weightA  = nullptr;
+        weightA2 = nullptr;
+        weightA  = CPUWeightCache::acquire(layout, a, sizeof(a), create(a));
+        if (3 != created) {
+            MNN_ERROR("WeightCache keeps a released weight\n");
+            return false;
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(WeightCacheTest, "core/WeightCache");
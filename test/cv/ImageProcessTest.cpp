@@ -691,3 +691,174 @@ public:
 };
 // {YUV_NV21, YUV_NV12, YUV_I420} -> {RGBA, RGB, BGRA, BGR, GRAY} unit test
 MNNTestSuiteRegister(ImageProcessYUVBlitterTest, "cv/image_process/yuv_blitter");
+
+class ImageProcessBatchCropTest : public MNNTestCase {
+public:
+    virtual ~ImageProcessBatchCropTest() = default;
+    virtual bool run() {
+        const int iw = 40, ih = 30, ow = 6, oh = 8, bpp = 3;
+        auto source = genSourceData(ih, iw, bpp);
+        ImageProcess::Config config;
+        config.sourceFormat = RGB;
+        config.destFormat   = BGR;
+        config.filterType   = BILINEAR;
+        for (int i = 0; i < 3; ++i) {
+            config.mean[i]   = 10.0f * i;
+            config.normal[i] = 0.5f + 0.1f * i;
+        }
+        std::shared_ptr<ImageProcess> process(ImageProcess::create(config));
+        // The whole image, an inner box, a box across the right bottom edge, a single row and a single column
+        const std::vector<float> boxes = {0.0f, 0.0f, 1.0f, 1.0f, 0.2f, 0.1f, 0.7f, 0.4f, 0.6f, 0.5f, 1.3f, 1.2f,
+                                          0.5f, 0.2f, 0.5f, 0.8f, 0.1f, 0.3f, 0.9f, 0.3f};
+        const int boxNumber            = (int)boxes.size() / 4;
+        std::shared_ptr<Tensor> batchTensor(
+            Tensor::create<float>(std::vector<int>{boxNumber, bpp, oh, ow}, nullptr, Tensor::CAFFE));
+        auto code = process->convert(source.data(), iw, ih, 0, boxes.data(), boxNumber, batchTensor.get());
+        if (NO_ERROR != code) {
+            MNN_ERROR("Batch crop convert failed\n");
+            return false;
+        }
+        // Reference: CropAndResize with bilinear sampling, the sample point is clamped to the image
+        auto sample = [&](float x, float y, int channel) {
+            x       = std::min(std::max(x, 0.0f), (float)(iw - 1));
+            y       = std::min(std::max(y, 0.0f), (float)(ih - 1));
+            int x0  = (int)x, y0 = (int)y;
+            int x1  = std::min(x0 + 1, iw - 1), y1 = std::min(y0 + 1, ih - 1);
+            float u = x - x0, v = y - y0;
+            auto p  = [&](int px, int py) { return (float)source[(py * iw + px) * bpp + channel]; };
+            return (p(x0, y0) * (1.0f - u) + p(x1, y0) * u) * (1.0f - v) + (p(x0, y1) * (1.0f - u) + p(x1, y1) * u) * v;
+        };
+        for (int b = 0; b < boxNumber; ++b) {
+            auto box      = boxes.data() + 4 * b;
+            auto batchPtr = batchTensor->host<float>() + b * bpp * oh * ow;
+            for (int c = 0; c < bpp; ++c) {
+                for (int y = 0; y < oh; ++y) {
+                    for (int x = 0; x < ow; ++x) {
+                        float sy = box[0] * (ih - 1) + y * (box[2] - box[0]) * (ih - 1) / (oh - 1);
+                        float sx = box[1] * (iw - 1) + x * (box[3] - box[1]) * (iw - 1) / (ow - 1);
+                        // BGR from RGB, the sampler rounds to uint8 before normalizing
+                        auto expect = (sample(sx, sy, 2 - c) - config.mean[c]) * config.normal[c];
+                        auto value  = batchPtr[(c * oh + y) * ow + x];
+                        if (fabsf(value - expect) > config.normal[c] + 1e-4f) {
+                            MNN_ERROR("Batch crop error for box %d: channel %d, (%d, %d), %f != %f\n", b, c, x, y,
+                                      value, expect);
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(ImageProcessBatchCropTest, "cv/image_process/batch_crop");
+
+class ImageProcessAreaTest : public MNNTestCase {
+public:
+    virtual ~ImageProcessAreaTest() = default;
+    virtual bool run() {
+        // Downscale by 3, each dest pixel is the average of a 3x3 block
+        const int ow = 17, oh = 11, iw = ow * 3, ih = oh * 3;
+        for (auto format : {RGBA, RGB, GRAY}) {
+            int bpp     = (RGBA == format) ? 4 : ((RGB == format) ? 3 : 1);
+            auto source = genSourceData(ih, iw, bpp);
+            ImageProcess::Config config;
+            config.sourceFormat = format;
+            config.destFormat   = format;
+            config.filterType   = AREA;
+            std::shared_ptr<ImageProcess> process(ImageProcess::create(config));
+            Matrix transform;
+            transform.setScale(3.0f, 3.0f);
+            transform.postTranslate(1.0f, 1.0f);
+            process->setMatrix(transform);
+            std::vector<uint8_t> dest(ow * oh * bpp);
+            process->convert(source.data(), iw, ih, 0, dest.data(), ow, oh, bpp, 0, halide_type_of<uint8_t>());
+            for (int y = 0; y < oh; ++y) {
+                for (int x = 0; x < ow; ++x) {
+                    for (int c = 0; c < bpp; ++c) {
+                        float sum = 0.0f;
+                        for (int ky = 0; ky < 3; ++ky) {
+                            for (int kx = 0; kx < 3; ++kx) {
+                                sum += source[((3 * y + ky) * iw + 3 * x + kx) * bpp + c];
+                            }
+                        }
+                        auto value = dest[(y * ow + x) * bpp + c];
+                        if (fabsf(value - sum / 9.0f) > 1.0f) {
+                            MNN_ERROR("Area error for bpp %d, %d, %d, %d: %d != %f\n", bpp, x, y, c, value,
+                                      sum / 9.0f);
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(ImageProcessAreaTest, "cv/image_process/area");
+
+class ImageProcessBicubicTest : public MNNTestCase {
+public:
+    virtual ~ImageProcessBicubicTest() = default;
+    virtual bool run() {
+        // Cubic convolution reproduces linear image, and the separable path (CLAMP_TO_EDGE) is the same as the
+        // pointwise path (ZERO) inside the image, except the rounding. The upscale is wider than a row tile, so the
+        // cached source rows are shared by dest rows and tiles
+        const int iw = 64, ih = 48;
+        const struct {
+            int ow, oh;
+            float scaleX, scaleY;
+        } cases[] = {{37, 29, 1.5f, 1.4f}, {290, 40, 0.2f, 0.25f}};
+        for (auto& cas : cases) {
+            if (!testCase(iw, ih, cas.ow, cas.oh, cas.scaleX, cas.scaleY)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    static bool testCase(int iw, int ih, int ow, int oh, float scaleX, float scaleY) {
+        for (auto format : {RGBA, RGB, GRAY}) {
+            int bpp = (RGBA == format) ? 4 : ((RGB == format) ? 3 : 1);
+            std::vector<uint8_t> source(iw * ih * bpp);
+            for (int y = 0; y < ih; ++y) {
+                for (int x = 0; x < iw; ++x) {
+                    for (int c = 0; c < bpp; ++c) {
+                        source[(y * iw + x) * bpp + c] = 2 * x + y + 10 * c;
+                    }
+                }
+            }
+            Matrix transform;
+            transform.setScale(scaleX, scaleY);
+            transform.postTranslate(2.3f, 2.1f);
+            std::vector<uint8_t> dest[2];
+            for (int i = 0; i < 2; ++i) {
+                ImageProcess::Config config;
+                config.sourceFormat = format;
+                config.destFormat   = format;
+                config.filterType   = BICUBIC;
+                config.wrap         = 0 == i ? CLAMP_TO_EDGE : ZERO;
+                std::shared_ptr<ImageProcess> process(ImageProcess::create(config));
+                process->setMatrix(transform);
+                dest[i].resize(ow * oh * bpp);
+                process->convert(source.data(), iw, ih, 0, dest[i].data(), ow, oh, bpp, 0,
+                                 halide_type_of<uint8_t>());
+            }
+            for (int y = 0; y < oh; ++y) {
+                for (int x = 0; x < ow; ++x) {
+                    float sx = scaleX * x + 2.3f, sy = scaleY * y + 2.1f;
+                    for (int c = 0; c < bpp; ++c) {
+                        float expect = 2.0f * sx + sy + 10 * c;
+                        int index    = (y * ow + x) * bpp + c;
+                        if (fabsf(dest[0][index] - expect) > 1.0f || abs(dest[0][index] - dest[1][index]) > 1) {
+                            MNN_ERROR("Bicubic error for bpp %d, %d, %d, %d: %d, %d, %f\n", bpp, x, y, c,
+                                      dest[0][index], dest[1][index], expect);
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(ImageProcessBicubicTest, "cv/image_process/bicubic");
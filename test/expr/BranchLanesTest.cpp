@@ -0,0 +1,83 @@
+//
+//  BranchLanesTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2020/12/22.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <MNN/expr/Executor.hpp>
+#include <MNN/expr/ExecutorScope.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include <vector>
+#include "MNNTestSuite.h"
+#include "TestUtils.h"
+
+using namespace MNN::Express;
+
+class BranchLanesTest : public MNNTestCase {
+public:
+    virtual ~BranchLanesTest() = default;
+    virtual bool run() {
+        // The lanes share the thread pool task of a multi-thread backend, and take their own for a single thread one
+        return _test(1) && _test(4);
+    }
+
+private:
+    static bool _test(int thread) {
+        std::vector<float> expect, result;
+        {
+            ExecutorScope scope(Executor::newExecutor(MNN_FORWARD_CPU, MNN::BackendConfig(), thread));
+            expect = _compute();
+        }
+        auto executor = Executor::newExecutor(MNN_FORWARD_CPU, MNN::BackendConfig(), thread);
+        executor->setBranchLanes(4);
+        {
+            ExecutorScope scope(executor);
+            result = _compute();
+        }
+        if (expect.size() != result.size()) {
+            MNN_ERROR("BranchLanes test failed for size with %d threads\n", thread);
+            return false;
+        }
+        if (!checkVectorByRelativeError<float>(result.data(), expect.data(), (int)expect.size(), 1e-5f)) {
+            MNN_ERROR("BranchLanes test failed with %d threads\n", thread);
+            return false;
+        }
+        return true;
+    }
+    static void _fill(VARP x, int seed) {
+        auto size = x->getInfo()->size;
+        auto ptr  = x->writeMap<float>();
+        for (int i = 0; i < size; ++i) {
+            ptr[i] = (float)((i * 7 + seed) % 19 - 9) / 9.0f;
+        }
+    }
+    // Sibling matmuls and elementwise ops with shared inputs, run twice with different inputs
+    static std::vector<float> _compute() {
+        auto x  = _Input({64, 48}, NCHW);
+        auto w0 = _Input({48, 64}, NCHW);
+        auto w1 = _Input({48, 64}, NCHW);
+        _fill(w0, 1);
+        _fill(w1, 2);
+        auto a = _MatMul(x, w0);
+        auto b = _MatMul(x, w1);
+        auto c = _Tanh(x);
+        auto d = _Sigmoid(x);
+        auto e = _MatMul(_Relu(a), _Transpose(b, {1, 0}));
+        auto f = _MatMul(c, _Transpose(d, {1, 0}));
+        auto y = _Concat({e + f, e * f, _Transpose(a - b, {1, 0})}, 0);
+        std::vector<float> outputs;
+        for (int seed = 0; seed < 2; ++seed) {
+            _fill(x, seed + 3);
+            auto size = y->getInfo()->size;
+            auto ptr  = y->readMap<float>();
+            if (nullptr == ptr) {
+                return {};
+            }
+            outputs.insert(outputs.end(), ptr, ptr + size);
+        }
+        return outputs;
+    }
+};
+MNNTestSuiteRegister(BranchLanesTest, "expr/BranchLanes");
@@ -136,5 +136,77 @@ public:
         return true;
     }
 };
+// Asymmetric quantization: x = (xq - zi) * sx, y = (yq - zo) * sy
+class ConvInt8ZeroPointTest : public MNNTestCase {
+public:
+    static bool testKernel(int kernel, int pad, int ic, int oc, int inputZeroPoint, int outputZeroPoint, bool relu) {
+        const int iw = 13, ih = 9, kernelSize = kernel * kernel;
+        std::vector<int> bias(oc);
+        std::vector<float> scale(oc);
+        std::vector<int8_t> weight(oc * ic * kernelSize);
+        for (int i = 0; i < oc; ++i) {
+            bias[i]  = (i * 337) % 2000 - 1000;
+            scale[i] = 1.0f / (float)(ic * kernelSize * (16 + i));
+            for (int j = 0; j < ic * kernelSize; ++j) {
+                weight[i * ic * kernelSize + j] = (i * 7 + j * 13) % 31 - 15;
+            }
+        }
+        VARP x     = _Input({1, ic, ih, iw}, NC4HW4, halide_type_of<int8_t>());
+        auto xInfo = x->getInfo();
+        auto xPtr  = x->writeMap<int8_t>();
+        for (int i = 0; i < xInfo->size; ++i) {
+            xPtr[i] = (int8_t)((i * 17) % 256 - 128);
+        }
+        auto conv = _Conv(std::vector<int8_t>(weight), std::vector<int>(bias), std::vector<float>(scale), x, {ic, oc},
+                          {kernel, kernel}, PaddingMode::CAFFE, {1, 1}, {1, 1}, 1, {pad, pad}, relu, 8);
+        std::unique_ptr<MNN::OpT> convOp(conv->expr().first->get()->UnPack());
+        convOp->main.AsConvolution2D()->symmetricQuan->inputZeroPoint  = inputZeroPoint;
+        convOp->main.AsConvolution2D()->symmetricQuan->outputZeroPoint = outputZeroPoint;
+        auto y     = Variable::create(Expr::create(convOp.get(), {x}));
+        auto yInfo = y->getInfo();
+        auto yPtr  = y->readMap<int8_t>();
+        const int ow = yInfo->dim[3], oh = yInfo->dim[2];
+        for (int oz = 0; oz < oc; ++oz) {
+            for (int oy = 0; oy < oh; ++oy) {
+                for (int ox = 0; ox < ow; ++ox) {
+                    int32_t sum = 0;
+                    for (int sz = 0; sz < ic; ++sz) {
+                        for (int ky = 0; ky < kernel; ++ky) {
+                            for (int kx = 0; kx < kernel; ++kx) {
+                                int ix = ox + kx - pad, iy = oy + ky - pad;
+                                int xValue = 0;
+                                if (ix >= 0 && ix < iw && iy >= 0 && iy < ih) {
+                                    xValue = xPtr[(((sz / 4) * ih + iy) * iw + ix) * 4 + sz % 4] - inputZeroPoint;
+                                }
+                                sum += xValue * weight[((oz * ic + sz) * kernel + ky) * kernel + kx];
+                            }
+                        }
+                    }
+                    int expect = (int)roundf((float)(sum + bias[oz]) * scale[oz]) + outputZeroPoint;
+                    expect     = std::min(std::max(expect, relu ? outputZeroPoint : -128), 127);
+                    int result = yPtr[(((oz / 4) * oh + oy) * ow + ox) * 4 + oz % 4];
+                    if (abs(result - expect) > 1) {
+                        MNN_PRINT("ConvInt8 zero point result Error: %d -> %d\n", expect, result);
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+    virtual bool run() {
+        for (bool relu : {false, true}) {
+            // 3x3 with padding, 1x1 (fast im2col)
+            if (!testKernel(3, 1, 11, 7, -128, -128, relu) || !testKernel(3, 1, 3, 5, 3, 10, relu) ||
+                !testKernel(1, 0, 8, 6, -128, 0, relu)) {
+                MNN_ERROR("Error for convint8 with zero point, relu = %d\n", relu);
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
 MNNTestSuiteRegister(ConvInt8Im2colGemmTest, "op/ConvInt8/im2col_gemm");
 MNNTestSuiteRegister(ConvInt8WinogradTest, "op/ConvInt8/winograd");
+MNNTestSuiteRegister(ConvInt8ZeroPointTest, "op/ConvInt8/zero_point");
@@ -0,0 +1,99 @@
+//
+//  ConvRawImageTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2020/12/10.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN::Express;
+using namespace MNN;
+
+// The first convolution reads uint8 NHWC image with the mean / normal folded in, compare with the float preprocess
+class ConvRawImageTest : public MNNTestCase {
+public:
+    virtual ~ConvRawImageTest() = default;
+    virtual bool run() {
+        const int ic = 3, oc = 6, ih = 13, iw = 11, kernel = 3, stride = 2, pad = 1;
+        const float mean[3]   = {123.7f, 116.3f, 103.5f};
+        const float normal[3] = {0.0171f, 0.0175f, 0.0174f};
+        auto image            = _Input({1, ih, iw, ic}, NHWC, halide_type_of<uint8_t>());
+        auto floatImage       = _Input({1, ic, ih, iw}, NCHW, halide_type_of<float>());
+        auto imagePtr         = image->writeMap<uint8_t>();
+        auto floatPtr         = floatImage->writeMap<float>();
+        for (int y = 0; y < ih; ++y) {
+            for (int x = 0; x < iw; ++x) {
+                for (int c = 0; c < ic; ++c) {
+                    uint8_t value = (y * 37 + x * 17 + c * 91) % 256;
+                    imagePtr[(y * iw + x) * ic + c]     = value;
+                    floatPtr[(c * ih + y) * iw + x] = ((float)value - mean[c]) * normal[c];
+                }
+            }
+        }
+        std::vector<float> weight(oc * ic * kernel * kernel), bias(oc);
+        for (int i = 0; i < weight.size(); ++i) {
+            weight[i] = ((i * 13) % 17 - 8) * 0.05f;
+        }
+        for (int i = 0; i < oc; ++i) {
+            bias[i] = i * 0.1f - 0.2f;
+        }
+        // Fold as the converter's --imageMean / --imageNormal
+        std::vector<float> foldWeight = weight, foldBias = bias;
+        for (int o = 0; o < oc; ++o) {
+            for (int c = 0; c < ic; ++c) {
+                for (int k = 0; k < kernel * kernel; ++k) {
+                    auto& w = foldWeight[(o * ic + c) * kernel * kernel + k];
+                    w *= normal[c];
+                    foldBias[o] -= w * mean[c];
+                }
+            }
+        }
+        auto expect = _Conv(std::move(weight), std::move(bias), _Convert(floatImage, NC4HW4), {ic, oc},
+                            {kernel, kernel}, CAFFE, {stride, stride}, {1, 1}, 1, {pad, pad}, true);
+        expect      = _Convert(expect, NCHW);
+
+        std::unique_ptr<OpT> convOp(new OpT);
+        convOp->type       = OpType_Convolution;
+        convOp->main.type  = OpParameter_Convolution2D;
+        convOp->main.value = new Convolution2DT;
+        auto conv2D        = convOp->main.AsConvolution2D();
+        conv2D->common.reset(new Convolution2DCommonT);
+        conv2D->common->padX        = pad;
+        conv2D->common->padY        = pad;
+        conv2D->common->strideX     = stride;
+        conv2D->common->strideY     = stride;
+        conv2D->common->outputCount = oc;
+        conv2D->common->inputCount  = ic;
+        conv2D->common->kernelX     = kernel;
+        conv2D->common->kernelY     = kernel;
+        conv2D->common->relu        = true;
+        conv2D->weight              = foldWeight;
+        conv2D->bias                = foldBias;
+        conv2D->inputPadValue       = {mean[0], mean[1], mean[2]};
+        auto y                      = Variable::create(Expr::create(convOp.get(), {image}));
+        auto info                   = y->getInfo();
+        if (nullptr == info || info->type != halide_type_of<float>() || info->order != NC4HW4) {
+            MNN_ERROR("Convolution for uint8 image should output float NC4HW4\n");
+            return false;
+        }
+        y              = _Convert(y, NCHW);
+        auto yPtr      = y->readMap<float>();
+        auto expectPtr = expect->readMap<float>();
+        if (nullptr == yPtr || nullptr == expectPtr) {
+            MNN_ERROR("Convolution for uint8 image compute error\n");
+            return false;
+        }
+        for (int i = 0; i < y->getInfo()->size; ++i) {
+            if (fabsf(yPtr[i] - expectPtr[i]) > 1e-3f) {
+                MNN_ERROR("Convolution for uint8 image error: %d, %f != %f\n", i, yPtr[i], expectPtr[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(ConvRawImageTest, "op/conv_raw_image");
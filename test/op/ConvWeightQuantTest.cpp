@@ -0,0 +1,108 @@
+//
+//  ConvWeightQuantTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2020/12/04.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN::Express;
+using namespace MNN;
+
+// 1x1 Convolution whose weight is only quantized (IDSTQuan type 4): weight = (q + 128) * scale + min
+static std::shared_ptr<Interpreter> _createConvolution(int ic, int oc, int h, int w, int weightRange, bool relu) {
+    auto x = _Input({1, ic, h, w}, NC4HW4, halide_type_of<float>());
+    x->setName("x");
+    std::unique_ptr<OpT> convOp(new OpT);
+    convOp->type       = OpType_Convolution;
+    convOp->main.type  = OpParameter_Convolution2D;
+    convOp->main.value = new Convolution2DT;
+    auto conv2D        = convOp->main.AsConvolution2D();
+    conv2D->common.reset(new Convolution2DCommonT);
+    conv2D->common->kernelX     = 1;
+    conv2D->common->kernelY     = 1;
+    conv2D->common->inputCount  = ic;
+    conv2D->common->outputCount = oc;
+    conv2D->common->relu        = relu;
+    conv2D->bias.resize(oc);
+    conv2D->quanParameter.reset(new IDSTQuanT);
+    auto quan  = conv2D->quanParameter.get();
+    quan->type = 4;
+    quan->aMax = oc;
+    quan->buffer.resize(ic * oc);
+    for (int o = 0; o < oc; ++o) {
+        conv2D->bias[o] = (float)(o % 3) * 0.1f;
+        quan->alpha.emplace_back(-0.5f + 0.03f * o);
+        quan->alpha.emplace_back(0.01f + 0.002f * o);
+        for (int i = 0; i < ic; ++i) {
+            quan->buffer[o * ic + i] = (int8_t)((o * 7 + i * 13) % (2 * weightRange + 1) - weightRange);
+        }
+    }
+    auto y = Variable::create(Expr::create(convOp.get(), {x}));
+    y->setName("y");
+    std::unique_ptr<NetT> netT(new NetT);
+    Variable::save({y}, netT.get());
+    flatbuffers::FlatBufferBuilder builder(1024);
+    auto offset = Net::Pack(builder, netT.get());
+    builder.Finish(offset);
+    return std::shared_ptr<Interpreter>(Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+}
+
+static std::vector<float> _run(Interpreter* net, BackendConfig::MemoryMode memory, const std::vector<float>& x) {
+    ScheduleConfig config;
+    BackendConfig backendConfig;
+    backendConfig.memory  = memory;
+    config.backendConfig  = &backendConfig;
+    config.numThread      = 2;
+    auto session          = net->createSession(config);
+    auto input            = net->getSessionInput(session, nullptr);
+    std::shared_ptr<Tensor> inputUser(new Tensor(input, Tensor::CAFFE));
+    ::memcpy(inputUser->host<float>(), x.data(), inputUser->size());
+    input->copyFromHostTensor(inputUser.get());
+    net->runSession(session);
+    auto output = net->getSessionOutput(session, "y");
+    std::shared_ptr<Tensor> outputUser(new Tensor(output, Tensor::CAFFE));
+    output->copyToHostTensor(outputUser.get());
+    auto outputPtr = outputUser->host<float>();
+    std::vector<float> result(outputPtr, outputPtr + outputUser->elementSize());
+    net->releaseSession(session);
+    return result;
+}
+
+class ConvWeightQuantTest : public MNNTestCase {
+public:
+    virtual ~ConvWeightQuantTest() = default;
+    virtual bool run() {
+        const int ic = 13, oc = 10, h = 5, w = 3;
+        std::vector<float> x(ic * h * w);
+        for (int i = 0; i < x.size(); ++i) {
+            x[i] = (float)((i * 17) % 11 - 5) / 5.0f;
+        }
+        // 127: int8 weight, 7: int4 weight
+        for (int range : {127, 7}) {
+            for (bool relu : {false, true}) {
+                auto net    = _createConvolution(ic, oc, h, w, range, relu);
+                auto expect = _run(net.get(), BackendConfig::Memory_Normal, x);
+                auto result = _run(net.get(), BackendConfig::Memory_Low, x);
+                if (result.size() != expect.size()) {
+                    MNN_ERROR("Weight quant convolution size error\n");
+                    return false;
+                }
+                for (int i = 0; i < expect.size(); ++i) {
+                    if (fabsf(result[i] - expect[i]) > 1e-3f * fmaxf(1.0f, fabsf(expect[i]))) {
+                        MNN_ERROR("Weight quant convolution (range %d) error: %d, %f != %f\n", range, i, result[i],
+                                  expect[i]);
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(ConvWeightQuantTest, "op/convolution/weight_quant");
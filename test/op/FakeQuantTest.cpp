@@ -0,0 +1,135 @@
+//
+//  FakeQuantTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2020/12/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/Expr.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include <vector>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+#include "TestUtils.h"
+
+using namespace MNN::Express;
+
+static std::vector<VARP> _FakeQuantGrad(VARP x, VARP scale, VARP outputDiff, int bits) {
+    using namespace MNN;
+    std::unique_ptr<OpT> op(new OpT);
+    op->type       = OpType_FakeQuantGrad;
+    op->main.type  = OpParameter_QuantizedFloatParam;
+    op->main.value = new QuantizedFloatParamT;
+    op->main.AsQuantizedFloatParam()->nbits = bits;
+    auto expr = Expr::create(std::move(op), {x, scale, outputDiff}, 2);
+    return {Variable::create(expr, 0), Variable::create(expr, 1)};
+}
+
+class FakeQuantTest : public MNNTestCase {
+public:
+    virtual ~FakeQuantTest() = default;
+    virtual bool run() {
+        // Per tensor, per channel of the first axis with odd inner size, per channel of NC4HW4 with channel % 4 != 0
+        return _test({2, 3, 5, 7}, {}, NCHW, 8, "per tensor") && _test({5, 3, 3, 3}, {5, 1, 1, 1}, NCHW, 4, "axis 0") &&
+               _test({2, 6, 5, 5}, {1, 6, 1, 1}, NC4HW4, 4, "NC4HW4") &&
+               _test({2, 6, 33, 65}, {}, NC4HW4, 8, "NC4HW4 per tensor") &&
+               _test({2, 6, 5, 5}, {}, NC4HW4, 8, "NC4HW4 per tensor with padding", 1.0f) &&
+               _test({2, 6, 5, 5}, {1, 6, 1, 1}, NC4HW4, 4, "NC4HW4 with padding", 1.0f) && _testRound();
+    }
+
+private:
+    // The vector path should round half away from zero exactly as roundf, also for the largest float below 0.5
+    static bool _testRound() {
+        std::vector<float> values = {0.49999997f, -0.49999997f, 0.5f, -0.5f,  1.4999999f, -1.4999999f,
+                                     2.5f,        -2.5f,        3.5f, -126.5f, 126.49999f, 0.0f};
+        int size                  = (int)values.size();
+        auto x                    = _Input({size}, NCHW);
+        ::memcpy(x->writeMap<float>(), values.data(), size * sizeof(float));
+        auto y   = _FakeQuant(x, _Scalar<float>(1.0f), 8);
+        auto ptr = y->readMap<float>();
+        for (int i = 0; i < size; ++i) {
+            if (ptr[i] != roundf(values[i])) {
+                MNN_ERROR("FakeQuant round %.8f to %f, should be %f\n", values[i], ptr[i], roundf(values[i]));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // shift is added after converting to format, for NC4HW4 it makes the padded channels non-zero
+    static bool _test(INTS shape, INTS scaleShape, Dimensionformat format, int bits, const char* name,
+                      float shift = 0.0f) {
+        int size = 1;
+        for (auto d : shape) {
+            size *= d;
+        }
+        int scaleSize = 1;
+        int axis      = -1;
+        for (int i = 0; i < scaleShape.size(); ++i) {
+            scaleSize *= scaleShape[i];
+            if (scaleShape[i] != 1) {
+                axis = i;
+            }
+        }
+        int inside = 1;
+        for (int i = axis + 1; i < shape.size(); ++i) {
+            inside *= shape[i];
+        }
+        float limit = (float)(1 << (bits - 1)) - 1.0f;
+        std::vector<float> xData(size), diffData(size), scaleData(scaleSize);
+        for (int i = 0; i < size; ++i) {
+            xData[i]    = (float)((i * 37) % 101 - 50) / 13.0f;
+            diffData[i] = (float)((i * 17) % 23 - 11) / 7.0f;
+        }
+        for (int i = 0; i < scaleSize; ++i) {
+            // Make some values out of range
+            scaleData[i] = 3.5f / limit * (1.0f + 0.1f * i);
+        }
+        std::vector<float> expectY(size), expectDx(size), expectDs(scaleSize, 0.0f);
+        for (int i = 0; i < size; ++i) {
+            int c       = axis < 0 ? 0 : (i / inside) % shape[axis];
+            float inv   = 1.0f / scaleData[c];
+            float v     = (xData[i] + shift) * inv;
+            float q     = roundf(fminf(fmaxf(v, -limit), limit));
+            bool in     = fabsf(v) <= limit;
+            expectY[i]  = q * scaleData[c];
+            expectDx[i] = in ? diffData[i] + shift : 0.0f;
+            expectDs[c] += (diffData[i] + shift) * (in ? q - v : q);
+        }
+        for (int i = 0; i < scaleSize; ++i) {
+            expectDs[i] /= sqrtf((float)(size / scaleSize) * limit);
+        }
+
+        auto x     = _Input(shape, NCHW);
+        auto diff  = _Input(shape, NCHW);
+        auto scale = _Input(scaleShape, NCHW);
+        ::memcpy(x->writeMap<float>(), xData.data(), size * sizeof(float));
+        ::memcpy(diff->writeMap<float>(), diffData.data(), size * sizeof(float));
+        ::memcpy(scale->writeMap<float>(), scaleData.data(), scaleSize * sizeof(float));
+        auto xFormat    = _Convert(x, format);
+        auto diffFormat = _Convert(diff, format);
+        if (0.0f != shift) {
+            xFormat    = xFormat + _Scalar<float>(shift);
+            diffFormat = diffFormat + _Scalar<float>(shift);
+        }
+        auto y    = _Convert(_FakeQuant(xFormat, scale, bits), NCHW);
+        auto grad = _FakeQuantGrad(xFormat, scale, diffFormat, bits);
+        auto dx   = _Convert(grad[0], NCHW);
+        if (!checkVector<float>(y->readMap<float>(), expectY.data(), size, 1e-5f)) {
+            MNN_ERROR("FakeQuant %s test failed\n", name);
+            return false;
+        }
+        if (!checkVector<float>(dx->readMap<float>(), expectDx.data(), size, 1e-6f)) {
+            MNN_ERROR("FakeQuantGrad %s test failed for x\n", name);
+            return false;
+        }
+        if (!checkVectorByRelativeError<float>(grad[1]->readMap<float>(), expectDs.data(), scaleSize, 1e-4f)) {
+            MNN_ERROR("FakeQuantGrad %s test failed for scale\n", name);
+            return false;
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(FakeQuantTest, "op/FakeQuant");
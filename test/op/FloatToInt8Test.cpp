@@ -0,0 +1,110 @@
+//
+//  FloatToInt8Test.cpp
+//  MNNTests
+//
+//  Created by MNN on 2020/12/28.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNN_generated.h"
+#include "MNNTestSuite.h"
+using namespace MNN::Express;
+
+// Sizes cover the vector body and every remainder of the SSE / AVX2 / NEON kernels
+static const int gWidths[] = {1, 2, 3, 7, 11, 37};
+static const int gChannel  = 6;
+static const float gScales[gChannel] = {2.0f, 0.5f, 1.0f, 4.0f, 0.25f, 8.0f};
+
+static VARP _withZeroPoint(VARP y, int inputZeroPoint, int outputZeroPoint) {
+    std::unique_ptr<MNN::OpT> op(y->expr().first->get()->UnPack());
+    op->main.AsQuantizedFloatParam()->inputZeroPoint  = inputZeroPoint;
+    op->main.AsQuantizedFloatParam()->outputZeroPoint = outputZeroPoint;
+    return Variable::create(Expr::create(op.get(), y->expr().first->inputs()));
+}
+
+class FloatToInt8ZeroPointTest : public MNNTestCase {
+public:
+    static bool testWidth(int width, int zeroPoint) {
+        auto scale = _Const(gScales, {gChannel}, NCHW);
+        auto x     = _Input({1, gChannel, 1, width}, NC4HW4);
+        auto xPtr  = x->writeMap<float>();
+        auto size  = (gChannel + 3) / 4 * 4 * width;
+        for (int i = 0; i < size; ++i) {
+            // Multiples of 1/8 give many exact halves after scaling, which roundf rounds away from zero
+            xPtr[i] = (float)((i * 53) % 801 - 400) / 8.0f;
+        }
+        xPtr[0] = 0.49999997f;
+        if (size > 6) {
+            xPtr[6] = -0.49999997f;
+        }
+        auto y    = _withZeroPoint(_FloatToInt8(x, scale, -128, 127), 0, zeroPoint);
+        auto yPtr = y->readMap<int8_t>();
+        for (int i = 0; i < size; ++i) {
+            int c = (i / (4 * width)) * 4 + i % 4;
+            if (c >= gChannel) {
+                continue;
+            }
+            int expect = (int)roundf(xPtr[i] * gScales[c]) + zeroPoint;
+            expect     = std::min(std::max(expect, -128), 127);
+            if (expect != yPtr[i]) {
+                MNN_ERROR("FloatToInt8 width = %d, zero point = %d, %f -> %d, expect %d\n", width, zeroPoint, xPtr[i],
+                          yPtr[i], expect);
+                return false;
+            }
+        }
+        return true;
+    }
+    virtual bool run() {
+        for (auto width : gWidths) {
+            for (int zeroPoint : {-128, -3, 17}) {
+                if (!testWidth(width, zeroPoint)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+class Int8ToFloatZeroPointTest : public MNNTestCase {
+public:
+    static bool testWidth(int width, int zeroPoint) {
+        auto scale = _Const(gScales, {gChannel}, NCHW);
+        auto x     = _Input({1, gChannel, 1, width}, NC4HW4, halide_type_of<int8_t>());
+        auto xPtr  = x->writeMap<int8_t>();
+        auto size  = (gChannel + 3) / 4 * 4 * width;
+        for (int i = 0; i < size; ++i) {
+            xPtr[i] = (int8_t)((i * 37) % 256 - 128);
+        }
+        auto y    = _withZeroPoint(_Int8ToFloat(x, scale), zeroPoint, 0);
+        auto yPtr = y->readMap<float>();
+        for (int i = 0; i < size; ++i) {
+            int c = (i / (4 * width)) * 4 + i % 4;
+            if (c >= gChannel) {
+                continue;
+            }
+            float expect = (float)(xPtr[i] - zeroPoint) * gScales[c];
+            if (expect != yPtr[i]) {
+                MNN_ERROR("Int8ToFloat width = %d, zero point = %d, %d -> %f, expect %f\n", width, zeroPoint, xPtr[i],
+                          yPtr[i], expect);
+                return false;
+            }
+        }
+        return true;
+    }
+    virtual bool run() {
+        for (auto width : gWidths) {
+            for (int zeroPoint : {-128, -3, 17}) {
+                if (!testWidth(width, zeroPoint)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+MNNTestSuiteRegister(FloatToInt8ZeroPointTest, "op/FloatToInt8/zero_point");
+MNNTestSuiteRegister(Int8ToFloatZeroPointTest, "op/Int8ToFloat/zero_point");
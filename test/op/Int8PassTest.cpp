@@ -0,0 +1,106 @@
+//
+//  Int8PassTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2020/12/08.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN::Express;
+using namespace MNN;
+
+template <typename T>
+static VARP _makeInput(int c, int h, int w, int offset) {
+    auto x    = _Input({1, c, h, w}, NC4HW4, halide_type_of<T>());
+    auto info = x->getInfo();
+    auto xPtr = x->template writeMap<T>();
+    for (int i = 0; i < info->size; ++i) {
+        xPtr[i] = (T)(((i + offset) * 37) % 255 - 127);
+    }
+    return x;
+}
+
+class EltwiseInt8ProdTest : public MNNTestCase {
+public:
+    virtual ~EltwiseInt8ProdTest() = default;
+    virtual bool run() {
+        const int c = 6, h = 3, w = 5;
+        auto x0 = _makeInput<int8_t>(c, h, w, 0);
+        auto x1 = _makeInput<int8_t>(c, h, w, 11);
+        std::vector<float> scale0(c), scale1(c), outputScale(c);
+        for (int i = 0; i < c; ++i) {
+            scale0[i]      = 0.01f + 0.001f * i;
+            scale1[i]      = 0.02f - 0.001f * i;
+            outputScale[i] = 1.0f / (0.6f + 0.05f * i);
+        }
+        std::unique_ptr<OpT> op(new OpT);
+        op->type       = OpType_EltwiseInt8;
+        op->main.type  = OpParameter_EltwiseInt8;
+        op->main.value = new EltwiseInt8T;
+        auto param     = op->main.AsEltwiseInt8();
+        param->type    = EltwiseType_PROD;
+        param->inputQuan0.reset(new QuantizedFloatParamT);
+        param->inputQuan0->tensorScale = scale0;
+        param->inputQuan1.reset(new QuantizedFloatParamT);
+        param->inputQuan1->tensorScale = scale1;
+        param->outputQuan.reset(new QuantizedFloatParamT);
+        param->outputQuan->tensorScale = outputScale;
+        auto y     = Variable::create(Expr::create(op.get(), {x0, x1}));
+        auto yPtr  = y->readMap<int8_t>();
+        auto x0Ptr = x0->readMap<int8_t>();
+        auto x1Ptr = x1->readMap<int8_t>();
+        if (nullptr == yPtr) {
+            MNN_ERROR("EltwiseInt8 PROD compute error\n");
+            return false;
+        }
+        for (int z = 0; z < c; ++z) {
+            for (int i = 0; i < h * w; ++i) {
+                auto index  = ((z / 4) * h * w + i) * 4 + z % 4;
+                auto value  = (float)x0Ptr[index] * scale0[z] * (float)x1Ptr[index] * scale1[z] * outputScale[z];
+                auto expect = std::min(std::max((int)roundf(value), -127), 127);
+                if (abs(expect - yPtr[index]) > 1) {
+                    MNN_ERROR("EltwiseInt8 PROD error: %d, %d != %d\n", index, yPtr[index], expect);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(EltwiseInt8ProdTest, "op/eltwise_int8_prod");
+
+class InterpInt8Test : public MNNTestCase {
+public:
+    virtual ~InterpInt8Test() = default;
+    virtual bool run() {
+        const int c = 5, h = 4, w = 7;
+        // The same values in int8 and float
+        auto x      = _makeInput<int8_t>(c, h, w, 3);
+        auto xFloat = _makeInput<float>(c, h, w, 3);
+        // 1: nearest, 2: bilinear, 4: nearest round
+        for (int type : {1, 2, 4}) {
+            auto y      = _Interp({x}, 2.0f, 1.5f, 0, 0, type, false);
+            auto expect = _Interp({xFloat}, 2.0f, 1.5f, 0, 0, type, false);
+            auto info   = y->getInfo();
+            if (nullptr == info || info->type != halide_type_of<int8_t>()) {
+                MNN_ERROR("Interp int8 type error for resize type %d\n", type);
+                return false;
+            }
+            auto yNCHW     = _Convert(y, NCHW);
+            auto yPtr      = yNCHW->readMap<int8_t>();
+            auto expectPtr = _Convert(expect, NCHW)->readMap<float>();
+            for (int i = 0; i < yNCHW->getInfo()->size; ++i) {
+                if (fabsf((float)yPtr[i] - expectPtr[i]) > 1.0f) {
+                    MNN_ERROR("Interp int8 error for resize type %d: %d, %d != %f\n", type, i, yPtr[i], expectPtr[i]);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(InterpInt8Test, "op/interp_int8");
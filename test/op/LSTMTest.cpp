@@ -0,0 +1,111 @@
+//
+//  LSTMTest.cpp
+//  MNNTests
+//
+//  Created by MNN on 2020/12/03.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN::Express;
+using namespace MNN;
+
+static float _value(int i) {
+    return (float)((i * 37) % 23 - 11) / 23.0f;
+}
+
+static std::vector<float> _range(int size, int offset) {
+    std::vector<float> res(size);
+    for (int i = 0; i < size; ++i) {
+        res[i] = _value(i + offset);
+    }
+    return res;
+}
+
+// Onnx's LSTM: X [seq, batch, input], Y [seq, direction, batch, hidden]
+static std::shared_ptr<Interpreter> _createLSTM(int seq, int batch, int input, int hidden, int direction) {
+    auto x = _Input({seq, batch, input}, NCHW, halide_type_of<float>());
+    x->setName("x");
+    auto w = _Const(_range(direction * 4 * hidden * input, 0).data(), {direction, 4 * hidden, input}, NCHW);
+    auto r = _Const(_range(direction * 4 * hidden * hidden, 7).data(), {direction, 4 * hidden, hidden}, NCHW);
+    auto b = _Const(_range(direction * 4 * hidden, 13).data(), {direction, 4 * hidden}, NCHW);
+    std::unique_ptr<OpT> lstm(new OpT);
+    lstm->type                       = OpType_LSTM;
+    lstm->main.type                  = OpParameter_LSTM;
+    lstm->main.value                 = new LSTMT;
+    lstm->main.AsLSTM()->outputCount = hidden;
+    auto y = Variable::create(Expr::create(lstm.get(), {x, w, r, b}, 3), 0);
+    y->setName("y");
+    std::unique_ptr<NetT> netT(new NetT);
+    Variable::save({y}, netT.get());
+    flatbuffers::FlatBufferBuilder builder(1024);
+    auto offset = Net::Pack(builder, netT.get());
+    builder.Finish(offset);
+    return std::shared_ptr<Interpreter>(Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+}
+
+static std::vector<float> _run(Interpreter* net, Session* session, const float* x) {
+    auto input = net->getSessionInput(session, nullptr);
+    std::shared_ptr<Tensor> inputUser(Tensor::createHostTensorFromDevice(input, false));
+    ::memcpy(inputUser->host<float>(), x, inputUser->size());
+    input->copyFromHostTensor(inputUser.get());
+    net->runSession(session);
+    auto output = net->getSessionOutput(session, "y");
+    std::shared_ptr<Tensor> outputUser(Tensor::createHostTensorFromDevice(output, true));
+    auto outputPtr = outputUser->host<float>();
+    return std::vector<float>(outputPtr, outputPtr + outputUser->elementSize());
+}
+
+static bool _compare(const std::vector<float>& result, const float* expect, const char* message) {
+    for (int i = 0; i < result.size(); ++i) {
+        if (fabsf(result[i] - expect[i]) > 1e-3f) {
+            MNN_ERROR("%s: %d, %f != %f\n", message, i, result[i], expect[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+class LSTMStreamTest : public MNNTestCase {
+public:
+    virtual ~LSTMStreamTest() = default;
+    virtual bool run() {
+        const int seq = 5, batch = 2, input = 7, hidden = 6;
+        auto x = _range(seq * batch * input, 3);
+        for (int direction = 1; direction <= 2; ++direction) {
+            // Reference: decomposed by geometry
+            auto net = _createLSTM(seq, batch, input, hidden, direction);
+            ScheduleConfig config;
+            auto session = net->createSession(config);
+            auto expect  = _run(net.get(), session, x.data());
+
+            // The whole sequence in keep mode is the same as the first run
+            auto keepNet = _createLSTM(seq, batch, input, hidden, direction);
+            keepNet->setSessionMode(Interpreter::Session_Recurrent_Keep);
+            auto keepSession = keepNet->createSession(config);
+            auto result      = _run(keepNet.get(), keepSession, x.data());
+            if (result.size() != expect.size() || !_compare(result, expect.data(), "LSTM keep state")) {
+                return false;
+            }
+            if (direction > 1) {
+                continue;
+            }
+            // Feed frame by frame
+            auto keepInput = keepNet->getSessionInput(keepSession, nullptr);
+            keepNet->resizeTensor(keepInput, {1, batch, input});
+            keepNet->resizeSession(keepSession);
+            for (int t = 0; t < seq; ++t) {
+                auto frame = _run(keepNet.get(), keepSession, x.data() + t * batch * input);
+                if (!_compare(frame, expect.data() + t * batch * hidden, "LSTM stream")) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(LSTMStreamTest, "op/lstm_stream");
@@ -0,0 +1,222 @@
+//
+//  ConvBackwardSpeed.cpp
+//  MNNTests
+//
+//  Created by MNN on 2020/12/18.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/AutoTime.hpp>
+#include <MNN/Tensor.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+#include "core/Backend.hpp"
+#include "core/Execution.hpp"
+#include "core/TensorUtils.hpp"
+#include "geometry/GeometryComputer.hpp"
+#include "geometry/GeometryComputerUtils.hpp"
+using namespace MNN;
+
+/**
+ Compare the dedicated CPU executions for the gradients of convolution (CPUConv2DBackPropFilter,
+ CPUDeconvolutionMultiInput) with the generic geometry lowering (im2col + MatMul + Raster), which is
+ used when the forward type of geometry context is not CPU. The 1x1 stride 1 layers take the lowering on CPU as well.
+ */
+class ConvBackwardSpeed : public MNNTestCase {
+public:
+    struct Shape {
+        int batch;
+        int ic;
+        int oc;
+        int ih;
+        int iw;
+        int kernel;
+        int stride;
+        int dilate;
+        int pad;
+        int group;
+        int oh() const {
+            return (ih + 2 * pad - dilate * (kernel - 1) - 1) / stride + 1;
+        }
+        int ow() const {
+            return (iw + 2 * pad - dilate * (kernel - 1) - 1) / stride + 1;
+        }
+    };
+
+    virtual bool run() {
+        Backend::Info info;
+        info.type      = MNN_FORWARD_CPU;
+        info.numThread = 4;
+        BackendConfig config;
+        config.precision = BackendConfig::Precision_High;
+        info.user        = &config;
+        std::unique_ptr<Runtime> runtime(MNNGetExtraRuntimeCreator(MNN_FORWARD_CPU)->onCreate(info));
+        std::shared_ptr<Backend> backend(runtime->onCreate());
+
+        // Check the result for odd sizes, then compare the speed for common layers of training
+        std::vector<Shape> checkShapes = {
+            {3, 5, 7, 13, 11, 3, 2, 2, 1, 1},
+            {2, 6, 6, 9, 10, 3, 2, 1, 1, 6},
+        };
+        for (auto& shape : checkShapes) {
+            if (!_test(backend, shape, 1)) {
+                return false;
+            }
+        }
+        std::vector<Shape> shapes = {
+            {4, 64, 64, 56, 56, 3, 1, 1, 1, 1},
+            {4, 32, 64, 112, 112, 3, 2, 1, 1, 1},
+            {8, 128, 256, 28, 28, 1, 1, 1, 0, 1},
+            {8, 256, 256, 14, 14, 3, 1, 1, 1, 1},
+            {4, 128, 128, 56, 56, 3, 1, 1, 1, 128},
+            {4, 128, 128, 56, 56, 3, 2, 1, 1, 128},
+        };
+        for (auto& shape : shapes) {
+            if (!_test(backend, shape, 10)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static std::vector<uint8_t> _makeOp(OpType type, const Shape& shape, int inputCount, int outputCount) {
+        std::unique_ptr<OpT> op(new OpT);
+        op->type       = type;
+        op->main.type  = OpParameter_Convolution2D;
+        op->main.value = new Convolution2DT;
+        auto conv      = op->main.AsConvolution2D();
+        conv->common.reset(new Convolution2DCommonT);
+        auto common         = conv->common.get();
+        common->kernelX     = shape.kernel;
+        common->kernelY     = shape.kernel;
+        common->strideX     = shape.stride;
+        common->strideY     = shape.stride;
+        common->dilateX     = shape.dilate;
+        common->dilateY     = shape.dilate;
+        common->padX        = shape.pad;
+        common->padY        = shape.pad;
+        common->group       = shape.group;
+        common->inputCount  = inputCount;
+        common->outputCount = outputCount;
+        common->padMode     = PadMode_CAFFE;
+        flatbuffers::FlatBufferBuilder builder;
+        builder.Finish(Op::Pack(builder, op.get()));
+        return std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+    }
+
+    static std::shared_ptr<Tensor> _makeTensor(Backend* backend, const std::vector<int>& shape) {
+        std::shared_ptr<Tensor> tensor(Tensor::createDevice<float>(shape, Tensor::CAFFE));
+        backend->onAcquireBuffer(tensor.get(), Backend::STATIC);
+        TensorUtils::getDescribe(tensor.get())->backend = backend;
+        return tensor;
+    }
+
+    // Compute the op by the commands of geometry as Executor does, return the average cost in ms
+    static float _compute(std::shared_ptr<Backend> backend, const Op* op, const std::vector<Tensor*>& inputs,
+                          Tensor* output, bool lowering, int times) {
+        // Let geometry write the output by raster instead of making it virtual
+        TensorUtils::getDescribe(output)->usage = Tensor::InsideDescribe::Usage::OUTPUT;
+        GeometryComputer::Context context(backend);
+        if (lowering) {
+            context.setForwardType(MNN_FORWARD_ALL);
+        }
+        CommandBuffer buffer;
+        CommandBuffer commands;
+        GeometryComputer::search(op->type())->compute(op, inputs, {output}, context, buffer);
+        GeometryComputerUtils::makeRaster(buffer, commands, context);
+        std::vector<std::shared_ptr<Execution>> executions;
+        std::vector<Tensor*> temps;
+        for (auto& cmd : commands.command) {
+            auto cmdOp = cmd.op;
+            if (!cmd.buffer.empty()) {
+                cmdOp = flatbuffers::GetRoot<Op>(cmd.buffer.data());
+            }
+            for (auto t : cmd.outputs) {
+                auto des = TensorUtils::getDescribe(t);
+                if (nullptr == des->backend) {
+                    TensorUtils::setLinearLayout(t);
+                    backend->onAcquireBuffer(t, Backend::STATIC);
+                    des->backend = backend.get();
+                    temps.emplace_back(t);
+                }
+            }
+            std::shared_ptr<Execution> exe(backend->onCreate(cmd.inputs, cmd.outputs, cmdOp));
+            if (nullptr == exe || NO_ERROR != exe->onResize(cmd.inputs, cmd.outputs)) {
+                MNN_ERROR("Can't create execution for %s\n", EnumNameOpType(cmdOp->type()));
+                return -1.0f;
+            }
+            executions.emplace_back(exe);
+        }
+        Timer timer;
+        for (int t = 0; t < times; ++t) {
+            backend->onExecuteBegin();
+            for (int i = 0; i < executions.size(); ++i) {
+                executions[i]->onExecute(commands.command[i].inputs, commands.command[i].outputs);
+            }
+            backend->onExecuteEnd();
+        }
+        auto cost = (float)timer.durationInUs() / 1000.0f / (float)times;
+        for (auto t : temps) {
+            backend->onReleaseBuffer(t, Backend::STATIC);
+        }
+        return cost;
+    }
+
+    static bool _compare(const Tensor* a, const Tensor* b, const char* name) {
+        auto size   = a->elementSize();
+        float diff  = 0.0f;
+        float limit = 0.0f;
+        for (int i = 0; i < size; ++i) {
+            diff  = fmaxf(diff, fabsf(a->host<float>()[i] - b->host<float>()[i]));
+            limit = fmaxf(limit, fabsf(b->host<float>()[i]));
+        }
+        if (diff > 0.001f * limit) {
+            MNN_ERROR("%s: the result of dedicated execution differs from the lowering, %f / %f\n", name, diff, limit);
+            return false;
+        }
+        return true;
+    }
+
+    bool _test(std::shared_ptr<Backend> backend, const Shape& shape, int times) {
+        auto bn     = backend.get();
+        auto input  = _makeTensor(bn, {shape.batch, shape.ic, shape.ih, shape.iw});
+        auto diff   = _makeTensor(bn, {shape.batch, shape.oc, shape.oh(), shape.ow()});
+        auto weight = _makeTensor(bn, {shape.oc, shape.ic / shape.group, shape.kernel, shape.kernel});
+        for (auto t : {input.get(), diff.get(), weight.get()}) {
+            auto size = t->elementSize();
+            for (int i = 0; i < size; ++i) {
+                t->host<float>()[i] = (float)((i * 7 + 3) % 17 - 8) / 8.0f;
+            }
+        }
+        MNN_PRINT("batch %d, ic %d, oc %d, %d x %d, kernel %d, stride %d, dilate %d, group %d\n", shape.batch, shape.ic,
+                  shape.oc, shape.ih, shape.iw, shape.kernel, shape.stride, shape.dilate, shape.group);
+        {
+            auto opBuffer = _makeOp(OpType_Conv2DBackPropFilter, shape, shape.ic, shape.oc);
+            auto op       = flatbuffers::GetRoot<Op>(opBuffer.data());
+            auto direct   = _makeTensor(bn, weight->shape());
+            auto lowering = _makeTensor(bn, weight->shape());
+            auto directCost   = _compute(backend, op, {input.get(), diff.get()}, direct.get(), false, times);
+            auto loweringCost = _compute(backend, op, {input.get(), diff.get()}, lowering.get(), true, times);
+            if (directCost < 0.0f || loweringCost < 0.0f || !_compare(direct.get(), lowering.get(), "filter")) {
+                return false;
+            }
+            MNN_PRINT("    backward filter: %.3f ms, lowering: %.3f ms\n", directCost, loweringCost);
+        }
+        if (1 == shape.group) {
+            auto opBuffer = _makeOp(OpType_Deconvolution, shape, shape.oc, shape.ic);
+            auto op       = flatbuffers::GetRoot<Op>(opBuffer.data());
+            auto direct   = _makeTensor(bn, input->shape());
+            auto lowering = _makeTensor(bn, input->shape());
+            auto directCost   = _compute(backend, op, {diff.get(), weight.get()}, direct.get(), false, times);
+            auto loweringCost = _compute(backend, op, {diff.get(), weight.get()}, lowering.get(), true, times);
+            if (directCost < 0.0f || loweringCost < 0.0f || !_compare(direct.get(), lowering.get(), "data")) {
+                return false;
+            }
+            MNN_PRINT("    backward data: %.3f ms, lowering: %.3f ms\n", directCost, loweringCost);
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(ConvBackwardSpeed, "speed/ConvBackward");
@@ -0,0 +1,94 @@
+//
+//  ConvRawImageSpeed.cpp
+//  MNNTests
+//
+//  Created by MNN on 2020/12/28.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <string.h>
+#include <MNN/AutoTime.hpp>
+#include <MNN/ImageProcess.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include "MNNTestSuite.h"
+#include "MNN_generated.h"
+using namespace MNN::Express;
+using namespace MNN;
+
+/**
+ The first convolution with the preprocess folded (uint8 NHWC image read by ConvolutionRawImage) against the float
+ path: ImageProcess normalizes the image into a float NHWC input, convert to NC4HW4 and the float convolution.
+ */
+class ConvRawImageSpeed : public MNNTestCase {
+public:
+    static VARP _rawImageConv(VARP image, int ic, int oc, int kernel, int stride) {
+        std::unique_ptr<OpT> convOp(new OpT);
+        convOp->type       = OpType_Convolution;
+        convOp->main.type  = OpParameter_Convolution2D;
+        convOp->main.value = new Convolution2DT;
+        auto conv2D        = convOp->main.AsConvolution2D();
+        conv2D->common.reset(new Convolution2DCommonT);
+        conv2D->common->padX        = kernel / 2;
+        conv2D->common->padY        = kernel / 2;
+        conv2D->common->strideX     = stride;
+        conv2D->common->strideY     = stride;
+        conv2D->common->outputCount = oc;
+        conv2D->common->inputCount  = ic;
+        conv2D->common->kernelX     = kernel;
+        conv2D->common->kernelY     = kernel;
+        conv2D->common->relu        = true;
+        conv2D->weight.resize(oc * ic * kernel * kernel);
+        for (int i = 0; i < conv2D->weight.size(); ++i) {
+            conv2D->weight[i] = ((i * 13) % 17 - 8) * 0.001f;
+        }
+        conv2D->bias.resize(oc, 0.1f);
+        conv2D->inputPadValue.resize(ic, 120.0f);
+        return Variable::create(Expr::create(convOp.get(), {image}));
+    }
+    static void _test(int size, int oc, int kernel, int stride, int times) {
+        const int ic = 3;
+        auto image   = _Input({1, size, size, ic}, NHWC, halide_type_of<uint8_t>());
+        auto raw     = _rawImageConv(image, ic, oc, kernel, stride);
+        std::vector<float> weight(oc * ic * kernel * kernel), bias(oc, 0.1f);
+        for (int i = 0; i < weight.size(); ++i) {
+            weight[i] = ((i * 13) % 17 - 8) * 0.001f;
+        }
+        auto floatImage = _Input({1, size, size, ic}, NHWC);
+        auto conv       = _Conv(std::move(weight), std::move(bias), _Convert(floatImage, NC4HW4), {ic, oc},
+                                {kernel, kernel}, CAFFE, {stride, stride}, {1, 1}, 1, {kernel / 2, kernel / 2}, true);
+        std::vector<uint8_t> source(size * size * ic);
+        for (int i = 0; i < source.size(); ++i) {
+            source[i] = (uint8_t)((i * 7) % 256);
+        }
+        const float mean[3]   = {123.7f, 116.3f, 103.5f};
+        const float normal[3] = {0.0171f, 0.0175f, 0.0174f};
+        std::shared_ptr<CV::ImageProcess> process(CV::ImageProcess::create(CV::RGB, CV::RGB, mean, 3, normal, 3));
+        float rawCost = 0.0f, floatCost = 0.0f;
+        {
+            Timer timer;
+            for (int t = 0; t < times; ++t) {
+                ::memcpy(image->writeMap<uint8_t>(), source.data(), source.size());
+                raw->readMap<float>();
+            }
+            rawCost = (float)timer.durationInUs() / 1000.0f / (float)times;
+        }
+        {
+            Timer timer;
+            for (int t = 0; t < times; ++t) {
+                process->convert(source.data(), size, size, 0, floatImage->writeMap<float>(), size, size, ic);
+                conv->readMap<float>();
+            }
+            floatCost = (float)timer.durationInUs() / 1000.0f / (float)times;
+        }
+        MNN_PRINT("%d x %d x 3 -> %d, kernel %d, stride %d: raw image %.3f ms, ImageProcess + float %.3f ms\n", size,
+                  size, oc, kernel, stride, rawCost, floatCost);
+    }
+    virtual bool run() {
+        _test(224, 32, 3, 2, 20);
+        _test(224, 32, 5, 2, 20);
+        _test(224, 64, 7, 2, 10);
+        _test(320, 16, 3, 1, 10);
+        return true;
+    }
+};
+MNNTestSuiteRegister(ConvRawImageSpeed, "speed/ConvRawImage");
@@ -7,9 +7,13 @@
 //
 
 #include <MNN/ImageProcess.hpp>
+#include <MNN/Interpreter.hpp>
+#include <MNN/expr/ExprCreator.hpp>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include "MNNTestSuite.h"
+#include "MNN_generated.h"
 #define MNN_OPEN_TIME_TRACE
 #include <MNN/AutoTime.hpp>
 
@@ -1052,3 +1056,182 @@ public:
     }
 };
 MNNTestSuiteRegister(ImageProcessSpeedI420ToRGBTest, "speed/cv/image_process/I420_to_rgb");
+
+// A net with a NC4HW4 float input, whose session input is converted by the CPU backend's threads
+static std::shared_ptr<Interpreter> _createInputNet(int b, int w, int h) {
+    auto x = Express::_Input({b, 4, h, w}, Express::NC4HW4, halide_type_of<float>());
+    auto y = Express::_Relu(x);
+    std::unique_ptr<NetT> netT(new NetT);
+    Express::Variable::save({y}, netT.get());
+    flatbuffers::FlatBufferBuilder builder(1024);
+    builder.Finish(Net::Pack(builder, netT.get()));
+    return std::shared_ptr<Interpreter>(Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+}
+
+// 4K camera frame to model input, with the threads of the session's CPU backend
+class ImageProcessSpeedRGBA4KToFloatTest : public MNNTestCase {
+public:
+    virtual ~ImageProcessSpeedRGBA4KToFloatTest() = default;
+    virtual bool run() {
+        const int sw = 3840, sh = 2160, dw = 224, dh = 224;
+        std::vector<uint8_t> pixels(sw * sh * 4);
+        for (int i = 0; i < pixels.size(); ++i) {
+            pixels[i] = (i % 251 + i / 4096) % 255;
+        }
+        ImageProcess::Config config;
+        config.sourceFormat = RGBA;
+        config.destFormat   = RGBA;
+        config.filterType   = BILINEAR;
+        for (int i = 0; i < 4; ++i) {
+            config.mean[i]   = 127.5f;
+            config.normal[i] = 1.0f / 127.5f;
+        }
+        std::shared_ptr<ImageProcess> process(ImageProcess::create(config));
+        Matrix tr;
+        tr.setScale((float)sw / dw, (float)sh / dh);
+        process->setMatrix(tr);
+
+        std::shared_ptr<Tensor> expect(Tensor::create<float>({1, 4, dh, dw}, nullptr, Tensor::CAFFE_C4));
+        process->convert(pixels.data(), sw, sh, 0, expect.get());
+        {
+            MNN_PRINT("Single thread: ");
+            AUTOTIME;
+            for (int i = 0; i < 10; ++i) {
+                process->convert(pixels.data(), sw, sh, 0, expect.get());
+            }
+        }
+        auto net = _createInputNet(1, dw, dh);
+        ScheduleConfig scheduleConfig;
+        scheduleConfig.numThread = 4;
+        auto session             = net->createSession(scheduleConfig);
+        auto input               = net->getSessionInput(session, nullptr);
+        process->convert(pixels.data(), sw, sh, 0, input);
+        {
+            MNN_PRINT("%d threads: ", scheduleConfig.numThread);
+            AUTOTIME;
+            for (int i = 0; i < 10; ++i) {
+                process->convert(pixels.data(), sw, sh, 0, input);
+            }
+        }
+        auto result = input->host<float>();
+        for (int i = 0; i < expect->elementSize(); ++i) {
+            if (result[i] != expect->host<float>()[i]) {
+                MNN_ERROR("Multi-thread convert error: %d, %f != %f\n", i, result[i], expect->host<float>()[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(ImageProcessSpeedRGBA4KToFloatTest, "speed/cv/image_process/rgba_4k_to_float");
+
+// Many ROIs of a 1080p frame to a batched classifier input
+class ImageProcessSpeedBatchCropTest : public MNNTestCase {
+public:
+    virtual ~ImageProcessSpeedBatchCropTest() = default;
+    virtual bool run() {
+        const int sw = 1920, sh = 1080, dw = 64, dh = 64, boxNumber = 128;
+        std::vector<uint8_t> pixels(sw * sh * 4);
+        for (int i = 0; i < pixels.size(); ++i) {
+            pixels[i] = (i % 251 + i / 4096) % 255;
+        }
+        std::vector<float> boxes(4 * boxNumber);
+        for (int i = 0; i < boxNumber; ++i) {
+            boxes[4 * i + 0] = (i % 8) * 0.1f;
+            boxes[4 * i + 1] = (i / 8) * 0.05f;
+            boxes[4 * i + 2] = boxes[4 * i + 0] + 0.15f;
+            boxes[4 * i + 3] = boxes[4 * i + 1] + 0.1f;
+        }
+        ImageProcess::Config config;
+        config.filterType = BILINEAR;
+        for (int i = 0; i < 4; ++i) {
+            config.mean[i]   = 127.5f;
+            config.normal[i] = 1.0f / 127.5f;
+        }
+        std::shared_ptr<ImageProcess> process(ImageProcess::create(config));
+        auto net = _createInputNet(boxNumber, dw, dh);
+        ScheduleConfig scheduleConfig;
+        scheduleConfig.numThread = 4;
+        auto session             = net->createSession(scheduleConfig);
+        auto input               = net->getSessionInput(session, nullptr);
+        std::shared_ptr<Tensor> expect(Tensor::create<float>({boxNumber, 4, dh, dw}, nullptr, Tensor::CAFFE_C4));
+        std::shared_ptr<Tensor> crop(Tensor::create<float>({1, 4, dh, dw}, nullptr, Tensor::CAFFE_C4));
+        {
+            MNN_PRINT("setMatrix and convert for each box: ");
+            AUTOTIME;
+            for (int b = 0; b < boxNumber; ++b) {
+                process->setMatrix(ImageProcess::computeBoxMatrix(boxes.data() + 4 * b, sw, sh, dw, dh));
+                process->convert(pixels.data(), sw, sh, 0, crop.get());
+                ::memcpy(expect->host<float>() + b * crop->elementSize(), crop->host<float>(), crop->size());
+            }
+        }
+        {
+            MNN_PRINT("Batch convert with %d threads: ", scheduleConfig.numThread);
+            AUTOTIME;
+            process->convert(pixels.data(), sw, sh, 0, boxes.data(), boxNumber, input);
+        }
+        auto result = input->host<float>();
+        for (int i = 0; i < expect->elementSize(); ++i) {
+            if (result[i] != expect->host<float>()[i]) {
+                MNN_ERROR("Batch crop convert error: %d, %f != %f\n", i, result[i], expect->host<float>()[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(ImageProcessSpeedBatchCropTest, "speed/cv/image_process/batch_crop");
+
+class ImageProcessSpeedResize4KTest : public MNNTestCase {
+public:
+    virtual ~ImageProcessSpeedResize4KTest() = default;
+    virtual bool run() {
+        const int sw = 3840, sh = 2160, dw = 224, dh = 224;
+        std::vector<uint8_t> source(sw * sh * 4);
+        for (int i = 0; i < source.size(); ++i) {
+            source[i] = (i % 251 + i / 4096) % 255;
+        }
+        std::shared_ptr<Tensor> tensor(Tensor::create<float>(std::vector<int>{1, 3, dh, dw}, nullptr, Tensor::CAFFE));
+        Matrix tr;
+        tr.setScale((float)sw / dw, (float)sh / dh);
+        const char* names[]       = {"bilinear", "bicubic", "area", "nearest"};
+        Filter filters[]          = {BILINEAR, BICUBIC, AREA, NEAREST};
+        const char* formatNames[] = {"RGBA", "RGB", "GRAY"};
+        ImageFormat formats[]     = {RGBA, RGB, GRAY};
+        for (int s = 0; s < 3; ++s) {
+            for (int f = 0; f < 4; ++f) {
+                ImageProcess::Config config;
+                config.sourceFormat = formats[s];
+                config.destFormat   = RGB;
+                config.filterType   = filters[f];
+                std::shared_ptr<ImageProcess> process(ImageProcess::create(config));
+                process->setMatrix(tr);
+                MNN_PRINT("4K %s -> 224x224 RGB, %s\n", formatNames[s], names[f]);
+                AUTOTIME;
+                for (int i = 0; i < 10; ++i) {
+                    process->convert(source.data(), sw, sh, 0, tensor.get());
+                }
+            }
+        }
+        // Upscale, a source row is shared by many dest rows
+        const int uw = 640, uh = 360, upW = 1920, upH = 1080;
+        std::shared_ptr<Tensor> upTensor(
+            Tensor::create<float>(std::vector<int>{1, 3, upH, upW}, nullptr, Tensor::CAFFE));
+        tr.setScale((float)uw / upW, (float)uh / upH);
+        for (int s = 0; s < 3; ++s) {
+            ImageProcess::Config config;
+            config.sourceFormat = formats[s];
+            config.destFormat   = RGB;
+            config.filterType   = BICUBIC;
+            std::shared_ptr<ImageProcess> process(ImageProcess::create(config));
+            process->setMatrix(tr);
+            MNN_PRINT("640x360 %s -> 1920x1080 RGB, bicubic\n", formatNames[s]);
+            AUTOTIME;
+            for (int i = 0; i < 10; ++i) {
+                process->convert(source.data(), uw, uh, 0, upTensor.get());
+            }
+        }
+        return true;
+    }
+};
+MNNTestSuiteRegister(ImageProcessSpeedResize4KTest, "speed/cv/image_process/resize_4k");
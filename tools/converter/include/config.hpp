@@ -10,6 +10,7 @@
 #define CONFIG_HPP
 #include <mutex>
 #include <string>
+#include <vector>
 
 class ProjectConfig {
 public:
@@ -59,6 +60,9 @@ public:
     // or sparse parameters.
     std::string compressionParamsFile = "";
     bool saveStaticModel = false;
+    // If not empty, fold the ImageProcess mean / normal into the first convolution, the input becomes uint8 NHWC
+    std::vector<float> imageMean;
+    std::vector<float> imageNormal;
 };
 
 #endif // CONFIG_HPP
@@ -20,5 +20,12 @@
  *@param saveHalfFloat when saveHalfFloat is true, save weight in half float data type
  */
 int writeFb(std::unique_ptr<MNN::NetT>& netT, const std::string& MNNModelFile, modelConfig config);
+/**
+ *@brief fold image preprocess (x - mean) * normal into the convolutions which read the float inputs,
+ *       the inputs become uint8 NHWC images
+ *@return true if any input is folded
+ */
+bool foldImagePreprocess(std::unique_ptr<MNN::NetT>& netT, const std::vector<float>& mean,
+                         const std::vector<float>& normal);
 void converToStaticModel(const MNN::Net* net, std::map<std::string,std::vector<int>>& inputConfig, std::string mnnFile);
 #endif // WRITEFB_HPP
@@ -15,9 +15,25 @@
 #include <unistd.h>
 #endif
 #include <MNN/VCS.h>
+#include <sstream>
 #include "config.hpp"
 #include "logkit.h"
 
+// The values of a float list option, given as "a,b,c" or by repeating the option
+static std::vector<float> _parseFloatList(const std::vector<std::string>& texts) {
+    std::vector<float> values;
+    for (auto& text : texts) {
+        std::istringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) {
+                values.emplace_back(std::stof(item));
+            }
+        }
+    }
+    return values;
+}
+
 /**
  *  Print Command Line Banner
  */
@@ -51,6 +67,10 @@ cxxopts::Options Cli::initializeMNNConvertArgs(modelConfig &modelPath, int argc,
             "weight scales and zero points for quantization or information "
             "for sparsity.", cxxopts::value<std::string>())(
         "saveStaticModel", "save static model with fix shape, default: false", cxxopts::value<bool>())(
+        "imageMean", "fold image preprocess mean into the first convolution and take uint8 NHWC image as input, ex: 127.5,127.5,127.5",
+            cxxopts::value<std::vector<std::string>>())(
+        "imageNormal", "the normal of image preprocess to fold, used with imageMean, default: 1.0 for each channel",
+            cxxopts::value<std::vector<std::string>>())(
         "inputConfigFile", "set input config file for static model, ex: ~/config.txt", cxxopts::value<std::string>());
 
     auto result = options.parse(argc, argv);
@@ -162,6 +182,17 @@ cxxopts::Options Cli::initializeMNNConvertArgs(modelConfig &modelPath, int argc,
     if (result.count("saveStaticModel")) {
         modelPath.saveStaticModel = true;
     }
+    if (result.count("imageMean")) {
+        modelPath.imageMean   = _parseFloatList(result["imageMean"].as<std::vector<std::string>>());
+        modelPath.imageNormal = std::vector<float>(modelPath.imageMean.size(), 1.0f);
+        if (result.count("imageNormal")) {
+            modelPath.imageNormal = _parseFloatList(result["imageNormal"].as<std::vector<std::string>>());
+        }
+        if (modelPath.imageNormal.size() != modelPath.imageMean.size()) {
+            std::cout << "The size of imageNormal should be the same as imageMean" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
 
     // Int8 calibration table path.
     if (result.count("compressionParamsFile")) {
@@ -0,0 +1,129 @@
+//
+//  foldImagePreprocess.cpp
+//  MNNConverter
+//
+//  Created by MNN on 2020/12/10.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <map>
+#include <set>
+#include "MNN_generated.h"
+#include "logkit.h"
+#include "writeFb.hpp"
+
+using namespace MNN;
+
+// conv((x - mean) * normal) = conv'(x), with w' = w * normal, b' = b - sum(w' * mean), pad with mean
+static void _foldConvolution(Convolution2DT* conv, const std::vector<float>& mean, const std::vector<float>& normal) {
+    auto outputCount = conv->common->outputCount;
+    auto srcCount    = (int)mean.size();
+    auto kernelSize  = conv->common->kernelX * conv->common->kernelY;
+    for (int o = 0; o < outputCount; ++o) {
+        float offset = 0.0f;
+        for (int c = 0; c < srcCount; ++c) {
+            auto w = conv->weight.data() + (o * srcCount + c) * kernelSize;
+            for (int k = 0; k < kernelSize; ++k) {
+                w[k] *= normal[c];
+                offset += w[k] * mean[c];
+            }
+        }
+        conv->bias[o] -= offset;
+    }
+    conv->inputPadValue = mean;
+}
+
+bool foldImagePreprocess(std::unique_ptr<MNN::NetT>& netT, const std::vector<float>& mean,
+                         const std::vector<float>& normal) {
+    std::map<int, std::vector<OpT*>> consumers;
+    for (auto& op : netT->oplists) {
+        for (auto index : op->inputIndexes) {
+            consumers[index].emplace_back(op.get());
+        }
+    }
+    auto foldable = [&](OpT* op) {
+        if (OpType_Convolution != op->type || 1 != op->inputIndexes.size()) {
+            return false;
+        }
+        auto conv = op->main.AsConvolution2D();
+        return nullptr == conv->quanParameter.get() && 1 == conv->common->group &&
+               conv->weight.size() == conv->common->outputCount * mean.size() * conv->common->kernelX *
+                                          conv->common->kernelY;
+    };
+    // ConvolutionRawImage computes by the CPU without the packed GEMM, it's faster than ImageProcess + the float
+    // convolution only if the kernel is small and the stride skips most of the image (test/speed/ConvRawImageSpeed)
+    auto rawFaster = [](OpT* op) {
+        auto common = op->main.AsConvolution2D()->common.get();
+        return common->strideX >= 2 && common->strideY >= 2 && common->kernelX <= 3 && common->kernelY <= 3;
+    };
+    std::set<OpT*> removed;
+    bool success = false;
+    for (auto& op : netT->oplists) {
+        if (OpType_Input != op->type) {
+            continue;
+        }
+        auto input = op->main.AsInput();
+        if (DataType_DT_FLOAT != input->dtype || 4 != input->dims.size()) {
+            continue;
+        }
+        // The input is used by convolutions directly or through one tensor format converter
+        auto inputIndex = op->outputIndexes[0];
+        std::vector<OpT*> convs;
+        OpT* converter  = nullptr;
+        bool valid      = true;
+        for (auto next : consumers[inputIndex]) {
+            if (OpType_ConvertTensor == next->type && nullptr == converter) {
+                converter = next;
+                for (auto conv : consumers[next->outputIndexes[0]]) {
+                    convs.emplace_back(conv);
+                }
+                continue;
+            }
+            convs.emplace_back(next);
+        }
+        for (auto conv : convs) {
+            valid = valid && foldable(conv);
+        }
+        if (convs.empty() || !valid) {
+            LOG(INFO) << "Can't fold image preprocess for input " << netT->tensorName[inputIndex]
+                      << ", it must be used by convolutions of " << mean.size() << " input channels only";
+            continue;
+        }
+        bool faster = true;
+        for (auto conv : convs) {
+            faster = faster && rawFaster(conv);
+        }
+        if (!faster) {
+            LOG(INFO) << "Don't fold image preprocess for input " << netT->tensorName[inputIndex]
+                      << ", the raw image convolution is only faster for kernel <= 3 and stride >= 2";
+            continue;
+        }
+        for (auto conv : convs) {
+            _foldConvolution(conv->main.AsConvolution2D(), mean, normal);
+            conv->inputIndexes[0] = inputIndex;
+        }
+        if (nullptr != converter) {
+            removed.insert(converter);
+        }
+        // uint8 NHWC image
+        if (MNN_DATA_FORMAT_NHWC != input->dformat) {
+            auto dims   = input->dims;
+            input->dims = {dims[0], dims[2], dims[3], dims[1]};
+        }
+        input->dformat = MNN_DATA_FORMAT_NHWC;
+        input->dtype   = DataType_DT_UINT8;
+        success        = true;
+        LOG(INFO) << "Fold image preprocess into " << convs.size() << " convolution for input "
+                  << netT->tensorName[inputIndex];
+        LOG(WARNING) << "The convolutions reading the uint8 image of " << netT->tensorName[inputIndex]
+                     << " run on CPU only, the other backends fall back to CPU for them";
+    }
+    for (auto iter = netT->oplists.begin(); iter != netT->oplists.end();) {
+        if (removed.find(iter->get()) != removed.end()) {
+            iter = netT->oplists.erase(iter);
+            continue;
+        }
+        iter++;
+    }
+    return success;
+}
@@ -9,6 +9,7 @@
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <functional>
 #include <set>
 
 #include "MNN_generated.h"
@@ -16,6 +17,7 @@
 #include "logkit.h"
 #include "writeFb.hpp"
 #include "cpp/ConfigFile.hpp"
+#include "cpp/ParallelFor.hpp"
 #include <MNN/MNNDefine.h>
 
 using namespace MNN;
@@ -282,6 +284,45 @@ static void WriteSparseQuanBlobs(ostream &out, const float* weightData, const fl
 	delete[] data_buf;
 }
 
+// The ops are independent for weight casting, run them with all the hardware threads
+static void _forEachOpParallel(std::unique_ptr<MNN::NetT>& netT,
+                               const std::function<void(std::unique_ptr<MNN::OpT>&)>& function) {
+    std::vector<std::unique_ptr<MNN::OpT>*> ops;
+    for (auto& op : netT->oplists) {
+        ops.emplace_back(&op);
+    }
+    for (auto& subgraph : netT->subgraphs) {
+        for (auto& op : subgraph->nodes) {
+            ops.emplace_back(&op);
+        }
+    }
+    parallelFor((int)ops.size(), [&](int i) { function(*ops[i]); });
+}
+
+template <typename T>
+static void _releaseVector(std::vector<T>& data) {
+    std::vector<T>().swap(data);
+}
+
+// Rough size of the weights, to reserve the builder once instead of growing by copy
+static size_t _estimateWeightBytes(const MNN::NetT* net) {
+    size_t bytes = 0;
+    for (auto& op : net->oplists) {
+        if (nullptr != op->main.AsConvolution2D()) {
+            auto param = op->main.AsConvolution2D();
+            bytes += (param->weight.size() + param->bias.size()) * sizeof(float);
+            if (nullptr != param->quanParameter) {
+                bytes += param->quanParameter->buffer.size() + param->quanParameter->alpha.size() * sizeof(float);
+            }
+        } else if (nullptr != op->main.AsBlob()) {
+            auto blob = op->main.AsBlob();
+            bytes += blob->float32s.size() * sizeof(float) + blob->int32s.size() * sizeof(int32_t) +
+                     blob->uint8s.size() + blob->int8s.size();
+        }
+    }
+    return bytes;
+}
+
 int writeFb(std::unique_ptr<MNN::NetT>& netT, const std::string& MNNModelFile, modelConfig config) {
     auto RemoveParams = [](std::unique_ptr<MNN::OpT>& op) {
         const auto opType = op->type;
@@ -326,6 +367,10 @@ int writeFb(std::unique_ptr<MNN::NetT>& netT, const std::string& MNNModelFile, m
                 break;
         }
     };
+    // Fold before the weight is removed or compressed
+    if (!config.imageMean.empty()) {
+        foldImagePreprocess(netT, config.imageMean, config.imageNormal);
+    }
     if (config.benchmarkModel) {
         for (auto& op : netT->oplists) {
             RemoveParams(op);
@@ -344,22 +389,14 @@ int writeFb(std::unique_ptr<MNN::NetT>& netT, const std::string& MNNModelFile, m
             case MNN::OpType_ConvolutionDepthwise: {
                 auto param           = op->main.AsConvolution2D();
                 const int weightSize = param->weight.size();
-                // const int biasSize = param->bias.size();
-                std::vector<half_float::half> quantizedFp16Weight;
-                quantizedFp16Weight.resize(weightSize);
-                std::transform(param->weight.begin(), param->weight.end(), quantizedFp16Weight.begin(),
-                               [](float w) { return half_float::half(w); });
-                // std::vector<half_float::half> quantizedFp16Bias;
-                // quantizedFp16Bias.resize(biasSize);
-                // std::transform(param->bias.begin(), param->bias.end(), quantizedFp16Bias.begin(), [](float
-                // b){return half_float::half(b); });
-                param->weight.clear();
-                // param->bias.clear();
-
+                // Cast into the buffer directly and free the float weight
                 param->quanParameter.reset(new MNN::IDSTQuanT);
                 param->quanParameter->type = 3;
-                int8_t* halfWeight         = reinterpret_cast<int8_t*>(quantizedFp16Weight.data());
-                param->quanParameter->buffer.assign(halfWeight, halfWeight + sizeof(half_float::half) * weightSize);
+                param->quanParameter->buffer.resize(sizeof(half_float::half) * weightSize);
+                auto halfWeight = reinterpret_cast<half_float::half*>(param->quanParameter->buffer.data());
+                std::transform(param->weight.begin(), param->weight.end(), halfWeight,
+                               [](float w) { return half_float::half(w); });
+                _releaseVector(param->weight);
                 break;
             }
             case MNN::OpType_Const: {
@@ -372,7 +409,7 @@ int writeFb(std::unique_ptr<MNN::NetT>& netT, const std::string& MNNModelFile, m
                     for (int i=0; i<size; ++i) {
                         dst[i] = blob->float32s[i];
                     }
-                    blob->float32s.clear();
+                    _releaseVector(blob->float32s);
                 }
                 break;
             }
@@ -381,14 +418,7 @@ int writeFb(std::unique_ptr<MNN::NetT>& netT, const std::string& MNNModelFile, m
         }
     };
     if (config.saveHalfFloat) {
-        for (auto& op : netT->oplists) {
-            CastParamsToHalf(op);
-        }
-        for (auto& subgraph : netT->subgraphs) {
-            for (auto& op : subgraph->nodes) {
-                CastParamsToHalf(op);
-            }
-        }
+        _forEachOpParallel(netT, CastParamsToHalf);
     }
 
     auto CastParamsToInt8 = [](std::unique_ptr<MNN::OpT>& op, int bits) {
@@ -430,7 +460,7 @@ int writeFb(std::unique_ptr<MNN::NetT>& netT, const std::string& MNNModelFile, m
                         tempString = outputStringStreamSQ.str();
                         param->quanParameter->type = 2;
                     }
-                    param->weight.clear();
+                    _releaseVector(param->weight);
                     param->quanParameter->buffer.resize(tempString.size());
                     ::memcpy(param->quanParameter->buffer.data(), tempString.data(), tempString.size());
                     param->quanParameter->alpha = std::move(scales);
@@ -443,14 +473,8 @@ int writeFb(std::unique_ptr<MNN::NetT>& netT, const std::string& MNNModelFile, m
         }
     };
     if (config.weightQuantBits > 0) {
-        for (auto& op : netT->oplists) {
-            CastParamsToInt8(op, config.weightQuantBits);
-        }
-        for (auto& subgraph : netT->subgraphs) {
-            for (auto& op : subgraph->nodes) {
-                CastParamsToInt8(op, config.weightQuantBits);
-            }
-        }
+        auto bits = config.weightQuantBits;
+        _forEachOpParallel(netT, [&](std::unique_ptr<MNN::OpT>& op) { CastParamsToInt8(op, bits); });
     }
 
     std::set<std::string> notSupportOps;
@@ -479,10 +503,14 @@ int writeFb(std::unique_ptr<MNN::NetT>& netT, const std::string& MNNModelFile, m
         LOG(FATAL) << "These Op Not Support: " << opNames.substr(0, opNames.size() - 2);
     }
 
-    flatbuffers::FlatBufferBuilder builderOutput(1024);
+    // The flatbuffer is built back to front with offsets to its end, so no weight can be streamed to the file
+    // before the whole model is packed. Streaming large blobs would need them outside the flatbuffer, which the
+    // model format doesn't support. The ops are released right after packing instead.
+    flatbuffers::FlatBufferBuilder builderOutput(_estimateWeightBytes(netT.get()) + 1024);
     builderOutput.ForceDefaults(true);
     auto len = MNN::Net::Pack(builderOutput, netT.get());
     builderOutput.Finish(len);
+    netT->oplists.clear();
     int sizeOutput    = builderOutput.GetSize();
     auto bufferOutput = builderOutput.GetBufferPointer();
 
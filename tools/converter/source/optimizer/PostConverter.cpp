@@ -8,9 +8,11 @@
 
 #include <unordered_set>
 
+#include <MNN/expr/ExecutorScope.hpp>
 #include <MNN/expr/Optimizer.hpp>
 #include <set>
 #include "../common/Global.hpp"
+#include "cpp/ParallelFor.hpp"
 #include "PostConverter.hpp"
 #include "PostTreatUtils.hpp"
 #include "Program.hpp"
@@ -417,8 +419,14 @@ bool fuseConstIntoSubgraph(MNN::NetT* net, const std::vector<MNN::SubGraphProtoT
         }
     }
     // Try Optimize Subgraph for more const op get
+    // The subgraphs are independent programs, fold their constants on worker threads. The mutex of Executor is per
+    // instance, each thread computes by its own executor so the threads don't serialize on the global executor.
     auto* ctx = Global<OptimizeContext>::Get();
-    for (auto mutable_subgraph : modifiedSubGraph) {
+    std::vector<MNN::SubGraphProtoT*> modified(modifiedSubGraph.begin(), modifiedSubGraph.end());
+    MNN::parallelFor((int)modified.size(), [&](int index) {
+        auto mutable_subgraph = modified[index];
+        auto executor         = Executor::newExecutor(MNN_FORWARD_CPU, MNN::BackendConfig(), 1);
+        ExecutorScope scope(executor);
         std::unique_ptr<MNN::NetT> subnet(new MNN::NetT);
         subnet->oplists    = std::move(mutable_subgraph->nodes);
         subnet->tensorName = std::move(mutable_subgraph->tensors);
@@ -448,7 +456,7 @@ bool fuseConstIntoSubgraph(MNN::NetT* net, const std::vector<MNN::SubGraphProtoT
         }
         mutable_subgraph->nodes   = std::move(new_subnet->oplists);
         mutable_subgraph->tensors = std::move(new_subnet->tensorName);
-    }
+    });
     return true;
 }
 
@@ -6,6 +6,7 @@
 //  Copyright © 2018, Alibaba Group Holding Limited
 //
 
+#include <math.h>
 #include "../TemplateMerge.hpp"
 #include "MNN/expr/ExprCreator.hpp"
 #include "MNN_generated.h"
@@ -32,6 +33,22 @@ EliminateQuantAndDequant::EliminateQuantAndDequant() {
             if (input_op->type() != OpType_Int8ToFloat) {
                 return false;
             }
+            // Int8 -> float -> int8 is identity only if the requantization keeps the same scale and zero point
+            auto quant   = expr->get()->main_as_QuantizedFloatParam();
+            auto dequant = input_op->main_as_QuantizedFloatParam();
+            if (nullptr == quant || nullptr == dequant || nullptr == quant->tensorScale() ||
+                nullptr == dequant->tensorScale()) {
+                return false;
+            }
+            if (quant->outputZeroPoint() != dequant->inputZeroPoint() ||
+                quant->tensorScale()->size() != dequant->tensorScale()->size()) {
+                return false;
+            }
+            for (int i = 0; i < quant->tensorScale()->size(); ++i) {
+                if (fabsf(quant->tensorScale()->data()[i] * dequant->tensorScale()->data()[i] - 1.0f) > 1e-4f) {
+                    return false;
+                }
+            }
         }
         if (expr->get()->type() == OpType_Int8ToFloat) {
             if (input_op->type() != OpType_FloatToInt8) {
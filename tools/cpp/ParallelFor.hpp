@@ -0,0 +1,47 @@
+//
+//  ParallelFor.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/28.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef PARALLELFOR_HPP
+#define PARALLELFOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace MNN {
+/*
+ * \brief Run independent tasks of the offline tools (converter, training) with std::thread
+ * The backends use MNN_CONCURRENCY_BEGIN / ThreadPool instead, whose few task slots are kept for the sessions.
+ * function(0) ~ function(size - 1) are taken in turn by threadNumber threads, the caller is one of them.
+ * threadNumber <= 0 means the hardware concurrency.
+ */
+inline void parallelFor(int size, const std::function<void(int)>& function, int threadNumber = 0) {
+    if (threadNumber <= 0) {
+        threadNumber = std::max((int)std::thread::hardware_concurrency(), 1);
+    }
+    threadNumber = std::min(threadNumber, size);
+    std::atomic<int> next(0);
+    auto run = [&]() {
+        for (int i = next++; i < size; i = next++) {
+            function(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadNumber; ++t) {
+        threads.emplace_back(run);
+    }
+    run();
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+} // namespace MNN
+
+#endif // PARALLELFOR_HPP
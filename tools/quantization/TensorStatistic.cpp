@@ -15,9 +15,8 @@
 
 // Given distribution P and Q, KL-Divergence is
 // Sum(P[i] * log(P[i] / Q[i]))
-static float _klDivergence(const std::vector<float>& candidateDis, const std::vector<float>& expandedDis) {
-    float result   = 0.0f;
-    const int size = candidateDis.size();
+static float _klDivergence(const std::vector<float>& candidateDis, const std::vector<float>& expandedDis, int size) {
+    float result = 0.0f;
 
     for (int i = 0; i < size; ++i) {
         if (candidateDis[i] != 0) {
@@ -36,7 +35,7 @@ TensorStatistic::TensorStatistic(const MNN::Tensor* tensor, std::string method,
                                  GET_THRESHOLD_METHOD thresholdMethod)
     : mOriginTensor(tensor), mName(name), mBinNumber(binNumber), mThresholdMethod(thresholdMethod) {
     MNN_ASSERT(tensor->dimensions() == 4);
-    if (method == "KL") {
+    if (method == "KL" || method == "ADMM") {
         auto channel = tensor->channel();
         mRangePerChannel.resize(channel);
         for (auto& iter : mRangePerChannel) {
@@ -145,6 +144,31 @@ void TensorStatistic::updateDistribution() {
     }
 }
 
+void TensorStatistic::mergeRange(const TensorStatistic& other) {
+    for (int c = 0; c < mRangePerChannel.size(); ++c) {
+        mRangePerChannel[c].first  = std::min(mRangePerChannel[c].first, other.mRangePerChannel[c].first);
+        mRangePerChannel[c].second = std::max(mRangePerChannel[c].second, other.mRangePerChannel[c].second);
+    }
+}
+
+void TensorStatistic::mergeDistribution(const TensorStatistic& other) {
+    for (int c = 0; c < mDistribution.size(); ++c) {
+        auto dst = mDistribution[c].data();
+        auto src = other.mDistribution[c].data();
+        for (int i = 0; i < mBinNumber; ++i) {
+            dst[i] += src[i];
+        }
+    }
+}
+
+float TensorStatistic::minValue() const {
+    float minValue = 0.0f;
+    for (auto& range : mRangePerChannel) {
+        minValue = std::min(minValue, range.first);
+    }
+    return minValue;
+}
+
 void TensorStatistic::setThresholdMethod(GET_THRESHOLD_METHOD thresholdMethod) {
     mThresholdMethod = thresholdMethod;
 }
@@ -162,10 +186,12 @@ int TensorStatistic::_computeThreshold(const std::vector<float>& distribution) {
         float afterThresholdSum = 0.0f;
         std::for_each(distribution.begin() + targetBinNums, distribution.end(),
                       [&](float n) { afterThresholdSum += n; });
+        std::vector<float> quantizedDistribution(targetBinNums);
+        std::vector<float> candidateDistribution(mBinNumber);
+        std::vector<float> expandedDistribution(mBinNumber);
         for (int i = targetBinNums; i < mBinNumber; ++i) {
-            std::vector<float> quantizedDistribution(targetBinNums);
-            std::vector<float> candidateDistribution(i);
-            std::vector<float> expandedDistribution(i);
+            std::fill(quantizedDistribution.begin(), quantizedDistribution.end(), 0.0f);
+            std::fill(expandedDistribution.begin(), expandedDistribution.begin() + i, 0.0f);
             std::copy(distribution.begin(), distribution.begin() + i, candidateDistribution.begin());
             candidateDistribution[i - 1] += afterThresholdSum;
             afterThresholdSum -= distribution[i];
@@ -235,7 +261,7 @@ int TensorStatistic::_computeThreshold(const std::vector<float>& distribution) {
                     }
                 }
             }
-            const float curKL = _klDivergence(candidateDistribution, expandedDistribution);
+            const float curKL = _klDivergence(candidateDistribution, expandedDistribution, i);
             // std::cout << "=====> KL: " << i << " ==> " << curKL << std::endl;
             if (curKL < minKLDivergence) {
                 minKLDivergence = curKL;
@@ -283,46 +309,44 @@ std::vector<float> TensorStatistic::finishAndCompute() {
     return scaleValue;
 }
 
-std::vector<float> TensorStatistic::computeScaleADMM() {
-    std::vector<float> scaleValue(mOriginTensor->channel(), 0.0f);
-
-    const int count         = mOriginTensor->elementSize();
-    float max               = 0;
-    const float bound       = 127;
-    const float* originData = mOriginTensor->host<float>();
-
-    for (int i = 0; i < count; i++) {
-        float absData = std::fabs(originData[i]);
-        if (absData > max) {
-            max = absData;
-        }
-    }
-    float alpha = max / (bound * 2.5);
-
-    // DLOG(INFO) << "alpha init: " << alpha;
+// The distribution's bin i holds the count of |x| in [i, i + 1) / interval, so the ADMM iteration
+// can use the bin center instead of keeping all feature maps
+static float _computeADMM(const std::vector<float>& distribution, float interval) {
+    const float bound = 127;
+    const int binNum  = distribution.size();
+    float alpha       = (float)binNum / interval / (bound * 2.5);
 
     const int maxStep = 300;
-    float sum1        = 0;
-    float sum2        = 0;
-    float invAlpha;
-
-    for (int i = 0; i < maxStep; i++) {
-        sum1     = 0;
-        sum2     = 0;
-        invAlpha = 1 / alpha;
-
-        for (int i = 0; i < count; i++) {
-            auto origin    = originData[i];
-            auto dataQuant = std::roundf(origin * invAlpha);
-            dataQuant      = std::fmin(bound, std::fmax(-bound, dataQuant));
-            sum1 += (dataQuant * origin);
-            sum2 += (dataQuant * dataQuant);
+    for (int step = 0; step < maxStep; step++) {
+        float sum1     = 0;
+        float sum2     = 0;
+        float invAlpha = 1 / alpha;
+        for (int i = 0; i < binNum; i++) {
+            auto origin    = ((float)i + 0.5f) / interval;
+            auto dataQuant = std::fmin(bound, std::roundf(origin * invAlpha));
+            sum1 += distribution[i] * dataQuant * origin;
+            sum2 += distribution[i] * dataQuant * dataQuant;
+        }
+        if (sum2 <= 0.0f) {
+            break;
         }
-
         alpha = sum1 / sum2;
     }
-    // DLOG(INFO) << "alpha final: " << alpha;
+    return alpha;
+}
 
-    std::fill(scaleValue.begin(), scaleValue.end(), alpha);
+std::vector<float> TensorStatistic::computeScaleADMM() {
+    std::vector<float> scaleValue(mDistribution.size(), 0.0f);
+    if (mMergeChannel) {
+        if (mValidChannel[0]) {
+            std::fill(scaleValue.begin(), scaleValue.end(), _computeADMM(mDistribution[0], mIntervals[0]));
+        }
+        return scaleValue;
+    }
+    for (int c = 0; c < mDistribution.size(); ++c) {
+        if (mValidChannel[c]) {
+            scaleValue[c] = _computeADMM(mDistribution[c], mIntervals[c]);
+        }
+    }
     return scaleValue;
 }
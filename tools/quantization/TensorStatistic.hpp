@@ -33,12 +33,19 @@ public:
     void resetDistribution();
     void updateDistribution();
 
+    // Merge the statistic of the same tensor collected by another session
+    void mergeRange(const TensorStatistic& other);
+    void mergeDistribution(const TensorStatistic& other);
+
+    // The min value of the tensor collected by updateRange
+    float minValue() const;
+
     void setThresholdMethod(GET_THRESHOLD_METHOD thresholdMethod);
     void setChannelWise(bool mergeChannel);
 
     std::vector<float> finishAndCompute();
 
-    // only this one for ADMM
+    // only this one for ADMM, computed from the distribution
     std::vector<float> computeScaleADMM();
 
 private:
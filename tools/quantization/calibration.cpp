@@ -7,10 +7,14 @@
 //
 
 #include "calibration.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <set>
+#include <thread>
 #include <MNN/ImageProcess.hpp>
 #include "flatbuffers/util.h"
 #include "logkit.h"
@@ -100,6 +104,18 @@ Calibration::Calibration(MNN::NetT* model, uint8_t* modelBuffer, const int buffe
         if (picObj.HasMember("used_image_num")) {
             _imageNum = picObj["used_image_num"].GetInt();
         }
+        if (picObj.HasMember("thread_num")) {
+            _threadNum = std::max(1, picObj["thread_num"].GetInt());
+        }
+        if (picObj.HasMember("mixed_precision_max_distance")) {
+            _mixedPrecisionMaxDistance = picObj["mixed_precision_max_distance"].GetFloat();
+        }
+        if (picObj.HasMember("mixed_precision_image_num")) {
+            _mixedPrecisionImageNum = std::max(1, picObj["mixed_precision_image_num"].GetInt());
+        }
+        if (picObj.HasMember("feature_quantize_asymmetric")) {
+            _featureQuantizeAsymmetric = picObj["feature_quantize_asymmetric"].GetBool();
+        }
         if (picObj.HasMember("feature_quantize_method")) {
             std::string method = picObj["feature_quantize_method"].GetString();
             if (Helper::featureQuantizeMethod.find(method) != Helper::featureQuantizeMethod.end()) {
@@ -121,8 +137,7 @@ Calibration::Calibration(MNN::NetT* model, uint8_t* modelBuffer, const int buffe
         DLOG(INFO) << "Use feature quantization method: " << _featureQuantizeMethod;
         DLOG(INFO) << "Use weight quantization method: " << _weightQuantizeMethod;
     }
-    std::shared_ptr<ImageProcess> process(ImageProcess::create(config));
-    _process = process;
+    _processConfig = config;
 
     // read images file names
     Helper::readImages(_imgaes, imagePath.c_str(), &_imageNum);
@@ -132,10 +147,21 @@ Calibration::Calibration(MNN::NetT* model, uint8_t* modelBuffer, const int buffe
 }
 
 void Calibration::_initMNNSession(const uint8_t* modelBuffer, const int bufferSize, const int channels) {
-    _interpreter.reset(MNN::Interpreter::createFromBuffer(modelBuffer, bufferSize));
-    MNN::ScheduleConfig config;
-    _session     = _interpreter->createSession(config);
-    _inputTensor = _interpreter->getSessionInput(_session, NULL);
+    _workers.resize(_threadNum);
+    for (auto& worker : _workers) {
+        worker.interpreter.reset(MNN::Interpreter::createFromBuffer(modelBuffer, bufferSize));
+        MNN::ScheduleConfig config;
+        if (_threadNum > 1) {
+            // Images are computed in parallel, don't use multi-thread inside the session
+            config.numThread = 1;
+        }
+        worker.session     = worker.interpreter->createSession(config);
+        worker.inputTensor = worker.interpreter->getSessionInput(worker.session, NULL);
+        worker.process.reset(ImageProcess::create(_processConfig));
+    }
+    _interpreter = _workers[0].interpreter;
+    _session     = _workers[0].session;
+    _inputTensor = _workers[0].inputTensor;
 
     _inputTensorDims.resize(4);
     auto inputTensorDataFormat = MNN::TensorUtils::getDescribe(_inputTensor)->dimensionFormat;
@@ -150,16 +176,11 @@ void Calibration::_initMNNSession(const uint8_t* modelBuffer, const int bufferSi
         _inputTensorDims[2] = _height;
         _inputTensorDims[3] = _width;
     }
-    if (_featureQuantizeMethod == "KL") {
-        _interpreter->resizeTensor(_inputTensor, _inputTensorDims);
-        _interpreter->resizeSession(_session);
-    } else if (_featureQuantizeMethod == "ADMM") {
-        DCHECK((_imageNum * 4 * _height * _width) < (INT_MAX / 4)) << "Use Little Number of Images When Use ADMM";
-        _inputTensorDims[0] = _imageNum;
-        _interpreter->resizeTensor(_inputTensor, _inputTensorDims);
-        _interpreter->resizeSession(_session);
+    for (auto& worker : _workers) {
+        worker.interpreter->resizeTensor(worker.inputTensor, _inputTensorDims);
+        worker.interpreter->resizeSession(worker.session);
+        worker.interpreter->releaseModel();
     }
-    _interpreter->releaseModel();
 }
 
 void Calibration::_initMaps() {
@@ -171,7 +192,7 @@ void Calibration::_initMaps() {
         _opInfo[info->name()].first = nTensors;
         if (Helper::gNeedFeatureOp.find(info->type()) != Helper::gNeedFeatureOp.end()) {
             for (auto t : nTensors) {
-                if (_featureInfo.find(t) == _featureInfo.end()) {
+                if (_featureInfo.find(t) == _featureInfo.end() && t->getType().code == halide_type_float) {
                     _featureInfo[t] = std::shared_ptr<TensorStatistic>(
                         new TensorStatistic(t, _featureQuantizeMethod, info->name() + "__input"));
                 }
@@ -184,7 +205,7 @@ void Calibration::_initMaps() {
         _opInfo[info->name()].second = nTensors;
         if (Helper::gNeedFeatureOp.find(info->type()) != Helper::gNeedFeatureOp.end()) {
             for (auto t : nTensors) {
-                if (_featureInfo.find(t) == _featureInfo.end()) {
+                if (_featureInfo.find(t) == _featureInfo.end() && t->getType().code == halide_type_float) {
                     _featureInfo[t] =
                         std::shared_ptr<TensorStatistic>(new TensorStatistic(t, _featureQuantizeMethod, info->name()));
                 }
@@ -205,6 +226,26 @@ void Calibration::_initMaps() {
             _tensorMap[op->outputIndexes[i]] = _opInfo[op->name].second[i];
         }
     }
+    // Ops turned into Raster by geometry (such as Concat) have no callback, find their tensors by the neighbours
+    for (auto& op : _originaleModel->oplists) {
+        if (_opInfo.find(op->name) != _opInfo.end()) {
+            continue;
+        }
+        std::vector<MNN::Tensor*> inputs, outputs;
+        for (auto index : op->inputIndexes) {
+            if (_tensorMap.find(index) != _tensorMap.end()) {
+                inputs.emplace_back(const_cast<MNN::Tensor*>(_tensorMap[index]));
+            }
+        }
+        for (auto index : op->outputIndexes) {
+            if (_tensorMap.find(index) != _tensorMap.end()) {
+                outputs.emplace_back(const_cast<MNN::Tensor*>(_tensorMap[index]));
+            }
+        }
+        if (inputs.size() == op->inputIndexes.size() && outputs.size() == op->outputIndexes.size()) {
+            _opInfo[op->name] = std::make_pair(inputs, outputs);
+        }
+    }
 
     if (_featureQuantizeMethod == "KL") {
         // set the tensor-statistic method of input tensor as THRESHOLD_MAX
@@ -213,23 +254,90 @@ void Calibration::_initMaps() {
             inputTensorStatistic->second->setThresholdMethod(THRESHOLD_MAX);
         }
     }
+
+    _workers[0].featureInfo     = _featureInfo;
+    _workers[0].mainFeatureInfo = _featureInfo;
+    for (int i = 1; i < _workers.size(); ++i) {
+        auto& worker = _workers[i];
+        // Match the tensors of other sessions with worker 0's by op name
+        std::map<std::string, std::pair<std::vector<MNN::Tensor*>, std::vector<MNN::Tensor*>>> opInfo;
+        MNN::TensorCallBackWithInfo before = [&](const std::vector<MNN::Tensor*>& nTensors,
+                                                 const MNN::OperatorInfo* info) {
+            opInfo[info->name()].first = nTensors;
+            return false;
+        };
+        MNN::TensorCallBackWithInfo after = [&](const std::vector<MNN::Tensor*>& nTensors,
+                                                const MNN::OperatorInfo* info) {
+            opInfo[info->name()].second = nTensors;
+            return true;
+        };
+        worker.interpreter->runSessionWithCallBackInfo(worker.session, before, after);
+        auto addFeature = [&](const std::string& name, const std::vector<MNN::Tensor*>& mainTensors,
+                              const std::vector<MNN::Tensor*>& tensors) {
+            for (int j = 0; j < mainTensors.size() && j < tensors.size(); ++j) {
+                if (_featureInfo.find(mainTensors[j]) == _featureInfo.end() ||
+                    worker.mainFeatureInfo.find(mainTensors[j]) != worker.mainFeatureInfo.end()) {
+                    continue;
+                }
+                std::shared_ptr<TensorStatistic> statistic(
+                    new TensorStatistic(tensors[j], _featureQuantizeMethod, name));
+                worker.featureInfo[tensors[j]]          = statistic;
+                worker.mainFeatureInfo[mainTensors[j]] = statistic;
+            }
+        };
+        for (auto& iter : opInfo) {
+            auto mainIter = _opInfo.find(iter.first);
+            if (mainIter == _opInfo.end()) {
+                continue;
+            }
+            addFeature(iter.first + "__input", mainIter->second.first, iter.second.first);
+            addFeature(iter.first, mainIter->second.second, iter.second.second);
+        }
+    }
 }
 
-void Calibration::_computeFeatureMapsRange() {
-    // feed input data according to input images
+void Calibration::_runImages(const char* title,
+                             const std::function<void(Worker&, const std::string&)>& function) {
+    std::atomic<int> next(0);
+    std::mutex countMutex;
     int count = 0;
-    for (const auto& img : _imgaes) {
-        for (auto& iter : _featureInfo) {
+    auto run  = [&](int workerIndex) {
+        while (true) {
+            int index = next++;
+            if (index >= _imgaes.size()) {
+                break;
+            }
+            function(_workers[workerIndex], _imgaes[index]);
+            std::unique_lock<std::mutex> _l(countMutex);
+            count++;
+            MNN_PRINT("\r%s: %.2lf %%", title, (float)count * 100.0f / (float)_imageNum);
+            fflush(stdout);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < _workers.size(); ++i) {
+        threads.emplace_back(run, i);
+    }
+    run(0);
+    for (auto& t : threads) {
+        t.join();
+    }
+    MNN_PRINT("\n");
+}
+
+void Calibration::_computeFeatureMapsRange() {
+    _runImages("ComputeFeatureRange", [this](Worker& worker, const std::string& img) {
+        auto& featureInfo = worker.featureInfo;
+        for (auto& iter : featureInfo) {
             iter.second->resetUpdatedRangeFlags();
         }
-        count++;
-        Helper::preprocessInput(_process.get(), _width, _height, img, _inputTensor);
+        Helper::preprocessInput(worker.process.get(), _width, _height, img, worker.inputTensor);
 
         MNN::TensorCallBackWithInfo before = [&](const std::vector<MNN::Tensor*>& nTensors,
                                                  const MNN::OperatorInfo* info) {
             for (auto t : nTensors) {
-                if (_featureInfo.find(t) != _featureInfo.end()) {
-                    _featureInfo[t]->updateRange();
+                if (featureInfo.find(t) != featureInfo.end()) {
+                    featureInfo[t]->updateRange();
                 }
             }
             return true;
@@ -237,131 +345,272 @@ void Calibration::_computeFeatureMapsRange() {
         MNN::TensorCallBackWithInfo after = [&](const std::vector<MNN::Tensor*>& nTensors,
                                                 const MNN::OperatorInfo* info) {
             for (auto t : nTensors) {
-                if (_featureInfo.find(t) != _featureInfo.end()) {
-                    _featureInfo[t]->updateRange();
+                if (featureInfo.find(t) != featureInfo.end()) {
+                    featureInfo[t]->updateRange();
                 }
             }
             return true;
         };
+        worker.interpreter->runSessionWithCallBackInfo(worker.session, before, after);
+    });
 
-        _interpreter->runSessionWithCallBackInfo(_session, before, after);
-        MNN_PRINT("\rComputeFeatureRange: %.2lf %%", (float)count * 100.0f / (float)_imageNum);
-        fflush(stdout);
+    // All sessions must use the same range to collect the distribution
+    for (int i = 1; i < _workers.size(); ++i) {
+        for (auto& iter : _workers[i].mainFeatureInfo) {
+            _featureInfo[iter.first]->mergeRange(*iter.second);
+        }
+    }
+    for (int i = 1; i < _workers.size(); ++i) {
+        for (auto& iter : _workers[i].mainFeatureInfo) {
+            iter.second->mergeRange(*_featureInfo[iter.first]);
+        }
     }
-    MNN_PRINT("\n");
 }
 
 void Calibration::_collectFeatureMapsDistribution() {
-    for (auto& iter : _featureInfo) {
-        iter.second->resetDistribution();
-    }
-    // feed input data according to input images
-    MNN::TensorCallBackWithInfo before = [&](const std::vector<MNN::Tensor*>& nTensors, const MNN::OperatorInfo* info) {
-        for (auto t : nTensors) {
-            if (_featureInfo.find(t) != _featureInfo.end()) {
-                _featureInfo[t]->updateDistribution();
-            }
+    for (auto& worker : _workers) {
+        for (auto& iter : worker.featureInfo) {
+            iter.second->resetDistribution();
         }
-        return true;
-    };
-    MNN::TensorCallBackWithInfo after = [&](const std::vector<MNN::Tensor*>& nTensors, const MNN::OperatorInfo* info) {
-        for (auto t : nTensors) {
-            if (_featureInfo.find(t) != _featureInfo.end()) {
-                _featureInfo[t]->updateDistribution();
-            }
-        }
-        return true;
-    };
-    int count = 0;
-    for (const auto& img : _imgaes) {
-        count++;
-        for (auto& iter : _featureInfo) {
+    }
+    _runImages("CollectFeatureDistribution", [this](Worker& worker, const std::string& img) {
+        auto& featureInfo = worker.featureInfo;
+        for (auto& iter : featureInfo) {
             iter.second->resetUpdatedDistributionFlag();
         }
-        Helper::preprocessInput(_process.get(), _width, _height, img, _inputTensor);
-        _interpreter->runSessionWithCallBackInfo(_session, before, after);
+        // feed input data according to input images
+        MNN::TensorCallBackWithInfo before = [&](const std::vector<MNN::Tensor*>& nTensors,
+                                                 const MNN::OperatorInfo* info) {
+            for (auto t : nTensors) {
+                if (featureInfo.find(t) != featureInfo.end()) {
+                    featureInfo[t]->updateDistribution();
+                }
+            }
+            return true;
+        };
+        MNN::TensorCallBackWithInfo after = [&](const std::vector<MNN::Tensor*>& nTensors,
+                                                const MNN::OperatorInfo* info) {
+            for (auto t : nTensors) {
+                if (featureInfo.find(t) != featureInfo.end()) {
+                    featureInfo[t]->updateDistribution();
+                }
+            }
+            return true;
+        };
+        Helper::preprocessInput(worker.process.get(), _width, _height, img, worker.inputTensor);
+        worker.interpreter->runSessionWithCallBackInfo(worker.session, before, after);
+    });
 
-        MNN_PRINT("\rCollectFeatureDistribution: %.2lf %%", (float)count * 100.0f / (float)_imageNum);
-        fflush(stdout);
+    for (int i = 1; i < _workers.size(); ++i) {
+        for (auto& iter : _workers[i].mainFeatureInfo) {
+            _featureInfo[iter.first]->mergeDistribution(*iter.second);
+        }
     }
-    MNN_PRINT("\n");
 }
 
-void Calibration::_computeFeatureScaleKL() {
+void Calibration::_computeFeatureScale(bool admm) {
     _computeFeatureMapsRange();
     _collectFeatureMapsDistribution();
 
+    // The threshold search of every tensor is independent
+    std::vector<std::pair<const MNN::Tensor*, std::shared_ptr<TensorStatistic>>> features(_featureInfo.begin(),
+                                                                                         _featureInfo.end());
+    std::vector<std::vector<float>> scales(features.size());
+    std::atomic<int> next(0);
+    auto run = [&]() {
+        while (true) {
+            int index = next++;
+            if (index >= features.size()) {
+                break;
+            }
+            auto statistic = features[index].second;
+            scales[index]  = admm ? statistic->computeScaleADMM() : statistic->finishAndCompute();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < _threadNum; ++i) {
+        threads.emplace_back(run);
+    }
+    run();
+    for (auto& t : threads) {
+        t.join();
+    }
     _scales.clear();
-    for (auto& iter : _featureInfo) {
-        AUTOTIME;
-        _scales[iter.first] = iter.second->finishAndCompute();
+    for (int i = 0; i < features.size(); ++i) {
+        _scales[features[i].first] = scales[i];
     }
-    //_featureInfo.clear();//No need now
 }
 
-void Calibration::_computeFeatureScaleADMM() {
-    // feed input data according to input images
-    int count                           = 0;
-    std::vector<int> oneImageTensorDims = _inputTensorDims;
-    oneImageTensorDims[0]               = 1;
-    auto inputTensorDataFormat          = MNN::TensorUtils::getDescribe(_inputTensor)->dimensionFormat;
-    auto dimType                        = MNN::Tensor::CAFFE_C4;
-    if (inputTensorDataFormat == MNN::MNN_DATA_FORMAT_NHWC) {
-        dimType = MNN::Tensor::TENSORFLOW;
+bool Calibration::_supportInt8(const MNN::OpT* op) const {
+    auto tensorsPair = _opInfo.find(op->name);
+    if (tensorsPair == _opInfo.end()) {
+        return false;
     }
-
-    for (const auto& img : _imgaes) {
-        auto curPtr = _inputTensor->host<float>() + count * _inputTensor->stride(0);
-        std::shared_ptr<MNN::Tensor> tensorWarp(
-            MNN::Tensor::create(oneImageTensorDims, _inputTensor->getType(), curPtr, dimType));
-        Helper::preprocessInput(_process.get(), _width, _height, img, tensorWarp.get());
-
-        count++;
-        MNN_PRINT("\rProcessImage: %.2lf %%", (float)count * 100.0f / (float)_imageNum);
-        fflush(stdout);
+    auto inputs  = tensorsPair->second.first;
+    auto outputs = tensorsPair->second.second;
+    if (op->type == MNN::OpType_Interp) {
+        // The other inputs are shape
+        inputs.resize(1);
     }
-    MNN_PRINT("\n");
-    _scales.clear();
-
-    const int totalLayers = _featureInfo.size();
-    count                 = 0;
-
-    MNN::TensorCallBackWithInfo before = [&](const std::vector<MNN::Tensor*>& nTensors, const MNN::OperatorInfo* info) {
-        if (Helper::gNeedFeatureOp.find(info->type()) != Helper::gNeedFeatureOp.end()) {
-            for (auto t : nTensors) {
-                if (_featureInfo.find(t) != _featureInfo.end()) {
-                    _scales[t] = _featureInfo[t]->computeScaleADMM();
-                    count++;
-                    MNN_PRINT("\rComputeADMM: %.2lf %%", (float)count * 100.0f / (float)totalLayers);
-                    fflush(stdout);
+    // FloatToInt8 / Int8ToFloat and the int8 ops need NC4HW4 4-D tensors
+    for (auto t : inputs) {
+        if (_featureInfo.find(t) == _featureInfo.end() || t->dimensions() != 4 ||
+            MNN::TensorUtils::getDescribe(t)->dimensionFormat != MNN::MNN_DATA_FORMAT_NC4HW4) {
+            return false;
+        }
+    }
+    for (auto t : outputs) {
+        if (_featureInfo.find(t) == _featureInfo.end() || t->dimensions() != 4 ||
+            MNN::TensorUtils::getDescribe(t)->dimensionFormat != MNN::MNN_DATA_FORMAT_NC4HW4) {
+            return false;
+        }
+    }
+    switch (op->type) {
+        case MNN::OpType_Concat:
+            return true;
+        case MNN::OpType_Interp: {
+            // nearest, bilinear, nearest round
+            auto resizeType = op->main.AsInterp()->resizeType;
+            return resizeType == 1 || resizeType == 2 || resizeType == 4;
+        }
+        case MNN::OpType_Pooling: {
+            auto pool = op->main.AsPool();
+            if (!pool->pads.empty()) {
+                return false;
+            }
+            if (pool->type == MNN::PoolType_MAXPOOL) {
+                return true;
+            }
+            // PoolInt8 average the valid values with int16 accumulator
+            if (pool->isGlobal) {
+                return inputs[0]->width() * inputs[0]->height() <= 256;
+            }
+            return pool->type == MNN::PoolType_AVEPOOL && pool->padX == 0 && pool->padY == 0 &&
+                   pool->padType != MNN::PoolPadType_SAME && pool->kernelX * pool->kernelY <= 256;
+        }
+        case MNN::OpType_BinaryOp:
+        case MNN::OpType_Eltwise: {
+            if (op->type == MNN::OpType_BinaryOp) {
+                auto binaryType = op->main.AsBinaryOp()->opType;
+                if (binaryType != MNN::BinaryOpOperation_ADD && binaryType != MNN::BinaryOpOperation_MUL) {
+                    return false;
+                }
+            } else {
+                auto param = op->main.AsEltwise();
+                if ((param->type != MNN::EltwiseType_SUM && param->type != MNN::EltwiseType_PROD) ||
+                    !param->coeff.empty()) {
+                    return false;
                 }
             }
+            // EltwiseInt8 don't broadcast
+            return inputs.size() == 2 && inputs[0]->shape() == outputs[0]->shape() &&
+                   inputs[1]->shape() == outputs[0]->shape();
         }
-        return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+void Calibration::_propagateScales() {
+    // Union the tensors of Concat / Interp / Pooling
+    std::map<const MNN::Tensor*, const MNN::Tensor*> parent;
+    std::function<const MNN::Tensor*(const MNN::Tensor*)> find = [&](const MNN::Tensor* t) {
+        auto iter = parent.find(t);
+        if (iter == parent.end() || iter->second == t) {
+            return t;
+        }
+        auto root    = find(iter->second);
+        parent[t] = root;
+        return root;
     };
-    MNN::TensorCallBackWithInfo after = [&](const std::vector<MNN::Tensor*>& nTensors, const MNN::OperatorInfo* info) {
-        if (Helper::gNeedFeatureOp.find(info->type()) != Helper::gNeedFeatureOp.end()) {
-            for (auto t : nTensors) {
-                if (_featureInfo.find(t) != _featureInfo.end()) {
-                    _scales[t] = _featureInfo[t]->computeScaleADMM();
-                    count++;
-                    MNN_PRINT("\rComputeADMM: %.2lf %%", (float)count * 100.0f / (float)totalLayers);
-                    fflush(stdout);
-                }
+    for (const auto& op : _originaleModel->oplists) {
+        if (op->type != MNN::OpType_Concat && op->type != MNN::OpType_Interp && op->type != MNN::OpType_Pooling) {
+            continue;
+        }
+        if (!_supportInt8(op.get())) {
+            continue;
+        }
+        const auto& tensorsPair = _opInfo.find(op->name)->second;
+        auto inputSize          = op->type == MNN::OpType_Interp ? 1 : tensorsPair.first.size();
+        for (int i = 0; i < inputSize; ++i) {
+            parent.insert(std::make_pair(tensorsPair.first[i], tensorsPair.first[i]));
+        }
+        parent.insert(std::make_pair(tensorsPair.second[0], tensorsPair.second[0]));
+        auto root = find(tensorsPair.second[0]);
+        for (int i = 0; i < inputSize; ++i) {
+            auto inputRoot = find(tensorsPair.first[i]);
+            if (inputRoot != root) {
+                parent[inputRoot] = root;
             }
         }
-        return true;
-    };
-
-    _interpreter->runSessionWithCallBackInfo(_session, before, after);
-    MNN_PRINT("\n");
+    }
+    std::map<const MNN::Tensor*, float> groupScale;
+    for (auto& iter : parent) {
+        auto root  = find(iter.first);
+        auto scale = _scales[iter.first];
+        if (!scale.empty()) {
+            groupScale[root] = std::max(groupScale[root], *std::max_element(scale.begin(), scale.end()));
+        }
+    }
+    for (auto& iter : parent) {
+        auto& scale = _scales[iter.first];
+        std::fill(scale.begin(), scale.end(), groupScale[find(iter.first)]);
+    }
 }
 
-void Calibration::_updateScale() {
+void Calibration::_computeZeroPoints() {
+    _zeroPoints.clear();
+    if (!_featureQuantizeAsymmetric) {
+        return;
+    }
+    // Only ConvInt8 support zero point for input, DepthwiseConvInt8 support zero point for output
+    std::set<const MNN::Tensor*> symmetricTensors;
     for (const auto& op : _originaleModel->oplists) {
+        auto tensorsPair = _opInfo.find(op->name);
+        if (tensorsPair == _opInfo.end()) {
+            continue;
+        }
+        if (op->type == MNN::OpType_Eltwise || op->type == MNN::OpType_BinaryOp || op->type == MNN::OpType_Concat ||
+            op->type == MNN::OpType_Interp || op->type == MNN::OpType_Pooling) {
+            symmetricTensors.insert(tensorsPair->second.first.begin(), tensorsPair->second.first.end());
+            symmetricTensors.insert(tensorsPair->second.second.begin(), tensorsPair->second.second.end());
+        } else if (op->type == MNN::OpType_ConvolutionDepthwise) {
+            symmetricTensors.insert(tensorsPair->second.first.begin(), tensorsPair->second.first.end());
+        }
+    }
+    for (auto& iter : _featureInfo) {
+        auto tensor = iter.first;
+        if (symmetricTensors.find(tensor) != symmetricTensors.end() || iter.second->minValue() < 0.0f) {
+            continue;
+        }
+        // [0, threshold] -> [-128, 127]
+        for (auto& scale : _scales[tensor]) {
+            scale = scale * 127.0f / 255.0f;
+        }
+        _zeroPoints[tensor] = -128;
+    }
+    DLOG(INFO) << "Asymmetric quantized tensors: " << _zeroPoints.size();
+}
+
+int Calibration::_zeroPoint(const MNN::Tensor* tensor) const {
+    auto iter = _zeroPoints.find(tensor);
+    if (iter == _zeroPoints.end()) {
+        return 0;
+    }
+    return iter->second;
+}
+
+void Calibration::_updateScale(MNN::NetT* model, const std::set<std::string>& floatOps) {
+    _int8PassOps.clear();
+    for (const auto& op : model->oplists) {
         const auto opType = op->type;
         if (opType != MNN::OpType_Convolution && opType != MNN::OpType_ConvolutionDepthwise &&
-            opType != MNN::OpType_Eltwise) {
+            opType != MNN::OpType_Eltwise && opType != MNN::OpType_BinaryOp && opType != MNN::OpType_Concat &&
+            opType != MNN::OpType_Interp && opType != MNN::OpType_Pooling) {
+            continue;
+        }
+        if (floatOps.find(op->name) != floatOps.end()) {
             continue;
         }
         auto tensorsPair = _opInfo.find(op->name);
@@ -369,12 +618,28 @@ void Calibration::_updateScale() {
             MNN_ERROR("Can't find tensors for %s\n", op->name.c_str());
         }
 
-        if (opType == MNN::OpType_Eltwise) {
-            auto param = op->main.AsEltwise();
-            // Now only support AddInt8
-            if (param->type != MNN::EltwiseType_SUM) {
+        if (opType == MNN::OpType_Concat || opType == MNN::OpType_Interp || opType == MNN::OpType_Pooling) {
+            if (!_supportInt8(op.get())) {
+                continue;
+            }
+            if (opType == MNN::OpType_Pooling) {
+                op->type = MNN::OpType_PoolInt8;
+            } else {
+                _int8PassOps.insert(op->name);
+            }
+            continue;
+        }
+
+        if (opType == MNN::OpType_Eltwise || opType == MNN::OpType_BinaryOp) {
+            if (!_supportInt8(op.get())) {
                 continue;
             }
+            auto type = MNN::EltwiseType_SUM;
+            if (opType == MNN::OpType_Eltwise && op->main.AsEltwise()->type == MNN::EltwiseType_PROD) {
+                type = MNN::EltwiseType_PROD;
+            } else if (opType == MNN::OpType_BinaryOp && op->main.AsBinaryOp()->opType == MNN::BinaryOpOperation_MUL) {
+                type = MNN::EltwiseType_PROD;
+            }
             const auto& inputScale0   = _scales[tensorsPair->second.first[0]];
             const auto& inputScale1   = _scales[tensorsPair->second.first[1]];
             const auto& outputScale   = _scales[tensorsPair->second.second[0]];
@@ -386,6 +651,7 @@ void Calibration::_updateScale() {
             op->main.type = MNN::OpParameter_EltwiseInt8;
 
             auto eltwiseInt8Param         = new MNN::EltwiseInt8T;
+            eltwiseInt8Param->type        = type;
             auto input0ScaleParam         = new MNN::QuantizedFloatParamT;
             auto input1ScaleParam         = new MNN::QuantizedFloatParamT;
             auto outputScaleParam         = new MNN::QuantizedFloatParamT;
@@ -410,6 +676,8 @@ void Calibration::_updateScale() {
         const int weightSize      = param->weight.size();
         param->symmetricQuan.reset(new MNN::QuantizedFloatParamT);
         auto& quantizedParam = param->symmetricQuan;
+        quantizedParam->inputZeroPoint  = _zeroPoint(tensorsPair->second.first[0]);
+        quantizedParam->outputZeroPoint = _zeroPoint(tensorsPair->second.second[0]);
         quantizedParam->scale.resize(channles);
         quantizedParam->weight.resize(weightSize);
         quantizedParam->bias.resize(channles);
@@ -435,14 +703,19 @@ void Calibration::_updateScale() {
     }
 }
 
-void Calibration::_insertDequantize() {
+void Calibration::_insertDequantize(MNN::NetT* model) {
     // Search All Int Tensors
     std::set<int> int8Tensors;
     std::set<int> int8Outputs;
-    for (auto& op : _originaleModel->oplists) {
-        if (Helper::INT8SUPPORTED_OPS.count(op->type) > 0) {
-            for (auto index : op->inputIndexes) {
-                int8Tensors.insert(index);
+    auto isInt8Op = [this](const MNN::OpT* op) {
+        return Helper::INT8SUPPORTED_OPS.count(op->type) > 0 || _int8PassOps.count(op->name) > 0;
+    };
+    for (auto& op : model->oplists) {
+        if (isInt8Op(op.get())) {
+            // The other inputs of Interp are shape
+            int inputSize = op->type == MNN::OpType_Interp ? 1 : (int)op->inputIndexes.size();
+            for (int i = 0; i < inputSize; ++i) {
+                int8Tensors.insert(op->inputIndexes[i]);
             }
             for (auto index : op->outputIndexes) {
                 int8Tensors.insert(index);
@@ -450,7 +723,7 @@ void Calibration::_insertDequantize() {
             }
         }
     }
-    for (auto& op : _originaleModel->oplists) {
+    for (auto& op : model->oplists) {
         for (auto index : op->inputIndexes) {
             auto iter = int8Outputs.find(index);
             if (iter != int8Outputs.end()) {
@@ -460,13 +733,12 @@ void Calibration::_insertDequantize() {
     }
 
     // Insert Convert For Not Support Int8 Ops
-    for (auto iter = _originaleModel->oplists.begin(); iter != _originaleModel->oplists.end();) {
+    for (auto iter = model->oplists.begin(); iter != model->oplists.end();) {
         auto op           = iter->get();
-        const auto opType = op->type;
         const auto name   = op->name;
         // check whether is output op
         // if Yes, insert dequantization op after this op
-        if (Helper::INT8SUPPORTED_OPS.find(opType) != Helper::INT8SUPPORTED_OPS.end()) {
+        if (isInt8Op(op)) {
             // this is quantized op
             iter++;
             continue;
@@ -493,15 +765,16 @@ void Calibration::_insertDequantize() {
             auto dequantizationParam         = new MNN::QuantizedFloatParamT;
             dequantizationOp->main.value     = dequantizationParam;
             dequantizationParam->tensorScale = inputOpScale;
+            dequantizationParam->inputZeroPoint = _zeroPoint(input);
 
             dequantizationOp->inputIndexes.push_back(curInputIndex);
-            dequantizationOp->outputIndexes.push_back(_originaleModel->tensorName.size());
-            _originaleModel->tensorName.push_back(dequantizationOp->name);
+            dequantizationOp->outputIndexes.push_back(model->tensorName.size());
+            model->tensorName.push_back(dequantizationOp->name);
 
             // reset current op's input index at i
             inputIndexes[i] = dequantizationOp->outputIndexes[0];
 
-            iter = _originaleModel->oplists.insert(iter, std::unique_ptr<MNN::OpT>(dequantizationOp));
+            iter = model->oplists.insert(iter, std::unique_ptr<MNN::OpT>(dequantizationOp));
             iter++;
         }
 
@@ -527,14 +800,15 @@ void Calibration::_insertDequantize() {
             std::vector<float> quantizationScale(channels);
             Helper::invertData(quantizationScale.data(), curScale.data(), channels);
             quantizationParam->tensorScale = quantizationScale;
+            quantizationParam->outputZeroPoint = _zeroPoint(output);
 
-            quantizationOp->inputIndexes.push_back(_originaleModel->tensorName.size());
+            quantizationOp->inputIndexes.push_back(model->tensorName.size());
             quantizationOp->outputIndexes.push_back(outputIndex);
-            _originaleModel->tensorName.push_back(_originaleModel->tensorName[outputIndex]);
-            _originaleModel->tensorName[outputIndex] = quantizationOp->name;
+            model->tensorName.push_back(model->tensorName[outputIndex]);
+            model->tensorName[outputIndex] = quantizationOp->name;
             op->outputIndexes[i]                              = quantizationOp->inputIndexes[0];
 
-            iter = _originaleModel->oplists.insert(iter, std::unique_ptr<MNN::OpT>(quantizationOp));
+            iter = model->oplists.insert(iter, std::unique_ptr<MNN::OpT>(quantizationOp));
             iter++;
         }
     }
@@ -550,22 +824,179 @@ void Calibration::_insertDequantize() {
         auto dequantizationParam         = new MNN::QuantizedFloatParamT;
         dequantizationOp->main.value     = dequantizationParam;
         dequantizationParam->tensorScale = _scales[_tensorMap[index]];
+        dequantizationParam->inputZeroPoint = _zeroPoint(_tensorMap[index]);
 
         dequantizationOp->inputIndexes.push_back(index);
-        dequantizationOp->outputIndexes.push_back(_originaleModel->tensorName.size());
-        auto originTensorName              = _originaleModel->tensorName[index];
-        _originaleModel->tensorName[index] = dequantizationOp->name;
-        _originaleModel->tensorName.emplace_back(originTensorName);
+        dequantizationOp->outputIndexes.push_back(model->tensorName.size());
+        auto originTensorName              = model->tensorName[index];
+        model->tensorName[index] = dequantizationOp->name;
+        model->tensorName.emplace_back(originTensorName);
+
+        model->oplists.insert(model->oplists.end(), std::unique_ptr<MNN::OpT>(dequantizationOp));
+    }
+}
+static std::unique_ptr<MNN::NetT> _cloneModel(const MNN::NetT* model) {
+    flatbuffers::FlatBufferBuilder builder(1024);
+    builder.Finish(MNN::Net::Pack(builder, model));
+    return MNN::UnPackNet(builder.GetBufferPointer());
+}
+
+// 1 - cos(a, b)
+static float _cosineDistance(const std::vector<float>& a, const std::vector<float>& b) {
+    double dot = 0.0, normA = 0.0, normB = 0.0;
+    for (int i = 0; i < a.size() && i < b.size(); ++i) {
+        dot += (double)a[i] * b[i];
+        normA += (double)a[i] * a[i];
+        normB += (double)b[i] * b[i];
+    }
+    if (normA == 0.0 || normB == 0.0) {
+        return normA == normB ? 0.0f : 1.0f;
+    }
+    return 1.0f - (float)(dot / std::sqrt(normA * normB));
+}
+
+void Calibration::_runModel(const MNN::NetT* model, std::vector<std::vector<float>>& outputs,
+                            std::map<std::string, float>& opCosts) {
+    flatbuffers::FlatBufferBuilder builder(1024);
+    builder.Finish(MNN::Net::Pack(builder, model));
+    std::shared_ptr<MNN::Interpreter> interpreter(
+        MNN::Interpreter::createFromBuffer(builder.GetBufferPointer(), builder.GetSize()));
+    MNN::ScheduleConfig config;
+    auto session = interpreter->createSession(config);
+    auto input   = interpreter->getSessionInput(session, NULL);
+    interpreter->resizeTensor(input, _inputTensorDims);
+    interpreter->resizeSession(session);
+    std::shared_ptr<ImageProcess> process(ImageProcess::create(_processConfig));
+
+    MNN::Timer timer;
+    MNN::TensorCallBackWithInfo before = [&](const std::vector<MNN::Tensor*>& nTensors, const MNN::OperatorInfo* info) {
+        timer.reset();
+        return true;
+    };
+    MNN::TensorCallBackWithInfo after = [&](const std::vector<MNN::Tensor*>& nTensors, const MNN::OperatorInfo* info) {
+        opCosts[info->name()] += (float)timer.durationInUs();
+        return true;
+    };
+    const int imageNum = std::min(_mixedPrecisionImageNum, (int)_imgaes.size());
+    outputs.resize(imageNum);
+    for (int i = 0; i < imageNum; ++i) {
+        Helper::preprocessInput(process.get(), _width, _height, _imgaes[i], input);
+        interpreter->runSessionWithCallBackInfo(session, before, after);
+        outputs[i].clear();
+        for (auto& iter : interpreter->getSessionOutputAll(session)) {
+            std::shared_ptr<MNN::Tensor> hostTensor(new MNN::Tensor(iter.second, MNN::Tensor::CAFFE));
+            iter.second->copyToHostTensor(hostTensor.get());
+            auto data = hostTensor->host<float>();
+            outputs[i].insert(outputs[i].end(), data, data + hostTensor->elementSize());
+        }
+    }
+}
 
-        _originaleModel->oplists.insert(_originaleModel->oplists.end(), std::unique_ptr<MNN::OpT>(dequantizationOp));
+std::set<std::string> Calibration::_searchMixedPrecision() {
+    std::set<std::string> layers;
+    for (const auto& op : _originaleModel->oplists) {
+        bool quantizable = op->type == MNN::OpType_Convolution || op->type == MNN::OpType_ConvolutionDepthwise ||
+                           (op->type == MNN::OpType_Eltwise && op->main.AsEltwise()->type == MNN::EltwiseType_SUM);
+        if (quantizable && _opInfo.find(op->name) != _opInfo.end()) {
+            layers.insert(op->name);
+        }
     }
+    std::vector<std::vector<float>> reference;
+    std::map<std::string, float> floatCosts;
+    _runModel(_originaleModel, reference, floatCosts);
+    auto runMixedModel = [&](const std::set<std::string>& floatOps, std::map<std::string, float>& opCosts) {
+        auto model = _cloneModel(_originaleModel);
+        _updateScale(model.get(), floatOps);
+        _insertDequantize(model.get());
+        std::vector<std::vector<float>> outputs;
+        _runModel(model.get(), outputs, opCosts);
+        float distance = 0.0f;
+        for (int i = 0; i < outputs.size(); ++i) {
+            distance += _cosineDistance(reference[i], outputs[i]);
+        }
+        return distance / std::max(1, (int)outputs.size());
+    };
+
+    // Quantize only one layer to get its error and speedup
+    struct LayerInfo {
+        std::string name;
+        float distance;
+        float speedup;
+    };
+    std::vector<LayerInfo> infos;
+    const float imageNum = (float)reference.size();
+    for (auto& name : layers) {
+        auto floatOps = layers;
+        floatOps.erase(name);
+        std::map<std::string, float> costs;
+        LayerInfo info;
+        info.name     = name;
+        info.distance = runMixedModel(floatOps, costs);
+        // Only this layer is int8, so all the FloatToInt8 / Int8ToFloat ops inserted by _insertDequantize serve it
+        float convertCost = 0.0f;
+        for (auto& iter : costs) {
+            if (iter.first.find("___FloatToInt8___") != std::string::npos ||
+                iter.first.find("___Int8ToFloat___") != std::string::npos) {
+                convertCost += iter.second;
+            }
+        }
+        info.speedup = floatCosts[name] - costs[name] - convertCost;
+        MNN_PRINT("%s: distance %f, fp32 %.1f us, int8 %.1f us, convert %.1f us\n", name.c_str(), info.distance,
+                  floatCosts[name] / imageNum, costs[name] / imageNum, convertCost / imageNum);
+        if (info.speedup <= 0.0f) {
+            // Slower in int8, keep it float
+            continue;
+        }
+        infos.emplace_back(info);
+    }
+
+    // Prefer the layers that give more speedup for less error, the sum of the errors is the first estimation
+    std::sort(infos.begin(), infos.end(), [](const LayerInfo& a, const LayerInfo& b) {
+        return a.speedup / (a.distance + 1e-6f) > b.speedup / (b.distance + 1e-6f);
+    });
+    std::vector<std::string> quantizeLayers;
+    float estimation = 0.0f;
+    for (auto& info : infos) {
+        if (estimation + info.distance > _mixedPrecisionMaxDistance) {
+            continue;
+        }
+        estimation += info.distance;
+        quantizeLayers.emplace_back(info.name);
+    }
+    // Check the whole model, give up the least profitable layers until it meets the budget
+    while (!quantizeLayers.empty()) {
+        auto floatOps = layers;
+        for (auto& name : quantizeLayers) {
+            floatOps.erase(name);
+        }
+        std::map<std::string, float> costs;
+        auto distance = runMixedModel(floatOps, costs);
+        MNN_PRINT("Quantize %d / %d layers, distance: %f\n", (int)quantizeLayers.size(), (int)layers.size(),
+                  distance);
+        if (distance <= _mixedPrecisionMaxDistance) {
+            for (auto& name : floatOps) {
+                MNN_PRINT("Keep float: %s\n", name.c_str());
+            }
+            return floatOps;
+        }
+        quantizeLayers.pop_back();
+    }
+    MNN_ERROR("Can't meet mixed_precision_max_distance %f with any int8 layer\n", _mixedPrecisionMaxDistance);
+    return layers;
 }
+
 void Calibration::runQuantizeModel() {
     if (_featureQuantizeMethod == "KL") {
-        _computeFeatureScaleKL();
+        _computeFeatureScale(false);
     } else if (_featureQuantizeMethod == "ADMM") {
-        _computeFeatureScaleADMM();
+        _computeFeatureScale(true);
+    }
+    _propagateScales();
+    _computeZeroPoints();
+    std::set<std::string> floatOps;
+    if (_mixedPrecisionMaxDistance > 0.0f) {
+        floatOps = _searchMixedPrecision();
     }
-    _updateScale();
-    _insertDequantize();
+    _updateScale(_originaleModel, floatOps);
+    _insertDequantize(_originaleModel);
 }
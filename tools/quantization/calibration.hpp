@@ -9,7 +9,9 @@
 #ifndef CALIBRATION_HPP
 #define CALIBRATION_HPP
 
+#include <functional>
 #include <map>
+#include <set>
 
 #include <MNN/ImageProcess.hpp>
 #include <MNN/Interpreter.hpp>
@@ -32,7 +34,7 @@ public:
 private:
     Calibration();
     MNN::NetT* _originaleModel;
-    std::shared_ptr<MNN::CV::ImageProcess> _process;
+    MNN::CV::ImageProcess::Config _processConfig;
     const int _binNums = 2048;
     int _imageNum      = 0;
     int _width;
@@ -48,6 +50,11 @@ private:
 
     // The scale results
     std::map<const MNN::Tensor*, std::vector<float>> _scales;
+    // Concat / Interp computed in int8, they don't change the scale
+    std::set<std::string> _int8PassOps;
+    // The zero points of asymmetric quantized tensors, int8 = round(float / scale) + zeroPoint
+    std::map<const MNN::Tensor*, int> _zeroPoints;
+    bool _featureQuantizeAsymmetric = false;
 
     std::shared_ptr<MNN::Interpreter> _interpreter;
     // keep mnn forward information
@@ -55,21 +62,54 @@ private:
     MNN::Tensor* _inputTensor;
     std::vector<int> _inputTensorDims;
 
+    // Every calibration thread runs its own session, worker 0 is the session above
+    struct Worker {
+        std::shared_ptr<MNN::Interpreter> interpreter;
+        MNN::Session* session    = nullptr;
+        MNN::Tensor* inputTensor = nullptr;
+        std::shared_ptr<MNN::CV::ImageProcess> process;
+        // Statistic of this session's tensors
+        std::map<const MNN::Tensor*, std::shared_ptr<TensorStatistic>> featureInfo;
+        // The same statistic, keyed by worker 0's tensors
+        std::map<const MNN::Tensor*, std::shared_ptr<TensorStatistic>> mainFeatureInfo;
+    };
+    std::vector<Worker> _workers;
+    int _threadNum = 1;
+
+    // Mixed precision: the max cosine distance of the outputs to fp32's, 0 means quantize all the layers
+    float _mixedPrecisionMaxDistance = 0.0f;
+    int _mixedPrecisionImageNum      = 10;
+
     std::string _featureQuantizeMethod = "KL";
     std::string _weightQuantizeMethod  = "MAX_ABS";
 
     void _initMNNSession(const uint8_t* modelBuffer, const int bufferSize, const int channels);
     void _initMaps();
 
+    // Feed every image to one of the workers, the workers run in parallel
+    void _runImages(const char* title, const std::function<void(Worker&, const std::string&)>& function);
     void _computeFeatureMapsRange();
     void _collectFeatureMapsDistribution();
-    void _computeFeatureScaleKL();
-    void _computeFeatureScaleADMM();
-    void _updateScale();
+    void _computeFeatureScale(bool admm);
+    // Whether op can be computed in int8: Concat / Interp / Pooling / Binary add and mul
+    bool _supportInt8(const MNN::OpT* op) const;
+    // Concat / Interp / Pooling keep the scale, so their inputs and outputs use the same (max) scale
+    void _propagateScales();
+    // Use [-128, 127] for the non-negative tensors that only connect to the ops support zero point
+    void _computeZeroPoints();
+    int _zeroPoint(const MNN::Tensor* tensor) const;
+    // quantize the Convolution / Eltwise ops of model, except floatOps
+    void _updateScale(MNN::NetT* model, const std::set<std::string>& floatOps);
 
     // insert the dequantization op before the not supported op(int8), and insert dequantization op
     // after the output op, so that get original float data conveniently
-    void _insertDequantize();
+    void _insertDequantize(MNN::NetT* model);
+
+    // Run model on the first images, get the outputs of every image and the cost (us) of every op
+    void _runModel(const MNN::NetT* model, std::vector<std::vector<float>>& outputs,
+                   std::map<std::string, float>& opCosts);
+    // Quantize one layer at a time to measure its error and speedup, then choose the layers kept as float
+    std::set<std::string> _searchMixedPrecision();
 };
 
 #endif // CALIBRATION_HPP
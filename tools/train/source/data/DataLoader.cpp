@@ -7,6 +7,11 @@
 //
 
 #include "DataLoader.hpp"
+#include <algorithm>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#include "Dataset.hpp"
 #include "LambdaTransform.hpp"
 #include "RandomSampler.hpp"
 #include "Sampler.hpp"
@@ -21,17 +26,201 @@ DataLoader::DataLoader(std::shared_ptr<BatchDataset> dataset, std::shared_ptr<Sa
     mDataset = dataset;
     mSampler = sampler;
     mConfig  = config;
+    if (mConfig->ringSize > 0) {
+        if (_initRing()) {
+            _startRing();
+        }
+        return;
+    }
     if (mConfig->numJobs > 0) {
         mJobs      = std::make_shared<BlockingQueue<Job>>(mConfig->numJobs);
         mDataQueue = std::make_shared<BlockingQueue<std::vector<Example>>>(mConfig->numJobs);
         prefetch(mConfig->numJobs);
         for (int i = 0; i < mConfig->numWorkers; i++) {
-            mWorkers.emplace_back([&] { workerThread(); });
+            mWorkers.emplace_back([this, i] {
+                _pinThread(i);
+                workerThread();
+            });
+        }
+    }
+}
+
+void DataLoader::_pinThread(int index) {
+#ifdef __linux__
+    if (!mConfig->pinThreads) {
+        return;
+    }
+    // The worker inherits the affinity of the thread creating the loader
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (0 != sched_getaffinity(0, sizeof(mask), &mask)) {
+        return;
+    }
+    std::vector<int> cpus;
+    for (int i = 0; i < CPU_SETSIZE; ++i) {
+        if (CPU_ISSET(i, &mask)) {
+            cpus.emplace_back(i);
+        }
+    }
+    if (cpus.size() <= 1) {
+        return;
+    }
+    // The first cpu is left to the main thread, which runs the training and consumes the batches
+    int cpu = cpus[1 + index % (cpus.size() - 1)];
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    if (0 != sched_setaffinity(0, sizeof(mask), &mask)) {
+        MNN_PRINT("Can't pin the worker %d of DataLoader to cpu %d\n", index, cpu);
+    }
+#endif
+}
+
+std::vector<size_t> DataLoader::_nextIndices() {
+    auto batchIndices = mSampler->next(mConfig->batchSize);
+    if (mConfig->dropLast && batchIndices.size() < mConfig->batchSize) {
+        return {};
+    }
+    return batchIndices;
+}
+
+bool DataLoader::_initRing() {
+    if (mDataset->size() == 0) {
+        MNN_ERROR("Can't create the batch ring of DataLoader for empty dataset\n");
+        return false;
+    }
+    // The slots are allocated by the shape of the first sample, all samples should have the same size
+    auto samples = mDataset->getBatch({0});
+    if (samples.size() != 1) {
+        MNN_ERROR("The dataset should not be stacked for the batch ring of DataLoader\n");
+        return false;
+    }
+    int batch     = (int)mConfig->batchSize;
+    auto allocate = [batch](const std::vector<VARP>& samples, std::vector<VARP>& vars, std::vector<uint8_t*>& ptrs,
+                            std::vector<size_t>& bytes) {
+        for (auto& sample : samples) {
+            auto info = sample->getInfo();
+            if (nullptr == info) {
+                return false;
+            }
+            std::vector<int> dim = {batch};
+            dim.insert(dim.end(), info->dim.begin(), info->dim.end());
+            auto var = _Input(dim, info->order, info->type);
+            vars.emplace_back(var);
+            ptrs.emplace_back(var->writeMap<uint8_t>());
+            bytes.emplace_back(info->size * info->type.bytes());
+        }
+        return true;
+    };
+    mSlots.resize(std::max(mConfig->ringSize, (size_t)2));
+    for (auto& slot : mSlots) {
+        if (!allocate(samples[0].first, slot.data, slot.buffer.data, slot.buffer.dataBytes) ||
+            !allocate(samples[0].second, slot.target, slot.buffer.target, slot.buffer.targetBytes)) {
+            MNN_ERROR("Can't compute the sample shape for the batch ring of DataLoader\n");
+            mSlots.clear();
+            return false;
         }
     }
+    return true;
+}
+
+void DataLoader::_startRing() {
+    mSubmitted = 0;
+    mReceived  = 0;
+    mRingWorkers.resize(mConfig->numWorkers);
+    for (auto& worker : mRingWorkers) {
+        // At most mSlots.size() - 1 jobs are running, the queues never block the producer
+        worker.jobs = std::make_shared<SPSCQueue<Job>>(mSlots.size());
+        worker.done = std::make_shared<SPSCQueue<Job>>(mSlots.size());
+    }
+    for (int i = 0; i < mRingWorkers.size(); i++) {
+        mWorkers.emplace_back([this, i] { _ringWorkerThread(i); });
+    }
+    _ringPrefetch();
+}
+
+void DataLoader::_ringWorkerThread(int index) {
+    _pinThread(index);
+    auto& worker = mRingWorkers[index];
+    while (true) {
+        auto job = worker.jobs->pop();
+        if (job.quit) {
+            break;
+        }
+        job.success = mDataset->getBatchTo(job.job, mSlots[job.slot].buffer);
+        worker.done->push(std::move(job));
+    }
+}
+
+void DataLoader::_ringPrefetch() {
+    if (mRingWorkers.empty()) {
+        return;
+    }
+    // The slot used by the batch returned last time is not reused until next() is called again
+    while (mSubmitted + 1 < mReceived + mSlots.size()) {
+        Job job;
+        job.job = _nextIndices();
+        if (job.job.empty()) {
+            break;
+        }
+        job.slot = mSubmitted % mSlots.size();
+        mRingWorkers[mSubmitted % mRingWorkers.size()].jobs->push(std::move(job));
+        mSubmitted++;
+    }
+}
+
+std::vector<Example> DataLoader::_ringNext() {
+    if (mSlots.empty()) {
+        MNN_ERROR("The batch ring of DataLoader is not created\n");
+        return {};
+    }
+    Job job;
+    if (mRingWorkers.empty()) {
+        job.job  = _nextIndices();
+        job.slot = mReceived % mSlots.size();
+        if (!job.job.empty()) {
+            job.success = mDataset->getBatchTo(job.job, mSlots[job.slot].buffer);
+        }
+    } else if (mReceived < mSubmitted) {
+        job = mRingWorkers[mReceived % mRingWorkers.size()].done->pop();
+    }
+    if (job.job.empty()) {
+        MNN_ASSERT(false); // the sampler is exhausted, should reset the data loader
+        return {};
+    }
+    mReceived++;
+    _ringPrefetch();
+    if (!job.success) {
+        MNN_ERROR("Can't write the batch into the ring of DataLoader, the samples should have the same size\n");
+        return {};
+    }
+    int number  = (int)job.job.size();
+    auto output = [&](const std::vector<VARP>& vars) {
+        std::vector<VARP> result;
+        for (auto& var : vars) {
+            if (number == mConfig->batchSize) {
+                // Inform the exprs using the slot that its content is changed
+                var->writeMap<void>();
+                result.emplace_back(var);
+                continue;
+            }
+            // The last batch is smaller than the slot
+            auto info = var->getInfo();
+            auto dim  = info->dim;
+            dim[0]    = number;
+            result.emplace_back(_Const(var->readMap<void>(), dim, info->order, info->type));
+        }
+        return result;
+    };
+    Example example;
+    example.first  = output(mSlots[job.slot].data);
+    example.second = output(mSlots[job.slot].target);
+    return {example};
 }
 
 std::vector<Example> DataLoader::next() {
+    if (mConfig->ringSize > 0) {
+        return _ringNext();
+    }
     if (mConfig->numWorkers == 0) {
         auto batchIndices = mSampler->next(mConfig->batchSize);
         MNN_ASSERT(batchIndices.size() != 0); // the sampler is exhausted, should reset the data loader
@@ -77,6 +266,22 @@ void DataLoader::workerThread() {
 }
 
 void DataLoader::join() {
+    if (!mRingWorkers.empty()) {
+        for (auto& worker : mRingWorkers) {
+            Job j;
+            j.quit = true;
+            worker.jobs->push(std::move(j));
+        }
+        for (auto& worker : mWorkers) {
+            worker.join();
+        }
+        mWorkers.clear();
+        mRingWorkers.clear();
+        return;
+    }
+    if (nullptr == mJobs) {
+        return;
+    }
     for (int i = 0; i < mConfig->numWorkers; i++) {
         Job j;
         j.quit = true;
@@ -90,16 +295,25 @@ void DataLoader::join() {
 void DataLoader::reset() {
     clean();
 
+    if (!mSlots.empty()) {
+        _startRing();
+        return;
+    }
     if (mConfig->numWorkers > 0) {
         prefetch(mConfig->numJobs);
         for (int i = 0; i < mConfig->numWorkers; i++) {
-            mWorkers.emplace_back([&] { workerThread(); });
+            mWorkers.emplace_back([this, i] {
+                _pinThread(i);
+                workerThread();
+            });
         }
     }
 }
 
 void DataLoader::clean() {
-    if (mJobs != nullptr) {
+    if (!mSlots.empty()) {
+        join();
+    } else if (mJobs != nullptr) {
         join();
         mWorkers.clear();
         mJobs->clear();
@@ -160,6 +374,16 @@ DataLoader* DataLoader::makeDataLoader(std::shared_ptr<BatchDataset> dataset,
     auto config  = std::make_shared<DataLoaderConfig>(batchSize, numWorkers);
     return new DataLoader(transDataset, sampler, config);
 }
+DataLoader* DataLoader::makeDataLoader(std::shared_ptr<BatchDataset> dataset,
+                                       std::shared_ptr<DataLoaderConfig> config,
+                                       const bool shuffle) {
+    auto sampler = std::make_shared<RandomSampler>(dataset->size(), shuffle);
+    if (config->ringSize > 0) {
+        return new DataLoader(dataset, sampler, config);
+    }
+    auto transDataset = std::make_shared<BatchTransformDataset>(dataset, std::make_shared<StackTransform>());
+    return new DataLoader(transDataset, sampler, config);
+}
 
 } // namespace Train
 } // namespace MNN
@@ -15,6 +15,7 @@
 #include "BlockingQueue.hpp"
 #include "DataLoaderConfig.hpp"
 #include "Example.hpp"
+#include "SPSCQueue.hpp"
 namespace MNN {
 namespace Train {
 class BatchDataset;
@@ -59,18 +60,52 @@ public:
                                       const int batchSize,
                                       const bool shuffle = true,
                                       const int numWorkers = 0);
+    /*
+     The samples of dataset are stacked as one example per batch, if config->ringSize > 0 they are written into the
+     preallocated batches by the workers directly, otherwise by StackTransform
+     */
+    static DataLoader* makeDataLoader(std::shared_ptr<BatchDataset> dataset,
+                                      std::shared_ptr<DataLoaderConfig> config,
+                                      const bool shuffle = true);
 
 private:
     struct Job {
         std::vector<size_t> job;
-        bool quit = false;
+        int slot     = 0;
+        bool success = false;
+        bool quit    = false;
+    };
+    // A preallocated batch of the ring
+    struct Slot {
+        std::vector<VARP> data;
+        std::vector<VARP> target;
+        BatchBuffer buffer;
     };
+    // Each worker of ring has its own queues, so the jobs are handed off without lock
+    struct RingWorker {
+        std::shared_ptr<SPSCQueue<Job>> jobs;
+        std::shared_ptr<SPSCQueue<Job>> done;
+    };
+    void _pinThread(int index);
+    std::vector<size_t> _nextIndices();
+    bool _initRing();
+    void _startRing();
+    void _ringWorkerThread(int index);
+    void _ringPrefetch();
+    std::vector<Example> _ringNext();
+
     std::shared_ptr<BatchDataset> mDataset;
     std::shared_ptr<Sampler> mSampler;
     std::shared_ptr<DataLoaderConfig> mConfig;
     std::shared_ptr<BlockingQueue<Job>> mJobs;
     std::shared_ptr<BlockingQueue<std::vector<Example>>> mDataQueue;
     std::vector<std::thread> mWorkers;
+
+    std::vector<Slot> mSlots;
+    std::vector<RingWorker> mRingWorkers;
+    // Job k is run by worker k % mRingWorkers.size() into slot k % mSlots.size()
+    size_t mSubmitted = 0;
+    size_t mReceived  = 0;
 };
 
 } // namespace Train
@@ -22,6 +22,12 @@ public:
     size_t numWorkers = 0;
     size_t numJobs    = numWorkers * 2;
     bool dropLast     = false;
+    // Number of preallocated batches, if > 0 the samples are written into them directly instead of StackTransform,
+    // and a batch returned by DataLoader::next is valid until the next call
+    size_t ringSize   = 0;
+    // Pin the worker threads to different cpus, except the first allowed one kept for the training thread,
+    // only for Linux / Android
+    bool pinThreads   = false;
 };
 
 } // namespace Train
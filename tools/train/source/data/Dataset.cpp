@@ -7,9 +7,48 @@
 //
 
 #include "Dataset.hpp"
+#include <string.h>
 namespace MNN {
 namespace Train {
 
+static bool _copyTo(const std::vector<VARP>& vars, const std::vector<uint8_t*>& dst, const std::vector<size_t>& bytes,
+                    size_t position) {
+    if (vars.size() != dst.size()) {
+        return false;
+    }
+    for (int i = 0; i < vars.size(); ++i) {
+        auto info = vars[i]->getInfo();
+        auto ptr  = vars[i]->readMap<void>();
+        if (nullptr == info || nullptr == ptr || info->size * info->type.bytes() != bytes[i]) {
+            return false;
+        }
+        ::memcpy(dst[i] + position * bytes[i], ptr, bytes[i]);
+    }
+    return true;
+}
+
+static bool _copyTo(const Example& example, const BatchBuffer& buffer, size_t position) {
+    return _copyTo(example.first, buffer.data, buffer.dataBytes, position) &&
+           _copyTo(example.second, buffer.target, buffer.targetBytes, position);
+}
+
+bool BatchDataset::getBatchTo(const std::vector<size_t>& indices, const BatchBuffer& buffer) {
+    auto batch = getBatch(indices);
+    if (batch.size() != indices.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!_copyTo(batch[i], buffer, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Dataset::getTo(size_t index, const BatchBuffer& buffer, size_t position) {
+    return _copyTo(get(index), buffer, position);
+}
+
 DataLoader* DatasetPtr::createLoader(const int batchSize, const bool stack, const bool shuffle, const int numWorkers) {
     return DataLoader::makeDataLoader(mDataset, batchSize, stack, shuffle, numWorkers);
 }
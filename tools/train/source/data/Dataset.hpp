@@ -39,6 +39,9 @@ public:
     // get batch using given indices
     virtual std::vector<Example> getBatch(std::vector<size_t> indices) = 0;
 
+    // write the samples of given indices into the buffer, return false if the size of a sample doesn't match
+    virtual bool getBatchTo(const std::vector<size_t>& indices, const BatchBuffer& buffer);
+
     // size of the dataset
     virtual size_t size() = 0;
 };
@@ -48,6 +51,18 @@ public:
     // return a specific example with given index
     virtual Example get(size_t index) = 0;
 
+    // write a specific example as the sample 'position' of the buffer, decode into it directly if possible
+    virtual bool getTo(size_t index, const BatchBuffer& buffer, size_t position);
+
+    bool getBatchTo(const std::vector<size_t>& indices, const BatchBuffer& buffer) override {
+        for (size_t i = 0; i < indices.size(); ++i) {
+            if (!getTo(indices[i], buffer, i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     std::vector<Example> getBatch(std::vector<size_t> indices) {
         std::vector<Example> batch;
         batch.reserve(indices.size());
@@ -23,6 +23,17 @@ namespace Train {
  */
 typedef std::pair<std::vector<VARP>, std::vector<VARP>> Example;
 
+/**
+ Preallocated memory of a stacked batch, the sample i of data j is at data[j] + i * dataBytes[j],
+ the same for target
+ */
+struct BatchBuffer {
+    std::vector<uint8_t*> data;
+    std::vector<size_t> dataBytes;
+    std::vector<uint8_t*> target;
+    std::vector<size_t> targetBytes;
+};
+
 } // namespace Train
 } // namespace MNN
 
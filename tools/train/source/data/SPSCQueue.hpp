@@ -0,0 +1,122 @@
+//
+//  SPSCQueue.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/16.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef SPSCQueue_hpp
+#define SPSCQueue_hpp
+#include <MNN/MNNDefine.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MNN {
+namespace Train {
+
+/**
+ Lock-free bounded queue for one producer thread and one consumer thread.
+ The producer only writes mTail and the consumer only writes mHead, so the handoff needs no lock.
+ push / pop spin with yield a while when the queue is full / empty, then block on a condition variable, which is
+ only signaled when the other side is blocked.
+ */
+template <typename T>
+class SPSCQueue {
+public:
+    SPSCQueue(size_t maxSize) : mBuffer(maxSize + 1) {
+    }
+
+    bool tryPush(T& value) {
+        auto tail = mTail.load(std::memory_order_relaxed);
+        auto next = tail + 1 == mBuffer.size() ? 0 : tail + 1;
+        if (next == mHead.load(std::memory_order_acquire)) {
+            return false;
+        }
+        mBuffer[tail] = std::move(value);
+        mTail.store(next, std::memory_order_release);
+        _notify();
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        auto head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(mBuffer[head]);
+        mHead.store(head + 1 == mBuffer.size() ? 0 : head + 1, std::memory_order_release);
+        _notify();
+        return true;
+    }
+
+    void push(T value) {
+        for (int i = 0; !tryPush(value); ++i) {
+            _wait(i, [this]() {
+                auto tail = mTail.load(std::memory_order_relaxed);
+                auto next = tail + 1 == mBuffer.size() ? 0 : tail + 1;
+                return next != mHead.load(std::memory_order_acquire);
+            });
+        }
+    }
+
+    T pop() {
+        T value;
+        for (int i = 0; !tryPop(value); ++i) {
+            _wait(i, [this]() {
+                return mHead.load(std::memory_order_relaxed) != mTail.load(std::memory_order_acquire);
+            });
+        }
+        return value;
+    }
+
+    // Only call it when the producer and consumer are both stopped
+    void clear() {
+        mHead.store(0);
+        mTail.store(0);
+        for (auto& v : mBuffer) {
+            v = T();
+        }
+    }
+
+private:
+    static constexpr int kSpinNumber = 256;
+    template <typename Ready>
+    void _wait(int i, Ready&& ready) {
+        if (i < kSpinNumber) {
+            std::this_thread::yield();
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWaiting.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        mCondition.wait(lock, ready);
+        mWaiting.fetch_sub(1);
+    }
+    void _notify() {
+        // Order the index store before reading mWaiting, pairs with the fetch_add of _wait
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (mWaiting.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mCondition.notify_all();
+        }
+    }
+    std::vector<T> mBuffer;
+    // Keep the indexes in different cache lines, they are written by different threads
+    std::atomic<size_t> mHead{0};
+    char mPadding[64];
+    std::atomic<size_t> mTail{0};
+    char mPadding2[64];
+    // Only used after spinning, the side blocked is waked by the other one
+    std::atomic<int> mWaiting{0};
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+};
+
+} // namespace Train
+} // namespace MNN
+
+#endif // SPSCQueue_hpp
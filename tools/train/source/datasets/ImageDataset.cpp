@@ -108,13 +108,49 @@ void ImageDataset::getAllDataAndLabelsFromTxt(const std::string pathToImages, st
     txtFile.close();
 }
 
+bool ImageDataset::getTo(size_t index, const BatchBuffer& buffer, size_t position) {
+    if (mReadAllToMemory) {
+        return Dataset::getTo(index, buffer, position);
+    }
+    auto& txtLabels = mAllTxtLines[index].second;
+    if (buffer.data.size() != 1 || buffer.target.size() != 1 ||
+        buffer.targetBytes[0] != txtLabels.size() * sizeof(int32_t)) {
+        return false;
+    }
+    // decode into the batch directly
+    auto dataBytes = buffer.dataBytes[0];
+    auto dst       = buffer.data[0] + position * dataBytes;
+    bool success   = convertImageTo(mAllTxtLines[index].first, mConfig, mProcessConfig, [&](int oh, int ow, int bpp) {
+        return oh * ow * bpp * sizeof(float) == dataBytes ? (float*)dst : nullptr;
+    });
+    if (!success) {
+        return false;
+    }
+    auto labels = (int32_t*)(buffer.target[0] + position * buffer.targetBytes[0]);
+    for (int j = 0; j < txtLabels.size(); j++) {
+        labels[j] = txtLabels[j];
+    }
+    return true;
+}
+
 VARP ImageDataset::convertImage(const std::string& imageName, const ImageConfig& mConfig, const MNN::CV::ImageProcess::Config& mProcessConfig) {
+    VARP data;
+    convertImageTo(imageName, mConfig, mProcessConfig, [&](int oh, int ow, int bpp) {
+        data = _Input({oh, ow, bpp}, NHWC, halide_type_of<float>());
+        return data->writeMap<float>();
+    });
+    return data;
+}
+
+bool ImageDataset::convertImageTo(const std::string& imageName, const ImageConfig& mConfig,
+                                  const MNN::CV::ImageProcess::Config& mProcessConfig,
+                                  const std::function<float*(int, int, int)>& allocate) {
     int originalWidth, originalHeight, comp;
     auto bitmap32bits = stbi_load(imageName.c_str(), &originalWidth, &originalHeight, &comp, 4);
     if (bitmap32bits == nullptr) {
         MNN_PRINT("can not open image: %s\n", imageName.c_str());
         MNN_ASSERT(false);
-        return nullptr;
+        return false;
     }
     
     // choose resize or crop
@@ -192,11 +228,15 @@ VARP ImageDataset::convertImage(const std::string& imageName, const ImageConfig&
         }
     }
 
-    auto data      = _Input({oh, ow, bpp}, NHWC, halide_type_of<float>());
-    process->convert(bitmap32bits, originalWidth, originalHeight, 0, data->writeMap<float>(), ow, oh, bpp, ow * bpp,
+    auto dst = allocate(oh, ow, bpp);
+    if (nullptr == dst) {
+        stbi_image_free(bitmap32bits);
+        return false;
+    }
+    process->convert(bitmap32bits, originalWidth, originalHeight, 0, dst, ow, oh, bpp, ow * bpp,
                       halide_type_of<float>());
     stbi_image_free(bitmap32bits);
-    return data;
+    return true;
 }
 
 std::pair<VARP, VARP> ImageDataset::getDataAndLabelsFrom(std::pair<std::string, std::vector<int> > dataAndLabels) {
@@ -9,6 +9,7 @@
 #ifndef ImageDataset_hpp
 #define ImageDataset_hpp
 
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -66,6 +67,8 @@ public:
 
     Example get(size_t index) override;
 
+    bool getTo(size_t index, const BatchBuffer& buffer, size_t position) override;
+
     size_t size() override;
 
 private:
@@ -78,6 +81,10 @@ private:
 
     void getAllDataAndLabelsFromTxt(const std::string pathToImages, std::string pathToImageTxt);
     std::pair<VARP, VARP> getDataAndLabelsFrom(std::pair<std::string, std::vector<int> > dataAndLabels);
+    // decode the image into the memory returned by allocate(height, width, bpp), which may return nullptr
+    static bool convertImageTo(const std::string& imageName, const ImageConfig& config,
+                               const MNN::CV::ImageProcess::Config& cvConfig,
+                               const std::function<float*(int, int, int)>& allocate);
 };
 } // namespace Train
 } // namespace MNN
@@ -130,6 +130,18 @@ Example MnistDataset::get(size_t index) {
     return {{data, returnIndex}, {label}};
 }
 
+bool MnistDataset::getTo(size_t index, const BatchBuffer& buffer, size_t position) {
+    const int imageBytes = kImageRows * kImageColumns;
+    if (buffer.data.size() != 2 || buffer.dataBytes[0] != imageBytes || buffer.dataBytes[1] != sizeof(float) ||
+        buffer.target.size() != 1 || buffer.targetBytes[0] != 1) {
+        return false;
+    }
+    ::memcpy(buffer.data[0] + position * imageBytes, mImagePtr + index * imageBytes, imageBytes);
+    ((float*)buffer.data[1])[position] = (float)index;
+    buffer.target[0][position]         = mLabelsPtr[index];
+    return true;
+}
+
 size_t MnistDataset::size() {
     return mImages->getInfo()->dim[0];
 }
@@ -21,6 +21,8 @@ public:
 
     Example get(size_t index) override;
 
+    bool getTo(size_t index, const BatchBuffer& buffer, size_t position) override;
+
     size_t size() override;
 
     const VARP images();
@@ -0,0 +1,489 @@
+//
+//  RecordDataset.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/17.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "RecordDataset.hpp"
+#if defined(_MSC_VER)
+#include <Windows.h>
+#undef min
+#undef max
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include "stb_image.h"
+
+namespace MNN {
+namespace Train {
+
+static const char* kRecordMagic     = "MNNR";
+static const uint32_t kVersion      = 1;
+static const uint64_t kRecordAlign  = 64;
+static const uint64_t kPayloadAlign = 16;
+static const int kMaxDims           = 8;
+
+enum FieldEncoding {
+    RAW   = 0,
+    IMAGE = 1,
+};
+
+struct RecordHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    uint64_t indexOffset;
+    uint64_t reserved;
+};
+
+struct FieldHeader {
+    uint32_t encoding;
+    // halide type: code | bits << 8 | lanes << 16, for IMAGE it is uint8 and dims[0] is the channels
+    uint32_t type;
+    uint32_t order;
+    uint32_t dimSize;
+    int32_t dims[kMaxDims];
+    uint64_t bytes;
+};
+
+static uint64_t _align(uint64_t size, uint64_t align) {
+    return (size + align - 1) / align * align;
+}
+
+// record: uint32 dataNumber, uint32 targetNumber, then FieldHeader and payload aligned to kPayloadAlign for each field
+struct RecordWriter::Field {
+    FieldHeader header;
+    const void* ptr;
+};
+
+RecordWriter::RecordWriter(const std::string& prefix, size_t recordsPerShard) {
+    mPrefix          = prefix;
+    mRecordsPerShard = std::max(recordsPerShard, (size_t)1);
+}
+
+RecordWriter::~RecordWriter() {
+    finish();
+}
+
+std::string RecordWriter::shardName(const std::string& prefix, int index) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "-%05d.rec", index);
+    return prefix + buffer;
+}
+
+bool RecordWriter::_fillFields(const std::vector<VARP>& vars, std::vector<Field>& fields) {
+    for (auto& var : vars) {
+        auto info = var->getInfo();
+        auto ptr  = var->readMap<void>();
+        if (nullptr == info || nullptr == ptr || info->dim.size() > kMaxDims) {
+            MNN_ERROR("Can't write variable %s to record\n", var->name().c_str());
+            return false;
+        }
+        Field field;
+        ::memset(&field.header, 0, sizeof(FieldHeader));
+        field.header.encoding = RAW;
+        field.header.type     = info->type.code | (info->type.bits << 8) | (info->type.lanes << 16);
+        field.header.order    = info->order;
+        field.header.dimSize  = (uint32_t)info->dim.size();
+        for (int i = 0; i < info->dim.size(); ++i) {
+            field.header.dims[i] = info->dim[i];
+        }
+        field.header.bytes = info->size * info->type.bytes();
+        field.ptr          = ptr;
+        fields.emplace_back(field);
+    }
+    return true;
+}
+
+bool RecordWriter::write(const Example& example) {
+    std::vector<Field> fields;
+    if (!_fillFields(example.first, fields) || !_fillFields(example.second, fields)) {
+        return false;
+    }
+    return _write(fields, (int)example.first.size());
+}
+
+bool RecordWriter::writeImage(const std::string& encoded, int channels, const std::vector<VARP>& target) {
+    std::vector<Field> fields(1);
+    ::memset(&fields[0].header, 0, sizeof(FieldHeader));
+    fields[0].header.encoding = IMAGE;
+    fields[0].header.type     = halide_type_uint | (8 << 8) | (1 << 16);
+    fields[0].header.order    = NHWC;
+    fields[0].header.dimSize  = 1;
+    fields[0].header.dims[0]  = channels;
+    fields[0].header.bytes    = encoded.size();
+    fields[0].ptr             = encoded.data();
+    if (!_fillFields(target, fields)) {
+        return false;
+    }
+    return _write(fields, 1);
+}
+
+bool RecordWriter::_write(const std::vector<Field>& fields, int dataNumber) {
+    if (!mFile.is_open()) {
+        auto name = shardName(mPrefix, (int)mShards.size());
+        mFile.open(name, std::ios::binary | std::ios::trunc);
+        if (!mFile.is_open()) {
+            MNN_ERROR("Can't open %s for writing records\n", name.c_str());
+            return false;
+        }
+        mShards.emplace_back(name);
+        RecordHeader header;
+        ::memset(&header, 0, sizeof(RecordHeader));
+        mFile.write((const char*)&header, sizeof(RecordHeader));
+        mOffset = sizeof(RecordHeader);
+        mIndex.clear();
+    }
+    static const char zeros[kRecordAlign] = {0};
+    auto start = _align(mOffset, kRecordAlign);
+    mFile.write(zeros, start - mOffset);
+    uint32_t numbers[2] = {(uint32_t)dataNumber, (uint32_t)(fields.size() - dataNumber)};
+    mFile.write((const char*)numbers, sizeof(numbers));
+    uint64_t size = sizeof(numbers);
+    for (auto& field : fields) {
+        mFile.write((const char*)&field.header, sizeof(FieldHeader));
+        size += sizeof(FieldHeader);
+        auto payload = _align(start + size, kPayloadAlign) - start;
+        mFile.write(zeros, payload - size);
+        mFile.write((const char*)field.ptr, field.header.bytes);
+        size = payload + field.header.bytes;
+    }
+    if (!mFile.good()) {
+        MNN_ERROR("Write record to %s failed\n", mShards.back().c_str());
+        return false;
+    }
+    mIndex.emplace_back(start);
+    mIndex.emplace_back(size);
+    mOffset = start + size;
+    if (mIndex.size() / 2 >= mRecordsPerShard) {
+        return _finishShard();
+    }
+    return true;
+}
+
+bool RecordWriter::_finishShard() {
+    RecordHeader header;
+    ::memcpy(header.magic, kRecordMagic, 4);
+    header.version     = kVersion;
+    header.count       = mIndex.size() / 2;
+    header.indexOffset = mOffset;
+    header.reserved    = 0;
+    mFile.write((const char*)mIndex.data(), mIndex.size() * sizeof(uint64_t));
+    mFile.seekp(0);
+    mFile.write((const char*)&header, sizeof(RecordHeader));
+    mFile.close();
+    mIndex.clear();
+    if (mFile.fail()) {
+        MNN_ERROR("Write index to %s failed\n", mShards.back().c_str());
+        return false;
+    }
+    return true;
+}
+
+bool RecordWriter::finish() {
+    if (!mFile.is_open()) {
+        return true;
+    }
+    return _finishShard();
+}
+
+struct RecordDataset::Shard {
+    ~Shard() {
+#if defined(_MSC_VER)
+        delete[] base;
+#else
+        if (nullptr != base) {
+            munmap((void*)base, size);
+        }
+#endif
+    }
+    bool map(const std::string& name);
+
+    const uint8_t* base = nullptr;
+    uint64_t size       = 0;
+    std::vector<uint64_t> index;
+};
+
+std::vector<std::string> RecordDataset::shardsOf(const std::string& prefix) {
+    std::vector<std::string> shards;
+    while (true) {
+        auto name = RecordWriter::shardName(prefix, (int)shards.size());
+        std::ifstream file(name);
+        if (!file.is_open()) {
+            break;
+        }
+        shards.emplace_back(name);
+    }
+    return shards;
+}
+
+DatasetPtr RecordDataset::create(const std::vector<std::string>& shards) {
+    DatasetPtr result;
+    std::shared_ptr<RecordDataset> dataset(new RecordDataset);
+    dataset->mStarts.emplace_back(0);
+    for (auto& name : shards) {
+        std::shared_ptr<Shard> shard(new Shard);
+        if (!shard->map(name)) {
+            return result;
+        }
+        auto header = (const RecordHeader*)shard->base;
+        if (shard->size < sizeof(RecordHeader) || 0 != ::memcmp(header->magic, kRecordMagic, 4) ||
+            header->version != kVersion || header->indexOffset + header->count * 2 * sizeof(uint64_t) > shard->size) {
+            MNN_ERROR("%s is not a valid record file\n", name.c_str());
+            return result;
+        }
+        auto index = (const uint64_t*)(shard->base + header->indexOffset);
+        shard->index.assign(index, index + header->count * 2);
+        for (int i = 0; i < header->count; ++i) {
+            if (shard->index[2 * i] + shard->index[2 * i + 1] > header->indexOffset) {
+                MNN_ERROR("The index of %s is broken\n", name.c_str());
+                return result;
+            }
+        }
+        dataset->mShards.emplace_back(shard);
+        dataset->mStarts.emplace_back(dataset->mStarts.back() + header->count);
+    }
+    result.mDataset = dataset;
+    return result;
+}
+
+size_t RecordDataset::size() {
+    return mStarts.back();
+}
+
+RecordDataset::Record RecordDataset::_record(size_t index) const {
+    MNN_ASSERT(index < mStarts.back());
+    auto shard = (int)(std::upper_bound(mStarts.begin(), mStarts.end(), index) - mStarts.begin()) - 1;
+    auto local = index - mStarts[shard];
+    auto& item = mShards[shard]->index;
+    return {shard, mShards[shard]->base + item[2 * local], item[2 * local + 1]};
+}
+
+struct FieldView {
+    const FieldHeader* header;
+    const uint8_t* payload;
+};
+
+static halide_type_t _type(uint32_t type) {
+    return halide_type_t((halide_type_code_t)(type & 0xff), (type >> 8) & 0xff, (type >> 16) & 0xffff);
+}
+
+// The header should describe its payload, otherwise the raw field would be read out of the record
+static bool _validField(const FieldHeader* header) {
+    if (header->dimSize > kMaxDims) {
+        return false;
+    }
+    if (IMAGE == header->encoding) {
+        return 1 == header->dimSize && header->dims[0] >= 1 && header->dims[0] <= 4;
+    }
+    auto type = _type(header->type);
+    if (RAW != header->encoding || type.code > halide_type_handle || 0 == type.bits || 0 != type.bits % 8 ||
+        0 == type.lanes) {
+        return false;
+    }
+    uint64_t bytes = type.bytes();
+    for (int i = 0; i < header->dimSize; ++i) {
+        if (header->dims[i] < 0) {
+            return false;
+        }
+        bytes *= (uint64_t)header->dims[i];
+        if (bytes > header->bytes) {
+            return false;
+        }
+    }
+    return bytes == header->bytes;
+}
+
+// Parse the fields of record, return the number of data fields, or -1 if the record is broken
+static int _parse(const uint8_t* record, uint64_t size, std::vector<FieldView>& fields) {
+    if (size < 2 * sizeof(uint32_t)) {
+        return -1;
+    }
+    auto numbers = (const uint32_t*)record;
+    uint64_t offset = 2 * sizeof(uint32_t);
+    uint64_t number = (uint64_t)numbers[0] + (uint64_t)numbers[1];
+    for (uint64_t i = 0; i < number; ++i) {
+        if (offset + sizeof(FieldHeader) > size) {
+            return -1;
+        }
+        FieldView view;
+        view.header = (const FieldHeader*)(record + offset);
+        offset      = _align(offset + sizeof(FieldHeader), kPayloadAlign);
+        if (offset > size || view.header->bytes > size - offset || !_validField(view.header)) {
+            return -1;
+        }
+        view.payload = record + offset;
+        offset += view.header->bytes;
+        fields.emplace_back(view);
+    }
+    return (int)numbers[0];
+}
+
+// Decode the image of field, the result should be freed by stbi_image_free
+static uint8_t* _decode(const FieldView& field, int& height, int& width, int& channels) {
+    int origin;
+    channels    = field.header->dims[0];
+    auto result = stbi_load_from_memory(field.payload, (int)field.header->bytes, &width, &height, &origin, channels);
+    if (nullptr == result) {
+        MNN_ERROR("Can't decode the image of record\n");
+    }
+    return result;
+}
+
+Example RecordDataset::get(size_t index) {
+    auto record = _record(index);
+    std::vector<FieldView> fields;
+    auto dataNumber = _parse(record.ptr, record.size, fields);
+    if (dataNumber < 0) {
+        MNN_ERROR("The record %d is broken\n", (int)index);
+        return {};
+    }
+    Example example;
+    for (int i = 0; i < fields.size(); ++i) {
+        auto header = fields[i].header;
+        VARP var;
+        if (IMAGE == header->encoding) {
+            int height, width, channels;
+            auto image = _decode(fields[i], height, width, channels);
+            if (nullptr == image) {
+                return {};
+            }
+            var = _Input({height, width, channels}, NHWC, halide_type_of<uint8_t>());
+            ::memcpy(var->writeMap<uint8_t>(), image, height * width * channels);
+            stbi_image_free(image);
+        } else {
+            Variable::Info info;
+            info.order = (Dimensionformat)header->order;
+            info.type  = _type(header->type);
+            info.dim.assign(header->dims, header->dims + header->dimSize);
+            // refer to the mapped memory directly
+            var = Variable::create(Expr::create(std::move(info), fields[i].payload, VARP::CONSTANT, false));
+        }
+        if (i < dataNumber) {
+            example.first.emplace_back(var);
+        } else {
+            example.second.emplace_back(var);
+        }
+    }
+    return example;
+}
+
+bool RecordDataset::getTo(size_t index, const BatchBuffer& buffer, size_t position) {
+    auto record = _record(index);
+    std::vector<FieldView> fields;
+    auto dataNumber = _parse(record.ptr, record.size, fields);
+    if (dataNumber != buffer.data.size() || fields.size() != buffer.data.size() + buffer.target.size()) {
+        return false;
+    }
+    for (int i = 0; i < fields.size(); ++i) {
+        auto dst   = i < dataNumber ? buffer.data[i] : buffer.target[i - dataNumber];
+        auto bytes = i < dataNumber ? buffer.dataBytes[i] : buffer.targetBytes[i - dataNumber];
+        dst += position * bytes;
+        if (IMAGE == fields[i].header->encoding) {
+            int height, width, channels;
+            auto image = _decode(fields[i], height, width, channels);
+            if (nullptr == image) {
+                return false;
+            }
+            bool match = height * width * channels == bytes;
+            if (match) {
+                ::memcpy(dst, image, bytes);
+            }
+            stbi_image_free(image);
+            if (!match) {
+                return false;
+            }
+            continue;
+        }
+        if (fields[i].header->bytes != bytes) {
+            return false;
+        }
+        ::memcpy(dst, fields[i].payload, bytes);
+    }
+    return true;
+}
+
+std::vector<Example> RecordDataset::getBatch(std::vector<size_t> indices) {
+    _willNeed(indices);
+    return Dataset::getBatch(indices);
+}
+
+bool RecordDataset::getBatchTo(const std::vector<size_t>& indices, const BatchBuffer& buffer) {
+    _willNeed(indices);
+    return Dataset::getBatchTo(indices, buffer);
+}
+
+#if defined(_MSC_VER)
+bool RecordDataset::Shard::map(const std::string& name) {
+    std::ifstream file(name, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        MNN_ERROR("Can't open record file %s\n", name.c_str());
+        return false;
+    }
+    size        = file.tellg();
+    auto buffer = new uint8_t[size];
+    base        = buffer;
+    file.seekg(0);
+    file.read((char*)buffer, size);
+    return file.good();
+}
+
+void RecordDataset::_willNeed(const std::vector<size_t>& indices) const {
+    // read to memory at once, nothing to do
+}
+#else
+bool RecordDataset::Shard::map(const std::string& name) {
+    int fd = open(name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        MNN_ERROR("Can't open record file %s\n", name.c_str());
+        return false;
+    }
+    struct stat status;
+    if (0 != fstat(fd, &status) || status.st_size <= 0) {
+        MNN_ERROR("Can't get the size of record file %s\n", name.c_str());
+        close(fd);
+        return false;
+    }
+    auto mapped = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping keeps the file referenced
+    close(fd);
+    if (MAP_FAILED == mapped) {
+        MNN_ERROR("Can't map record file %s\n", name.c_str());
+        return false;
+    }
+    base = (const uint8_t*)mapped;
+    size = status.st_size;
+    return true;
+}
+
+void RecordDataset::_willNeed(const std::vector<size_t>& indices) const {
+    // the shuffled records are scattered, ask the system to read them in the order of offset before decoding,
+    // so the disk is read sequentially and overlapped with the copy of the first records
+    std::vector<Record> records;
+    records.reserve(indices.size());
+    for (auto index : indices) {
+        records.emplace_back(_record(index));
+    }
+    std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+        return a.shard < b.shard || (a.shard == b.shard && a.ptr < b.ptr);
+    });
+    static const uint64_t pageSize = sysconf(_SC_PAGESIZE);
+    for (auto& record : records) {
+        auto base  = mShards[record.shard]->base;
+        auto start = (uint64_t)(record.ptr - base) / pageSize * pageSize;
+        auto end   = (uint64_t)(record.ptr - base) + record.size;
+        madvise((void*)(base + start), end - start, MADV_WILLNEED);
+    }
+}
+#endif
+
+} // namespace Train
+} // namespace MNN
@@ -0,0 +1,104 @@
+//
+//  RecordDataset.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/17.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef RecordDataset_hpp
+#define RecordDataset_hpp
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Dataset.hpp"
+#include "Example.hpp"
+
+//
+// the record format packs the examples of a dataset into a few shard files, named as:
+//      prefix-00000.rec
+//      prefix-00001.rec
+//      ...
+// each shard has a header, the records aligned to 64 bytes, and an index of the record offsets at the end.
+// a field of the record is either the raw tensor content, or an encoded image (jpg, png, ...)
+// which is decoded to uint8 NHWC when reading.
+// use the recordConverter.out tool or RecordWriter to create the shards.
+//
+
+namespace MNN {
+namespace Train {
+class MNN_PUBLIC RecordWriter {
+public:
+    RecordWriter(const std::string& prefix, size_t recordsPerShard = 10000);
+    ~RecordWriter();
+
+    // write the data and target of example as raw content
+    bool write(const Example& example);
+
+    // write the encoded image as data, it is decoded to 'channels' channels when reading
+    bool writeImage(const std::string& encoded, int channels, const std::vector<VARP>& target);
+
+    // write the index of the last shard, called by destructor if needed
+    bool finish();
+
+    const std::vector<std::string>& shards() const {
+        return mShards;
+    }
+
+    static std::string shardName(const std::string& prefix, int index);
+
+private:
+    struct Field;
+    static bool _fillFields(const std::vector<VARP>& vars, std::vector<Field>& fields);
+    bool _write(const std::vector<Field>& fields, int dataNumber);
+    bool _finishShard();
+
+    std::string mPrefix;
+    size_t mRecordsPerShard;
+    std::vector<std::string> mShards;
+    std::ofstream mFile;
+    uint64_t mOffset = 0;
+    std::vector<uint64_t> mIndex;
+};
+
+class MNN_PUBLIC RecordDataset : public Dataset {
+public:
+    // the shards are mapped to memory, return an empty DatasetPtr if failed
+    static DatasetPtr create(const std::vector<std::string>& shards);
+
+    // the existing shards prefix-00000.rec, prefix-00001.rec, ... in order
+    static std::vector<std::string> shardsOf(const std::string& prefix);
+
+    // the raw fields of example refer to the mapped memory without copy, keep the dataset alive while using them
+    Example get(size_t index) override;
+
+    bool getTo(size_t index, const BatchBuffer& buffer, size_t position) override;
+
+    std::vector<Example> getBatch(std::vector<size_t> indices) override;
+
+    bool getBatchTo(const std::vector<size_t>& indices, const BatchBuffer& buffer) override;
+
+    size_t size() override;
+
+private:
+    struct Shard;
+    struct Record {
+        int shard;
+        const uint8_t* ptr;
+        uint64_t size;
+    };
+    RecordDataset() = default;
+    Record _record(size_t index) const;
+    // hint the system to read the records of a batch in the order of their offsets
+    void _willNeed(const std::vector<size_t>& indices) const;
+
+    std::vector<std::shared_ptr<Shard>> mShards;
+    // the first record index of each shard, the last one is the size
+    std::vector<size_t> mStarts;
+};
+} // namespace Train
+} // namespace MNN
+
+#endif // RecordDataset_hpp
@@ -28,7 +28,7 @@ using namespace MNN;
 using namespace MNN::Express;
 using namespace MNN::Train;
 
-void MnistUtils::train(std::shared_ptr<Module> model, std::string root) {
+void MnistUtils::train(std::shared_ptr<Module> model, std::string root, bool mixedPrecision) {
     {
         // Load snapshot
         auto para = Variable::load("mnist.snapshot.mnn");
@@ -36,11 +36,17 @@ void MnistUtils::train(std::shared_ptr<Module> model, std::string root) {
     }
     auto exe = Executor::getGlobalExecutor();
     BackendConfig config;
+    if (mixedPrecision) {
+        config.precision = BackendConfig::Precision_Low;
+    }
     exe->setGlobalExecutorConfig(MNN_FORWARD_USER_1, config, 4);
     std::shared_ptr<SGD> sgd(new SGD(model));
     sgd->setMomentum(0.9f);
     // sgd->setMomentum2(0.99f);
     sgd->setWeightDecay(0.0005f);
+    if (mixedPrecision) {
+        sgd->setLossScale(ParameterOptimizer::LossScale());
+    }
 
     auto dataset = MnistDataset::create(root, MnistDataset::Mode::TRAIN);
     // the stack transform, stack [1, 28, 28] to [n, 1, 28, 28]
@@ -115,6 +121,9 @@ void MnistUtils::train(std::shared_ptr<Module> model, std::string root) {
                     std::cout << "  " << moveBatchSize << " / " << dataLoader->size();
                     std::cout << " loss: " << loss->readMap<float>()[0];
                     std::cout << " lr: " << rate;
+                    if (mixedPrecision) {
+                        std::cout << " loss scale: " << sgd->lossScale() << " skipped: " << sgd->skippedSteps();
+                    }
                     std::cout << " time: " << (float)_100Time.durationInUs() / 1000.0f << " ms / " << (i - lastIndex) <<  " iter"  << std::endl;
                     std::cout.flush();
                     _100Time.reset();
@@ -11,6 +11,7 @@
 #include <MNN/expr/Module.hpp>
 class MnistUtils {
 public:
-    static void train(std::shared_ptr<MNN::Express::Module> model, std::string root);
+    // mixedPrecision: compute in fp16 if the backend supports, with dynamic loss scaling
+    static void train(std::shared_ptr<MNN::Express::Module> model, std::string root, bool mixedPrecision = false);
 };
 #endif
@@ -59,7 +59,10 @@ void MobilenetV2Utils::train(std::shared_ptr<Module> model, const int numClasses
     const int testBatchSize = 10;
     const int testNumWorkers = 0;
 
-    auto trainDataLoader = trainDataset.createLoader(trainBatchSize, true, true, trainNumWorkers);
+    // decode the train images into a ring of batches directly, the batch is only used in its iteration
+    auto trainConfig = std::make_shared<DataLoaderConfig>(trainBatchSize, trainNumWorkers);
+    trainConfig->ringSize = trainNumWorkers * 2 + 1;
+    auto trainDataLoader = DataLoader::makeDataLoader(trainDataset.mDataset, trainConfig, true);
     auto testDataLoader = testDataset.createLoader(testBatchSize, true, false, testNumWorkers);
 
     const int trainIterations = trainDataLoader->iterNumber();
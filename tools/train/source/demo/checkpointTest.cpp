@@ -0,0 +1,130 @@
+//
+//  checkpointTest.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/28.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/ExprCreator.hpp>
+#include <MNN/expr/NN.hpp>
+#include "Checkpoint.hpp"
+#include "DemoUnit.hpp"
+#include "OpGrad.hpp"
+#include "RandomGenerator.hpp"
+using namespace MNN::Express;
+using namespace MNN::Train;
+
+class CheckpointBlock : public Module {
+public:
+    CheckpointBlock(int ic, int oc) {
+        NN::ConvOption option;
+        option.kernelSize = {3, 3};
+        option.channel    = {ic, oc};
+        option.padMode    = SAME;
+        conv.reset(NN::Conv(option));
+        bn.reset(NN::BatchNorm(oc));
+        dropout.reset(NN::Dropout(0.3f));
+        registerModel({conv, bn, dropout});
+    }
+    virtual std::vector<VARP> onForward(const std::vector<VARP>& inputs) override {
+        auto x = _Relu(bn->forward(conv->forward(inputs[0])));
+        return {dropout->forward(x)};
+    }
+    std::shared_ptr<Module> conv;
+    std::shared_ptr<Module> bn;
+    std::shared_ptr<Module> dropout;
+};
+
+class CheckpointNet : public Module {
+public:
+    CheckpointNet() {
+        block1.reset(Checkpoint::create(std::shared_ptr<Module>(new CheckpointBlock(4, 8))));
+        block2.reset(Checkpoint::create(std::shared_ptr<Module>(new CheckpointBlock(8, 8))));
+        registerModel({block1, block2});
+    }
+    virtual std::vector<VARP> onForward(const std::vector<VARP>& inputs) override {
+        auto x = _Convert(inputs[0], NC4HW4);
+        x      = block2->forward(block1->forward(x));
+        x      = _Convert(x, NCHW);
+        return {_ReduceMean(x * x, {})};
+    }
+    std::shared_ptr<Module> block1;
+    std::shared_ptr<Module> block2;
+};
+
+/** The gradients backward through the checkpoints, with the recomputed activations and Dropout masks, are the same
+    as the normal backward */
+class CheckpointGradTest : public DemoUnit {
+public:
+    static std::vector<std::vector<float>> computeGrads(std::shared_ptr<Module> net, VARP input,
+                                                        const std::vector<VARP>& parameters,
+                                                        const std::mt19937& random) {
+        RandomGenerator::generator() = random;
+        auto loss                    = net->forward(input);
+        auto grads = MNN::OpGrad::grad(loss, std::set<VARP>(parameters.begin(), parameters.end()));
+        std::vector<std::vector<float>> result;
+        for (auto& p : parameters) {
+            auto grad = grads[p];
+            if (nullptr == grad || nullptr == grad->readMap<float>()) {
+                MNN_ERROR("No gradient for parameter %s\n", p->name().c_str());
+                return {};
+            }
+            auto ptr = grad->readMap<float>();
+            result.emplace_back(ptr, ptr + grad->getInfo()->size);
+        }
+        return result;
+    }
+    virtual int run(int argc, const char* argv[]) override {
+        MNN_PRINT("Test grad of checkpoint against the normal backward\n");
+        std::shared_ptr<Module> net(new CheckpointNet);
+        net->setIsTraining(true);
+        std::vector<VARP> parameters;
+        for (auto& p : net->parameters()) {
+            if (nullptr == p->expr().first->get() && VARP::TRAINABLE == p->expr().first->inputType()) {
+                parameters.emplace_back(p);
+            }
+        }
+        auto input = _Input({2, 4, 10, 10}, NCHW);
+        auto ptr   = input->writeMap<float>();
+        for (int i = 0; i < input->getInfo()->size; ++i) {
+            ptr[i] = (float)((i * 17) % 23 - 11) / 11.0f;
+        }
+        auto random = RandomGenerator::generator();
+
+        auto normal = computeGrads(net, input, parameters, random);
+        std::vector<std::vector<float>> checkpoint;
+        {
+            Checkpoint::Scope scope;
+            checkpoint = computeGrads(net, input, parameters, random);
+            if (Checkpoint::recorded()) {
+                MNN_ERROR("The grad doesn't consume the checkpoints\n");
+                return 1;
+            }
+            net->forward(input);
+        }
+        if (Checkpoint::recorded()) {
+            MNN_ERROR("The checkpoints are kept after the scope\n");
+            return 1;
+        }
+        if (normal.empty() || normal.size() != checkpoint.size()) {
+            return 1;
+        }
+        for (int i = 0; i < normal.size(); ++i) {
+            float maxValue = 0.0f, maxDiff = 0.0f;
+            for (int j = 0; j < normal[i].size(); ++j) {
+                maxValue = fmaxf(maxValue, fabsf(normal[i][j]));
+                maxDiff  = fmaxf(maxDiff, fabsf(normal[i][j] - checkpoint[i][j]));
+            }
+            if (maxDiff > 1e-4f * fmaxf(maxValue, 1e-3f)) {
+                MNN_ERROR("Gradient of %s differs: %f, max %f\n", parameters[i]->name().c_str(), maxDiff, maxValue);
+                return 1;
+            }
+        }
+        MNN_PRINT("Checkpoint grads of %d parameters match\n", (int)parameters.size());
+        return 0;
+    }
+};
+
+DemoUnitSetRegister(CheckpointGradTest, "CheckpointGradTest");
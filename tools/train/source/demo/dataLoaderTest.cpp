@@ -41,7 +41,7 @@ public:
             return 0;
         }
 
-        const int testCount = 6;
+        const int testCount = 7;
         int passedTestCount = 0;
 
         std::string root = argv[1];
@@ -265,6 +265,36 @@ public:
         passedTestCount++;
         cout << "[" << passedTestCount << " / " << testCount << "] passed." << endl;
 
+        // test the batch ring, the samples are written into the preallocated batches by workers
+        auto ringConfig      = std::make_shared<DataLoaderConfig>(trainBatchSize, trainNumWorkers);
+        ringConfig->ringSize = 5;
+        auto ringDataLoader  = std::shared_ptr<DataLoader>(DataLoader::makeDataLoader(trainDataset.mDataset, ringConfig));
+
+        for (int i = 0; i < iterations; i++) {
+            auto trainData = ringDataLoader->next();
+            MNN_ASSERT(trainData.size() == 1);
+
+            auto data  = trainData[0].first[0]->readMap<uint8_t>();
+            auto label = trainData[0].second[0]->readMap<uint8_t>();
+
+            for (int j = 0; j < trainBatchSize; j++) {
+                auto index = int(trainData[0].first[1]->readMap<float>()[j]);
+
+                auto trueData  = images->readMap<uint8_t>() + kImageRows * kImageColumns * index;
+                auto trueLabel = labels->readMap<uint8_t>() + index;
+
+                for (int k = 0; k < kImageRows * kImageColumns; k++) {
+                    int dataIndex = j * (kImageRows * kImageColumns) + k;
+                    MNN_ASSERT(data[dataIndex] == trueData[k]);
+                }
+                MNN_ASSERT(label[j] == trueLabel[0]);
+            }
+        }
+        ringDataLoader->clean();
+
+        passedTestCount++;
+        cout << "[" << passedTestCount << " / " << testCount << "] passed." << endl;
+
         return 0;
     }
 };
@@ -0,0 +1,207 @@
+//
+//  dataParallelTest.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/30.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/ExprCreator.hpp>
+#include <MNN/expr/NN.hpp>
+#include "DataParallel.hpp"
+#include "DemoUnit.hpp"
+#include "SGD.hpp"
+using namespace MNN::Express;
+using namespace MNN::Train;
+
+class DataParallelNet : public Module {
+public:
+    DataParallelNet() {
+        fc1.reset(NN::Linear(8, 16));
+        fc2.reset(NN::Linear(16, 4));
+        registerModel({fc1, fc2});
+    }
+    virtual std::vector<VARP> onForward(const std::vector<VARP>& inputs) override {
+        return {fc2->forward(_Relu(fc1->forward(inputs[0])))};
+    }
+    std::shared_ptr<Module> fc1;
+    std::shared_ptr<Module> fc2;
+
+private:
+    DataParallelNet(CloneContext* ctx) {
+    }
+    Module* clone(CloneContext* ctx) const override {
+        DataParallelNet* module(new DataParallelNet(ctx));
+        module->fc1.reset(fc1->clone(ctx));
+        module->fc2.reset(fc2->clone(ctx));
+        module->registerModel({module->fc1, module->fc2});
+        return this->cloneBaseTo(ctx, module);
+    }
+};
+
+class DataParallelBNNet : public Module {
+public:
+    DataParallelBNNet() {
+        NN::ConvOption option;
+        option.kernelSize = {3, 3};
+        option.channel    = {4, 8};
+        option.padMode    = SAME;
+        conv.reset(NN::Conv(option));
+        bn.reset(NN::BatchNorm(8, 4, 0.9f));
+        fc.reset(NN::Linear(8, 4));
+        registerModel({conv, bn, fc});
+    }
+    virtual std::vector<VARP> onForward(const std::vector<VARP>& inputs) override {
+        auto x = _Relu(bn->forward(conv->forward(_Convert(inputs[0], NC4HW4))));
+        x      = _ReduceMean(_Convert(x, NCHW), {2, 3});
+        return {fc->forward(x)};
+    }
+    // The parameters of BatchNorm are scale, bias, running variance and running mean
+    VARP runningMean() const {
+        return bn->parameters()[3];
+    }
+    std::shared_ptr<Module> conv;
+    std::shared_ptr<Module> bn;
+    std::shared_ptr<Module> fc;
+
+private:
+    DataParallelBNNet(CloneContext* ctx) {
+    }
+    Module* clone(CloneContext* ctx) const override {
+        DataParallelBNNet* module(new DataParallelBNNet(ctx));
+        module->conv.reset(conv->clone(ctx));
+        module->bn.reset(bn->clone(ctx));
+        module->fc.reset(fc->clone(ctx));
+        module->registerModel({module->conv, module->bn, module->fc});
+        return this->cloneBaseTo(ctx, module);
+    }
+};
+
+/** DataParallel trains the same as one SGD on the whole batch: the gradients of the replicas are weighted by their
+    batch slices, and the states of BatchNorm are averaged by the replicas */
+class DataParallelTest : public DemoUnit {
+public:
+    // The content repeats every period samples
+    static VARP _input(INTS dims, int seed, int period) {
+        auto var    = _Input(dims, NCHW);
+        auto ptr    = var->writeMap<float>();
+        auto size   = var->getInfo()->size;
+        auto repeat = size / dims[0] * period;
+        for (int i = 0; i < size; ++i) {
+            ptr[i] = (float)(((i % repeat) * 7 + seed * 13) % 19 - 9) / 9.0f;
+        }
+        return var;
+    }
+    static VARP _loss(std::shared_ptr<Module> module, const std::vector<VARP>& inputs) {
+        auto output = module->forward(inputs[0]);
+        return _ReduceMean(_Square(output - inputs[1]), {});
+    }
+    static bool _equal(VARP a, VARP b, float limit, const char* name, int index) {
+        auto size = a->getInfo()->size;
+        auto pa   = a->readMap<float>();
+        auto pb   = b->readMap<float>();
+        for (int i = 0; i < size; ++i) {
+            if (fabsf(pa[i] - pb[i]) > limit * fmaxf(1.0f, fabsf(pb[i]))) {
+                MNN_ERROR("%s: parameter %d, %d, parallel %f != single %f\n", name, index, i, pa[i], pb[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+    static std::shared_ptr<SGD> _sgd(std::shared_ptr<Module> module) {
+        std::shared_ptr<SGD> sgd(new SGD(module));
+        sgd->setLearningRate(0.05f);
+        sgd->setMomentum(0.9f);
+        sgd->setWeightDecay(0.001f);
+        return sgd;
+    }
+    static std::shared_ptr<Module> _copy(std::shared_ptr<Module> origin, Module* module) {
+        std::shared_ptr<Module> result(module);
+        std::vector<VARP> copies;
+        for (auto& p : origin->parameters()) {
+            auto info = p->getInfo();
+            if (VARP::TRAINABLE == p->expr().first->inputType()) {
+                copies.emplace_back(_TrainableParam(p->readMap<float>(), info->dim, info->order));
+            } else {
+                copies.emplace_back(_Const(p->readMap<float>(), info->dim, info->order));
+            }
+        }
+        if (!result->loadParameters(copies)) {
+            return nullptr;
+        }
+        return result;
+    }
+    // Train the copies by DataParallel and by one SGD on the same batches, the batch repeats every period samples
+    template <typename T>
+    static bool _test(int replicas, INTS inputShape, int period, int steps, float limit, const char* name) {
+        std::shared_ptr<Module> single(new T);
+        auto parallelModel = _copy(single, new T);
+        if (nullptr == parallelModel) {
+            return false;
+        }
+        auto singleSGD = _sgd(single);
+        std::unique_ptr<DataParallel> parallel(DataParallel::create(parallelModel, _sgd(parallelModel), replicas));
+        if (nullptr == parallel) {
+            return false;
+        }
+        for (int i = 0; i < steps; ++i) {
+            auto x = _input(inputShape, i, period);
+            auto y = _input({inputShape[0], 4}, i + 100, period);
+            auto loss = _loss(single, {x, y});
+            singleSGD->step(loss);
+            auto singleLoss   = loss->readMap<float>()[0];
+            auto parallelLoss = parallel->step({x, y}, _loss);
+            if (parallelLoss < 0.0f || fabsf(parallelLoss - singleLoss) > limit * fmaxf(1.0f, singleLoss)) {
+                MNN_ERROR("%s: loss of step %d, parallel %f != single %f\n", name, i, parallelLoss, singleLoss);
+                return false;
+            }
+        }
+        auto singleParameters   = single->parameters();
+        auto parallelParameters = parallelModel->parameters();
+        for (int i = 0; i < singleParameters.size(); ++i) {
+            if (!_equal(parallelParameters[i], singleParameters[i], limit, name, i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    // The batch statistics of BatchNorm differ by slice, only the running mean is linear to them
+    static bool _testRunningMean(int replicas, int batch) {
+        std::shared_ptr<DataParallelBNNet> single(new DataParallelBNNet);
+        auto parallelModel = _copy(single, new DataParallelBNNet);
+        if (nullptr == parallelModel) {
+            return false;
+        }
+        std::unique_ptr<DataParallel> parallel(DataParallel::create(parallelModel, _sgd(parallelModel), replicas));
+        if (nullptr == parallel) {
+            return false;
+        }
+        auto x = _input({batch, 4, 6, 6}, 0, batch);
+        auto y = _input({batch, 4}, 100, batch);
+        _sgd(single)->step(_loss(single, {x, y}));
+        if (parallel->step({x, y}, _loss) < 0.0f) {
+            return false;
+        }
+        auto parallelMean = static_cast<DataParallelBNNet*>(parallelModel.get())->runningMean();
+        return _equal(parallelMean, single->runningMean(), 1e-5f, "BatchNorm running mean", 0);
+    }
+    virtual int run(int argc, const char* argv[]) override {
+        MNN_PRINT("Test DataParallel against one SGD\n");
+        // Uneven slices of 7 samples weight the gradients of replicas differently
+        for (int replicas = 1; replicas <= 3; ++replicas) {
+            if (!_test<DataParallelNet>(replicas, {7, 8}, 7, 5, 1e-5f, "Linear")) {
+                return 1;
+            }
+        }
+        // The batch statistics of each replica are the same as the whole batch if every slice has the same samples
+        if (!_test<DataParallelBNNet>(2, {8, 4, 6, 6}, 4, 5, 1e-5f, "BatchNorm") ||
+            !_test<DataParallelBNNet>(3, {9, 4, 6, 6}, 3, 5, 1e-5f, "BatchNorm") || !_testRunningMean(4, 6)) {
+            return 1;
+        }
+        MNN_PRINT("DataParallel parameters and BatchNorm states match one SGD\n");
+        return 0;
+    }
+};
+
+DemoUnitSetRegister(DataParallelTest, "DataParallelTest");
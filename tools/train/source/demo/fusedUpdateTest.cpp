@@ -0,0 +1,126 @@
+//
+//  fusedUpdateTest.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/29.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/ExprCreator.hpp>
+#include <MNN/expr/NN.hpp>
+#include "ADAM.hpp"
+#include "DemoUnit.hpp"
+#include "SGD.hpp"
+using namespace MNN::Express;
+using namespace MNN::Train;
+
+class FusedUpdateNet : public Module {
+public:
+    FusedUpdateNet() {
+        // 24000 weights, more than one block of the fused update
+        fc1.reset(NN::Linear(120, 200));
+        fc2.reset(NN::Linear(200, 4));
+        registerModel({fc1, fc2});
+    }
+    virtual std::vector<VARP> onForward(const std::vector<VARP>& inputs) override {
+        return {fc2->forward(_Relu(fc1->forward(inputs[0])))};
+    }
+    std::shared_ptr<Module> fc1;
+    std::shared_ptr<Module> fc2;
+};
+
+// Update by the graph of regularizeParameters / onComputeUpdateValue
+template <typename T>
+class GraphUpdate : public T {
+public:
+    GraphUpdate(std::shared_ptr<Module> module) : T(module) {
+    }
+    virtual bool onFusedUpdate(const std::vector<SGD::UpdateState>& states) override {
+        return false;
+    }
+};
+
+/** The fused in-place updates of SGD, ADAM and AdamW give the same parameters as their update graphs */
+class FusedUpdateTest : public DemoUnit {
+public:
+    static VARP _input(INTS dims, int seed) {
+        auto var  = _Input(dims, NCHW);
+        auto ptr  = var->writeMap<float>();
+        auto size = var->getInfo()->size;
+        for (int i = 0; i < size; ++i) {
+            ptr[i] = (float)((i * 7 + seed * 13) % 19 - 9) / 9.0f;
+        }
+        return var;
+    }
+    static void _config(SGD* sgd, SGD::RegularizationMethod method) {
+        sgd->setLearningRate(0.01f);
+        sgd->setMomentum(0.9f);
+        sgd->setWeightDecay(0.01f);
+        sgd->setRegularizationMethod(method);
+    }
+    static void _config(ADAM* adam, bool decoupled) {
+        _config(static_cast<SGD*>(adam), SGD::L2);
+        adam->setMomentum2(0.999f);
+        adam->setEps(1e-8f);
+        adam->setDecoupledWeightDecay(decoupled);
+    }
+    static std::vector<VARP> _train(std::shared_ptr<Module> net, std::shared_ptr<SGD> sgd) {
+        for (int i = 0; i < 20; ++i) {
+            auto output = net->forward(_input({6, 120}, i));
+            auto loss   = _ReduceMean(_Square(output - _input({6, 4}, i + 100)), {});
+            if (!sgd->step(loss)) {
+                return {};
+            }
+        }
+        return net->parameters();
+    }
+    template <typename Fused, typename Graph, typename Config>
+    static bool _test(Config config, const char* name) {
+        std::shared_ptr<Module> fused(new FusedUpdateNet);
+        std::shared_ptr<Module> graph(new FusedUpdateNet);
+        std::vector<VARP> copies;
+        for (auto& p : fused->parameters()) {
+            auto info = p->getInfo();
+            copies.emplace_back(_TrainableParam(p->readMap<float>(), info->dim, info->order));
+        }
+        if (!graph->loadParameters(copies)) {
+            return false;
+        }
+        std::shared_ptr<SGD> fusedOptimizer(new Fused(fused));
+        std::shared_ptr<SGD> graphOptimizer(new Graph(graph));
+        _config(static_cast<Fused*>(fusedOptimizer.get()), config);
+        _config(static_cast<Fused*>(graphOptimizer.get()), config);
+        auto fusedParameters = _train(fused, fusedOptimizer);
+        auto graphParameters = _train(graph, graphOptimizer);
+        if (fusedParameters.empty() || fusedParameters.size() != graphParameters.size()) {
+            MNN_ERROR("%s: train failed\n", name);
+            return false;
+        }
+        for (int i = 0; i < fusedParameters.size(); ++i) {
+            auto size = fusedParameters[i]->getInfo()->size;
+            auto pa   = fusedParameters[i]->readMap<float>();
+            auto pb   = graphParameters[i]->readMap<float>();
+            for (int j = 0; j < size; ++j) {
+                if (fabsf(pa[j] - pb[j]) > 1e-5f * fmaxf(1.0f, fabsf(pb[j]))) {
+                    MNN_ERROR("%s: parameter %d, %d, fused %f != graph %f\n", name, i, j, pa[j], pb[j]);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    virtual int run(int argc, const char* argv[]) override {
+        MNN_PRINT("Test fused parameter update against the update graph\n");
+        bool res = _test<SGD, GraphUpdate<SGD>>(SGD::L2, "SGD L2") &&
+                   _test<SGD, GraphUpdate<SGD>>(SGD::L1L2, "SGD L1L2") &&
+                   _test<ADAM, GraphUpdate<ADAM>>(false, "ADAM") && _test<ADAM, GraphUpdate<ADAM>>(true, "AdamW");
+        if (!res) {
+            return 1;
+        }
+        MNN_PRINT("Fused SGD, ADAM and AdamW updates match the graph\n");
+        return 0;
+    }
+};
+
+DemoUnitSetRegister(FusedUpdateTest, "FusedUpdateTest");
@@ -0,0 +1,211 @@
+//
+//  gradCacheTest.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/28.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/ExprCreator.hpp>
+#include <MNN/expr/NN.hpp>
+#include "DemoUnit.hpp"
+#include "GradCache.hpp"
+#include "OpGrad.hpp"
+#include "SGD.hpp"
+using namespace MNN::Express;
+using namespace MNN::Train;
+
+class GradCacheNet : public Module {
+public:
+    GradCacheNet() {
+        fc1.reset(NN::Linear(8, 16));
+        fc2.reset(NN::Linear(16, 4));
+        registerModel({fc1, fc2});
+    }
+    virtual std::vector<VARP> onForward(const std::vector<VARP>& inputs) override {
+        return {fc2->forward(_Relu(fc1->forward(inputs[0])))};
+    }
+    std::shared_ptr<Module> fc1;
+    std::shared_ptr<Module> fc2;
+};
+
+class GradCacheBNNet : public Module {
+public:
+    GradCacheBNNet() {
+        NN::ConvOption option;
+        option.kernelSize = {3, 3};
+        option.channel    = {4, 8};
+        option.padMode    = SAME;
+        conv.reset(NN::Conv(option));
+        bn.reset(NN::BatchNorm(8, 4, 0.9f));
+        fc.reset(NN::Linear(8, 4));
+        registerModel({conv, bn, fc});
+    }
+    virtual std::vector<VARP> onForward(const std::vector<VARP>& inputs) override {
+        auto x = _Relu(bn->forward(conv->forward(_Convert(inputs[0], NC4HW4))));
+        x      = _ReduceMean(_Convert(x, NCHW), {2, 3});
+        return {fc->forward(x)};
+    }
+    std::shared_ptr<Module> conv;
+    std::shared_ptr<Module> bn;
+    std::shared_ptr<Module> fc;
+};
+
+/** GradCache returns the same gradients as OpGrad::grad while the graph is reused, rebuilds the backward graph when
+    the shape or an input needed by shape changes, and SGD trains the same with and without it, including the
+    BatchNorm statistics and the loss read after each step */
+class GradCacheTest : public DemoUnit {
+public:
+    static VARP _input(INTS dims, int seed) {
+        auto var  = _Input(dims, NCHW);
+        auto ptr  = var->writeMap<float>();
+        auto size = var->getInfo()->size;
+        for (int i = 0; i < size; ++i) {
+            ptr[i] = (float)((i * 7 + seed * 13) % 19 - 9) / 9.0f;
+        }
+        return var;
+    }
+    static bool _equal(VARP a, VARP b, float limit, const char* name) {
+        auto size = a->getInfo()->size;
+        if (size != b->getInfo()->size) {
+            MNN_ERROR("%s: size %d != %d\n", name, size, b->getInfo()->size);
+            return false;
+        }
+        auto pa = a->readMap<float>();
+        auto pb = b->readMap<float>();
+        for (int i = 0; i < size; ++i) {
+            if (fabsf(pa[i] - pb[i]) > limit * fmaxf(1.0f, fabsf(pb[i]))) {
+                MNN_ERROR("%s: %d, %f != %f\n", name, i, pa[i], pb[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+    static bool _checkCount(const GradCache& cache, int hit, int build, const char* name) {
+        if (cache.hitCount() != hit || cache.buildCount() != build) {
+            MNN_ERROR("%s: hit %d, build %d, should be %d, %d\n", name, cache.hitCount(), cache.buildCount(), hit,
+                      build);
+            return false;
+        }
+        return true;
+    }
+    // Reuse for new contents, rebuild for new batch
+    static bool _testShape() {
+        auto weight = _input({4, 3}, 1);
+        auto w      = _TrainableParam(weight->readMap<float>(), {4, 3}, NCHW);
+        GradCache cache;
+        std::vector<int> batches = {2, 2, 3, 3};
+        std::vector<int> builds  = {1, 1, 2, 2};
+        for (int i = 0; i < batches.size(); ++i) {
+            auto loss  = _ReduceSum(_Square(_MatMul(_input({batches[i], 4}, i), w)), {});
+            auto grads = cache.grad(loss, {w});
+            auto truth = MNN::OpGrad::grad(loss, {w});
+            if (!_equal(grads[w], truth[w], 1e-5f, "MatMul grad") ||
+                !_checkCount(cache, i + 1 - builds[i], builds[i], "MatMul")) {
+                return false;
+            }
+        }
+        return true;
+    }
+    // The perm of Transpose is read to build its gradient, the graph with a new perm can't be reused
+    static bool _testShapeContent() {
+        auto weight = _input({3, 3}, 2);
+        auto w      = _TrainableParam(weight->readMap<float>(), {3, 3}, NCHW);
+        GradCache cache;
+        std::vector<std::vector<int>> perms = {{0, 1}, {1, 0}, {1, 0}};
+        std::vector<int> builds             = {1, 2, 2};
+        for (int i = 0; i < perms.size(); ++i) {
+            auto perm = _Input({2}, NCHW, halide_type_of<int>());
+            ::memcpy(perm->writeMap<int>(), perms[i].data(), 2 * sizeof(int));
+            // The coefficients are not symmetric, the gradient of w is c or its transpose
+            auto c     = _input({3, 3}, i + 3);
+            auto loss  = _ReduceSum(_Transpose(w, perm) * c, {});
+            auto grads = cache.grad(loss, {w});
+            auto truth = 0 == perms[i][0] ? c : _Transpose(c, {1, 0});
+            if (!_equal(grads[w], truth, 1e-6f, "Transpose grad") ||
+                !_checkCount(cache, i + 1 - builds[i], builds[i], "Transpose")) {
+                return false;
+            }
+        }
+        return true;
+    }
+    static std::vector<VARP> _train(std::shared_ptr<Module> net, bool cache, INTS inputShape,
+                                    std::vector<float>& losses) {
+        std::shared_ptr<SGD> sgd(new SGD(net));
+        sgd->setLearningRate(0.05f);
+        sgd->setMomentum(0.9f);
+        sgd->setWeightDecay(0.001f);
+        sgd->setCacheGrad(cache);
+        for (int i = 0; i < 10; ++i) {
+            // The batch changes in the middle, the cached graph should be built again
+            inputShape[0] = (i >= 4 && i < 7) ? 3 : 5;
+            auto output   = net->forward(_input(inputShape, i));
+            auto loss     = _ReduceMean(_Square(output - _input({inputShape[0], 4}, i + 100)), {});
+            sgd->step(loss);
+            // The loss and the states are computed by the step, reading them should not compute the forward again
+            if (cache && nullptr != loss->expr().first->get()) {
+                MNN_ERROR("The loss is not computed by the cached step\n");
+                return {};
+            }
+            for (auto& p : net->parameters()) {
+                if (nullptr != p->expr().first->get()) {
+                    MNN_ERROR("The state is not computed by the step\n");
+                    return {};
+                }
+            }
+            losses.emplace_back(loss->readMap<float>()[0]);
+        }
+        return net->parameters();
+    }
+    template <typename T>
+    static bool _testSGD(INTS inputShape, float limit, const char* name) {
+        std::shared_ptr<Module> cached(new T);
+        std::shared_ptr<Module> origin(new T);
+        std::vector<VARP> copies;
+        for (auto& p : cached->parameters()) {
+            auto info = p->getInfo();
+            if (VARP::TRAINABLE == p->expr().first->inputType()) {
+                copies.emplace_back(_TrainableParam(p->readMap<float>(), info->dim, info->order));
+            } else {
+                copies.emplace_back(_Const(p->readMap<float>(), info->dim, info->order));
+            }
+        }
+        if (!origin->loadParameters(copies)) {
+            return false;
+        }
+        std::vector<float> cachedLosses, originLosses;
+        auto cachedParameters = _train(cached, true, inputShape, cachedLosses);
+        auto originParameters = _train(origin, false, inputShape, originLosses);
+        if (cachedParameters.empty() || cachedParameters.size() != originParameters.size()) {
+            MNN_ERROR("%s: train failed\n", name);
+            return false;
+        }
+        for (int i = 0; i < cachedLosses.size(); ++i) {
+            if (fabsf(cachedLosses[i] - originLosses[i]) > limit * fmaxf(1.0f, fabsf(originLosses[i]))) {
+                MNN_ERROR("%s: loss of step %d, %f != %f\n", name, i, cachedLosses[i], originLosses[i]);
+                return false;
+            }
+        }
+        for (int i = 0; i < cachedParameters.size(); ++i) {
+            if (!_equal(cachedParameters[i], originParameters[i], limit, name)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    virtual int run(int argc, const char* argv[]) override {
+        MNN_PRINT("Test GradCache against OpGrad::grad\n");
+        if (!_testShape() || !_testShapeContent()) {
+            return 1;
+        }
+        if (!_testSGD<GradCacheNet>({0, 8}, 1e-6f, "SGD parameter") ||
+            !_testSGD<GradCacheBNNet>({0, 4, 6, 6}, 1e-5f, "SGD BatchNorm")) {
+            return 1;
+        }
+        MNN_PRINT("GradCache gradients and SGD parameters match\n");
+        return 0;
+    }
+};
+
+DemoUnitSetRegister(GradCacheTest, "GradCacheTest");
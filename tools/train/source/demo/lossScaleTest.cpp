@@ -0,0 +1,169 @@
+//
+//  lossScaleTest.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/30.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <math.h>
+#include <MNN/expr/ExprCreator.hpp>
+#include <MNN/expr/NN.hpp>
+#include "DataParallel.hpp"
+#include "DemoUnit.hpp"
+#include "SGD.hpp"
+using namespace MNN::Express;
+using namespace MNN::Train;
+
+class LossScaleNet : public Module {
+public:
+    LossScaleNet() {
+        fc1.reset(NN::Linear(8, 16));
+        fc2.reset(NN::Linear(16, 4));
+        registerModel({fc1, fc2});
+    }
+    virtual std::vector<VARP> onForward(const std::vector<VARP>& inputs) override {
+        return {fc2->forward(_Relu(fc1->forward(inputs[0])))};
+    }
+    std::shared_ptr<Module> fc1;
+    std::shared_ptr<Module> fc2;
+
+private:
+    LossScaleNet(CloneContext* ctx) {
+    }
+    Module* clone(CloneContext* ctx) const override {
+        LossScaleNet* module(new LossScaleNet(ctx));
+        module->fc1.reset(fc1->clone(ctx));
+        module->fc2.reset(fc2->clone(ctx));
+        module->registerModel({module->fc1, module->fc2});
+        return this->cloneBaseTo(ctx, module);
+    }
+};
+
+/** A step whose scaled gradients overflow returns false and doesn't change the weights or the momentum, the scale
+    backs off by it and grows after growthInterval steps, for SGD and DataParallel */
+class LossScaleTest : public DemoUnit {
+public:
+    // Step 2 has a large input, the gradients of its scaled loss overflow
+    static const int kOverflowStep = 2;
+    static VARP _input(INTS dims, int seed, float scale) {
+        auto var  = _Input(dims, NCHW);
+        auto ptr  = var->writeMap<float>();
+        auto size = var->getInfo()->size;
+        for (int i = 0; i < size; ++i) {
+            ptr[i] = scale * (float)((i * 7 + seed * 13) % 19 - 9) / 9.0f;
+        }
+        return var;
+    }
+    static std::vector<VARP> _batch(int step) {
+        return {_input({4, 8}, step, kOverflowStep == step ? 1e30f : 1.0f), _input({4, 4}, step + 100, 1.0f)};
+    }
+    static VARP _loss(std::shared_ptr<Module> module, const std::vector<VARP>& inputs) {
+        auto output = module->forward(inputs[0]);
+        return _ReduceMean(_Square(output - inputs[1]), {});
+    }
+    static std::shared_ptr<SGD> _sgd(std::shared_ptr<Module> module, bool scale) {
+        std::shared_ptr<SGD> sgd(new SGD(module));
+        sgd->setLearningRate(0.05f);
+        sgd->setMomentum(0.9f);
+        if (scale) {
+            ParameterOptimizer::LossScale config;
+            config.scale          = 1024.0f;
+            config.growthInterval = 3;
+            sgd->setLossScale(config);
+        }
+        return sgd;
+    }
+    static std::vector<std::vector<float>> _snapshot(std::shared_ptr<Module> module) {
+        std::vector<std::vector<float>> result;
+        for (auto& p : module->parameters()) {
+            auto ptr = p->readMap<float>();
+            result.emplace_back(ptr, ptr + p->getInfo()->size);
+        }
+        return result;
+    }
+    static bool _equal(const std::vector<std::vector<float>>& a, const std::vector<std::vector<float>>& b,
+                       float limit, const char* name) {
+        for (int i = 0; i < a.size(); ++i) {
+            for (int j = 0; j < a[i].size(); ++j) {
+                if (fabsf(a[i][j] - b[i][j]) > limit * fmaxf(1.0f, fabsf(b[i][j]))) {
+                    MNN_ERROR("%s: parameter %d, %d, %f != %f\n", name, i, j, a[i][j], b[i][j]);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    static std::shared_ptr<Module> _copy(std::shared_ptr<Module> origin) {
+        std::shared_ptr<Module> result(new LossScaleNet);
+        std::vector<VARP> copies;
+        for (auto& p : origin->parameters()) {
+            auto info = p->getInfo();
+            copies.emplace_back(_TrainableParam(p->readMap<float>(), info->dim, info->order));
+        }
+        if (!result->loadParameters(copies)) {
+            return nullptr;
+        }
+        return result;
+    }
+    // Train by SGD::step or DataParallel::step, and by SGD without loss scaling and the overflow batch
+    static bool _test(bool parallel, const char* name) {
+        std::shared_ptr<Module> scaled(new LossScaleNet);
+        auto reference = _copy(scaled);
+        if (nullptr == reference) {
+            return false;
+        }
+        auto sgd          = _sgd(scaled, true);
+        auto referenceSGD = _sgd(reference, false);
+        std::unique_ptr<DataParallel> dataParallel;
+        if (parallel) {
+            dataParallel.reset(DataParallel::create(scaled, sgd, 2));
+            if (nullptr == dataParallel) {
+                return false;
+            }
+        }
+        // The scale of each step after its update: grows after 3 clean steps, backs off by the overflow
+        const std::vector<float> scales = {1024.0f, 1024.0f, 512.0f, 512.0f, 512.0f, 1024.0f, 1024.0f};
+        for (int i = 0; i < scales.size(); ++i) {
+            auto inputs = _batch(i);
+            auto before = _snapshot(scaled);
+            bool updated = false;
+            if (parallel) {
+                updated = dataParallel->step(inputs, _loss) >= 0.0f && !dataParallel->skipped();
+            } else {
+                updated = sgd->step(_loss(scaled, inputs));
+            }
+            if (updated != (kOverflowStep != i)) {
+                MNN_ERROR("%s: step %d %s\n", name, i, updated ? "should overflow" : "failed");
+                return false;
+            }
+            if (sgd->lossScale() != scales[i]) {
+                MNN_ERROR("%s: scale of step %d is %f, should be %f\n", name, i, sgd->lossScale(), scales[i]);
+                return false;
+            }
+            if (!updated) {
+                if (!_equal(_snapshot(scaled), before, 0.0f, name) || 1 != sgd->skippedSteps()) {
+                    MNN_ERROR("%s: the overflow step changed the weights\n", name);
+                    return false;
+                }
+                continue;
+            }
+            // The scale is a power of 2, the same as training without the overflow batch and loss scaling
+            referenceSGD->step(_loss(reference, inputs));
+            if (!_equal(_snapshot(scaled), _snapshot(reference), 1e-5f, name)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    virtual int run(int argc, const char* argv[]) override {
+        MNN_PRINT("Test loss scaling with an overflow step\n");
+        if (!_test(false, "SGD") || !_test(true, "DataParallel")) {
+            return 1;
+        }
+        MNN_PRINT("The overflow step is skipped and the scale backs off and grows\n");
+        return 0;
+    }
+};
+
+DemoUnitSetRegister(LossScaleTest, "LossScaleTest");
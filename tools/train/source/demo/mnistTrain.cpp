@@ -123,8 +123,8 @@ public:
     std::shared_ptr<Module> dropout;
 };
 
-static void train(std::shared_ptr<Module> model, std::string root) {
-    MnistUtils::train(model, root);
+static void train(std::shared_ptr<Module> model, std::string root, bool mixedPrecision = false) {
+    MnistUtils::train(model, root, mixedPrecision);
 }
 
 class MnistInt8Train : public DemoUnit {
@@ -195,6 +195,23 @@ public:
         return 0;
     }
 };
+class MnistTrainMixedPrecision : public DemoUnit {
+public:
+    virtual int run(int argc, const char* argv[]) override {
+        if (argc < 2) {
+            std::cout << "usage: ./runTrainDemo.out MnistTrainMixedPrecision /path/to/unzipped/mnist/data/" << std::endl;
+            return 0;
+        }
+        // global random number generator, should invoke before construct the model and dataset
+        RandomGenerator::generator(17);
+
+        std::string root = argv[1];
+        std::shared_ptr<Module> model(new Lenet);
+        train(model, root, true);
+        return 0;
+    }
+};
 DemoUnitSetRegister(MnistTrain, "MnistTrain");
+DemoUnitSetRegister(MnistTrainMixedPrecision, "MnistTrainMixedPrecision");
 DemoUnitSetRegister(MnistTrainSnapshot, "MnistTrainSnapshot");
 DemoUnitSetRegister(MnistInt8Train, "MnistInt8Train");
@@ -8,20 +8,27 @@
 
 #include <MNN/expr/Executor.hpp>
 #include <MNN/expr/Optimizer.hpp>
+#include <string.h>
 #include <cmath>
 #include <iostream>
+#include <random>
 #include <sstream>
+#include <thread>
 #include <vector>
+#include "DataParallel.hpp"
 #include "DemoUnit.hpp"
+#include "Loss.hpp"
 #include "MobilenetV2.hpp"
 #include "MobilenetV2Utils.hpp"
 #include <MNN/expr/NN.hpp>
 #define MNN_OPEN_TIME_TRACE
 #include <MNN/AutoTime.hpp>
 #include "RandomGenerator.hpp"
+#include "SGD.hpp"
 #include "Transformer.hpp"
 #include "module/PipelineModule.hpp"
 
+using namespace MNN;
 using namespace MNN::Train;
 using namespace MNN::Express;
 using namespace MNN::Train::Model;
@@ -170,7 +177,133 @@ public:
     }
 };
 
+class MobilenetV2DataParallel : public DemoUnit {
+public:
+    virtual int run(int argc, const char* argv[]) override {
+        std::cout << "usage: ./runTrainDemo.out MobilenetV2DataParallel [batch] [size] [iterations] [maxReplicas]"
+                  << std::endl;
+        int values[4] = {32, 224, 5, 4};
+        for (int i = 1; i < argc && i <= 4; ++i) {
+            std::istringstream is(argv[i]);
+            is >> values[i - 1];
+        }
+        const int batch       = values[0];
+        const int size        = values[1];
+        const int iterations  = values[2];
+        const int maxReplicas = values[3];
+        const int numClasses  = 1001;
+        const int cores       = std::max((int)std::thread::hardware_concurrency(), 1);
+        RandomGenerator::generator(17);
+        std::shared_ptr<Module> model(new MobilenetV2(numClasses));
+
+        // Random images and labels, only the speed is measured
+        auto images = _Input({batch, 3, size, size}, NCHW);
+        auto labels = _Input({batch, numClasses}, NCHW);
+        auto imagePtr = images->writeMap<float>();
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        for (int i = 0; i < batch * 3 * size * size; ++i) {
+            imagePtr[i] = distribution(RandomGenerator::generator());
+        }
+        auto labelPtr = labels->writeMap<float>();
+        ::memset(labelPtr, 0, batch * numClasses * sizeof(float));
+        for (int i = 0; i < batch; ++i) {
+            labelPtr[i * numClasses + (i * 7) % numClasses] = 1.0f;
+        }
+        auto lossFunction = [](std::shared_ptr<Module> module, const std::vector<VARP>& inputs) {
+            auto predict = module->forward(_Convert(inputs[0], NC4HW4));
+            return _CrossEntropy(predict, inputs[1]);
+        };
+
+        // Baseline: one module on one executor with all threads
+        float baseline = 0.0f;
+        {
+            Executor::getGlobalExecutor()->setGlobalExecutorConfig(MNN_FORWARD_CPU, BackendConfig(), cores);
+            std::shared_ptr<SGD> solver(new SGD(model));
+            solver->setLearningRate(1e-5f);
+            solver->setMomentum(0.9f);
+            Timer timer;
+            for (int i = 0; i < iterations; ++i) {
+                solver->step(lossFunction(model, {images, labels}));
+            }
+            baseline = (float)timer.durationInUs() / 1000.0f / iterations;
+            MNN_PRINT("Single executor, %d threads: %.2f ms / step\n", cores, baseline);
+        }
+        for (int replicas = 1; replicas <= maxReplicas; replicas *= 2) {
+            std::shared_ptr<SGD> solver(new SGD(model));
+            solver->setLearningRate(1e-5f);
+            solver->setMomentum(0.9f);
+            auto threads = std::max(cores / replicas, 1);
+            std::unique_ptr<DataParallel> parallel(DataParallel::create(model, solver, replicas, threads));
+            if (nullptr == parallel) {
+                return 0;
+            }
+            float loss = 0.0f;
+            Timer timer;
+            for (int i = 0; i < iterations; ++i) {
+                loss = parallel->step({images, labels}, lossFunction);
+            }
+            auto cost = (float)timer.durationInUs() / 1000.0f / iterations;
+            MNN_PRINT("DataParallel %d replicas x %d threads: %.2f ms / step, speedup %.2f, loss %f\n", replicas,
+                      threads, cost, baseline / cost, loss);
+        }
+        return 0;
+    }
+};
+
+class MobilenetV2GradCache : public DemoUnit {
+public:
+    virtual int run(int argc, const char* argv[]) override {
+        std::cout << "usage: ./runTrainDemo.out MobilenetV2GradCache [batch] [size] [iterations]" << std::endl;
+        int values[3] = {8, 224, 10};
+        for (int i = 1; i < argc && i <= 3; ++i) {
+            std::istringstream is(argv[i]);
+            is >> values[i - 1];
+        }
+        const int batch      = values[0];
+        const int size       = values[1];
+        const int iterations = values[2];
+        const int numClasses = 1001;
+        RandomGenerator::generator(17);
+        auto images   = _Input({batch, 3, size, size}, NCHW);
+        auto labels   = _Input({batch, numClasses}, NCHW);
+        auto labelPtr = labels->writeMap<float>();
+        ::memset(labelPtr, 0, batch * numClasses * sizeof(float));
+        for (int i = 0; i < batch; ++i) {
+            labelPtr[i * numClasses + (i * 7) % numClasses] = 1.0f;
+        }
+        // Train the same model with and without the cached backward graph, the loss is read each step like a
+        // training loop logging it
+        for (int cache = 0; cache < 2; ++cache) {
+            std::shared_ptr<Module> model(new MobilenetV2(numClasses));
+            std::shared_ptr<SGD> solver(new SGD(model));
+            solver->setLearningRate(1e-5f);
+            solver->setMomentum(0.9f);
+            solver->setCacheGrad(cache > 0);
+            std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+            std::mt19937 engine(17);
+            float loss = 0.0f;
+            Timer timer;
+            for (int i = 0; i < iterations; ++i) {
+                auto imagePtr = images->writeMap<float>();
+                for (int j = 0; j < batch * 3 * size * size; ++j) {
+                    imagePtr[j] = distribution(engine);
+                }
+                auto predict = model->forward(_Convert(images, NC4HW4));
+                auto lossVar = _CrossEntropy(predict, labels);
+                solver->step(lossVar);
+                loss = lossVar->readMap<float>()[0];
+            }
+            auto cost = (float)timer.durationInUs() / 1000.0f / iterations;
+            MNN_PRINT("MobilenetV2 batch %d, %dx%d, %s: %.2f ms / step, last loss %f\n", batch, size, size,
+                      cache > 0 ? "GradCache" : "no cache", cost, loss);
+        }
+        return 0;
+    }
+};
+
 DemoUnitSetRegister(MobilenetV2Transfer, "MobilenetV2Transfer");
 DemoUnitSetRegister(MobilenetV2Train, "MobilenetV2Train");
 DemoUnitSetRegister(MobilenetV2PostTrain, "MobilenetV2PostTrain");
 DemoUnitSetRegister(MobilenetV2TrainQuant, "MobilenetV2TrainQuant");
+DemoUnitSetRegister(MobilenetV2DataParallel, "MobilenetV2DataParallel");
+DemoUnitSetRegister(MobilenetV2GradCache, "MobilenetV2GradCache");
@@ -63,6 +63,8 @@ static bool loadConfig(std::string configPath) {
         std::string type = picObj["ScaleUpdateMethod"].GetString();
         if (type == "Maximum") {
             gMethod = NN::Maximum;
+        } else if (type == "Learnable") {
+            gMethod = NN::Learnable;
         }
     }
     if (picObj.HasMember("FeatureScaleStatMethod")) {
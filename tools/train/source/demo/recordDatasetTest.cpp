@@ -0,0 +1,140 @@
+//
+//  recordDatasetTest.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/28.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <MNN/expr/ExprCreator.hpp>
+#include <fstream>
+#include <iterator>
+#include "DemoUnit.hpp"
+#include "RecordDataset.hpp"
+
+using namespace MNN::Express;
+using namespace MNN::Train;
+
+/** The examples written by RecordWriter are read back the same, and a record whose field header doesn't match its
+    payload is rejected */
+class RecordDatasetTest : public DemoUnit {
+public:
+    static const int kNumber = 10;
+    static float _value(int index, int i) {
+        return (float)(index * 100 + i) * 0.5f;
+    }
+    static bool _check(const float* data, const int* label, int index) {
+        for (int i = 0; i < 6; ++i) {
+            if (data[i] != _value(index, i)) {
+                MNN_ERROR("The data of record %d is %f, should be %f\n", index, data[i], _value(index, i));
+                return false;
+            }
+        }
+        if (label[0] != index) {
+            MNN_ERROR("The label of record %d is %d\n", index, label[0]);
+            return false;
+        }
+        return true;
+    }
+    virtual int run(int argc, const char* argv[]) override {
+        std::string prefix = argc > 1 ? argv[1] : "recordDatasetTest";
+        MNN_PRINT("Test RecordDataset round trip with %s-*.rec\n", prefix.c_str());
+        {
+            RecordWriter writer(prefix, 4);
+            for (int index = 0; index < kNumber; ++index) {
+                auto data = _Input({2, 3}, NCHW);
+                auto ptr  = data->writeMap<float>();
+                for (int i = 0; i < 6; ++i) {
+                    ptr[i] = _value(index, i);
+                }
+                if (!writer.write({{data}, {_Scalar<int>(index)}})) {
+                    return 1;
+                }
+            }
+        }
+        auto shards = RecordDataset::shardsOf(prefix);
+        if (shards.size() != 3) {
+            MNN_ERROR("Should write 3 shards, but %d\n", (int)shards.size());
+            return 1;
+        }
+        auto dataset = RecordDataset::create(shards);
+        if (nullptr == dataset.mDataset || dataset.mDataset->size() != kNumber) {
+            MNN_ERROR("Can't read the records back\n");
+            return 1;
+        }
+        for (int index = 0; index < kNumber; ++index) {
+            auto example = dataset.get<RecordDataset>()->get(index);
+            if (example.first.size() != 1 || example.second.size() != 1) {
+                MNN_ERROR("The fields of record %d are lost\n", index);
+                return 1;
+            }
+            auto info = example.first[0]->getInfo();
+            if (info->dim != std::vector<int>({2, 3}) || info->type != halide_type_of<float>()) {
+                MNN_ERROR("The shape of record %d is changed\n", index);
+                return 1;
+            }
+            if (!_check(example.first[0]->readMap<float>(), example.second[0]->readMap<int>(), index)) {
+                return 1;
+            }
+        }
+        std::vector<size_t> indices = {7, 2, 9};
+        std::vector<float> data(indices.size() * 6);
+        std::vector<int> label(indices.size());
+        BatchBuffer buffer;
+        buffer.data        = {(uint8_t*)data.data()};
+        buffer.dataBytes   = {6 * sizeof(float)};
+        buffer.target      = {(uint8_t*)label.data()};
+        buffer.targetBytes = {sizeof(int)};
+        if (!dataset.get<RecordDataset>()->getBatchTo(indices, buffer)) {
+            MNN_ERROR("Can't write the records into batch\n");
+            return 1;
+        }
+        for (int i = 0; i < indices.size(); ++i) {
+            if (!_check(data.data() + 6 * i, label.data() + i, (int)indices[i])) {
+                return 1;
+            }
+        }
+
+        // Make dims of the first field disagree with its bytes, the record should be rejected instead of read over
+        std::string content;
+        {
+            std::ifstream file(shards[0], std::ios::binary);
+            content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        uint64_t indexOffset, start;
+        ::memcpy(&indexOffset, content.data() + 16, sizeof(uint64_t));
+        ::memcpy(&start, content.data() + indexOffset, sizeof(uint64_t));
+        // uint32 dataNumber, uint32 targetNumber, then encoding, type, order, dimSize, dims
+        int32_t dim = 1000;
+        ::memcpy(&content[start + 2 * sizeof(uint32_t) + 4 * sizeof(uint32_t)], &dim, sizeof(int32_t));
+        auto broken = RecordWriter::shardName(prefix + "Broken", 0);
+        {
+            std::ofstream file(broken, std::ios::binary | std::ios::trunc);
+            file.write(content.data(), content.size());
+        }
+        auto brokenDataset = RecordDataset::create({broken});
+        if (nullptr == brokenDataset.mDataset) {
+            MNN_ERROR("Can't read %s\n", broken.c_str());
+            return 1;
+        }
+        auto example = brokenDataset.get<RecordDataset>()->get(0);
+        if (!example.first.empty() || brokenDataset.get<RecordDataset>()->getBatchTo({0}, buffer)) {
+            MNN_ERROR("The broken record is not rejected\n");
+            return 1;
+        }
+        if (!_check(brokenDataset.get<RecordDataset>()->get(1).first[0]->readMap<float>(),
+                    brokenDataset.get<RecordDataset>()->get(1).second[0]->readMap<int>(), 1)) {
+            return 1;
+        }
+        for (auto& name : shards) {
+            remove(name.c_str());
+        }
+        remove(broken.c_str());
+        MNN_PRINT("RecordDataset round trip of %d examples passed\n", kNumber);
+        return 0;
+    }
+};
+
+DemoUnitSetRegister(RecordDatasetTest, "RecordDatasetTest");
@@ -0,0 +1,166 @@
+//
+//  recordConverter.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/17.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include <MNN/ImageProcess.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include <stdlib.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "MnistDataset.hpp"
+#include "RecordDataset.hpp"
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+using namespace MNN;
+using namespace MNN::CV;
+using namespace MNN::Express;
+using namespace MNN::Train;
+
+static void _usage() {
+    MNN_PRINT("Usage: ./recordConverter.out image path/to/images/ image.txt outputPrefix [recordsPerShard] "
+              "[height width]\n");
+    MNN_PRINT("    the txt file is the same as ImageDataset: 'image1.jpg label1,label2,...' per line\n");
+    MNN_PRINT("    without height / width the encoded images are stored and decoded when reading,\n");
+    MNN_PRINT("    otherwise they are decoded and resized to uint8 RGB here\n");
+    MNN_PRINT("       ./recordConverter.out mnist path/to/mnist/ outputPrefix [recordsPerShard] [test]\n");
+}
+
+static bool _readFile(const std::string& name, std::string& content) {
+    std::ifstream file(name, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    content = buffer.str();
+    return true;
+}
+
+static VARP _decodeAndResize(const std::string& encoded, int height, int width) {
+    int originWidth, originHeight, comp;
+    auto bitmap = stbi_load_from_memory((const stbi_uc*)encoded.data(), (int)encoded.size(), &originWidth,
+                                        &originHeight, &comp, 4);
+    if (nullptr == bitmap) {
+        return nullptr;
+    }
+    ImageProcess::Config config;
+    config.sourceFormat = CV::RGBA;
+    config.destFormat   = CV::RGB;
+    config.filterType   = CV::BILINEAR;
+    std::shared_ptr<ImageProcess> process(ImageProcess::create(config));
+    Matrix trans;
+    trans.setScale((float)(originWidth - 1) / (float)(std::max(width - 1, 1)),
+                   (float)(originHeight - 1) / (float)(std::max(height - 1, 1)));
+    process->setMatrix(trans);
+    auto image = _Input({height, width, 3}, NHWC, halide_type_of<uint8_t>());
+    process->convert(bitmap, originWidth, originHeight, 0, image->writeMap<uint8_t>(), width, height, 3, width * 3,
+                     halide_type_of<uint8_t>());
+    stbi_image_free(bitmap);
+    return image;
+}
+
+static int _convertImages(int argc, const char* argv[]) {
+    if (argc < 5) {
+        _usage();
+        return 0;
+    }
+    std::string root   = argv[2];
+    size_t perShard    = argc > 5 ? atoi(argv[5]) : 10000;
+    int height         = argc > 7 ? atoi(argv[6]) : 0;
+    int width          = argc > 7 ? atoi(argv[7]) : 0;
+    std::ifstream list(argv[3]);
+    if (!list.is_open()) {
+        MNN_ERROR("Can't open %s\n", argv[3]);
+        return 1;
+    }
+    RecordWriter writer(argv[4], perShard);
+    std::string line;
+    int count = 0;
+    while (std::getline(list, line)) {
+        std::istringstream items(line);
+        std::string name, labelString;
+        if (!(items >> name >> labelString)) {
+            MNN_ERROR("Invalid line: %s\n", line.c_str());
+            return 1;
+        }
+        std::vector<int> labels;
+        std::istringstream labelItems(labelString);
+        for (std::string label; std::getline(labelItems, label, ',');) {
+            labels.emplace_back(atoi(label.c_str()));
+        }
+        auto target = _Const(labels.data(), {(int)labels.size()}, NHWC, halide_type_of<int32_t>());
+        std::string encoded;
+        if (!_readFile(root + name, encoded)) {
+            MNN_ERROR("Can't read image %s\n", (root + name).c_str());
+            return 1;
+        }
+        bool success = false;
+        if (height > 0 && width > 0) {
+            auto image = _decodeAndResize(encoded, height, width);
+            if (nullptr == image) {
+                MNN_ERROR("Can't decode image %s\n", (root + name).c_str());
+                return 1;
+            }
+            success = writer.write({{image}, {target}});
+        } else {
+            success = writer.writeImage(encoded, 3, {target});
+        }
+        if (!success) {
+            return 1;
+        }
+        if (++count % 10000 == 0) {
+            MNN_PRINT("%d images converted\n", count);
+        }
+    }
+    if (!writer.finish()) {
+        return 1;
+    }
+    MNN_PRINT("%d images converted into %d shards\n", count, (int)writer.shards().size());
+    return 0;
+}
+
+static int _convertMnist(int argc, const char* argv[]) {
+    if (argc < 4) {
+        _usage();
+        return 0;
+    }
+    size_t perShard = argc > 4 ? atoi(argv[4]) : 10000;
+    bool test       = argc > 5 && std::string(argv[5]) == "test";
+    auto dataset    = MnistDataset::create(argv[2], test ? MnistDataset::Mode::TEST : MnistDataset::Mode::TRAIN);
+    RecordWriter writer(argv[3], perShard);
+    auto mnist = dataset.get<MnistDataset>();
+    for (size_t i = 0; i < mnist->size(); ++i) {
+        if (!writer.write(mnist->get(i))) {
+            return 1;
+        }
+    }
+    if (!writer.finish()) {
+        return 1;
+    }
+    MNN_PRINT("%d images converted into %d shards\n", (int)mnist->size(), (int)writer.shards().size());
+    return 0;
+}
+
+int main(int argc, const char* argv[]) {
+    if (argc < 2) {
+        _usage();
+        return 0;
+    }
+    std::string mode = argv[1];
+    if (mode == "image") {
+        return _convertImages(argc, argv);
+    }
+    if (mode == "mnist") {
+        return _convertMnist(argc, argv);
+    }
+    _usage();
+    return 0;
+}
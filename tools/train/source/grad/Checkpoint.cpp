@@ -0,0 +1,310 @@
+//
+//  Checkpoint.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/15.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "Checkpoint.hpp"
+#include <MNN/expr/ExprCreator.hpp>
+#include "OpGrad.hpp"
+#include "RandomGenerator.hpp"
+using namespace MNN::Express;
+
+namespace MNN {
+namespace Train {
+
+struct CheckpointSegment {
+    std::shared_ptr<Module> module;
+    // The origin inputs, may be computed by ops before the checkpoint
+    std::vector<VARP> inputs;
+    // The inputs used by the forward of module, no op
+    std::vector<VARP> detached;
+    // The computed outputs, no op
+    std::vector<VARP> outputs;
+    // The random generator before the forward, such as for the mask of Dropout
+    std::mt19937 random;
+};
+thread_local static Checkpoint::Scope* gScope = nullptr;
+
+Checkpoint::Scope::Scope() {
+    mPrevious = gScope;
+    gScope    = this;
+}
+
+Checkpoint::Scope::~Scope() {
+    gScope = mPrevious;
+}
+
+static bool _useRandomOp(const std::vector<VARP>& outputs) {
+    for (auto& expr : Variable::getExecuteOrder(outputs)) {
+        if (nullptr != expr->get() && OpType_RandomUniform == expr->get()->type()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+class CheckpointModule : public Module {
+public:
+    CheckpointModule(std::shared_ptr<Module> module) : mModule(module) {
+        registerModel({module});
+        setName(module->name());
+        setType("Checkpoint");
+    }
+
+    virtual std::vector<VARP> onForward(const std::vector<VARP>& inputs) override {
+        if (!getIsTraining() || nullptr == gScope) {
+            return mModule->onForward(inputs);
+        }
+        std::shared_ptr<CheckpointSegment> segmentPtr(new CheckpointSegment);
+        auto& segment  = *segmentPtr;
+        segment.module = mModule;
+        segment.inputs = inputs;
+        segment.random = RandomGenerator::generator();
+        for (auto& input : inputs) {
+            if (nullptr == input->expr().first->get()) {
+                segment.detached.emplace_back(input);
+                continue;
+            }
+            auto info = input->getInfo();
+            auto ptr  = input->readMap<void>();
+            if (nullptr == info || nullptr == ptr) {
+                MNN_ERROR("Compute error for the input of checkpoint %s\n", name().c_str());
+                return {};
+            }
+            segment.detached.emplace_back(_Const(ptr, info->dim, info->order, info->type));
+        }
+        auto outputs = mModule->onForward(segment.detached);
+        if (_useRandomOp(outputs)) {
+            // The random op can't be replayed, keep the activations and connect the graph to the origin inputs
+            if (!mRandomWarned) {
+                MNN_PRINT("Checkpoint %s uses random op, it is not recomputed\n", name().c_str());
+                mRandomWarned = true;
+            }
+            for (int i = 0; i < inputs.size(); ++i) {
+                if (inputs[i].get() != segment.detached[i].get()) {
+                    Variable::replace(segment.detached[i], inputs[i]);
+                }
+            }
+            return outputs;
+        }
+        // Compute the outputs with the states such as running mean of BatchNorm, then cut them from the activations
+        std::vector<VARP> prepareCompute = outputs;
+        std::vector<VARP> states;
+        for (auto& p : mModule->parameters()) {
+            if (nullptr != p.get() && nullptr != p->expr().first->get()) {
+                states.emplace_back(p);
+                prepareCompute.emplace_back(p);
+            }
+        }
+        Variable::prepareCompute(prepareCompute);
+        for (auto& output : outputs) {
+            auto info = output->getInfo();
+            auto ptr  = output->readMap<void>();
+            if (nullptr == info || nullptr == ptr) {
+                MNN_ERROR("Compute error for the output of checkpoint %s\n", name().c_str());
+                return {};
+            }
+            auto result = _Const(ptr, info->dim, info->order, info->type);
+            result->setName(output->name());
+            segment.outputs.emplace_back(result);
+        }
+        for (auto& p : states) {
+            auto info = p->getInfo();
+            auto ptr  = p->readMap<void>();
+            if (nullptr == info || nullptr == ptr) {
+                MNN_ERROR("Compute error for the state of checkpoint %s\n", name().c_str());
+                return {};
+            }
+            Variable::replace(p, _Const(ptr, info->dim, info->order, info->type));
+        }
+        gScope->mSegments.emplace_back(segmentPtr);
+        return segment.outputs;
+    }
+
+private:
+    CheckpointModule() = default;
+
+    Module* clone(CloneContext* ctx) const override {
+        CheckpointModule* module(new CheckpointModule);
+        module->mModule.reset(mModule->clone(ctx));
+        module->registerModel({module->mModule});
+        return this->cloneBaseTo(ctx, module);
+    }
+
+    std::shared_ptr<Module> mModule;
+    // Warn about the random op once, not for each forward
+    bool mRandomWarned = false;
+};
+
+namespace {
+// Sum of the gradients which have been computed, the backward is computed piece by piece to release the activations
+class GradAccumulator {
+public:
+    bool add(const std::map<VARP, VARP>& grads) {
+        std::vector<VARP> prepareCompute;
+        for (auto& iter : grads) {
+            if (nullptr != iter.second) {
+                prepareCompute.emplace_back(iter.second);
+            }
+        }
+        Variable::prepareCompute(prepareCompute);
+        for (auto& iter : grads) {
+            if (nullptr == iter.second) {
+                continue;
+            }
+            auto info = iter.second->getInfo();
+            auto src  = iter.second->readMap<float>();
+            if (nullptr == info || nullptr == src || info->type != halide_type_of<float>()) {
+                MNN_ERROR("Compute error for gradient of checkpoint\n");
+                return false;
+            }
+            auto sum = mSums.find(iter.first);
+            if (sum == mSums.end()) {
+                mSums.insert(std::make_pair(iter.first, _Const(src, info->dim, info->order)));
+                continue;
+            }
+            auto dst = sum->second->writeMap<float>();
+            if (sum->second->getInfo()->size != info->size) {
+                MNN_ERROR("Gradient size not match for checkpoint\n");
+                return false;
+            }
+            for (int i = 0; i < info->size; ++i) {
+                dst[i] += src[i];
+            }
+        }
+        return true;
+    }
+    VARP get(VARP var) const {
+        auto iter = mSums.find(var);
+        if (iter == mSums.end()) {
+            return nullptr;
+        }
+        return iter->second;
+    }
+
+private:
+    std::map<VARP, VARP> mSums;
+};
+
+// Backward from outputs with their gradients, the outputs of the same expr are backward together
+std::map<VARP, VARP> _backward(const std::vector<VARP>& outputs, const std::vector<VARP>& outputGrads,
+                               const std::set<VARP>& parameters, const std::string& blockExpr) {
+    std::map<EXPRP, std::vector<VARP>> groups;
+    for (int i = 0; i < outputs.size(); ++i) {
+        if (nullptr == outputGrads[i]) {
+            continue;
+        }
+        auto expr = outputs[i]->expr();
+        if (groups.find(expr.first) == groups.end()) {
+            groups.insert(std::make_pair(expr.first, std::vector<VARP>(expr.first->outputSize())));
+        }
+        groups[expr.first][expr.second] = outputGrads[i];
+    }
+    std::map<VARP, VARP> result;
+    for (auto& group : groups) {
+        std::map<EXPRP, std::vector<VARP>> backwardMap;
+        backwardMap[group.first] = group.second;
+        auto grads = OpGrad::gradCommon(Variable::create(group.first), parameters, backwardMap, blockExpr);
+        for (auto& iter : grads) {
+            if (nullptr == iter.second) {
+                continue;
+            }
+            auto& dst = result[iter.first];
+            dst       = nullptr == dst ? iter.second : _Add(dst, iter.second);
+        }
+    }
+    return result;
+}
+} // namespace
+
+Module* Checkpoint::create(std::shared_ptr<Module> module) {
+    return new CheckpointModule(module);
+}
+
+bool Checkpoint::recorded() {
+    return nullptr != gScope && !gScope->mSegments.empty();
+}
+
+void Checkpoint::clear() {
+    if (nullptr != gScope) {
+        gScope->mSegments.clear();
+    }
+}
+
+std::map<VARP, VARP> Checkpoint::grad(VARP loss, const std::set<VARP>& parameters, const std::string& blockExpr) {
+    std::vector<std::shared_ptr<CheckpointSegment>> segments;
+    if (nullptr != gScope) {
+        segments.swap(gScope->mSegments);
+    }
+    // The outputs of checkpoints are the leaves of the graph after them
+    std::set<VARP> targets = parameters;
+    for (auto& segment : segments) {
+        targets.insert(segment->outputs.begin(), segment->outputs.end());
+    }
+    GradAccumulator accumulator;
+    {
+        auto shape = loss->getInfo();
+        MNN_ASSERT(shape->size == 1);
+        if (!accumulator.add(_backward({loss}, {_Const(1.0f, shape->dim, shape->order)}, targets, blockExpr))) {
+            return {};
+        }
+    }
+    // A checkpoint only uses the outputs of checkpoints before it, so the reverse order is a valid backward order
+    for (auto iter = segments.rbegin(); iter != segments.rend(); ++iter) {
+        auto& segment = **iter;
+        std::vector<VARP> outputGrads;
+        bool used = false;
+        for (auto& output : segment.outputs) {
+            outputGrads.emplace_back(accumulator.get(output));
+            used = used || nullptr != outputGrads.back();
+        }
+        if (!used) {
+            continue;
+        }
+        // Recompute the activations with the same random state, and keep the states updated by the first forward
+        auto states        = segment.module->parameters();
+        auto& generator    = RandomGenerator::generator();
+        auto currentRandom = generator;
+        generator          = segment.random;
+        auto outputs       = segment.module->onForward(segment.detached);
+        generator          = currentRandom;
+        auto current       = segment.module->parameters();
+        for (int i = 0; i < states.size(); ++i) {
+            if (nullptr != current[i].get() && current[i].get() != states[i].get()) {
+                Variable::replace(current[i], states[i]);
+            }
+        }
+        std::set<VARP> localTargets = targets;
+        localTargets.insert(segment.detached.begin(), segment.detached.end());
+        if (!accumulator.add(_backward(outputs, outputGrads, localTargets, blockExpr))) {
+            return {};
+        }
+        // Backward through the ops computing the inputs
+        for (int i = 0; i < segment.inputs.size(); ++i) {
+            if (segment.inputs[i].get() == segment.detached[i].get()) {
+                continue;
+            }
+            auto inputGrad = accumulator.get(segment.detached[i]);
+            if (nullptr == inputGrad) {
+                continue;
+            }
+            if (!accumulator.add(_backward({segment.inputs[i]}, {inputGrad}, targets, blockExpr))) {
+                return {};
+            }
+        }
+    }
+    std::map<VARP, VARP> grads;
+    for (auto& p : parameters) {
+        auto grad = accumulator.get(p);
+        if (nullptr != grad) {
+            grads[p] = grad;
+        }
+    }
+    return grads;
+}
+
+} // namespace Train
+} // namespace MNN
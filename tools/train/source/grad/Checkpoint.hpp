@@ -0,0 +1,66 @@
+//
+//  Checkpoint.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/15.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef Checkpoint_hpp
+#define Checkpoint_hpp
+
+#include <MNN/expr/Module.hpp>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace MNN {
+namespace Train {
+
+struct CheckpointSegment;
+class CheckpointModule;
+
+/** Gradient checkpointing: in training, the forward of a checkpoint module is computed at once and only its outputs
+    are kept, the activations inside are dropped. OpGrad::grad recomputes the checkpoints one by one in reverse order
+    during backward, so the peak memory is about the activations of one checkpoint and the outputs of all of them,
+    at the cost of one more forward of the checkpoint modules.
+    The recompute restores the state of the random generator, so Dropout draws the same mask. A module using the
+    RandomUniform op can't be recomputed the same, it is computed as a normal module. */
+class MNN_PUBLIC Checkpoint {
+public:
+    // Wrap the module as a checkpoint, it has the same parameters as the module
+    static Express::Module* create(std::shared_ptr<Express::Module> module);
+
+    /** Guard of a training step in this thread: the forward of checkpoints in its lifetime is recorded, and
+        OpGrad::grad backwards through the recorded checkpoints. They are dropped with the guard. Without a guard,
+        checkpoint modules compute as the modules they wrap. */
+    class MNN_PUBLIC Scope {
+    public:
+        Scope();
+        ~Scope();
+
+    private:
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        friend class Checkpoint;
+        friend class CheckpointModule;
+        Scope* mPrevious;
+        std::vector<std::shared_ptr<CheckpointSegment>> mSegments;
+    };
+
+    // Whether the scope of this thread has recorded checkpoints
+    static bool recorded();
+
+    // Drop the recorded checkpoints, such as after a forward which is not used for backward
+    static void clear();
+
+    // Gradients of loss by backward through the recorded checkpoints, the result has been computed
+    static std::map<Express::VARP, Express::VARP> grad(Express::VARP loss, const std::set<Express::VARP>& parameters,
+                                                       const std::string& blockExpr = "");
+};
+
+} // namespace Train
+} // namespace MNN
+
+#endif // Checkpoint_hpp
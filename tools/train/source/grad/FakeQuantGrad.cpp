@@ -0,0 +1,36 @@
+//
+//  FakeQuantGrad.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/20.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "OpGrad.hpp"
+#include "core/Macro.h"
+using namespace std;
+using namespace MNN;
+using namespace MNN::Express;
+
+// The grad of x and scale are computed together by FakeQuantGrad, see CPUFakeQuant
+class FakeQuantGrad : public OpGrad {
+public:
+    virtual std::vector<Express::VARP> onGrad(Express::EXPRP expr,
+                                              const std::vector<Express::VARP>& backwardOutput) override {
+        auto inputs = expr->inputs();
+        auto info   = inputs[0]->getInfo();
+        if (nullptr == info) {
+            return {};
+        }
+        std::unique_ptr<OpT> op(expr->get()->UnPack());
+        op->type        = OpType_FakeQuantGrad;
+        auto outputDiff = _Convert(backwardOutput[0], info->order);
+        auto gradExpr   = Expr::create(std::move(op), {inputs[0], inputs[1], outputDiff}, 2);
+        return {Variable::create(gradExpr, 0), Variable::create(gradExpr, 1)};
+    }
+};
+static const auto gRegister = []() {
+    static FakeQuantGrad _c;
+    OpGrad::insert(OpType_FakeQuant, &_c);
+    return true;
+}();
@@ -0,0 +1,256 @@
+//
+//  GradCache.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/19.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "GradCache.hpp"
+#include <MNN/expr/ExecutorScope.hpp>
+#include <string.h>
+#include "Checkpoint.hpp"
+#include "OpGrad.hpp"
+using namespace MNN::Express;
+
+namespace MNN {
+namespace Train {
+
+static bool _sameInfo(const Variable::Info* a, const Variable::Info* b) {
+    if (nullptr == a || nullptr == b) {
+        return false;
+    }
+    return a->order == b->order && a->type == b->type && a->dim == b->dim;
+}
+
+static bool _sameOp(const Expr* a, const Expr* b) {
+    auto extraA = a->extra();
+    auto extraB = b->extra();
+    if (nullptr == extraA.first || nullptr == extraB.first) {
+        return a->get() == b->get();
+    }
+    return extraA.second == extraB.second && 0 == ::memcmp(extraA.first.get(), extraB.first.get(), extraA.second);
+}
+
+void GradCache::clear() {
+    mOrder.clear();
+    mPositions.clear();
+    mInsides.clear();
+    mInputs.clear();
+    mExtras.clear();
+    mShapeContent.clear();
+    mOutputs.clear();
+    mParameters.clear();
+    mGrads.clear();
+}
+
+bool GradCache::_match(const std::vector<VARP>& outputs, const std::vector<EXPRP>& order,
+                       const std::set<VARP>& parameters, const std::string& blockExpr, bool& rewired) {
+    rewired = false;
+    if (mOrder.size() != order.size() || mOutputs.size() != outputs.size() || mParameters != parameters ||
+        mBlockExpr != blockExpr) {
+        return false;
+    }
+    std::map<const Expr*, int> positions;
+    for (int i = 0; i < order.size(); ++i) {
+        positions.insert(std::make_pair(order[i].get(), i));
+    }
+    for (int i = 0; i < outputs.size(); ++i) {
+        auto output = outputs[i]->expr();
+        if (mOutputs[i] != std::make_pair(positions[output.first.get()], output.second)) {
+            return false;
+        }
+    }
+    // The cached input and the new one whose content should be copied into it
+    std::vector<std::pair<VARP, VARP>> copies;
+    std::vector<int> relinks;
+    for (int i = 0; i < order.size(); ++i) {
+        auto cached = mOrder[i].get();
+        auto expr   = order[i].get();
+        if (cached == expr) {
+            if (expr->inside() == mInsides[i]) {
+                continue;
+            }
+            // A persistent graph (such as FixModule) links its input to the new forward by Expr::replace, which
+            // drops the compute cache of the gradients. Link the op back to the cached graph, or the forward before
+            // it would be computed twice, by the new graph and by the cached graph for the gradients
+            rewired = true;
+            if (nullptr == expr->get()) {
+                continue;
+            }
+            auto& inputs = mInputs[i];
+            if (nullptr == expr->extra().first || nullptr == mExtras[i].first ||
+                expr->extra().second != mExtras[i].second ||
+                0 != ::memcmp(expr->extra().first.get(), mExtras[i].first.get(), mExtras[i].second) ||
+                expr->inputs().size() != inputs.size()) {
+                return false;
+            }
+            for (int j = 0; j < inputs.size(); ++j) {
+                auto input = expr->inputs()[j]->expr();
+                if (inputs[j] != std::make_pair(positions[input.first.get()], input.second)) {
+                    return false;
+                }
+            }
+            relinks.emplace_back(i);
+            continue;
+        }
+        if ((nullptr == cached->get()) != (nullptr == expr->get())) {
+            return false;
+        }
+        if (nullptr == expr->get()) {
+            // The parameters must be the same, other inputs may have different contents of the same shape
+            if (VARP::TRAINABLE == cached->inputType() || VARP::TRAINABLE == expr->inputType()) {
+                return false;
+            }
+            if (!_sameInfo(cached->outputInfo(0), expr->outputInfo(0))) {
+                return false;
+            }
+            auto src = Variable::create(order[i]);
+            auto dst = Variable::create(mOrder[i]);
+            auto srcPtr = src->readMap<void>();
+            auto dstPtr = dst->readMap<void>();
+            if (nullptr == srcPtr || nullptr == dstPtr) {
+                return false;
+            }
+            auto info = src->getInfo();
+            if (0 == ::memcmp(srcPtr, dstPtr, info->size * info->type.bytes())) {
+                continue;
+            }
+            // The gradients may be built by the content, such as the axis of reduction
+            if (mShapeContent[i]) {
+                return false;
+            }
+            copies.emplace_back(dst, src);
+            continue;
+        }
+        if (cached->outputSize() != expr->outputSize() || cached->inputs().size() != expr->inputs().size() ||
+            !_sameOp(cached, expr)) {
+            return false;
+        }
+        for (int j = 0; j < expr->inputs().size(); ++j) {
+            auto cachedInput = cached->inputs()[j]->expr();
+            auto input       = expr->inputs()[j]->expr();
+            if (cachedInput.second != input.second ||
+                mPositions[cachedInput.first.get()] != positions[input.first.get()]) {
+                return false;
+            }
+        }
+        if (!order[i]->requireInfo()) {
+            return false;
+        }
+        for (int j = 0; j < expr->outputSize(); ++j) {
+            if (!_sameInfo(cached->outputInfo(j), expr->outputInfo(j))) {
+                return false;
+            }
+        }
+    }
+    for (auto& iter : copies) {
+        auto info = iter.second->getInfo();
+        ::memcpy(iter.first->writeMap<void>(), iter.second->readMap<void>(), info->size * info->type.bytes());
+    }
+    for (auto i : relinks) {
+        std::vector<VARP> inputs;
+        for (auto& input : mInputs[i]) {
+            inputs.emplace_back(Variable::create(mOrder[input.first], input.second));
+        }
+        Expr::replace(mOrder[i], Expr::create(mExtras[i], std::move(inputs), mOrder[i]->outputSize()));
+    }
+    if (rewired) {
+        for (int i = 0; i < mOrder.size(); ++i) {
+            mInsides[i] = mOrder[i]->inside();
+        }
+    }
+    return true;
+}
+
+std::map<VARP, VARP> GradCache::grad(VARP loss, const std::set<VARP>& parameters, const std::string& blockExpr) {
+    std::vector<VARP> outputs;
+    return grad(loss, outputs, parameters, blockExpr);
+}
+
+std::map<VARP, VARP> GradCache::grad(VARP loss, std::vector<VARP>& outputs, const std::set<VARP>& parameters,
+                                     const std::string& blockExpr) {
+    std::vector<VARP> targets = {loss};
+    targets.insert(targets.end(), outputs.begin(), outputs.end());
+    if (Checkpoint::recorded()) {
+        // The backward through checkpoints computes the segments at once, it can't be reused
+        clear();
+        auto grads = OpGrad::grad(loss, parameters, blockExpr);
+        std::vector<VARP> prepares = outputs;
+        for (auto& iter : grads) {
+            prepares.emplace_back(iter.second);
+        }
+        Variable::prepareCompute(prepares);
+        return grads;
+    }
+    auto order   = Variable::getExecuteOrder(targets);
+    bool rewired = false;
+    if (_match(targets, order, parameters, blockExpr, rewired)) {
+        mHitCount++;
+        if (rewired) {
+            _prepare();
+        }
+        for (int i = 0; i < outputs.size(); ++i) {
+            outputs[i] = Variable::create(mOrder[mOutputs[i + 1].first], mOutputs[i + 1].second);
+        }
+        return mGrads;
+    }
+    clear();
+    mBuildCount++;
+    mGrads = OpGrad::grad(loss, parameters, blockExpr);
+    if (mGrads.empty()) {
+        return mGrads;
+    }
+    mOrder      = std::move(order);
+    mParameters = parameters;
+    mBlockExpr  = blockExpr;
+    mShapeContent.resize(mOrder.size(), false);
+    for (int i = 0; i < mOrder.size(); ++i) {
+        mPositions.insert(std::make_pair(mOrder[i].get(), i));
+    }
+    mInsides.resize(mOrder.size());
+    mInputs.resize(mOrder.size());
+    mExtras.resize(mOrder.size());
+    for (int i = 0; i < mOrder.size(); ++i) {
+        mInsides[i] = mOrder[i]->inside();
+        mExtras[i]  = mOrder[i]->extra();
+        for (auto& input : mOrder[i]->inputs()) {
+            mInputs[i].emplace_back(mPositions[input->expr().first.get()], input->expr().second);
+        }
+    }
+    for (auto& target : targets) {
+        auto expr = target->expr();
+        mOutputs.emplace_back(mPositions[expr.first.get()], expr.second);
+    }
+    for (auto& expr : mOrder) {
+        if (nullptr == expr->get()) {
+            continue;
+        }
+        auto req = ExecutorScope::Current()->getRequirement(expr.get());
+        for (int j = 0; j < expr->inputs().size(); ++j) {
+            if (req.shapeNeedContent[j]) {
+                mShapeContent[mPositions[expr->inputs()[j]->expr().first.get()]] = true;
+            }
+        }
+    }
+    // Return new variables of the cached exprs, the caller may point the given ones to others
+    for (int i = 0; i < outputs.size(); ++i) {
+        outputs[i] = Variable::create(mOrder[mOutputs[i + 1].first], mOutputs[i + 1].second);
+    }
+    _prepare();
+    return mGrads;
+}
+
+void GradCache::_prepare() {
+    std::vector<VARP> prepares;
+    for (int i = 1; i < mOutputs.size(); ++i) {
+        prepares.emplace_back(Variable::create(mOrder[mOutputs[i].first], mOutputs[i].second));
+    }
+    for (auto& iter : mGrads) {
+        prepares.emplace_back(iter.second);
+    }
+    Variable::prepareCompute(prepares);
+}
+
+} // namespace Train
+} // namespace MNN
@@ -0,0 +1,81 @@
+//
+//  GradCache.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/19.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef GradCache_hpp
+#define GradCache_hpp
+
+#include <MNN/expr/Expr.hpp>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace MNN {
+namespace Train {
+
+/** Cache the backward graph of a loss across training steps. The forward of each step usually builds a new graph
+    of the same structure, only the data (and random masks such as dropout) differ. If the new loss graph has the
+    same ops, links and shapes as the cached one and uses the same parameters, the contents of its inputs are
+    copied into the cached graph, which marks the compute cache of it dirty, and the cached gradients are returned.
+    Otherwise the backward graph is built again by OpGrad::grad.
+    The variables computed by the same forward beside the loss, such as the running mean of BatchNorm or the loss
+    read by the training loop, should be passed as outputs. They are computed together with the gradients, and on
+    hit the new forward graph is not computed at all. */
+class MNN_PUBLIC GradCache {
+public:
+    GradCache()  = default;
+    ~GradCache() = default;
+
+    // The gradients of loss, they are prepared to compute together but not computed
+    std::map<Express::VARP, Express::VARP> grad(Express::VARP loss, const std::set<Express::VARP>& parameters,
+                                                const std::string& blockExpr = "");
+    // outputs are replaced by the variables of the graph the gradients come from, the cached one on hit
+    std::map<Express::VARP, Express::VARP> grad(Express::VARP loss, std::vector<Express::VARP>& outputs,
+                                                const std::set<Express::VARP>& parameters,
+                                                const std::string& blockExpr = "");
+
+    // Drop the cached graph
+    void clear();
+
+    // Number of the steps reusing the cached graph / building a new one
+    int hitCount() const {
+        return mHitCount;
+    }
+    int buildCount() const {
+        return mBuildCount;
+    }
+
+private:
+    bool _match(const std::vector<Express::VARP>& outputs, const std::vector<Express::EXPRP>& order,
+                const std::set<Express::VARP>& parameters, const std::string& blockExpr, bool& rewired);
+    // Compute the gradients and the outputs together in one cache
+    void _prepare();
+
+    // Execute order of the cached loss, the graph is kept alive by it
+    std::vector<Express::EXPRP> mOrder;
+    std::map<const Express::Expr*, int> mPositions;
+    // Whether the content of the expr is needed by some op to compute shape
+    std::vector<bool> mShapeContent;
+    // The inside, the input positions and the op of each cached expr when it's built, to find and undo the
+    // replacement by a persistent graph
+    std::vector<std::shared_ptr<Express::Expr::Inside>> mInsides;
+    std::vector<std::vector<std::pair<int, int>>> mInputs;
+    std::vector<std::pair<std::shared_ptr<char>, int>> mExtras;
+    // Position in mOrder and output index of the loss and the outputs
+    std::vector<std::pair<int, int>> mOutputs;
+    std::set<Express::VARP> mParameters;
+    std::string mBlockExpr;
+    std::map<Express::VARP, Express::VARP> mGrads;
+    int mHitCount   = 0;
+    int mBuildCount = 0;
+};
+
+} // namespace Train
+} // namespace MNN
+
+#endif // GradCache_hpp
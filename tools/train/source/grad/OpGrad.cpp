@@ -7,6 +7,7 @@
 //
 
 #include "OpGrad.hpp"
+#include "Checkpoint.hpp"
 using namespace std;
 using namespace MNN::Express;
 namespace MNN {
@@ -53,6 +54,9 @@ std::vector<Express::VARP> OpGrad::gradLinear(Express::VARP loss, const std::vec
 }
 
 std::map<Express::VARP, Express::VARP> OpGrad::grad(VARP loss, const std::set<Express::VARP>& parameters, const std::string& blockName) {
+    if (Train::Checkpoint::recorded()) {
+        return Train::Checkpoint::grad(loss, parameters, blockName);
+    }
     std::map<EXPRP, std::vector<VARP>> backwardMap;
     {
         auto shape = loss->getInfo();
@@ -34,6 +34,7 @@ public:
     static void insert(int type, OpGrad* creator);
     static std::vector<Express::VARP> gradLinear(Express::VARP loss, const std::vector<Express::VARP>& parameters, const std::vector<Express::VARP>& outputDiff, const std::string& blockExpr = "");
     static std::map<Express::VARP, Express::VARP> gradCommon(Express::VARP loss, const std::set<Express::VARP>& parameters, std::map<Express::EXPRP, std::vector<Express::VARP>>& backwardMap, const std::string& blockExpr = "");
+    // Backward through the checkpoints recorded by the forward if any, see Train::Checkpoint
     static std::map<Express::VARP, Express::VARP> grad(Express::VARP loss, const std::set<Express::VARP>& parameters, const std::string& blockExpr = "");
 
 protected:
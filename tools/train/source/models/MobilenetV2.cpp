@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include "MobilenetV2.hpp"
+#include "Checkpoint.hpp"
 
 namespace MNN {
 namespace Train {
@@ -21,6 +22,17 @@ public:
 
     std::shared_ptr<Module> conv;
     std::shared_ptr<Module> bn;
+
+private:
+    _ConvBnRelu() = default;
+
+    Module* clone(CloneContext* ctx) const override {
+        _ConvBnRelu* module(new _ConvBnRelu);
+        module->conv.reset(conv->clone(ctx));
+        module->bn.reset(bn->clone(ctx));
+        module->registerModel({module->conv, module->bn});
+        return this->cloneBaseTo(ctx, module);
+    }
 };
 
 std::shared_ptr<Module> ConvBnRelu(std::vector<int> inputOutputChannels, int kernelSize = 3, int stride = 1,
@@ -36,6 +48,19 @@ public:
 
     std::vector<std::shared_ptr<Module> > layers;
     bool useShortcut = false;
+
+private:
+    _BottleNeck() = default;
+
+    Module* clone(CloneContext* ctx) const override {
+        _BottleNeck* module(new _BottleNeck);
+        for (auto& layer : layers) {
+            module->layers.emplace_back(layer->clone(ctx));
+        }
+        module->useShortcut = useShortcut;
+        module->registerModel(module->layers);
+        return this->cloneBaseTo(ctx, module);
+    }
 };
 
 std::shared_ptr<Module> BottleNeck(std::vector<int> inputOutputChannels, int stride, int expandRatio) {
@@ -111,7 +136,7 @@ std::vector<Express::VARP> _BottleNeck::onForward(const std::vector<Express::VAR
     return {x};
 }
 
-MobilenetV2::MobilenetV2(int numClasses, float widthMult, int divisor) {
+MobilenetV2::MobilenetV2(int numClasses, float widthMult, int divisor, bool checkpoint) {
     int inputChannels = 32;
     int lastChannels  = 1280;
 
@@ -144,7 +169,11 @@ MobilenetV2::MobilenetV2(int numClasses, float widthMult, int divisor) {
                 stride = s;
             }
 
-            bottleNeckBlocks.emplace_back(BottleNeck({inputChannels, outputChannels}, stride, t));
+            auto block = BottleNeck({inputChannels, outputChannels}, stride, t);
+            if (checkpoint) {
+                block.reset(Checkpoint::create(block));
+            }
+            bottleNeckBlocks.emplace_back(block);
             inputChannels = outputChannels;
         }
     }
@@ -183,6 +212,20 @@ std::vector<Express::VARP> MobilenetV2::onForward(const std::vector<Express::VAR
     return {x};
 }
 
+Module* MobilenetV2::clone(CloneContext* ctx) const {
+    MobilenetV2* module(new MobilenetV2(ctx));
+    module->firstConv.reset(firstConv->clone(ctx));
+    for (auto& block : bottleNeckBlocks) {
+        module->bottleNeckBlocks.emplace_back(block->clone(ctx));
+    }
+    module->lastConv.reset(lastConv->clone(ctx));
+    module->dropout.reset(dropout->clone(ctx));
+    module->fc.reset(fc->clone(ctx));
+    module->registerModel({module->firstConv, module->lastConv, module->dropout, module->fc});
+    module->registerModel(module->bottleNeckBlocks);
+    return this->cloneBaseTo(ctx, module);
+}
+
 } // namespace Model
 } // namespace Train
 } // namespace MNN
@@ -24,7 +24,9 @@ class MNN_PUBLIC MobilenetV2 : public Express::Module {
 public:
     // use tensorflow numClasses = 1001, which label 0 means outlier of the original 1000 classes
     // so you maybe need to add 1 to your true labels, if you are testing with ImageNet dataset
-    MobilenetV2(int numClasses = 1001, float widthMult = 1.0f, int divisor = 8);
+    // checkpoint: recompute the activations of bottleneck blocks in backward instead of keeping them, it takes effect
+    // in a Checkpoint::Scope around the forward and backward
+    MobilenetV2(int numClasses = 1001, float widthMult = 1.0f, int divisor = 8, bool checkpoint = false);
 
     virtual std::vector<Express::VARP> onForward(const std::vector<Express::VARP> &inputs) override;
 
@@ -33,6 +35,13 @@ public:
     std::shared_ptr<Express::Module> lastConv;
     std::shared_ptr<Express::Module> dropout;
     std::shared_ptr<Express::Module> fc;
+
+private:
+    // Empty model for clone, the children are cloned from the origin
+    explicit MobilenetV2(CloneContext* ctx) {
+    }
+
+    Module* clone(CloneContext* ctx) const override;
 };
 
 } // namespace Model
@@ -7,6 +7,7 @@
 //
 
 #include "ADAM.hpp"
+#include <math.h>
 #include "OpGrad.hpp"
 
 using namespace MNN::Express;
@@ -36,6 +37,58 @@ float ADAM::getEps() {
     return mEps;
 }
 
+bool ADAM::getDecoupledWeightDecay() {
+    return mDecoupledWeightDecay;
+}
+
+void ADAM::setDecoupledWeightDecay(bool decoupled) {
+    mDecoupledWeightDecay = decoupled;
+}
+
+Express::VARP ADAM::regularizeParameters(Express::VARP param, Express::VARP grad) {
+    if (mDecoupledWeightDecay) {
+        return grad;
+    }
+    return SGD::regularizeParameters(param, grad);
+}
+
+bool ADAM::onFusedUpdate(const std::vector<UpdateState>& states) {
+    std::vector<std::pair<float*, float*>> moments(states.size());
+    for (int i = 0; i < states.size(); ++i) {
+        moments[i].first  = mHistory[states[i].parameter]->writeMap<float>();
+        moments[i].second = mHistory2[states[i].parameter]->writeMap<float>();
+        if (nullptr == moments[i].first || nullptr == moments[i].second) {
+            return false;
+        }
+    }
+    float step       = (float)currentStep();
+    float beta1      = mMomentum;
+    float beta2      = mMomentum2;
+    float eps        = mEps;
+    float lr         = mLearningRate;
+    float correction = lr * sqrtf(1.0f - powf(beta2, step)) / (1.0f - powf(beta1, step));
+    float decay      = mDecoupledWeightDecay ? lr * mWeightDecay : 0.0f;
+    // AdamW doesn't add the regularization to gradient
+    float l1 = 0.0f, l2 = 0.0f;
+    if (!mDecoupledWeightDecay) {
+        regularizeCoefficients(l1, l2);
+    }
+    parallelUpdate(states, [=, &states, &moments](int index, int start, int end) {
+        auto param = states[index].parameterPtr;
+        auto grad  = states[index].gradPtr;
+        auto m     = moments[index].first;
+        auto v     = moments[index].second;
+        for (int i = start; i < end; ++i) {
+            float p = param[i];
+            float g = regularize(p, grad[i], l1, l2);
+            m[i]    = beta1 * m[i] + (1.0f - beta1) * g;
+            v[i]    = beta2 * v[i] + (1.0f - beta2) * g * g;
+            param[i] = p - decay * p - correction * m[i] / (sqrtf(v[i]) + eps);
+        }
+    });
+    return true;
+}
+
 Express::VARP ADAM::onComputeUpdateValue(Express::VARP param, Express::VARP grad) {
     auto lr    = _Const(mLearningRate, {}, NCHW);
     auto step  = _Const(currentStep(), {}, NCHW);
@@ -54,6 +107,9 @@ Express::VARP ADAM::onComputeUpdateValue(Express::VARP param, Express::VARP grad
     mHistory2[param].fix(Express::VARP::CONSTANT);
 
     auto updateValue = lr * correction * (mHistory[param] / (_Sqrt(mHistory2[param]) + eps));
+    if (mDecoupledWeightDecay) {
+        updateValue = updateValue + lr * _Const(mWeightDecay, {}, NCHW) * param;
+    }
     updateValue.fix(Express::VARP::CONSTANT);
 
     return updateValue;
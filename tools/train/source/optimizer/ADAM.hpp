@@ -25,6 +25,10 @@ public:
 
     virtual Express::VARP onComputeUpdateValue(Express::VARP param, Express::VARP grad) override;
 
+    virtual Express::VARP regularizeParameters(Express::VARP param, Express::VARP grad) override;
+
+    virtual bool onFusedUpdate(const std::vector<UpdateState>& states) override;
+
     float getMomentum2();
 
     void setMomentum2(float momentum2);
@@ -33,9 +37,15 @@ public:
 
     void setEps(float eps);
 
+    // AdamW: decay the parameter by lr * weightDecay directly instead of adding the regularization to gradient
+    bool getDecoupledWeightDecay();
+
+    void setDecoupledWeightDecay(bool decoupled);
+
 private:
     float mMomentum2 = 0.999; // default 0.999
     float mEps       = 1e-8;
+    bool mDecoupledWeightDecay = false;
     std::map<MNN::Express::VARP, MNN::Express::VARP> mHistory2;
 };
 
@@ -0,0 +1,315 @@
+//
+//  DataParallel.cpp
+//  MNN
+//
+//  Created by MNN on 2020/12/14.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#include "DataParallel.hpp"
+#include <MNN/expr/ExecutorScope.hpp>
+#include <MNN/expr/ExprCreator.hpp>
+#include <string.h>
+#include <algorithm>
+#include "OpGrad.hpp"
+#include "cpp/ParallelFor.hpp"
+using namespace MNN::Express;
+
+namespace MNN {
+namespace Train {
+
+// Run function(0) ~ function(number - 1) concurrently, one thread for each
+static void _parallelFor(int number, const std::function<void(int)>& function) {
+    parallelFor(number, function, number);
+}
+
+static bool _isTrainable(VARP p) {
+    return nullptr != p.get() && nullptr == p->expr().first->get() &&
+           VARP::TRAINABLE == p->expr().first->inputType();
+}
+
+DataParallel* DataParallel::create(std::shared_ptr<Module> module, std::shared_ptr<ParameterOptimizer> optimizer,
+                                   int replicas, int threadsPerReplica, MNNForwardType type) {
+    if (nullptr == module || nullptr == optimizer || replicas < 1) {
+        MNN_ERROR("DataParallel need module, optimizer and at least one replica\n");
+        return nullptr;
+    }
+    std::unique_ptr<DataParallel> result(new DataParallel);
+    result->mModule    = module;
+    result->mOptimizer = optimizer;
+    auto parameters    = module->parameters();
+    int offset         = 0;
+    for (int i = 0; i < parameters.size(); ++i) {
+        if (!_isTrainable(parameters[i])) {
+            continue;
+        }
+        auto info = parameters[i]->getInfo();
+        if (nullptr == info || info->type != halide_type_of<float>()) {
+            MNN_ERROR("DataParallel only support float trainable parameter\n");
+            return nullptr;
+        }
+        result->mTrainableIndexes.emplace_back(i);
+        result->mOffsets.emplace_back(offset);
+        offset += info->size;
+    }
+    result->mOffsets.emplace_back(offset);
+    result->mGradient.resize(offset);
+    BackendConfig config;
+    result->mReplicas.resize(replicas);
+    for (auto& replica : result->mReplicas) {
+        replica.executor = Executor::newExecutor(type, config, threadsPerReplica);
+        replica.module.reset(Module::clone(module.get(), false));
+        if (nullptr == replica.executor || nullptr == replica.module) {
+            MNN_ERROR("Can't create replica for DataParallel, the module may not support clone\n");
+            return nullptr;
+        }
+        auto replicaParameters = replica.module->parameters();
+        if (replicaParameters.size() != parameters.size()) {
+            MNN_ERROR("The parameters of replica is not the same as the module\n");
+            return nullptr;
+        }
+        for (auto index : result->mTrainableIndexes) {
+            replica.trainable.emplace_back(replicaParameters[index]);
+        }
+    }
+    return result.release();
+}
+
+bool DataParallel::_compute(Replica& replica, const std::vector<VARP>& inputs, const LossFunction& lossFunction) {
+    std::vector<VARP> prepareCompute;
+    VARP loss;
+    {
+        // Building the graph is cheap but touches global state, such as the random generator of Dropout,
+        // so only the computing runs concurrently
+        std::lock_guard<std::mutex> _l(mBuildMutex);
+        loss = lossFunction(replica.module, inputs);
+        if (nullptr == loss) {
+            return false;
+        }
+        std::set<VARP> trainable(replica.trainable.begin(), replica.trainable.end());
+        auto grad = OpGrad::grad(mOptimizer->scaleLoss(loss), trainable);
+        prepareCompute.emplace_back(loss);
+        replica.grads.resize(replica.trainable.size());
+        for (int i = 0; i < replica.trainable.size(); ++i) {
+            auto iter        = grad.find(replica.trainable[i]);
+            replica.grads[i] = iter == grad.end() ? nullptr : iter->second;
+            if (nullptr != replica.grads[i]) {
+                prepareCompute.emplace_back(replica.grads[i]);
+            }
+        }
+    }
+    auto parameters = replica.module->parameters();
+    replica.states.clear();
+    for (int i = 0; i < parameters.size(); ++i) {
+        if (nullptr != parameters[i].get() && nullptr != parameters[i]->expr().first->get()) {
+            replica.states.emplace_back(i);
+            prepareCompute.emplace_back(parameters[i]);
+        }
+    }
+    Variable::prepareCompute(prepareCompute);
+    auto lossPtr = loss->readMap<float>();
+    if (nullptr == lossPtr) {
+        return false;
+    }
+    replica.loss = lossPtr[0];
+    replica.gradPtrs.resize(replica.grads.size());
+    for (int i = 0; i < replica.grads.size(); ++i) {
+        replica.gradPtrs[i] = nullptr;
+        if (nullptr == replica.grads[i]) {
+            // Not used by the loss, the gradient is zero
+            continue;
+        }
+        auto info           = replica.grads[i]->getInfo();
+        replica.gradPtrs[i] = replica.grads[i]->readMap<float>();
+        if (nullptr == info || nullptr == replica.gradPtrs[i] || info->type != halide_type_of<float>() ||
+            info->size != mOffsets[i + 1] - mOffsets[i]) {
+            return false;
+        }
+    }
+    // Cut the forward graph from the states, the same as SGD
+    for (auto index : replica.states) {
+        auto p    = parameters[index];
+        auto info = p->getInfo();
+        auto ptr  = p->readMap<void>();
+        if (nullptr == info || nullptr == ptr) {
+            return false;
+        }
+        Variable::replace(p, _Const(ptr, info->dim, info->order, info->type));
+    }
+    return true;
+}
+
+void DataParallel::_reduce(int part) {
+    // Reduce-scatter: each thread sums one contiguous part of the flatten gradient over all replicas
+    int number = (int)mReplicas.size();
+    int total  = (int)mGradient.size();
+    int start  = (int)((int64_t)total * part / number);
+    int end    = (int)((int64_t)total * (part + 1) / number);
+    auto dst   = mGradient.data();
+    ::memset(dst + start, 0, (end - start) * sizeof(float));
+    for (int i = 0; i < mTrainableIndexes.size(); ++i) {
+        int sta = std::max(start, mOffsets[i]);
+        int fin = std::min(end, mOffsets[i + 1]);
+        if (sta >= fin) {
+            continue;
+        }
+        for (auto& replica : mReplicas) {
+            if (replica.weight <= 0.0f || nullptr == replica.gradPtrs[i]) {
+                continue;
+            }
+            auto src    = replica.gradPtrs[i] - mOffsets[i];
+            auto weight = replica.weight;
+            for (int x = sta; x < fin; ++x) {
+                dst[x] += weight * src[x];
+            }
+        }
+    }
+}
+
+void DataParallel::_updateStates() {
+    // Average the states such as running mean / variance of BatchNorm by the weight of replicas
+    auto parameters = mModule->parameters();
+    std::vector<std::vector<VARP>> replicaParameters(mReplicas.size());
+    std::set<int> states;
+    for (int r = 0; r < mReplicas.size(); ++r) {
+        replicaParameters[r] = mReplicas[r].module->parameters();
+        if (mReplicas[r].weight > 0.0f) {
+            states.insert(mReplicas[r].states.begin(), mReplicas[r].states.end());
+        }
+    }
+    for (auto index : states) {
+        std::vector<float> average;
+        const Variable::Info* info = nullptr;
+        float weightSum            = 0.0f;
+        for (int r = 0; r < mReplicas.size(); ++r) {
+            auto& replica = mReplicas[r];
+            if (replica.weight <= 0.0f ||
+                std::find(replica.states.begin(), replica.states.end(), index) == replica.states.end()) {
+                continue;
+            }
+            info     = replicaParameters[r][index]->getInfo();
+            auto src = replicaParameters[r][index]->readMap<float>();
+            if (nullptr == info || nullptr == src || info->type != halide_type_of<float>()) {
+                break;
+            }
+            average.resize(info->size, 0.0f);
+            for (int x = 0; x < info->size; ++x) {
+                average[x] += replica.weight * src[x];
+            }
+            weightSum += replica.weight;
+        }
+        if (weightSum <= 0.0f || average.size() != info->size) {
+            continue;
+        }
+        for (auto& v : average) {
+            v /= weightSum;
+        }
+        Variable::replace(parameters[index], _Const(average.data(), info->dim, info->order));
+        for (int r = 0; r < mReplicas.size(); ++r) {
+            Variable::replace(replicaParameters[r][index], _Const(average.data(), info->dim, info->order));
+        }
+    }
+    for (auto& replica : mReplicas) {
+        replica.states.clear();
+    }
+}
+
+float DataParallel::step(const std::vector<VARP>& inputs, const LossFunction& lossFunction) {
+    mSkipped = false;
+    if (inputs.empty()) {
+        MNN_ERROR("DataParallel need inputs to split\n");
+        return -1.0f;
+    }
+    std::vector<const Variable::Info*> infos(inputs.size());
+    std::vector<const uint8_t*> ptrs(inputs.size());
+    int batch = 0;
+    for (int i = 0; i < inputs.size(); ++i) {
+        infos[i] = inputs[i]->getInfo();
+        ptrs[i]  = inputs[i]->readMap<uint8_t>();
+        if (nullptr == infos[i] || nullptr == ptrs[i] || infos[i]->dim.empty()) {
+            MNN_ERROR("DataParallel can't compute input %d\n", i);
+            return -1.0f;
+        }
+        if (0 == i) {
+            batch = infos[i]->dim[0];
+        }
+        if (infos[i]->dim[0] != batch || batch <= 0) {
+            MNN_ERROR("The inputs of DataParallel should have the same batch\n");
+            return -1.0f;
+        }
+    }
+    int number = (int)mReplicas.size();
+    std::vector<int> valid(number, 0);
+    _parallelFor(number, [&](int r) {
+        auto& replica = mReplicas[r];
+        int start     = batch * r / number;
+        int end       = batch * (r + 1) / number;
+        replica.weight = (float)(end - start) / (float)batch;
+        replica.loss   = 0.0f;
+        if (start >= end) {
+            valid[r] = 1;
+            return;
+        }
+        ExecutorScope scope(replica.executor);
+        replica.module->setIsTraining(mModule->getIsTraining());
+        std::vector<VARP> slices(inputs.size());
+        for (int i = 0; i < inputs.size(); ++i) {
+            auto dim   = infos[i]->dim;
+            auto bytes = infos[i]->size / batch * infos[i]->type.bytes();
+            dim[0]     = end - start;
+            slices[i]  = _Const(ptrs[i] + start * bytes, dim, infos[i]->order, infos[i]->type);
+        }
+        valid[r] = _compute(replica, slices, lossFunction) ? 1 : 0;
+    });
+    for (int r = 0; r < number; ++r) {
+        if (!valid[r]) {
+            MNN_ERROR("Compute error in replica %d of DataParallel\n", r);
+            return -1.0f;
+        }
+    }
+    _parallelFor(number, [this](int part) { _reduce(part); });
+
+    auto parameters = mModule->parameters();
+    std::map<VARP, VARP> grads;
+    for (int i = 0; i < mTrainableIndexes.size(); ++i) {
+        auto p    = parameters[mTrainableIndexes[i]];
+        auto info = p->getInfo();
+        grads[p]  = _Const(mGradient.data() + mOffsets[i], info->dim, info->order);
+    }
+    // Skip the update if the gradients of scaled loss overflow, the states are still updated
+    mSkipped = !mOptimizer->unscaleGradients(grads);
+    if (!mSkipped && !mOptimizer->applyGradients(grads)) {
+        MNN_ERROR("Apply gradients error in DataParallel\n");
+        return -1.0f;
+    }
+    _updateStates();
+
+    // Broadcast the new parameters to the replicas
+    std::vector<const float*> sources(mTrainableIndexes.size());
+    for (int i = 0; i < mTrainableIndexes.size(); ++i) {
+        sources[i] = parameters[mTrainableIndexes[i]]->readMap<float>();
+        if (nullptr == sources[i]) {
+            MNN_ERROR("Compute error for parameter %d of DataParallel\n", mTrainableIndexes[i]);
+            return -1.0f;
+        }
+    }
+    _parallelFor(number, [&](int r) {
+        auto& replica = mReplicas[r];
+        ExecutorScope scope(replica.executor);
+        for (int i = 0; i < replica.trainable.size(); ++i) {
+            auto dst = replica.trainable[i]->writeMap<float>();
+            MNN_ASSERT(nullptr != dst);
+            ::memcpy(dst, sources[i], (mOffsets[i + 1] - mOffsets[i]) * sizeof(float));
+        }
+        replica.grads.clear();
+        replica.gradPtrs.clear();
+    });
+    float loss = 0.0f;
+    for (auto& replica : mReplicas) {
+        loss += replica.weight * replica.loss;
+    }
+    return loss;
+}
+
+} // namespace Train
+} // namespace MNN
@@ -0,0 +1,88 @@
+//
+//  DataParallel.hpp
+//  MNN
+//
+//  Created by MNN on 2020/12/14.
+//  Copyright © 2018, Alibaba Group Holding Limited
+//
+
+#ifndef DataParallel_hpp
+#define DataParallel_hpp
+
+#include <MNN/expr/Executor.hpp>
+#include <MNN/expr/Module.hpp>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "ParameterOptimizer.hpp"
+
+namespace MNN {
+namespace Train {
+
+/** Data parallel training on one device: the module is cloned into some replicas, each one runs on its own executor.
+    A step splits the batch across the replicas, computes their gradients concurrently, reduces them in host memory
+    and applies them to the origin module by the optimizer once, then copies the new parameters back to the replicas.
+    The origin module should be used only by the optimizer / test between the steps. */
+class MNN_PUBLIC DataParallel {
+public:
+    // Compute the loss of one replica by the batch slice of inputs
+    typedef std::function<Express::VARP(std::shared_ptr<Express::Module> module, const std::vector<Express::VARP>& inputs)>
+        LossFunction;
+
+    /** The module must support clone, the optimizer must be created by the module and support applyGradients.
+        Return nullptr if failed. */
+    static DataParallel* create(std::shared_ptr<Express::Module> module, std::shared_ptr<ParameterOptimizer> optimizer,
+                                int replicas, int threadsPerReplica = 1, MNNForwardType type = MNN_FORWARD_CPU);
+
+    /** Split the first dimension of inputs into replicas, the loss should be the mean of its batch slice.
+        Return the mean loss of the batch, negative if failed. */
+    float step(const std::vector<Express::VARP>& inputs, const LossFunction& lossFunction);
+
+    // Whether the last step computed the gradients but skipped the update, for the overflow of scaled loss
+    bool skipped() const {
+        return mSkipped;
+    }
+
+    int replicas() const {
+        return (int)mReplicas.size();
+    }
+
+    std::shared_ptr<Express::Module> module() const {
+        return mModule;
+    }
+
+private:
+    DataParallel() = default;
+
+    struct Replica {
+        std::shared_ptr<Express::Module> module;
+        std::shared_ptr<Express::Executor> executor;
+        // Trainable parameters of the replica and their gradients, the same order as mTrainableIndexes
+        std::vector<Express::VARP> trainable;
+        std::vector<Express::VARP> grads;
+        std::vector<const float*> gradPtrs;
+        // Index of parameters computed by the forward, such as the running mean / variance of BatchNorm
+        std::vector<int> states;
+        float loss   = 0.0f;
+        float weight = 0.0f;
+    };
+
+    bool _compute(Replica& replica, const std::vector<Express::VARP>& inputs, const LossFunction& lossFunction);
+    void _reduce(int part);
+    void _updateStates();
+
+    std::shared_ptr<Express::Module> mModule;
+    std::shared_ptr<ParameterOptimizer> mOptimizer;
+    std::vector<Replica> mReplicas;
+    // Index of trainable parameters in Module::parameters() and their offset in mGradient, the last offset is the size
+    std::vector<int> mTrainableIndexes;
+    std::vector<int> mOffsets;
+    std::vector<float> mGradient;
+    std::mutex mBuildMutex;
+    bool mSkipped = false;
+};
+
+} // namespace Train
+} // namespace MNN
+
+#endif // DataParallel_hpp
@@ -7,6 +7,8 @@
 //
 
 #include "ParameterOptimizer.hpp"
+#include <MNN/expr/ExprCreator.hpp>
+#include <algorithm>
 #include "SGD.hpp"
 #include "ADAM.hpp"
 using namespace MNN::Express;
@@ -48,14 +50,111 @@ ParameterOptimizer* ParameterOptimizer::createADAM(std::shared_ptr<Module> modul
     return adam;
 }
 
+ParameterOptimizer* ParameterOptimizer::createADAMW(std::shared_ptr<Module> module, float lr, float momentum, float momentum2, float weightDecay, float eps) {
+    auto adam = new ADAM(module);
+    adam->setLearningRate(lr);
+    adam->setMomentum(momentum);
+    adam->setMomentum2(momentum2);
+    adam->setWeightDecay(weightDecay);
+    adam->setEps(eps);
+    adam->setDecoupledWeightDecay(true);
+    return adam;
+}
+
 bool ParameterOptimizer::step(Express::VARP loss) {
     mStep++;
-    auto res = this->onGetNextParameter(loss);
+    mOverflow = false;
+    auto res  = this->onGetNextParameter(loss);
+    if (mOverflow) {
+        mStep--;
+        return false;
+    }
+    return _updateParameters(res);
+}
+
+bool ParameterOptimizer::applyGradients(std::map<Express::VARP, Express::VARP> grads) {
+    mStep++;
+    return _updateParameters(this->onApplyGradients(std::move(grads)));
+}
+
+void ParameterOptimizer::setLossScale(const LossScale& config) {
+    // The inverse of scale should not be denormal, which is flushed to zero by -ffast-math
+    const float limit        = 1e30f;
+    mUseLossScale            = true;
+    mLossScale               = config;
+    mLossScale.maxScale      = std::min(mLossScale.maxScale, limit);
+    mLossScale.minScale      = std::min(mLossScale.minScale, mLossScale.maxScale);
+    mLossScale.scale         = std::max(std::min(mLossScale.scale, mLossScale.maxScale), mLossScale.minScale);
+    mGoodSteps               = 0;
+}
+
+float ParameterOptimizer::lossScale() const {
+    return mUseLossScale ? mLossScale.scale : 1.0f;
+}
+
+Express::VARP ParameterOptimizer::scaleLoss(Express::VARP loss) const {
+    if (!mUseLossScale) {
+        return loss;
+    }
+    return loss * _Scalar<float>(mLossScale.scale);
+}
+
+bool ParameterOptimizer::unscaleGradients(const std::map<Express::VARP, Express::VARP>& grads) {
+    if (!mUseLossScale) {
+        return true;
+    }
+    std::vector<std::pair<float*, int>> buffers;
+    bool overflow = false;
+    for (auto& iter : grads) {
+        auto info = iter.second->getInfo();
+        if (nullptr == info || info->type != halide_type_of<float>()) {
+            continue;
+        }
+        auto ptr = iter.second->writeMap<float>();
+        if (nullptr == ptr) {
+            MNN_ERROR("Gradient should be computed before unscale\n");
+            overflow = true;
+            break;
+        }
+        // Check the exponent bits, std::isfinite may be optimized out by -ffast-math
+        auto bits = (const uint32_t*)ptr;
+        for (int i = 0; i < info->size && !overflow; ++i) {
+            overflow = (bits[i] & 0x7f800000) == 0x7f800000;
+        }
+        if (overflow) {
+            break;
+        }
+        buffers.emplace_back(ptr, info->size);
+    }
+    if (overflow) {
+        mOverflow = true;
+        mSkippedSteps++;
+        mGoodSteps       = 0;
+        mLossScale.scale = std::max(mLossScale.scale * mLossScale.backoffFactor, mLossScale.minScale);
+        return false;
+    }
+    auto inverse = 1.0f / mLossScale.scale;
+    for (auto& buffer : buffers) {
+        for (int i = 0; i < buffer.second; ++i) {
+            buffer.first[i] *= inverse;
+        }
+    }
+    if (++mGoodSteps >= mLossScale.growthInterval) {
+        mGoodSteps       = 0;
+        mLossScale.scale = std::min(mLossScale.scale * mLossScale.growthFactor, mLossScale.maxScale);
+    }
+    return true;
+}
+
+bool ParameterOptimizer::_updateParameters(const std::map<Express::VARP, Express::VARP>& res) {
     for (auto iter : res) {
         iter.second.fix(Express::VARP::TRAINABLE);
     }
     for (auto iter : res) {
-        iter.first->input(iter.second);
+        // The parameter updated in place maps to itself
+        if (iter.first.get() != iter.second.get()) {
+            iter.first->input(iter.second);
+        }
     }
     return !res.empty();
 }
@@ -21,16 +21,52 @@ public:
         L1L2,
     };
 
+    /** Dynamic loss scaling for training in reduced precision, such as fp16 by Arm82 backend with
+        BackendConfig::Precision_Low. The parameters are still float, the gradients are computed by loss * scale and
+        divided by scale before update, so the small ones don't underflow. If any gradient is inf / nan the update
+        is skipped and the scale is multiplied by backoffFactor, after growthInterval steps without overflow the
+        scale is multiplied by growthFactor. The scale is kept no larger than 1e30, so its inverse is not denormal. */
+    struct LossScale {
+        float scale         = 65536.0f;
+        float growthFactor  = 2.0f;
+        float backoffFactor = 0.5f;
+        int growthInterval  = 2000;
+        float minScale      = 1.0f;
+        float maxScale      = 16777216.0f;
+    };
+
     ParameterOptimizer(std::shared_ptr<Express::Module> module);
     virtual ~ParameterOptimizer() = default;
     bool step(Express::VARP loss);
+    // Update the trainable parameters by gradients computed outside, such as the ones reduced by DataParallel
+    bool applyGradients(std::map<Express::VARP, Express::VARP> grads);
     int currentStep();
     void setCurrentStep(int step);
 
+    // Enable dynamic loss scaling, the step is false and not counted if the gradients overflow
+    void setLossScale(const LossScale& config);
+    // The current scale, 1 if loss scaling is not enabled
+    float lossScale() const;
+    // Number of steps skipped for overflow
+    int skippedSteps() const {
+        return mSkippedSteps;
+    }
+    // Multiply the loss by the current scale for backward
+    Express::VARP scaleLoss(Express::VARP loss) const;
+    /** Check the computed gradients of scaled loss and divide them by the scale in place, then adjust the scale.
+        Return false if some gradient overflows, the update should be skipped. */
+    bool unscaleGradients(const std::map<Express::VARP, Express::VARP>& grads);
+
     virtual std::map<Express::VARP, Express::VARP> onGetNextParameter(Express::VARP loss) = 0;
 
+    // grads map trainable parameter to its computed gradient, return the map of parameter to its new value
+    virtual std::map<Express::VARP, Express::VARP> onApplyGradients(std::map<Express::VARP, Express::VARP> grads) {
+        return {};
+    }
+
     static ParameterOptimizer* createSGD(std::shared_ptr<Express::Module> module, float lr, float momentum, float weightDecay, RegularizationMethod method);
     static ParameterOptimizer* createADAM(std::shared_ptr<Express::Module> module, float lr, float momentum, float momentum2, float weightDecay, float eps, RegularizationMethod method);
+    static ParameterOptimizer* createADAMW(std::shared_ptr<Express::Module> module, float lr, float momentum, float momentum2, float weightDecay, float eps);
 protected:
     const std::set<Express::VARP>& trainable() const {
         return mTrainable;
@@ -38,8 +74,17 @@ protected:
     std::shared_ptr<Express::Module> module() const {
         return mModule;
     }
+    bool lossScaleEnabled() const {
+        return mUseLossScale;
+    }
 private:
+    bool _updateParameters(const std::map<Express::VARP, Express::VARP>& res);
     int mStep = 0;
+    bool mUseLossScale = false;
+    LossScale mLossScale;
+    int mGoodSteps     = 0;
+    int mSkippedSteps  = 0;
+    bool mOverflow     = false;
     std::shared_ptr<Express::Module> mModule;
     std::set<Express::VARP> mTrainable;
 };
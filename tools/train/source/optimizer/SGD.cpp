@@ -7,9 +7,14 @@
 //
 
 #include "SGD.hpp"
+#include <algorithm>
 #include "OpGrad.hpp"
+#include "cpp/ParallelFor.hpp"
 using namespace MNN::Express;
 
+// Elements of a parameter updated by one task
+#define SGD_UPDATE_BLOCK 16384
+
 namespace MNN {
 namespace Train {
 SGD::SGD(std::shared_ptr<Module> module) : ParameterOptimizer(module) {
@@ -17,6 +22,15 @@ SGD::SGD(std::shared_ptr<Module> module) : ParameterOptimizer(module) {
     for (auto p : train) {
         mHistory[p] = _Const(0.0f, p->getInfo()->dim, p->getInfo()->order);
     }
+    mGradCache.reset(new GradCache);
+}
+
+void SGD::setCacheGrad(bool cache) {
+    if (!cache) {
+        mGradCache = nullptr;
+    } else if (nullptr == mGradCache) {
+        mGradCache.reset(new GradCache);
+    }
 }
 
 void SGD::setLearningRate(float rate) {
@@ -76,38 +90,163 @@ Express::VARP SGD::onComputeUpdateValue(Express::VARP param, Express::VARP grad)
     return mHistory[param];
 }
 
+void SGD::parallelUpdate(const std::vector<UpdateState>& states, const std::function<void(int, int, int)>& function) {
+    struct Block {
+        int index;
+        int start;
+        int end;
+    };
+    std::vector<Block> blocks;
+    for (int i = 0; i < states.size(); ++i) {
+        for (int start = 0; start < states[i].size; start += SGD_UPDATE_BLOCK) {
+            blocks.emplace_back(Block{i, start, std::min(start + SGD_UPDATE_BLOCK, states[i].size)});
+        }
+    }
+    parallelFor((int)blocks.size(), [&](int i) { function(blocks[i].index, blocks[i].start, blocks[i].end); });
+}
+
+bool SGD::onFusedUpdate(const std::vector<UpdateState>& states) {
+    std::vector<float*> histories(states.size());
+    for (int i = 0; i < states.size(); ++i) {
+        histories[i] = mHistory[states[i].parameter]->writeMap<float>();
+        if (nullptr == histories[i]) {
+            return false;
+        }
+    }
+    float lr       = mLearningRate;
+    float momentum = mMomentum;
+    float l1, l2;
+    regularizeCoefficients(l1, l2);
+    parallelUpdate(states, [=, &states, &histories](int index, int start, int end) {
+        auto param   = states[index].parameterPtr;
+        auto grad    = states[index].gradPtr;
+        auto history = histories[index];
+        for (int i = start; i < end; ++i) {
+            history[i] = lr * regularize(param[i], grad[i], l1, l2) + momentum * history[i];
+            param[i] -= history[i];
+        }
+    });
+    return true;
+}
+
 std::map<Express::VARP, Express::VARP> SGD::onGetNextParameter(Express::VARP loss) {
-    auto grad = OpGrad::grad(loss, trainable(), mGradBlockExprName);
-    auto parameters = module()->parameters();
-    std::vector<VARP> prepareCompute;
-    for (auto iter : parameters) {
+    // The states computed by forward, such as the running mean of BatchNorm
+    std::vector<VARP> states;
+    for (auto iter : module()->parameters()) {
         if (iter->expr().first->get() != nullptr) {
-            prepareCompute.emplace_back(iter);
+            states.emplace_back(iter);
         }
     }
+    std::map<VARP, VARP> grad;
+    if (nullptr != mGradCache) {
+        // Compute the loss and the states by the graph of the cached gradients, the new forward graph is dropped by
+        // pointing them to the results, so the training loop reading the loss doesn't compute the forward again
+        std::vector<VARP> outputs = {loss};
+        outputs.insert(outputs.end(), states.begin(), states.end());
+        auto computed = outputs;
+        grad = mGradCache->grad(scaleLoss(loss), computed, trainable(), mGradBlockExprName);
+        std::vector<VARP> results(outputs.size());
+        for (int i = 0; i < outputs.size(); ++i) {
+            auto info = computed[i]->getInfo();
+            auto ptr  = computed[i]->readMap<void>();
+            if (nullptr == ptr) {
+                MNN_ERROR("Compute error in SGD\n");
+                return {};
+            }
+            results[i] = _Const(ptr, info->dim, info->order, info->type);
+        }
+        // The exprs of the outputs are kept by the cache, only the variables are moved
+        for (int i = 0; i < outputs.size(); ++i) {
+            outputs[i]->setExpr(results[i]->expr().first, 0);
+        }
+        // Keep the graph of cached gradients for the next step, copy them only if they are unscaled in place
+        for (auto& iter : grad) {
+            auto info = iter.second->getInfo();
+            auto ptr  = iter.second->readMap<void>();
+            if (nullptr == ptr) {
+                MNN_ERROR("Compute error in SGD\n");
+                return {};
+            }
+            if (lossScaleEnabled()) {
+                iter.second = _Const(ptr, info->dim, info->order, info->type);
+            }
+        }
+    } else {
+        grad = OpGrad::grad(scaleLoss(loss), trainable(), mGradBlockExprName);
+        // Compute the loss with the states, reading it after the update would compute the forward again
+        std::vector<VARP> prepareCompute = {loss};
+        prepareCompute.insert(prepareCompute.end(), states.begin(), states.end());
+        for (auto& iter : grad) {
+            prepareCompute.emplace_back(iter.second);
+        }
+        Variable::prepareCompute(prepareCompute);
+        std::vector<VARP> replaceOp(prepareCompute.size());
+        for (int i=0; i<prepareCompute.size(); ++i) {
+            auto info = prepareCompute[i]->getInfo();
+            auto ptr = prepareCompute[i]->readMap<void>();
+            if (nullptr == ptr) {
+                MNN_ERROR("Compute error in SGD\n");
+                return {};
+            }
+            auto newVar = _Const(ptr, info->dim, info->order, info->type);
+            replaceOp[i]= newVar;
+        }
+        // The loss may be used by the backward graph, only move the variable
+        loss->setExpr(replaceOp[0]->expr().first, 0);
+        for (int i=1; i<prepareCompute.size(); ++i) {
+            Variable::replace(prepareCompute[i], replaceOp[i]);
+        }
+    }
+    if (!unscaleGradients(grad)) {
+        return {};
+    }
+    return onApplyGradients(std::move(grad));
+}
+
+std::map<Express::VARP, Express::VARP> SGD::onApplyGradients(std::map<Express::VARP, Express::VARP> grad) {
+    // Update in place if all parameters are float, the parameter maps to itself
+    std::vector<UpdateState> states;
     for (auto& iter : grad) {
-        prepareCompute.emplace_back(iter.second);
+        auto paramInfo = iter.first->getInfo();
+        auto gradInfo  = iter.second->getInfo();
+        if (nullptr == paramInfo || nullptr == gradInfo || paramInfo->type != halide_type_of<float>() ||
+            gradInfo->type != halide_type_of<float>() || paramInfo->size != gradInfo->size) {
+            states.clear();
+            break;
+        }
+        UpdateState state;
+        state.parameter = iter.first;
+        state.gradPtr   = iter.second->readMap<float>();
+        state.size      = (int)paramInfo->size;
+        if (nullptr == state.gradPtr) {
+            states.clear();
+            break;
+        }
+        states.emplace_back(state);
     }
-    Variable::prepareCompute(prepareCompute);
-    std::vector<VARP> replaceOp(prepareCompute.size());
-    for (int i=0; i<prepareCompute.size(); ++i) {
-        auto info = prepareCompute[i]->getInfo();
-        auto ptr = prepareCompute[i]->readMap<void>();
-        if (nullptr == ptr) {
-            MNN_ERROR("Compute error in SGD\n");
-            return {};
+    // Map the parameters after all gradients are computed, writing a parameter makes the gradients depending on it
+    // dirty, which would compute the backward graph again for the next gradient
+    for (auto& state : states) {
+        state.parameterPtr = state.parameter->writeMap<float>();
+        if (nullptr == state.parameterPtr) {
+            states.clear();
+            break;
         }
-        auto newVar = _Const(ptr, info->dim, info->order, info->type);
-        replaceOp[i]= newVar;
     }
-    for (int i=0; i<prepareCompute.size(); ++i) {
-        Variable::replace(prepareCompute[i], replaceOp[i]);
+    if (states.size() == grad.size() && onFusedUpdate(states)) {
+        for (auto& iter : grad) {
+            iter.second = iter.first;
+        }
+        return grad;
     }
 
     for (auto& iter : grad) {
         // apply regularization
         auto addWeightDecayGrad = regularizeParameters(iter.first, iter.second);
-        addWeightDecayGrad.fix(Express::VARP::CONSTANT);
+        // AdamW returns the gradient itself, fixing it in place would replace an expr the module graph may share
+        if (addWeightDecayGrad.get() != iter.second.get()) {
+            addWeightDecayGrad.fix(Express::VARP::CONSTANT);
+        }
         // apply momentum, etc.
         auto updateValue = this->onComputeUpdateValue(iter.first, addWeightDecayGrad);
         // apply update
@@ -10,8 +10,10 @@
 #define SGD_hpp
 
 #include <MNN/expr/ExprCreator.hpp>
+#include <functional>
 #include <string>
 #include <vector>
+#include "GradCache.hpp"
 #include "ParameterOptimizer.hpp"
 
 namespace MNN {
@@ -23,10 +25,24 @@ public:
     virtual ~ SGD() = default;
     virtual std::map<Express::VARP, Express::VARP> onGetNextParameter(Express::VARP loss) override;
 
-    Express::VARP regularizeParameters(Express::VARP param, Express::VARP grad);
+    virtual std::map<Express::VARP, Express::VARP> onApplyGradients(std::map<Express::VARP, Express::VARP> grad) override;
+
+    virtual Express::VARP regularizeParameters(Express::VARP param, Express::VARP grad);
 
     virtual Express::VARP onComputeUpdateValue(Express::VARP param, Express::VARP grad);
 
+    /** A float trainable parameter and its computed gradient */
+    struct UpdateState {
+        Express::VARP parameter;
+        float* parameterPtr;
+        const float* gradPtr;
+        int size;
+    };
+    /** Apply regularization, momentum and the update to all parameters in place, in one multithreaded pass.
+        Return false to update by the graph of regularizeParameters / onComputeUpdateValue instead, so the subclass
+        which overrides onComputeUpdateValue should override it as well. */
+    virtual bool onFusedUpdate(const std::vector<UpdateState>& states);
+
     void setLearningRate(float rate);
 
     float getMomentum();
@@ -47,7 +63,25 @@ public:
         mGradBlockExprName = std::move(block);
     }
 
+    /** Reuse the backward graph of the last step if the loss is computed by a graph of the same structure and
+        shapes, see GradCache. It's enabled by default. */
+    void setCacheGrad(bool cache);
+
 protected:
+    // grad + l1 * sign(param) + l2 * param, the coefficients of mRegularizationMethod are got by
+    // regularizeCoefficients, the same as regularizeParameters
+    void regularizeCoefficients(float& l1, float& l2) const {
+        l1 = (L1 == mRegularizationMethod || L1L2 == mRegularizationMethod) ? mWeightDecay : 0.0f;
+        l2 = (L2 == mRegularizationMethod || L1L2 == mRegularizationMethod) ? mWeightDecay : 0.0f;
+    }
+    static inline float regularize(float param, float grad, float l1, float l2) {
+        float sign = (float)((param > 0.0f) - (param < 0.0f));
+        return grad + l1 * sign + l2 * param;
+    }
+    // Split all states into blocks, run function(stateIndex, start, end) on them with the hardware threads
+    static void parallelUpdate(const std::vector<UpdateState>& states,
+                               const std::function<void(int, int, int)>& function);
+
     float mLearningRate                        = 0.001f;
     float mMomentum                            = 0;
     float mWeightDecay                         = 0;
@@ -55,8 +89,7 @@ protected:
     std::map<MNN::Express::VARP, MNN::Express::VARP> mHistory;
 
     // For Cache
-    const Express::Expr* mLoss = nullptr;
-    int mLossFromIndex         = 0;
+    std::shared_ptr<GradCache> mGradCache;
     std::string mGradBlockExprName;
 };
 